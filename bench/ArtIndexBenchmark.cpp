@@ -0,0 +1,107 @@
+#include "BenchUtil.hpp"
+#include "index/ArtIndex.hpp"
+#include "index/BPlusTree.hpp"
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <unordered_map>
+
+// In-memory index throughput for a hot table: random inserts and point
+// lookups in an ART, a B+ tree whose pages all fit in the buffer pool, and
+// std::unordered_map; then ART lookups from several threads.
+
+namespace {
+
+constexpr int kKeys = 2000000;
+constexpr int kLookups = 2000000;
+constexpr std::size_t kPoolSize = 16384; // 64 MB, the whole B+ tree
+const char *kDbFile = "bench_art_index.db";
+
+RID ridFor(int64_t key) {
+  return RID{static_cast<page_id_t>(key & 0xffff),
+             static_cast<uint16_t>((key >> 16) & 0xff)};
+}
+
+} // namespace
+
+int main() {
+  std::mt19937_64 rng(5);
+  std::vector<int64_t> keys(kKeys);
+  for (int64_t &key : keys) {
+    key = static_cast<int64_t>(rng() >> 1);
+  }
+  std::vector<int64_t> probes(kLookups);
+  for (int i = 0; i < kLookups; i++) {
+    probes[i] = keys[rng() % kKeys];
+  }
+
+  ArtIndex art;
+  Timer timer;
+  for (int64_t key : keys) {
+    art.insert(key, ridFor(key));
+  }
+  report("insert, ART", kKeys, timer.elapsedSeconds(), "inserts");
+
+  std::remove(kDbFile);
+  BufferPoolManager bpm(kPoolSize, kDbFile);
+  BPlusTree tree(&bpm);
+  timer.reset();
+  for (int64_t key : keys) {
+    tree.insert(key, ridFor(key));
+  }
+  report("insert, B+ tree (pages in pool)", kKeys, timer.elapsedSeconds(),
+         "inserts");
+
+  std::unordered_map<int64_t, RID> map;
+  timer.reset();
+  for (int64_t key : keys) {
+    map.emplace(key, ridFor(key));
+  }
+  report("insert, std::unordered_map", kKeys, timer.elapsedSeconds(),
+         "inserts");
+
+  RID rid;
+  std::size_t found = 0;
+  timer.reset();
+  for (int64_t key : probes) {
+    found += art.lookup(key, &rid);
+  }
+  report("lookup, ART", kLookups, timer.elapsedSeconds(), "lookups");
+
+  timer.reset();
+  for (int64_t key : probes) {
+    found += tree.lookup(key, &rid);
+  }
+  report("lookup, B+ tree (pages in pool)", kLookups, timer.elapsedSeconds(),
+         "lookups");
+
+  timer.reset();
+  for (int64_t key : probes) {
+    found += map.count(key);
+  }
+  report("lookup, std::unordered_map", kLookups, timer.elapsedSeconds(),
+         "lookups");
+  doNotOptimize(found);
+
+  for (int num_threads : {1, 2, 4, 8}) {
+    timer.reset();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; t++) {
+      threads.emplace_back([&, t] {
+        RID local;
+        std::size_t hits = 0;
+        for (int i = t; i < kLookups; i += num_threads) {
+          hits += art.lookup(probes[i], &local);
+        }
+        doNotOptimize(hits);
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    report("lookup, ART, " + std::to_string(num_threads) + " threads",
+           kLookups, timer.elapsedSeconds(), "lookups");
+  }
+  std::remove(kDbFile);
+  return 0;
+}
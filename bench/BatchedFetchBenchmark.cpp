@@ -0,0 +1,80 @@
+#include "BenchUtil.hpp"
+#include "index/BPlusTree.hpp"
+#include <fcntl.h>
+#include <random>
+#include <unistd.h>
+
+// Random point lookups in batches of keys on a B+ tree about 8x the pool
+// (2M keys, 1024 frames), with the index file dropped from the OS page
+// cache before each run:
+// 1. one lookup (and one fetchPage per level) per key
+// 2. lookupBatch: the distinct nodes of each level fetched with one
+//    fetchPages call, misses read as a batch of coalesced parallel reads
+// Reports lookups/s and disk reads for several batch sizes.
+
+namespace {
+
+constexpr int kKeys = 2000000;
+constexpr int kLookups = 200000;
+constexpr std::size_t kPoolSize = 1024;
+const char *kDbFile = "bench_batched_fetch.db";
+
+void dropPageCache() {
+  int fd = open(kDbFile, O_RDONLY);
+  posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+  close(fd);
+}
+
+} // namespace
+
+int main() {
+  std::remove(kDbFile);
+  page_id_t root;
+  {
+    BufferPoolManager bpm(kPoolSize, kDbFile);
+    std::vector<std::pair<int64_t, RID>> entries;
+    for (int64_t i = 0; i < kKeys; i++) {
+      entries.emplace_back(i, RID{static_cast<page_id_t>(i >> 8),
+                                  static_cast<uint16_t>(i & 0xff)});
+    }
+    BPlusTree tree(&bpm);
+    tree.bulkLoad(entries);
+    root = tree.getRootPageId();
+  }
+
+  for (std::size_t batch_size : {16, 64, 256}) {
+    for (bool batched : {false, true}) {
+      dropPageCache();
+      BufferPoolManager bpm(kPoolSize, kDbFile);
+      BPlusTree tree(&bpm, root);
+      std::mt19937_64 rng(batch_size);
+      std::vector<int64_t> keys(batch_size);
+      std::vector<RID> rids;
+      std::vector<bool> found;
+      std::size_t hits = 0;
+      Timer timer;
+      for (int done = 0; done < kLookups; done += batch_size) {
+        for (int64_t &key : keys) {
+          key = static_cast<int64_t>(rng() % kKeys);
+        }
+        if (batched) {
+          hits += tree.lookupBatch(keys, &rids, &found);
+        } else {
+          RID rid;
+          for (int64_t key : keys) {
+            hits += tree.lookup(key, &rid);
+          }
+        }
+      }
+      report(std::string(batched ? "lookupBatch" : "lookup per key") +
+                 ", batches of " + std::to_string(batch_size),
+             kLookups, timer.elapsedSeconds(), "lookups");
+      BufferPoolStats stats = bpm.getStats();
+      std::printf("  %zu misses in %zu disk reads\n", stats.misses,
+                  stats.disk_reads);
+      doNotOptimize(hits);
+    }
+  }
+  std::remove(kDbFile);
+  return 0;
+}
@@ -0,0 +1,39 @@
+/* Helpers shared by the micro benchmarks
+1. Timer measures wall-clock time of a block
+2. report prints one aligned line per measurement so runs are easy to diff
+*/
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+class Timer {
+private:
+  std::chrono::steady_clock::time_point start;
+
+public:
+  Timer() : start(std::chrono::steady_clock::now()) {}
+
+  void reset() { start = std::chrono::steady_clock::now(); }
+
+  double elapsedSeconds() const {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                         start)
+        .count();
+  }
+};
+
+// prints "<name>  <ops> ops in <secs> s  (<ops/s> <unit>/s)"
+inline void report(const std::string &name, uint64_t ops, double seconds,
+                   const char *unit = "ops") {
+  double rate = seconds > 0 ? static_cast<double>(ops) / seconds : 0;
+  std::printf("%-44s %12llu %s in %8.3f s  (%14.0f %s/s)\n", name.c_str(),
+              static_cast<unsigned long long>(ops), unit, seconds, rate, unit);
+}
+
+// keeps the optimizer from discarding benchmark results
+template <typename T> inline void doNotOptimize(const T &value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
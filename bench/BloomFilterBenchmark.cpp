@@ -0,0 +1,99 @@
+#include "BenchUtil.hpp"
+#include "index/BPlusTree.hpp"
+#include "index/PageBloomFilters.hpp"
+
+// Negative-lookup throughput and page I/O saved by Bloom filters:
+// 1. B+ tree point lookups of absent keys, with and without the index filter
+// 2. heap lookups on a non-indexed column, scanning every page vs. fetching
+//    only the pages whose per-page filter may contain the key
+
+namespace {
+
+constexpr int kKeys = 2000000;
+constexpr int kLookups = 500000;
+constexpr int kHeapRows = 200000;
+constexpr int kHeapLookups = 200;
+constexpr std::size_t kPoolSize = 256; // 1 MB, far smaller than the index
+const char *kDbFile = "bench_bloom_filter.db";
+
+void printIo(const BufferPoolStats &stats) {
+  std::printf("%44s fetches=%zu disk reads=%zu\n", "",
+              stats.hits + stats.misses, stats.disk_reads);
+}
+
+} // namespace
+
+int main() {
+  std::remove(kDbFile);
+  BufferPoolManager bpm(kPoolSize, kDbFile);
+
+  std::vector<std::pair<int64_t, RID>> entries;
+  entries.reserve(kKeys);
+  for (int i = 0; i < kKeys; i++) {
+    entries.emplace_back(static_cast<int64_t>(i) * 2,
+                         RID{static_cast<page_id_t>(i >> 8), 0});
+  }
+  BPlusTree tree(&bpm);
+  tree.bulkLoad(entries);
+
+  for (bool filtered : {false, true}) {
+    if (filtered) {
+      tree.enableBloomFilter(kKeys);
+    }
+    bpm.resetStats();
+    Timer timer;
+    std::size_t found = 0;
+    RID rid;
+    for (int i = 0; i < kLookups; i++) {
+      // odd keys are absent, spread over the whole key range
+      int64_t key = (static_cast<int64_t>(i) * 7919 % kKeys) * 2 + 1;
+      found += tree.lookup(key, &rid);
+    }
+    double seconds = timer.elapsedSeconds();
+    doNotOptimize(found);
+    report(filtered ? "index lookup, bloom filter" : "index lookup, no filter",
+           kLookups, seconds, "lookups");
+    printIo(bpm.getStats());
+  }
+
+  Schema schema({Column("id", TypeId::BIGINT, false),
+                 Column("payload", TypeId::VARCHAR, false)});
+  TableHeap heap(&bpm);
+  TupleBuilder row(schema);
+  for (int i = 0; i < kHeapRows; i++) {
+    row.setBigInt(0, i * 2);
+    row.setVarchar(1, "payload" + std::to_string(i));
+    heap.insertTuple(row);
+  }
+
+  // baseline: every page is fetched and every row compared
+  bpm.resetStats();
+  Timer scan_timer;
+  std::size_t matches = 0;
+  for (int i = 0; i < kHeapLookups; i++) {
+    int64_t key = static_cast<int64_t>(i) * 997 * 2 + 1;
+    heap.forEachRecord([&](const RID &, const char *data, uint16_t length) {
+      matches += Tuple(&schema, data, length).getBigInt(0) == key;
+    });
+  }
+  report("heap lookup, full scan", kHeapLookups, scan_timer.elapsedSeconds(),
+         "lookups");
+  printIo(bpm.getStats());
+
+  PageBloomFilters filters(&bpm, schema, 0);
+  filters.build(heap);
+  bpm.resetStats();
+  Timer filter_timer;
+  for (int i = 0; i < kHeapLookups; i++) {
+    matches += filters.lookup(static_cast<int64_t>(i) * 997 * 2 + 1);
+  }
+  report("heap lookup, per-page filters", kHeapLookups,
+         filter_timer.elapsedSeconds(), "lookups");
+  printIo(bpm.getStats());
+  std::printf("%44s filter memory=%zu KB pages skipped=%zu\n", "",
+              filters.getMemoryUsage() >> 10, filters.getPagesSkipped());
+  doNotOptimize(matches);
+
+  std::remove(kDbFile);
+  return 0;
+}
@@ -0,0 +1,64 @@
+#include "BenchUtil.hpp"
+#include "catalog/Catalog.hpp"
+#include <string>
+
+// Startup time of a database holding thousands of tables
+//  - lazy open: header page only, then a single table lookup
+//  - eager open: what loading every table's metadata up front would cost
+
+namespace {
+
+constexpr int kTables = 5000;
+constexpr std::size_t kPoolSize = 256;
+const char *kDbFile = "bench_catalog.db";
+
+Schema tableSchema(int columns) {
+  std::vector<Column> cols;
+  for (int i = 0; i < columns; i++) {
+    cols.emplace_back("column_" + std::to_string(i),
+                      i % 2 == 0 ? TypeId::BIGINT : TypeId::VARCHAR);
+  }
+  return Schema(std::move(cols));
+}
+
+} // namespace
+
+int main() {
+  std::remove(kDbFile);
+  {
+    BufferPoolManager bpm(kPoolSize, kDbFile);
+    Catalog catalog(&bpm);
+    Schema schema = tableSchema(12);
+    Timer timer;
+    for (int i = 0; i < kTables; i++) {
+      catalog.createTable("table_" + std::to_string(i), schema);
+    }
+    report("create tables", kTables, timer.elapsedSeconds(), "table");
+  }
+
+  {
+    Timer timer;
+    BufferPoolManager bpm(kPoolSize, kDbFile);
+    Catalog catalog(&bpm);
+    double open_seconds = timer.elapsedSeconds();
+    TableInfo *info = catalog.getTable("table_4242");
+    double first_lookup_seconds = timer.elapsedSeconds();
+    doNotOptimize(info);
+    report("lazy open (header page only)", 1, open_seconds, "open");
+    report("lazy open + first table lookup", 1, first_lookup_seconds, "open");
+  }
+
+  {
+    Timer timer;
+    BufferPoolManager bpm(kPoolSize, kDbFile);
+    Catalog catalog(&bpm);
+    for (const std::string &name : catalog.getTableNames()) {
+      doNotOptimize(catalog.getTable(name));
+    }
+    report("eager open (decode all tables)", kTables, timer.elapsedSeconds(),
+           "table");
+  }
+
+  std::remove(kDbFile);
+  return 0;
+}
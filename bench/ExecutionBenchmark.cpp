@@ -0,0 +1,192 @@
+#include "BenchUtil.hpp"
+#include "execution/AggregateOperator.hpp"
+#include "execution/FilterOperator.hpp"
+#include "execution/SeqScanOperator.hpp"
+#include <memory>
+
+// Rows/s of scan, scan+filter and scan+filter+aggregate queries, vectorized
+// operators vs a classic tuple-at-a-time (one virtual call per row) pipeline
+
+namespace {
+
+constexpr int kRows = 1000000;
+constexpr std::size_t kPoolSize = 16384; // whole table stays resident
+const char *kDbFile = "bench_execution.db";
+
+const Schema &benchSchema() {
+  static Schema schema({Column("id", TypeId::BIGINT, false),
+                        Column("category", TypeId::INTEGER),
+                        Column("price", TypeId::DOUBLE),
+                        Column("name", TypeId::VARCHAR)});
+  return schema;
+}
+
+// ---- tuple-at-a-time baseline ----
+
+class TupleIterator {
+public:
+  virtual ~TupleIterator() = default;
+  virtual bool next(Tuple &tuple) = 0;
+};
+
+class TupleScan : public TupleIterator {
+private:
+  BufferPoolManager *bpm;
+  const std::vector<page_id_t> &page_ids;
+  std::size_t page_cursor = 0;
+  uint16_t slot = 0;
+  Page *page = nullptr;
+
+public:
+  TupleScan(BufferPoolManager *bufferPool, const std::vector<page_id_t> &pages)
+      : bpm(bufferPool), page_ids(pages) {}
+
+  bool next(Tuple &tuple) override {
+    while (page_cursor < page_ids.size()) {
+      if (page == nullptr) {
+        page = bpm->fetchPage(page_ids[page_cursor]);
+        slot = 0;
+      }
+      while (slot < page->getNumberOfSlots()) {
+        uint16_t current = slot++;
+        if (!page->isRecordDeleted(current)) {
+          tuple = Tuple(&benchSchema(), page->getRecord(current),
+                        page->getRecordLength(current));
+          return true;
+        }
+      }
+      bpm->unpinPage(page_ids[page_cursor++], false);
+      page = nullptr;
+    }
+    return false;
+  }
+};
+
+class TupleFilter : public TupleIterator {
+private:
+  std::unique_ptr<TupleIterator> child;
+  int32_t max_category;
+
+public:
+  TupleFilter(std::unique_ptr<TupleIterator> childIterator, int32_t maxCategory)
+      : child(std::move(childIterator)), max_category(maxCategory) {}
+
+  bool next(Tuple &tuple) override {
+    while (child->next(tuple)) {
+      if (!tuple.isNull(1) && tuple.getInteger(1) < max_category) {
+        return true;
+      }
+    }
+    return false;
+  }
+};
+
+std::unique_ptr<Operator> vectorScan(BufferPoolManager *bpm,
+                                     const TableHeap &heap,
+                                     std::vector<uint32_t> columns) {
+  return std::make_unique<SeqScanOperator>(bpm, heap, benchSchema(),
+                                           std::move(columns));
+}
+
+} // namespace
+
+int main() {
+  std::remove(kDbFile);
+  BufferPoolManager bpm(kPoolSize, kDbFile);
+  TableHeap heap(&bpm);
+  {
+    TupleBuilder builder(benchSchema());
+    for (int i = 0; i < kRows; i++) {
+      builder.reset();
+      builder.setBigInt(0, i);
+      builder.setInteger(1, i % 10);
+      builder.setDouble(2, (i % 1000) * 0.25);
+      builder.setVarchar(3, "name");
+      heap.insertTuple(builder);
+    }
+  }
+
+  // Q1: SELECT COUNT(*) FROM t
+  {
+    Timer timer;
+    TupleScan scan(&bpm, heap.getPageIds());
+    Tuple tuple;
+    int64_t count = 0;
+    while (scan.next(tuple)) {
+      count++;
+    }
+    report("tuple-at-a-time  scan", kRows, timer.elapsedSeconds(), "row");
+    doNotOptimize(count);
+  }
+  {
+    Timer timer;
+    AggregateOperator op(vectorScan(&bpm, heap, {0}),
+                         {{AggregateType::COUNT_STAR}});
+    DataChunk chunk(op.getOutputSchema());
+    op.next(chunk);
+    report("vectorized       scan", kRows, timer.elapsedSeconds(), "row");
+    doNotOptimize(chunk.getColumn(0).getData<int64_t>()[0]);
+  }
+
+  // Q2: SELECT COUNT(*) FROM t WHERE category < 3
+  {
+    Timer timer;
+    TupleFilter filter(std::make_unique<TupleScan>(&bpm, heap.getPageIds()),
+                       3);
+    Tuple tuple;
+    int64_t count = 0;
+    while (filter.next(tuple)) {
+      count++;
+    }
+    report("tuple-at-a-time  scan+filter", kRows, timer.elapsedSeconds(),
+           "row");
+    doNotOptimize(count);
+  }
+  {
+    Timer timer;
+    AggregateOperator op(
+        std::make_unique<FilterOperator>(
+            vectorScan(&bpm, heap, {1}),
+            std::vector<Predicate>{{0, CompareOp::LT, Value::integer32(3)}}),
+        {{AggregateType::COUNT_STAR}});
+    DataChunk chunk(op.getOutputSchema());
+    op.next(chunk);
+    report("vectorized       scan+filter", kRows, timer.elapsedSeconds(),
+           "row");
+    doNotOptimize(chunk.getColumn(0).getData<int64_t>()[0]);
+  }
+
+  // Q3: SELECT SUM(price), MAX(id) FROM t WHERE category < 3
+  {
+    Timer timer;
+    TupleFilter filter(std::make_unique<TupleScan>(&bpm, heap.getPageIds()),
+                       3);
+    Tuple tuple;
+    double sum = 0;
+    int64_t max_id = 0;
+    while (filter.next(tuple)) {
+      sum += tuple.getDouble(2);
+      max_id = std::max(max_id, tuple.getBigInt(0));
+    }
+    report("tuple-at-a-time  scan+filter+agg", kRows, timer.elapsedSeconds(),
+           "row");
+    doNotOptimize(sum);
+    doNotOptimize(max_id);
+  }
+  {
+    Timer timer;
+    AggregateOperator op(
+        std::make_unique<FilterOperator>(
+            vectorScan(&bpm, heap, {0, 1, 2}),
+            std::vector<Predicate>{{1, CompareOp::LT, Value::integer32(3)}}),
+        {{AggregateType::SUM, 2}, {AggregateType::MAX, 0}});
+    DataChunk chunk(op.getOutputSchema());
+    op.next(chunk);
+    report("vectorized       scan+filter+agg", kRows, timer.elapsedSeconds(),
+           "row");
+    doNotOptimize(chunk.getColumn(0).getData<double>()[0]);
+  }
+
+  std::remove(kDbFile);
+  return 0;
+}
@@ -0,0 +1,70 @@
+#include "BenchUtil.hpp"
+#include "execution/HashJoinOperator.hpp"
+
+// Join throughput (probe rows/s) with the build side fully in memory and with
+// a memory budget of 1/10 of the build side (partitions spill to temp pages)
+
+namespace {
+
+constexpr int kBuildRows = 400000;
+constexpr int kProbeRows = 2000000;
+constexpr std::size_t kPoolSize = 40000;
+const char *kDbFile = "bench_hash_join.db";
+
+} // namespace
+
+int main() {
+  std::remove(kDbFile);
+  Schema build_schema({Column("key", TypeId::BIGINT, false),
+                       Column("payload", TypeId::DOUBLE, false)});
+  Schema probe_schema({Column("id", TypeId::BIGINT, false),
+                       Column("key", TypeId::BIGINT, false)});
+
+  BufferPoolManager bpm(kPoolSize, kDbFile);
+  TableHeap build(&bpm);
+  TableHeap probe(&bpm);
+  {
+    TupleBuilder row(build_schema);
+    for (int i = 0; i < kBuildRows; i++) {
+      row.setBigInt(0, i);
+      row.setDouble(1, i * 1.5);
+      build.insertTuple(row);
+    }
+    TupleBuilder probe_row(probe_schema);
+    for (int i = 0; i < kProbeRows; i++) {
+      probe_row.setBigInt(0, i);
+      probe_row.setBigInt(1, (i * 2654435761LL) % (2 * kBuildRows));
+      probe.insertTuple(probe_row);
+    }
+  }
+
+  // in-memory footprint of the build side, used to size the budgets
+  std::size_t build_bytes = static_cast<std::size_t>(kBuildRows) * 64;
+
+  for (std::size_t budget : {build_bytes * 4, build_bytes / 10}) {
+    HashJoinOperator join(
+        std::make_unique<SeqScanOperator>(&bpm, build, build_schema),
+        std::make_unique<SeqScanOperator>(&bpm, probe, probe_schema), 0, 1,
+        &bpm, budget);
+    DataChunk chunk(join.getOutputSchema());
+
+    Timer timer;
+    std::size_t output_rows = 0;
+    while (join.next(chunk)) {
+      output_rows += chunk.getCount();
+    }
+    double seconds = timer.elapsedSeconds();
+
+    const HashJoinStats &stats = join.getStats();
+    std::string mode =
+        stats.spilled_partitions == 0 ? "in-memory" : "spilling";
+    report(mode + " join (budget " + std::to_string(budget >> 10) + " KB)",
+           kProbeRows, seconds, "probe");
+    std::printf("%44s output=%zu spilled partitions=%zu build=%zu probe=%zu\n",
+                "", output_rows, stats.spilled_partitions,
+                stats.spilled_build_rows, stats.spilled_probe_rows);
+  }
+
+  std::remove(kDbFile);
+  return 0;
+}
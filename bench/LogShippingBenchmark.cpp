@@ -0,0 +1,123 @@
+#include "BenchUtil.hpp"
+#include "buffer/LogFollower.hpp"
+#include <algorithm>
+#include <fstream>
+#include <random>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Read scale-out with a log-shipping replica in a second process: the
+// primary updates random pages of a 40 MB file (4 MB pool) in batches of
+// 1000 with a sync point after each, pausing 10 ms between batches (a
+// primary that is not saturated), while the follower process tails the
+// page log, replays it into its own pool and serves random page reads.
+// Reports the primary's update time without and with log shipping, the
+// follower's read rate, and the replication lag of the sync points
+// (mean, p99, max).
+
+namespace {
+
+constexpr int kPages = 10000;
+constexpr int kBatches = 100;
+constexpr int kBatchUpdates = 1000;
+constexpr std::size_t kPoolSize = 1024;
+const char *kDbFile = "bench_log_primary.db";
+const char *kReplicaFile = "bench_log_replica.db";
+const char *kLogFile = "bench_log_pages.log";
+
+// the update batches; returns the updates/s while updating
+double runPrimary(bool shipping) {
+  BufferPoolManager bpm(kPoolSize, kDbFile);
+  if (shipping) {
+    bpm.enableLogShipping(kLogFile);
+  }
+  std::mt19937 rng(6);
+  double seconds = 0;
+  for (int batch = 0; batch < kBatches; batch++) {
+    Timer timer;
+    for (int i = 0; i < kBatchUpdates; i++) {
+      Page *page = bpm.fetchPage(static_cast<page_id_t>(rng() % kPages));
+      if (page != nullptr) {
+        page->getData()[PAGE_SIZE - 1]++;
+        bpm.unpinPage(page, true);
+      }
+    }
+    if (shipping) {
+      bpm.logSyncPoint();
+    } else {
+      bpm.flushAllDirtyPages();
+    }
+    seconds += timer.elapsedSeconds();
+    usleep(10000);
+  }
+  return kBatches * kBatchUpdates / seconds;
+}
+
+} // namespace
+
+int main() {
+  std::remove(kDbFile);
+  {
+    BufferPoolManager bpm(64, kDbFile);
+    for (int i = 0; i < kPages; i++) {
+      page_id_t page_id;
+      bpm.newPage(&page_id);
+      bpm.unpinPage(page_id, true);
+    }
+  }
+  std::printf("primary alone, no log shipping: %.0f updates/s\n",
+              runPrimary(false));
+
+  std::ofstream(kLogFile).close();
+  std::fflush(stdout);
+  pid_t child = fork();
+  if (child == 0) {
+    std::printf("primary with a follower process: %.0f updates/s\n",
+                runPrimary(true));
+    std::fflush(stdout);
+    _exit(0);
+  }
+
+  LogFollower follower(kLogFile, kPoolSize, kReplicaFile);
+  BufferPoolManager *replica = follower.getBufferPool();
+  std::mt19937 rng(7);
+  std::vector<double> lags;
+  std::size_t reads = 0;
+  bool primary_done = false;
+  Timer timer;
+  while (true) {
+    if (!primary_done) {
+      int status;
+      primary_done = waitpid(child, &status, WNOHANG) == child;
+    }
+    if (follower.poll() > 0) {
+      lags.push_back(follower.getStatus().lag_seconds * 1e3);
+    } else if (primary_done) {
+      break;
+    }
+    // a batch of read-only queries on one consistent state
+    auto lock = follower.readLock();
+    for (int i = 0; i < 1000; i++) {
+      Page *page = replica->fetchPage(static_cast<page_id_t>(rng() % kPages));
+      if (page != nullptr) {
+        doNotOptimize(page->getData()[0]);
+        replica->unpinPage(page, false);
+        reads++;
+      }
+    }
+  }
+  report("follower reads", reads, timer.elapsedSeconds(), "reads");
+  std::sort(lags.begin(), lags.end());
+  double mean = 0;
+  for (double lag : lags) {
+    mean += lag / lags.size();
+  }
+  std::printf("  %zu sync points replayed, lag mean %.2f ms, p99 %.2f ms, "
+              "max %.2f ms\n",
+              follower.getStatus().sync_points, mean,
+              lags[lags.size() * 99 / 100], lags.back());
+  for (const char *file : {kDbFile, kReplicaFile, kLogFile}) {
+    std::remove(file);
+  }
+  return 0;
+}
@@ -0,0 +1,147 @@
+#include "BenchUtil.hpp"
+#include "index/BPlusTree.hpp"
+#include "lsm/LsmTree.hpp"
+#include <random>
+
+// Write-heavy ingest (random inserts and overwrites) and point reads:
+// 1. heap + B+ tree: rows are updated in place, the index is probed first
+// 2. LSM tree with leveled and with tiered compaction
+// Write amplification is disk bytes written / user bytes ingested; read
+// amplification is pages fetched (and runs probed) per lookup
+
+namespace {
+
+// LSM pages are never reused, so the key space is kept small to bound the
+// size of the database file across all compactions
+constexpr int kKeySpace = 100000;
+constexpr int kWrites = 300000;
+constexpr int kLookups = 100000;
+constexpr std::size_t kValueSize = 100;
+constexpr std::size_t kPoolSize = 256; // 1 MB
+const char *kDbFile = "bench_lsm.db";
+
+std::vector<int64_t> writeKeys() {
+  std::mt19937_64 rng(42);
+  std::vector<int64_t> keys(kWrites);
+  for (int64_t &key : keys) {
+    key = static_cast<int64_t>(rng() % kKeySpace);
+  }
+  return keys;
+}
+
+std::string valueFor(int64_t key, int version) {
+  std::string value(kValueSize, 'a' + static_cast<char>(version % 26));
+  memcpy(value.data(), &key, sizeof(key));
+  return value;
+}
+
+void printAmplification(std::size_t disk_writes) {
+  double ingested = static_cast<double>(kWrites) *
+                    static_cast<double>(sizeof(int64_t) + kValueSize);
+  std::printf("%44s pages written=%zu write amp=%.2f\n", "", disk_writes,
+              static_cast<double>(disk_writes) * PAGE_SIZE / ingested);
+}
+
+void benchHeap(const std::vector<int64_t> &keys) {
+  std::remove(kDbFile);
+  BufferPoolManager bpm(kPoolSize, kDbFile);
+  TableHeap heap(&bpm);
+  BPlusTree tree(&bpm);
+  std::vector<char> record(sizeof(int64_t) + kValueSize);
+
+  Timer timer;
+  for (int i = 0; i < kWrites; i++) {
+    std::string value = valueFor(keys[i], i);
+    memcpy(record.data(), &keys[i], sizeof(int64_t));
+    memcpy(record.data() + sizeof(int64_t), value.data(), kValueSize);
+    RID rid;
+    if (tree.lookup(keys[i], &rid)) {
+      heap.updateRecord(rid, record.data(),
+                        static_cast<uint16_t>(record.size()));
+    } else {
+      heap.insertRecord(record.data(), static_cast<uint16_t>(record.size()),
+                        &rid);
+      tree.insert(keys[i], rid);
+    }
+  }
+  bpm.flushAllDirtyPages();
+  report("ingest, heap + B+ tree", kWrites, timer.elapsedSeconds(), "writes");
+  printAmplification(bpm.getStats().disk_writes);
+
+  bpm.resetStats();
+  Timer read_timer;
+  std::size_t found = 0;
+  for (int i = 0; i < kLookups; i++) {
+    RID rid;
+    int64_t key = static_cast<int64_t>(i) * 7919 % kKeySpace;
+    if (tree.lookup(key, &rid)) {
+      found += heap.getRecord(rid, record);
+    }
+  }
+  doNotOptimize(found);
+  report("lookup, heap + B+ tree", kLookups, read_timer.elapsedSeconds(),
+         "lookups");
+  BufferPoolStats stats = bpm.getStats();
+  std::printf("%44s pages/lookup=%.2f disk reads=%zu\n", "",
+              static_cast<double>(stats.hits + stats.misses) / kLookups,
+              stats.disk_reads);
+}
+
+void benchLsm(const std::vector<int64_t> &keys, CompactionStyle style) {
+  std::remove(kDbFile);
+  BufferPoolManager bpm(kPoolSize, kDbFile);
+  page_id_t manifest_page_id;
+  bpm.newPage(&manifest_page_id);
+  bpm.unpinPage(manifest_page_id, true);
+
+  LsmOptions options;
+  options.memtable_bytes = 1 << 20;
+  options.level_base_bytes = 4 << 20;
+  options.level_ratio = 4;
+  options.style = style;
+  const char *name = style == CompactionStyle::LEVELED ? "leveled" : "tiered";
+  LsmTree tree(&bpm, manifest_page_id, options);
+
+  Timer timer;
+  for (int i = 0; i < kWrites; i++) {
+    tree.put(keys[i], valueFor(keys[i], i));
+  }
+  tree.flush();
+  tree.waitForCompactions();
+  report(std::string("ingest, LSM ") + name, kWrites, timer.elapsedSeconds(),
+         "writes");
+  printAmplification(bpm.getStats().disk_writes);
+
+  LsmStats before = tree.getStats();
+  bpm.resetStats();
+  Timer read_timer;
+  std::size_t found = 0;
+  std::string value;
+  for (int i = 0; i < kLookups; i++) {
+    int64_t key = static_cast<int64_t>(i) * 7919 % kKeySpace;
+    found += tree.get(key, &value);
+  }
+  doNotOptimize(found);
+  report(std::string("lookup, LSM ") + name, kLookups,
+         read_timer.elapsedSeconds(), "lookups");
+  LsmReadCost reads = tree.getStats().reads;
+  std::printf("%44s pages/lookup=%.2f runs/lookup=%.2f disk reads=%zu\n", "",
+              static_cast<double>(reads.pages_read -
+                                  before.reads.pages_read) /
+                  kLookups,
+              static_cast<double>(reads.runs_probed -
+                                  before.reads.runs_probed) /
+                  kLookups,
+              bpm.getStats().disk_reads);
+}
+
+} // namespace
+
+int main() {
+  std::vector<int64_t> keys = writeKeys();
+  benchHeap(keys);
+  benchLsm(keys, CompactionStyle::LEVELED);
+  benchLsm(keys, CompactionStyle::TIERED);
+  std::remove(kDbFile);
+  return 0;
+}
@@ -0,0 +1,84 @@
+#include "BenchUtil.hpp"
+#include "lsm/LsmTree.hpp"
+#include <map>
+#include <mutex>
+#include <random>
+#include <thread>
+
+// Concurrent insert throughput at 1 to 64 threads:
+// 1. std::map behind one mutex (the previous memtable)
+// 2. the lock-free skiplist memtable
+// 3. LsmTree::put, where full memtables are flushed to pages in background
+
+namespace {
+
+constexpr int kInserts = 1 << 20; // split across the threads
+constexpr std::size_t kValueSize = 32;
+constexpr std::size_t kPoolSize = 1024;
+const char *kDbFile = "bench_memtable.db";
+
+int64_t keyFor(int thread, int i) {
+  // distinct, scattered keys per thread
+  return static_cast<int64_t>((static_cast<uint64_t>(i) * 64 + thread) *
+                              0x9e3779b97f4a7c15ull >> 1);
+}
+
+template <typename Insert>
+double runThreads(int num_threads, const Insert &insert) {
+  Timer timer;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; t++) {
+    threads.emplace_back([&, t] {
+      std::string value(kValueSize, 'v');
+      for (int i = 0; i < kInserts / num_threads; i++) {
+        insert(keyFor(t, i), value);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  return timer.elapsedSeconds();
+}
+
+} // namespace
+
+int main() {
+  for (int num_threads : {1, 2, 4, 8, 16, 32, 64}) {
+    std::string suffix = ", " + std::to_string(num_threads) + " threads";
+
+    std::map<int64_t, std::string> map;
+    std::mutex map_mutex;
+    double seconds =
+        runThreads(num_threads, [&](int64_t key, const std::string &value) {
+          std::lock_guard<std::mutex> lock(map_mutex);
+          map[key] = value;
+        });
+    report("std::map + mutex" + suffix, kInserts, seconds, "inserts");
+
+    MemTable table;
+    seconds =
+        runThreads(num_threads, [&](int64_t key, const std::string &value) {
+          table.put(key, value, false);
+        });
+    report("skiplist memtable" + suffix, kInserts, seconds, "inserts");
+
+    std::remove(kDbFile);
+    {
+      BufferPoolManager bpm(kPoolSize, kDbFile);
+      page_id_t manifest_page_id;
+      bpm.newPage(&manifest_page_id);
+      bpm.unpinPage(manifest_page_id, true);
+      LsmOptions options;
+      options.memtable_bytes = 8 << 20;
+      LsmTree tree(&bpm, manifest_page_id, options);
+      seconds =
+          runThreads(num_threads, [&](int64_t key, const std::string &value) {
+            tree.put(key, value);
+          });
+      report("LsmTree::put" + suffix, kInserts, seconds, "inserts");
+    }
+  }
+  std::remove(kDbFile);
+  return 0;
+}
@@ -0,0 +1,92 @@
+#include "BenchUtil.hpp"
+#include "buffer/BufferPoolManager.hpp"
+#include <random>
+#include <thread>
+
+// Frame placement for 4 threads, each loading and then fetching its own
+// 2000 pages, on 2 NUMA nodes with 2 threads bound to each:
+// 1. node-unaware: pages loaded before NUMA is configured, so each thread's
+//    pages sit in frames of both nodes
+// 2. node-aware: threads bound first, so they load into their node's frames
+// Reports fetches/s and local vs. remote frame accesses. Runs with
+// simulated nodes, and with real ones when the machine has 2 nodes.
+
+namespace {
+
+constexpr int kThreads = 4;
+constexpr int kPagesPerThread = 2000;
+constexpr int kFetchesPerThread = 500000;
+constexpr std::size_t kPoolSize = 8192;
+const char *kDbFile = "bench_numa.db";
+
+// runs body(thread, bpm) on every thread, bound to node thread % 2
+template <typename Body>
+void runThreads(BufferPoolManager &bpm, bool bind, const Body &body) {
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; t++) {
+    threads.emplace_back([&, t] {
+      if (bind) {
+        bpm.bindThreadToNode(t % 2);
+      }
+      body(t);
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+}
+
+void run(bool simulated, bool aware) {
+  std::remove(kDbFile);
+  BufferPoolManager bpm(kPoolSize, kDbFile);
+  if (aware && !bpm.configureNuma(2, simulated)) {
+    return;
+  }
+  std::vector<std::vector<page_id_t>> pages(kThreads);
+  runThreads(bpm, aware, [&](int t) {
+    for (int i = 0; i < kPagesPerThread; i++) {
+      page_id_t page_id;
+      if (bpm.newPage(&page_id) != nullptr) {
+        pages[t].push_back(page_id);
+        bpm.unpinPage(page_id, true);
+      }
+    }
+  });
+  if (!aware && !bpm.configureNuma(2, simulated)) {
+    return;
+  }
+
+  bpm.resetStats();
+  Timer timer;
+  runThreads(bpm, true, [&](int t) {
+    std::mt19937 rng(t);
+    for (int i = 0; i < kFetchesPerThread; i++) {
+      Page *page = bpm.fetchPage(pages[t][rng() % pages[t].size()]);
+      if (page != nullptr) {
+        doNotOptimize(page->getData()[0]);
+        bpm.unpinPage(page, false);
+      }
+    }
+  });
+  std::string label = std::string(simulated ? "simulated" : "real") +
+                      (aware ? ", node-aware" : ", node-unaware");
+  report("fetches, " + label, kThreads * kFetchesPerThread,
+         timer.elapsedSeconds(), "fetches");
+  BufferPoolStats stats = bpm.getStats();
+  std::printf("  local %zu, remote %zu (%.1f%% local)\n",
+              stats.local_accesses, stats.remote_accesses,
+              100.0 * stats.local_accesses /
+                  (stats.local_accesses + stats.remote_accesses));
+}
+
+} // namespace
+
+int main() {
+  for (bool simulated : {true, false}) {
+    for (bool aware : {false, true}) {
+      run(simulated, aware);
+    }
+  }
+  std::remove(kDbFile);
+  return 0;
+}
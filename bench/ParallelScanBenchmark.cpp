@@ -0,0 +1,61 @@
+#include "BenchUtil.hpp"
+#include "execution/ParallelAggregateOperator.hpp"
+#include <thread>
+
+// Scan throughput of SELECT COUNT(*), SUM(value) ... WHERE bucket < 5 with
+// morsel-driven workers, from 1 thread up to 2x the hardware threads
+
+namespace {
+
+constexpr int kRows = 2000000;
+constexpr std::size_t kPoolSize = 20000;
+const char *kDbFile = "bench_parallel_scan.db";
+
+} // namespace
+
+int main() {
+  std::remove(kDbFile);
+  Schema schema({Column("id", TypeId::BIGINT, false),
+                 Column("bucket", TypeId::INTEGER, false),
+                 Column("value", TypeId::DOUBLE, false)});
+
+  BufferPoolManager bpm(kPoolSize, kDbFile);
+  TableHeap heap(&bpm);
+  TupleBuilder builder(schema);
+  for (int i = 0; i < kRows; i++) {
+    builder.setBigInt(0, i);
+    builder.setInteger(1, i % 10);
+    builder.setDouble(2, i * 0.5);
+    heap.insertTuple(builder);
+  }
+  std::printf("%zu pages, %u hardware threads\n", heap.getPageIds().size(),
+              std::thread::hardware_concurrency());
+
+  std::size_t max_threads =
+      std::max<std::size_t>(8, 2 * std::thread::hardware_concurrency());
+  double single_thread_seconds = 0;
+  for (std::size_t threads = 1; threads <= max_threads; threads *= 2) {
+    auto scan = std::make_unique<ParallelSeqScan>(
+        &bpm, heap.getPageIds(), schema, std::vector<uint32_t>{1, 2},
+        std::vector<Predicate>{{0, CompareOp::LT, Value::integer32(5)}});
+    ParallelAggregateOperator aggregate(
+        std::move(scan), {{AggregateType::COUNT_STAR}, {AggregateType::SUM, 1}},
+        threads);
+    DataChunk chunk(aggregate.getOutputSchema());
+
+    Timer timer;
+    aggregate.next(chunk);
+    double seconds = timer.elapsedSeconds();
+    if (threads == 1) {
+      single_thread_seconds = seconds;
+    }
+
+    report("parallel scan threads=" + std::to_string(threads), kRows, seconds,
+           "row");
+    std::printf("%44s speedup x%.2f\n", "", single_thread_seconds / seconds);
+    doNotOptimize(chunk.getColumn(1).getData<double>()[0]);
+  }
+
+  std::remove(kDbFile);
+  return 0;
+}
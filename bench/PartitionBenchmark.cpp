@@ -0,0 +1,109 @@
+#include "BenchUtil.hpp"
+#include "execution/SeqScanOperator.hpp"
+#include "index/BPlusTree.hpp"
+#include <random>
+
+// Isolation of an OLTP workload (random point lookups over a hot key range
+// of a B+ tree) from a batch job (full scans of a table 10x the pool),
+// interleaved on one buffer pool:
+// 1. shared pool: the scan and the index compete in one LRU
+// 2. batch table's file in a partition capped at 64 frames
+// Reports the OLTP hit rate before and while the scan runs, and lookups/s.
+
+namespace {
+
+constexpr int kKeys = 500000;
+constexpr int kHotKeys = 200000; // ~800 leaves
+constexpr int kLookupsPerChunk = 5;
+constexpr std::size_t kPoolSize = 1024; // 4 MB
+constexpr std::size_t kScanRows = 1000000;
+const char *kDbFile = "bench_partition.db";
+const char *kBatchFile = "bench_partition_batch.db";
+
+RID ridFor(int64_t key) {
+  return RID{static_cast<page_id_t>(key >> 8),
+             static_cast<uint16_t>(key & 0xff)};
+}
+
+double hitRate(const PartitionStats &stats) {
+  std::size_t accesses = stats.hits + stats.misses;
+  return accesses > 0 ? 100.0 * stats.hits / accesses : 0;
+}
+
+} // namespace
+
+int main() {
+  std::vector<std::pair<int64_t, RID>> entries;
+  for (int64_t i = 0; i < kKeys; i++) {
+    entries.emplace_back(i, ridFor(i));
+  }
+  Schema schema({Column("key", TypeId::BIGINT, false),
+                 Column("name", TypeId::VARCHAR, false)});
+
+  for (bool partitioned : {false, true}) {
+    std::remove(kDbFile);
+    std::remove(kBatchFile);
+    BufferPoolManager bpm(kPoolSize, kDbFile);
+    // OLTP stats are read from the default partition in both runs
+    partition_id_t batch =
+        bpm.createPartition("batch", 0, partitioned ? 64 : kPoolSize);
+    file_id_t batch_file = bpm.addFile(kBatchFile);
+    bpm.setFilePartition(batch_file, batch);
+    const std::string label = partitioned ? "batch capped" : "shared pool";
+
+    BPlusTree tree(&bpm);
+    tree.bulkLoad(entries);
+    TableHeap table(&bpm, batch_file);
+    TupleBuilder row(schema);
+    for (std::size_t i = 0; i < kScanRows; i++) {
+      row.setBigInt(0, static_cast<int64_t>(i));
+      row.setVarchar(1, "batch row " + std::to_string(i));
+      table.insertTuple(row);
+    }
+    bpm.flushAllDirtyPages();
+
+    std::mt19937_64 rng(1);
+    RID rid;
+    std::size_t found = 0;
+    // warm the hot set, then measure without the scan
+    for (int i = 0; i < 200000; i++) {
+      found += tree.lookup(static_cast<int64_t>(rng() % kHotKeys), &rid);
+    }
+    bpm.resetStats();
+    Timer timer;
+    for (int i = 0; i < 200000; i++) {
+      found += tree.lookup(static_cast<int64_t>(rng() % kHotKeys), &rid);
+    }
+    report("lookups alone, " + label, 200000, timer.elapsedSeconds(),
+           "lookups");
+    std::printf("  OLTP hit rate %.2f%%\n",
+                hitRate(bpm.getPartitionStats(DEFAULT_PARTITION_ID)));
+
+    // a batch scan chunk between every few lookups
+    bpm.resetStats();
+    SeqScanOperator scan(&bpm, table, schema);
+    DataChunk chunk(scan.getOutputSchema());
+    std::size_t lookups = 0, scanned = 0;
+    double lookup_seconds = 0;
+    while (scan.next(chunk)) {
+      scanned += chunk.getCount();
+      Timer lookup_timer;
+      for (int i = 0; i < kLookupsPerChunk; i++) {
+        found += tree.lookup(static_cast<int64_t>(rng() % kHotKeys), &rid);
+      }
+      lookup_seconds += lookup_timer.elapsedSeconds();
+      lookups += kLookupsPerChunk;
+    }
+    report("lookups during scan, " + label, lookups, lookup_seconds,
+           "lookups");
+    PartitionStats batch_stats = bpm.getPartitionStats(batch);
+    std::printf("  OLTP hit rate %.2f%%, scanned %zu rows, batch frames %zu"
+                "\n",
+                hitRate(bpm.getPartitionStats(DEFAULT_PARTITION_ID)),
+                scanned, batch_stats.resident_frames);
+    doNotOptimize(found);
+  }
+  std::remove(kDbFile);
+  std::remove(kBatchFile);
+  return 0;
+}
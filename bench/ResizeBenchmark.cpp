@@ -0,0 +1,108 @@
+#include "BenchUtil.hpp"
+#include "buffer/BufferPoolManager.hpp"
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <random>
+#include <thread>
+#include <unistd.h>
+
+// Latency of page fetches from 4 threads (random pages of a 40 MB file)
+// while the pool is left alone and while it is resized back and forth
+// between 4K and 16K frames; reports p50 / p99 / max fetch latency, how
+// long each resize takes, and the process RSS after growing and shrinking.
+
+namespace {
+
+constexpr int kPages = 10000;
+constexpr int kThreads = 4;
+constexpr std::size_t kSmallPool = 4096;  // 16 MB
+constexpr std::size_t kLargePool = 16384; // 64 MB
+const char *kDbFile = "bench_resize.db";
+
+std::size_t residentMB() {
+  std::ifstream statm("/proc/self/statm");
+  std::size_t size = 0, resident = 0;
+  statm >> size >> resident;
+  return resident * static_cast<std::size_t>(sysconf(_SC_PAGESIZE)) >> 20;
+}
+
+// runs the fetch threads until action returns, then prints percentiles
+template <typename Action>
+void measure(BufferPoolManager &bpm, const std::string &name,
+             const Action &action) {
+  std::atomic<bool> stop{false};
+  std::vector<std::vector<double>> latencies(kThreads);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; t++) {
+    threads.emplace_back([&, t] {
+      std::mt19937 rng(t);
+      while (!stop) {
+        page_id_t page_id = static_cast<page_id_t>(rng() % kPages);
+        Timer timer;
+        Page *page = bpm.fetchPage(page_id);
+        if (page != nullptr) {
+          doNotOptimize(page->getData()[0]);
+          bpm.unpinPage(page, false);
+        }
+        latencies[t].push_back(timer.elapsedSeconds() * 1e6);
+      }
+    });
+  }
+  action();
+  stop = true;
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  std::vector<double> all;
+  for (auto &samples : latencies) {
+    all.insert(all.end(), samples.begin(), samples.end());
+  }
+  std::sort(all.begin(), all.end());
+  std::printf("%-28s %9zu fetches  p50 %6.2f us  p99 %8.2f us  max %9.1f us"
+              "\n",
+              name.c_str(), all.size(), all[all.size() / 2],
+              all[all.size() * 99 / 100], all.back());
+}
+
+} // namespace
+
+int main() {
+  std::remove(kDbFile);
+  {
+    BufferPoolManager bpm(64, kDbFile);
+    for (int i = 0; i < kPages; i++) {
+      page_id_t page_id;
+      bpm.newPage(&page_id);
+      bpm.unpinPage(page_id, true);
+    }
+  }
+
+  BufferPoolManager bpm(kLargePool, kDbFile);
+  std::printf("RSS at start: %zu MB\n", residentMB());
+  measure(bpm, "steady, 16K frames", [] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+  });
+  std::printf("RSS with 16K frames: %zu MB\n", residentMB());
+
+  measure(bpm, "while resizing", [&] {
+    for (int round = 0; round < 3; round++) {
+      for (std::size_t size : {kSmallPool, kLargePool}) {
+        Timer timer;
+        bpm.resize(size);
+        std::printf("  resize to %5zu frames: %7.2f ms\n", size,
+                    timer.elapsedSeconds() * 1e3);
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+      }
+    }
+  });
+
+  bpm.resize(kSmallPool);
+  measure(bpm, "steady, 4K frames", [] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+  });
+  std::printf("RSS with 4K frames: %zu MB\n", residentMB());
+  std::remove(kDbFile);
+  return 0;
+}
@@ -0,0 +1,99 @@
+#include "BenchUtil.hpp"
+#include "buffer/BufferPoolManager.hpp"
+#include <algorithm>
+#include <fcntl.h>
+#include <random>
+#include <unistd.h>
+
+// Page fetches over a 160 MB DB file with an 8 MB pool: 80% of them go to
+// a 32 MB hot set, the rest to pages of a sequential scan over the whole
+// file. The DB file is dropped from the OS page cache every 1000 fetches
+// to keep it on the slow volume. Runs
+// 1. without a second tier
+// 2. with a 64 MB second tier on a fast local disk (/dev/shm) admitting
+//    every evicted page
+// 3. the same tier admitting only pages that were hit again (REUSED)
+// Reports the hit rate of memory and of the tier, DB file reads, and the
+// mean and p99 fetch latency.
+
+namespace {
+
+constexpr int kPages = 40000;
+constexpr int kHotPages = 8000;
+constexpr int kFetches = 200000;
+constexpr std::size_t kPoolSize = 2048;
+constexpr std::size_t kTierPages = 16384;
+const char *kDbFile = "bench_second_tier.db";
+const char *kTierFile = "/dev/shm/bench_second_tier.cache";
+
+void dropPageCache() {
+  int fd = open(kDbFile, O_RDONLY);
+  posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+  close(fd);
+}
+
+} // namespace
+
+int main() {
+  std::remove(kDbFile);
+  {
+    BufferPoolManager bpm(64, kDbFile);
+    for (int i = 0; i < kPages; i++) {
+      page_id_t page_id;
+      bpm.newPage(&page_id);
+      bpm.unpinPage(page_id, true);
+    }
+  }
+
+  const char *labels[] = {"no second tier", "second tier, admit all",
+                          "second tier, admit reused"};
+  for (int mode = 0; mode < 3; mode++) {
+    dropPageCache();
+    BufferPoolManager bpm(kPoolSize, kDbFile);
+    if (mode > 0) {
+      bpm.enableSecondTier(kTierFile, kTierPages,
+                           mode == 1 ? TierAdmission::ALL
+                                     : TierAdmission::REUSED);
+    }
+    std::mt19937 rng(11);
+    std::vector<double> latencies;
+    latencies.reserve(kFetches);
+    page_id_t scan = 0;
+    Timer total;
+    for (int i = 0; i < kFetches; i++) {
+      if (i % 1000 == 0) {
+        dropPageCache();
+      }
+      page_id_t page_id;
+      if (rng() % 5 != 0) {
+        // hot pages spread over the file
+        page_id = static_cast<page_id_t>(rng() % kHotPages * 5);
+      } else {
+        page_id = scan;
+        scan = (scan + 1) % kPages;
+      }
+      Timer timer;
+      Page *page = bpm.fetchPage(page_id);
+      if (page != nullptr) {
+        doNotOptimize(page->getData()[0]);
+        bpm.unpinPage(page, false);
+      }
+      latencies.push_back(timer.elapsedSeconds() * 1e6);
+    }
+    report(labels[mode], kFetches, total.elapsedSeconds(), "fetches");
+
+    BufferPoolStats stats = bpm.getStats();
+    double mean = 0;
+    for (double latency : latencies) {
+      mean += latency / kFetches;
+    }
+    std::sort(latencies.begin(), latencies.end());
+    std::printf("  memory hits %.1f%%, tier hits %.1f%% (%zu admitted), "
+                "DB file reads %zu\n  latency mean %.2f us, p99 %.2f us\n",
+                100.0 * stats.hits / kFetches,
+                100.0 * stats.tier_hits / kFetches, stats.tier_writes,
+                stats.disk_reads, mean, latencies[kFetches * 99 / 100]);
+  }
+  std::remove(kDbFile);
+  return 0;
+}
@@ -0,0 +1,150 @@
+#include "BenchUtil.hpp"
+#include "buffer/SizeClassPool.hpp"
+#include <cstring>
+#include <random>
+
+// Blob read throughput and memory utilization for blobs of 8KB to 200KB:
+// 1. each blob split over consecutive 4KB BufferPoolManager pages, read
+//    with one fetchPage per 4KB
+// 2. each blob in one size-class page, read with a single fetch
+// Both with memory for every blob (warm) and with the same budget of a
+// quarter of the blob data, so most reads go to the file (cold).
+
+namespace {
+
+constexpr int kBlobs = 400;
+constexpr int kReads = 4000;
+constexpr std::size_t kMinBlob = 8 * 1024;
+constexpr std::size_t kMaxBlob = 200 * 1024;
+const char *kDbFile = "bench_size_class.db";
+
+struct Blob {
+  page_id_t first;
+  std::size_t size;
+};
+
+std::size_t chunksOf(std::size_t bytes) {
+  return (bytes + PAGE_SIZE - 1) / PAGE_SIZE;
+}
+
+// reads blob into out through the 4KB frames
+bool readChunked(BufferPoolManager &bpm, const Blob &blob, char *out) {
+  for (std::size_t i = 0; i < chunksOf(blob.size); i++) {
+    page_id_t page_id = static_cast<page_id_t>(blob.first + i);
+    Page *page = bpm.fetchPage(page_id);
+    if (page == nullptr) {
+      return false;
+    }
+    std::size_t length = std::min<std::size_t>(PAGE_SIZE,
+                                               blob.size - i * PAGE_SIZE);
+    std::memcpy(out + i * PAGE_SIZE, page->getData(), length);
+    bpm.unpinPage(page_id, false);
+  }
+  return true;
+}
+
+bool readSizeClass(SizeClassPool &pool, const Blob &blob, char *out) {
+  char *data = pool.fetchPage(blob.first, blob.size);
+  if (data == nullptr) {
+    return false;
+  }
+  std::memcpy(out, data, blob.size);
+  pool.unpinPage(blob.first, false);
+  return true;
+}
+
+} // namespace
+
+int main() {
+  std::mt19937_64 rng(3);
+  std::vector<std::size_t> sizes(kBlobs);
+  std::size_t payload = 0;
+  for (std::size_t &size : sizes) {
+    size = kMinBlob + rng() % (kMaxBlob - kMinBlob);
+    payload += size;
+  }
+  std::vector<int> order(kReads);
+  for (int &blob : order) {
+    blob = static_cast<int>(rng() % kBlobs);
+  }
+  std::vector<char> contents(kMaxBlob, 'x');
+  std::vector<char> out(kMaxBlob);
+
+  std::remove(kDbFile);
+  std::vector<Blob> chunked, classed;
+  // memory of the 4KB frames that hold every blob
+  std::size_t chunked_bytes = 0;
+  {
+    BufferPoolManager bpm(64, kDbFile);
+    for (std::size_t size : sizes) {
+      Blob blob{INVALID_PAGE_ID, size};
+      for (std::size_t i = 0; i < chunksOf(size); i++) {
+        page_id_t page_id;
+        Page *page = bpm.newPage(&page_id);
+        std::memcpy(page->getData(), contents.data(), PAGE_SIZE);
+        bpm.unpinPage(page_id, true);
+        blob.first = i == 0 ? page_id : blob.first;
+      }
+      chunked.push_back(blob);
+      chunked_bytes += chunksOf(size) * PAGE_SIZE;
+    }
+    SizeClassPool pool(&bpm, 64 << 20);
+    for (std::size_t size : sizes) {
+      Blob blob{INVALID_PAGE_ID, size};
+      char *data = pool.newPage(size, &blob.first);
+      std::memcpy(data, contents.data(), size);
+      pool.unpinPage(blob.first, true);
+      classed.push_back(blob);
+    }
+    SizeClassPoolStats stats = pool.getStats();
+    std::printf("payload %zu KB; in memory: 4KB frames %zu KB (%.1f%%), "
+                "size classes %zu KB (%.1f%%), 256KB pages %zu KB (%.1f%%)\n",
+                payload >> 10, chunked_bytes >> 10,
+                100.0 * payload / chunked_bytes, stats.allocated_bytes >> 10,
+                100.0 * payload / stats.allocated_bytes,
+                (kBlobs * SizeClassPool::kMaxPageSize) >> 10,
+                100.0 * payload / (kBlobs * SizeClassPool::kMaxPageSize));
+  }
+
+  for (bool cold : {false, true}) {
+    const char *label = cold ? "cold" : "warm";
+    std::size_t frames = chunked_bytes / PAGE_SIZE / (cold ? 4 : 1);
+
+    BufferPoolManager bpm(frames, kDbFile);
+    Timer timer;
+    std::size_t bytes = 0;
+    for (int pass = 0; pass < 2; pass++) { // first pass loads the pool
+      bpm.resetStats();
+      timer.reset();
+      bytes = 0;
+      for (int blob : order) {
+        readChunked(bpm, chunked[blob], out.data());
+        bytes += chunked[blob].size;
+      }
+    }
+    report(std::string("blob reads, 4KB frames, ") + label, kReads,
+           timer.elapsedSeconds(), "blobs");
+    std::printf("  %.0f MB/s, %zu disk reads\n",
+                bytes / timer.elapsedSeconds() / (1 << 20),
+                bpm.getStats().disk_reads);
+
+    SizeClassPool pool(&bpm, cold ? frames * PAGE_SIZE : 64 << 20);
+    for (int pass = 0; pass < 2; pass++) {
+      bpm.resetStats();
+      timer.reset();
+      bytes = 0;
+      for (int blob : order) {
+        readSizeClass(pool, classed[blob], out.data());
+        bytes += classed[blob].size;
+      }
+    }
+    report(std::string("blob reads, size classes, ") + label, kReads,
+           timer.elapsedSeconds(), "blobs");
+    std::printf("  %.0f MB/s, %zu disk reads\n",
+                bytes / timer.elapsedSeconds() / (1 << 20),
+                bpm.getStats().disk_reads);
+  }
+  doNotOptimize(out);
+  std::remove(kDbFile);
+  return 0;
+}
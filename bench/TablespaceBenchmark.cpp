@@ -0,0 +1,87 @@
+#include "BenchUtil.hpp"
+#include "execution/ExternalSortOperator.hpp"
+#include "execution/SeqScanOperator.hpp"
+#include <sys/stat.h>
+
+// Mixed workload over one base table: rounds of an external sort (spilling
+// runs) followed by a full scan of the table, with
+// 1. the spill pages in the primary DB file next to the table
+// 2. the spill pages in a temporary file on a separate (tmpfs) disk
+// Reports time per phase and the primary file size after each round: spill
+// page ids are never reused, so spilling into the primary file grows it.
+
+namespace {
+
+constexpr std::size_t kRows = 500000; // ~20 MB of table pages
+constexpr std::size_t kMemoryBudget = 2 << 20;
+constexpr std::size_t kPoolSize = 1024; // 4 MB of frames
+constexpr int kRounds = 3;
+const char *kDbFile = "bench_tablespace.db";
+const char *kTempFile = "/dev/shm/bench_tablespace_temp.db";
+
+std::size_t fileSize(const char *path) {
+  struct stat info;
+  return stat(path, &info) == 0 ? static_cast<std::size_t>(info.st_size) : 0;
+}
+
+} // namespace
+
+int main() {
+  Schema schema({Column("key", TypeId::BIGINT, false),
+                 Column("name", TypeId::VARCHAR, false)});
+
+  for (bool separate : {false, true}) {
+    std::remove(kDbFile);
+    BufferPoolManager bpm(kPoolSize, kDbFile);
+    if (separate) {
+      file_id_t temp = bpm.addFile(kTempFile, true);
+      if (temp == INVALID_FILE_ID) {
+        return 1;
+      }
+      bpm.setSpillFile(temp);
+    } else {
+      bpm.setSpillFile(PRIMARY_FILE_ID); // not the default temp file
+    }
+    const std::string label = separate ? "temp file" : "one file";
+
+    TableHeap table(&bpm);
+    TupleBuilder row(schema);
+    for (std::size_t i = 0; i < kRows; i++) {
+      uint64_t key = (i * 0x9E3779B97F4A7C15ULL) >> 20;
+      row.setBigInt(0, static_cast<int64_t>(key));
+      row.setVarchar(1, "row" + std::to_string(key % 100000000));
+      table.insertTuple(row);
+    }
+    bpm.flushAllDirtyPages();
+
+    for (int round = 0; round < kRounds; round++) {
+      Timer timer;
+      std::size_t rows = 0;
+      {
+        ExternalSortOperator sort(
+            std::make_unique<SeqScanOperator>(&bpm, table, schema),
+            {SortKey(1), SortKey(0)}, &bpm, kMemoryBudget);
+        DataChunk chunk(sort.getOutputSchema());
+        while (sort.next(chunk)) {
+          rows += chunk.getCount();
+        }
+      }
+      report("sort, " + label + ", round " + std::to_string(round), rows,
+             timer.elapsedSeconds(), "rows");
+
+      timer.reset();
+      rows = 0;
+      SeqScanOperator scan(&bpm, table, schema);
+      DataChunk chunk(scan.getOutputSchema());
+      while (scan.next(chunk)) {
+        rows += chunk.getCount();
+      }
+      report("scan, " + label + ", round " + std::to_string(round), rows,
+             timer.elapsedSeconds(), "rows");
+      bpm.flushAllDirtyPages();
+      std::printf("  primary file %zu MB\n", fileSize(kDbFile) >> 20);
+    }
+  }
+  std::remove(kDbFile);
+  return 0;
+}
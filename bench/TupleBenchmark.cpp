@@ -0,0 +1,141 @@
+#include "BenchUtil.hpp"
+#include "storage/Tuple.hpp"
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Field access and serialization throughput of the Tuple layer
+//  - raw struct memcpy (what callers of Page::insertRecord do today)
+//  - TupleBuilder serialized straight into the page
+//  - O(1) column access through Tuple vs walking the columns to find one
+
+namespace {
+
+struct RawRecord {
+  int32_t id;
+  char name[32];
+  double balance;
+  int64_t created_at;
+};
+
+const Schema &benchSchema() {
+  static Schema schema({Column("id", TypeId::INTEGER, false),
+                        Column("name", TypeId::VARCHAR),
+                        Column("balance", TypeId::DOUBLE),
+                        Column("created_at", TypeId::BIGINT)});
+  return schema;
+}
+
+// decodes column `target` by walking every column before it, which is what a
+// layout without precomputed offsets has to do
+int64_t parseToColumn(const char *data, uint32_t target) {
+  const Schema &schema = benchSchema();
+  uint16_t offset = schema.getNullBitmapSize();
+  for (uint32_t i = 0; i < target; i++) {
+    offset += getFixedSize(schema.getType(i));
+  }
+  int64_t value;
+  memcpy(&value, data + offset, sizeof(value));
+  return value;
+}
+
+constexpr int kRounds = 20000;
+
+} // namespace
+
+int main() {
+  const Schema &schema = benchSchema();
+  Page page;
+  uint64_t records = 0;
+
+  // ---- serialization ----
+  {
+    RawRecord raw = {1, "benchmark-user", 10.5, 1700000000};
+    Timer timer;
+    for (int round = 0; round < kRounds; round++) {
+      page.resetMemory();
+      while (page.insertRecord(reinterpret_cast<char *>(&raw), sizeof(raw))) {
+        raw.id++;
+        records++;
+      }
+    }
+    report("serialize: raw struct memcpy", records, timer.elapsedSeconds(),
+           "rec");
+  }
+
+  records = 0;
+  {
+    TupleBuilder builder(schema);
+    builder.setVarchar(1, "benchmark-user");
+    builder.setDouble(2, 10.5);
+    builder.setBigInt(3, 1700000000);
+    int32_t id = 0;
+    Timer timer;
+    for (int round = 0; round < kRounds; round++) {
+      page.resetMemory();
+      for (;;) {
+        builder.setInteger(0, id++);
+        if (!builder.insertInto(page)) {
+          break;
+        }
+        records++;
+      }
+    }
+    report("serialize: TupleBuilder into page", records,
+           timer.elapsedSeconds(), "rec");
+  }
+
+  // ---- field access ----
+  std::vector<Tuple> tuples;
+  for (uint16_t slot = 0; slot < page.getNumberOfRecords(); slot++) {
+    tuples.push_back(Tuple::fromPage(&schema, page, slot));
+  }
+
+  uint64_t reads = 0;
+  int64_t checksum = 0;
+  {
+    Timer timer;
+    for (int round = 0; round < kRounds * 10; round++) {
+      for (const Tuple &tuple : tuples) {
+        checksum += tuple.getBigInt(3) + tuple.getInteger(0);
+        reads += 2;
+      }
+    }
+    report("access: Tuple precomputed offsets", reads, timer.elapsedSeconds(),
+           "field");
+  }
+  doNotOptimize(checksum);
+
+  reads = 0;
+  checksum = 0;
+  {
+    Timer timer;
+    for (int round = 0; round < kRounds * 10; round++) {
+      for (const Tuple &tuple : tuples) {
+        checksum += parseToColumn(tuple.getData(), 3) +
+                    static_cast<int32_t>(parseToColumn(tuple.getData(), 0));
+        reads += 2;
+      }
+    }
+    report("access: walk columns to offset", reads, timer.elapsedSeconds(),
+           "field");
+  }
+  doNotOptimize(checksum);
+
+  reads = 0;
+  uint64_t total_length = 0;
+  {
+    Timer timer;
+    for (int round = 0; round < kRounds * 10; round++) {
+      for (const Tuple &tuple : tuples) {
+        total_length += tuple.getVarchar(1).size();
+        reads++;
+      }
+    }
+    report("access: Tuple varchar via offset table", reads,
+           timer.elapsedSeconds(), "field");
+  }
+  doNotOptimize(total_length);
+
+  return 0;
+}
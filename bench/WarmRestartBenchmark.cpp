@@ -0,0 +1,104 @@
+#include "BenchUtil.hpp"
+#include "buffer/BufferPoolManager.hpp"
+#include <fcntl.h>
+#include <random>
+#include <unistd.h>
+
+// Time to steady-state hit rate after a restart. Random fetches over a
+// hot set of 3000 pages scattered over a 80 MB file run until the pool is
+// warm and its hot set is dumped; the pool is then restarted with the
+// file dropped from the OS page cache:
+// 1. cold: every hot page is faulted in by a fetchPage miss
+// 2. warm restart: the dump is preloaded in the background while the
+//    same fetches are served
+// 3. warm restart, preloading before serving
+// Reports the hit rate per window of fetches and the time until a window
+// reaches 95% hits.
+
+namespace {
+
+constexpr int kPages = 20000;
+constexpr int kHotPages = 3000;
+constexpr std::size_t kPoolSize = 4096;
+constexpr int kWindow = 2000;
+constexpr int kWindows = 40;
+const char *kDbFile = "bench_warm_restart.db";
+const char *kHotFile = "bench_warm_restart.hot";
+
+void dropPageCache() {
+  int fd = open(kDbFile, O_RDONLY);
+  posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+  close(fd);
+}
+
+// fetches random hot pages; returns the hits of the window
+std::size_t runWindow(BufferPoolManager &bpm,
+                      const std::vector<page_id_t> &hot, std::mt19937 &rng) {
+  std::size_t hits = bpm.getStats().hits;
+  for (int i = 0; i < kWindow; i++) {
+    Page *page = bpm.fetchPage(hot[rng() % hot.size()]);
+    if (page != nullptr) {
+      doNotOptimize(page->getData()[0]);
+      bpm.unpinPage(page, false);
+    }
+  }
+  return bpm.getStats().hits - hits;
+}
+
+} // namespace
+
+int main() {
+  std::remove(kDbFile);
+  std::remove(kHotFile);
+  std::mt19937 rng(5);
+  std::vector<page_id_t> hot(kHotPages);
+  {
+    BufferPoolManager bpm(64, kDbFile);
+    for (int i = 0; i < kPages; i++) {
+      page_id_t page_id;
+      bpm.newPage(&page_id);
+      bpm.unpinPage(page_id, true);
+    }
+  }
+  for (page_id_t &page_id : hot) {
+    page_id = static_cast<page_id_t>(rng() % kPages);
+  }
+  {
+    BufferPoolManager bpm(kPoolSize, kDbFile);
+    for (int w = 0; w < kWindows; w++) {
+      runWindow(bpm, hot, rng);
+    }
+    bpm.dumpHotSet(kHotFile);
+  }
+
+  const char *labels[] = {"cold restart", "warm restart, background",
+                          "warm restart, preload first"};
+  for (int mode = 0; mode < 3; mode++) {
+    dropPageCache();
+    BufferPoolManager bpm(kPoolSize, kDbFile);
+    Timer timer;
+    if (mode > 0) {
+      bpm.preloadHotSet(kHotFile, mode == 1);
+    }
+    double steady = -1;
+    std::size_t misses = 0;
+    std::printf("%s:", labels[mode]);
+    for (int w = 0; w < kWindows; w++) {
+      std::size_t hits = runWindow(bpm, hot, rng);
+      misses += kWindow - hits;
+      double rate = 100.0 * hits / kWindow;
+      if (w % 4 == 0) {
+        std::printf(" %.0f%%", rate);
+      }
+      if (steady < 0 && rate >= 95) {
+        steady = timer.elapsedSeconds();
+      }
+    }
+    std::printf("\n  95%% hit rate after %.1f ms, %zu misses, %zu pages "
+                "preloaded\n",
+                steady * 1e3, misses, bpm.getStats().preloaded);
+  }
+  std::remove(kDbFile);
+  std::remove(kHotFile);
+  return 0;
+}
@@ -1,52 +1,175 @@
 #include "BufferPoolManager.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
 #include <fstream>
-#include <ios>
+#include <limits>
+#include <new>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <thread>
+#include <unistd.h>
+#ifdef SRIDB_HAVE_NUMA
+#include <numa.h>
+#include <numaif.h>
+#include <sched.h>
+#endif
 
-page_id_t BufferPoolManager::pageIdCounter = 0;
 BufferPoolManager::BufferPoolManager(const std::size_t poolSize,
                                      const std::string &fileName)
-    : pool_size(poolSize), db_file_name(fileName) {
+    : pool_size(poolSize) {
 
-  // resize the frame
-  frames.resize(pool_size);
+  // frames hold atomics and cannot be moved: build them in place
+  while (num_frames < pool_size && addChunk()) {
+  }
+  pool_size = std::min(pool_size, num_frames);
 
   // clear the lists and maps
-  free_frames.clear();
+  free_frames.assign(1, std::list<frame_id_t>());
   page_table.clear();
   lru_list.clear();
 
   // free frames available
-  for (int i = 0; i < pool_size; i++) {
-    free_frames.push_back(i);
+  for (std::size_t i = 0; i < pool_size; i++) {
+    freeFrame(static_cast<frame_id_t>(i));
   }
 
-  // open the DB file
-  db_file.open(db_file_name, std::ios::binary | std::ios::in | std::ios::out);
-
-  if (!db_file.is_open()) {
-    // file does not exists
-    db_file.clear(); // clear the flags if any set
-    db_file.open(fileName, std::ios::binary | std::ios::trunc |
-                               std::ios::out); // force creation
-    db_file.close();
-    db_file.open(db_file_name, std::ios::binary | std::ios::in | std::ios::out);
-  }
+  // the primary DB file is file 0, in the default partition
+  files.push_back(openFile(fileName, false));
+  partitions.push_back(
+      Partition{"default", 0, std::numeric_limits<std::size_t>::max()});
 }
 
 BufferPoolManager::~BufferPoolManager() {
-  if (db_file.is_open()) {
-    flushAllPages();
-    db_file.close();
+  {
+    std::lock_guard<std::mutex> warm_guard(warm_mutex);
+    warm_stop = true;
+  }
+  warm_cv.notify_all();
+  if (dump_thread.joinable()) {
+    dump_thread.join();
+  }
+  waitForPreload();
+  {
+    std::lock_guard<std::mutex> io_guard(io_mutex);
+    io_stop = true;
+  }
+  io_cv.notify_all();
+  for (std::thread &thread : io_threads) {
+    thread.join();
+  }
+
+  std::lock_guard<std::mutex> guard(latch);
+  flushAllPages();
+  for (DbFile &file : files) {
+    if (file.fd >= 0) {
+      close(file.fd);
+      if (file.temporary) {
+        unlink(file.path.c_str());
+      }
+    }
+  }
+  if (tier_fd >= 0) {
+    close(tier_fd);
+    unlink(tier_path.c_str());
+  }
+  if (snapshot_fd >= 0) {
+    close(snapshot_fd);
+    unlink(snapshot_path.c_str());
+  }
+  if (log_fd >= 0) {
+    close(log_fd);
   }
 
   // clear the lists and maps
-  frames.clear();
+  while (!chunks.empty()) {
+    removeChunk();
+  }
   free_frames.clear();
   page_table.clear();
   lru_list.clear();
   lru_iterator.clear();
 }
 
+BufferPoolManager::DbFile
+BufferPoolManager::openFile(const std::string &path, bool temporary) {
+  DbFile file;
+  file.path = path;
+  file.temporary = temporary;
+  int flags = O_RDWR | O_CREAT | (temporary ? O_TRUNC : 0);
+  file.fd = open(path.c_str(), flags, 0644);
+  if (file.fd < 0) {
+    std::cerr << "Could not open database file " << path << "\n";
+    return file;
+  }
+
+  // continue allocating after the last page already in the file, so
+  // reopening a database never hands out an id that is in use
+  struct stat info;
+  if (fstat(file.fd, &info) == 0) {
+    file.num_pages = static_cast<uint32_t>(info.st_size / PAGE_SIZE);
+  }
+  return file;
+}
+
+BufferPoolManager::DbFile *BufferPoolManager::fileFor(page_id_t page_id) {
+  file_id_t file_id = fileOf(page_id);
+  if (file_id >= files.size() || files[file_id].fd < 0) {
+    std::cerr << "Database file " << static_cast<int>(file_id)
+              << " not open\n";
+    return nullptr;
+  }
+  return &files[file_id];
+}
+
+bool BufferPoolManager::readPageFromDisk(page_id_t page_id, Page *page) {
+  DbFile *file = fileFor(page_id);
+  if (file == nullptr) {
+    return false;
+  }
+
+  if (readFromTier(page_id, page)) {
+    return true;
+  }
+
+  // the page may not be in the file yet: it then reads as empty
+  off_t offset = static_cast<off_t>(pageNumberOf(page_id)) * PAGE_SIZE;
+  ssize_t read = pread(file->fd, page->getData(), PAGE_SIZE, offset);
+  stats.disk_reads++;
+  if (read != PAGE_SIZE) {
+    page->resetMemory();
+  }
+
+  page->setPageId(page_id);
+  return true;
+}
+
+bool BufferPoolManager::writePageToDisk(page_id_t page_id, Page *page) {
+  DbFile *file = fileFor(page_id);
+  if (file == nullptr) {
+    return false;
+  }
+  preserveForSnapshot(page_id, 1);
+  markChanged(page_id, 1);
+  off_t offset = static_cast<off_t>(pageNumberOf(page_id)) * PAGE_SIZE;
+  ssize_t written = pwrite(file->fd, page->getData(), PAGE_SIZE, offset);
+  stats.disk_writes++;
+  notePreloadWrite(page_id, 1);
+  dropFromTier(page_id);
+
+  if (written != PAGE_SIZE) {
+    std::cerr << "Failed to write page " << page_id << " to disk\n";
+    return false;
+  }
+  if (fileOf(page_id) == PRIMARY_FILE_ID) {
+    appendLog(PageLogType::PAGE, page_id, page->getData());
+  }
+  return true;
+}
+
 /*
 1. checks page is in memory
 2. If yes, increment pin_count, update lru_list and return page
@@ -58,41 +181,216 @@ page_id as invalid
 update the page_table, update lru_list, and return page
 */
 Page *BufferPoolManager::fetchPage(page_id_t page_id) {
+  std::lock_guard<std::mutex> guard(latch);
+  return fetchPageLocked(page_id);
+}
 
-  std::cout << "Entered Page_id " << page_id << std::endl;
+Page *BufferPoolManager::fetchPageLocked(page_id_t page_id) {
   if (page_table.count(page_id) > 0) {
-    std::cout << "Page table has it" << std::endl;
-    frames[page_table[page_id]].pin_count++;
+    stats.hits++;
+    Frame &frame = frameAt(page_table[page_id]);
+    partitions[frame.partition].stats.hits++;
+    countAccess(page_table[page_id]);
+    frame.reused = true;
+    frame.pin_count++;
     updateLRU(page_table[page_id]);
-    return &frames[page_table[page_id]].page;
+    return &frame.page;
   }
+  stats.misses++;
+  partition_id_t partition_id = partitionOf(page_id);
+  partitions[partition_id].stats.misses++;
 
-  if (free_frames.empty() && !evictPage()) {
-    std::cout << "could not evict" << std::endl;
+  frame_id_t availableFrameId = acquireFrame(partition_id);
+  if (availableFrameId == INVALID_FRAME_ID) {
     return nullptr;
   }
 
-  if (free_frames.empty()) {
-    std::cout << "Frames not empty" << std::endl;
+  // Load page from disk
+  if (!readPageFromDisk(page_id, &frameAt(availableFrameId).page)) {
+    freeFrame(availableFrameId);
     return nullptr;
   }
 
-  frame_id_t availableFrameId = *free_frames.begin();
-  free_frames.pop_front();
-
-  // Load page from disk
-  readPageFromDisk(page_id, &frames[availableFrameId].page);
-
-  // Initialize frame
-  frames[availableFrameId].page_id = page_id;
-  frames[availableFrameId].pin_count = 1;
-  frames[availableFrameId].is_dirty = false;
+  // Initialize frame; the pin count goes last, it publishes the frame to
+  // swizzled readers
+  countAccess(availableFrameId);
+  frameAt(availableFrameId).page_id = page_id;
+  frameAt(availableFrameId).is_dirty = false;
+  assignFrame(frameAt(availableFrameId), partition_id);
+  frameAt(availableFrameId).pin_count.store(1, std::memory_order_release);
 
   // Update page table and LRU
   page_table[page_id] = availableFrameId;
   updateLRU(availableFrameId);
 
-  return &frames[availableFrameId].page;
+  return &frameAt(availableFrameId).page;
+}
+
+bool BufferPoolManager::fetchPages(const page_id_t *page_ids,
+                                   std::size_t count, Page **pages) {
+  std::lock_guard<std::mutex> guard(latch);
+
+  // hits are pinned right away, so making room for the misses cannot
+  // evict them
+  std::vector<page_id_t> misses;
+  for (std::size_t i = 0; i < count; i++) {
+    auto entry = page_table.find(page_ids[i]);
+    if (entry == page_table.end()) {
+      pages[i] = nullptr;
+      misses.push_back(page_ids[i]);
+      continue;
+    }
+    Frame &frame = frameAt(entry->second);
+    stats.hits++;
+    partitions[frame.partition].stats.hits++;
+    countAccess(entry->second);
+    frame.reused = true;
+    frame.pin_count++;
+    updateLRU(entry->second);
+    pages[i] = &frame.page;
+  }
+  std::sort(misses.begin(), misses.end());
+  misses.erase(std::unique(misses.begin(), misses.end()), misses.end());
+
+  // frames for every miss; they stay out of the page table and the LRU
+  // list until the batch is read, so they cannot be evicted meanwhile
+  std::vector<frame_id_t> frame_ids;
+  for (page_id_t page_id : misses) {
+    partition_id_t partition_id = partitionOf(page_id);
+    frame_id_t frame_id = fileFor(page_id) != nullptr
+                              ? acquireFrame(partition_id)
+                              : INVALID_FRAME_ID;
+    if (frame_id == INVALID_FRAME_ID) {
+      for (frame_id_t acquired : frame_ids) {
+        releaseFrame(frameAt(acquired));
+        freeFrame(acquired);
+      }
+      for (std::size_t i = 0; i < count; i++) {
+        if (pages[i] != nullptr) {
+          unpin(frameOf(pages[i]));
+          pages[i] = nullptr;
+        }
+      }
+      return false;
+    }
+    assignFrame(frameAt(frame_id), partition_id);
+    frame_ids.push_back(frame_id);
+  }
+
+  // adjacent pages of one file become one read; pages cached in the
+  // second tier are read from there
+  ReadBatch batch;
+  for (std::size_t i = 0; i < misses.size(); i++) {
+    batch.buffers.push_back(frameAt(frame_ids[i]).page.getData());
+    if (readFromTier(misses[i], &frameAt(frame_ids[i]).page)) {
+      continue;
+    }
+    ReadRun *run = batch.runs.empty() ? nullptr : &batch.runs.back();
+    if (run != nullptr && run->first + run->count == i &&
+        misses[i] == misses[i - 1] + 1 &&
+        fileOf(misses[i]) == fileOf(misses[i - 1]) &&
+        run->count < kPreloadRun) {
+      run->count++;
+      continue;
+    }
+    batch.runs.push_back(
+        ReadRun{files[fileOf(misses[i])].fd,
+                static_cast<off_t>(pageNumberOf(misses[i])) * PAGE_SIZE, i,
+                1});
+  }
+  readBatch(batch);
+  stats.disk_reads += batch.runs.size();
+
+  for (const ReadRun &run : batch.runs) {
+    std::size_t valid =
+        run.result > 0 ? static_cast<std::size_t>(run.result) : 0;
+    for (std::size_t k = 0; k < run.count; k++) {
+      Page &page = frameAt(frame_ids[run.first + k]).page;
+      // the page may not be in the file yet: it then reads as empty
+      if ((k + 1) * PAGE_SIZE > valid) {
+        page.resetMemory();
+      }
+      page.setPageId(misses[run.first + k]);
+    }
+  }
+  for (std::size_t i = 0; i < misses.size(); i++) {
+    Frame &frame = frameAt(frame_ids[i]);
+    stats.misses++;
+    partitions[frame.partition].stats.misses++;
+    countAccess(frame_ids[i]);
+    frame.page_id = misses[i];
+    frame.is_dirty = false;
+    frame.pin_count.store(0, std::memory_order_release);
+    page_table[misses[i]] = frame_ids[i];
+    updateLRU(frame_ids[i]);
+  }
+  for (std::size_t i = 0; i < count; i++) {
+    if (pages[i] == nullptr) {
+      Frame &frame = frameAt(page_table[page_ids[i]]);
+      frame.pin_count++;
+      pages[i] = &frame.page;
+    }
+  }
+  return true;
+}
+
+void BufferPoolManager::runReads(ReadBatch &batch) {
+  for (std::size_t r = batch.next++; r < batch.runs.size();
+       r = batch.next++) {
+    ReadRun &run = batch.runs[r];
+    iovec iov[kPreloadRun];
+    for (std::size_t k = 0; k < run.count; k++) {
+      iov[k].iov_base = batch.buffers[run.first + k];
+      iov[k].iov_len = PAGE_SIZE;
+    }
+    run.result = preadv(run.fd, iov, static_cast<int>(run.count), run.offset);
+  }
+}
+
+void BufferPoolManager::readBatch(ReadBatch &batch) {
+  if (batch.runs.size() == 1) {
+    runReads(batch);
+    return;
+  }
+  if (io_threads.empty()) {
+    for (std::size_t i = 0; i < kIoThreads; i++) {
+      io_threads.emplace_back(&BufferPoolManager::ioWorker, this);
+    }
+  }
+  {
+    std::lock_guard<std::mutex> io_guard(io_mutex);
+    io_batch = &batch;
+    io_generation++;
+  }
+  io_cv.notify_all();
+  runReads(batch);
+
+  // every run is claimed: wait for the I/O threads still reading
+  std::unique_lock<std::mutex> io_lock(io_mutex);
+  io_done_cv.wait(io_lock, [this] { return io_active == 0; });
+  io_batch = nullptr;
+}
+
+void BufferPoolManager::ioWorker() {
+  std::unique_lock<std::mutex> io_lock(io_mutex);
+  std::size_t seen = 0;
+  while (true) {
+    io_cv.wait(io_lock, [&] {
+      return io_stop || (io_batch != nullptr && io_generation != seen);
+    });
+    if (io_stop) {
+      return;
+    }
+    seen = io_generation;
+    ReadBatch *batch = io_batch;
+    io_active++;
+    io_lock.unlock();
+    runReads(*batch);
+    io_lock.lock();
+    if (--io_active == 0) {
+      io_done_cv.notify_all();
+    }
+  }
 }
 
 /*
@@ -100,34 +398,139 @@ Page *BufferPoolManager::fetchPage(page_id_t page_id) {
 2. Decrement the pin_count and set the is_dirty flag as requested
 */
 bool BufferPoolManager::unpinPage(page_id_t page_id, bool is_dirty) {
+  std::lock_guard<std::mutex> guard(latch);
   if (page_table.count(page_id) > 0) {
-    if (frames[page_table[page_id]].pin_count <= 0) {
+    Frame &frame = frameAt(page_table[page_id]);
+    if (frame.pin_count <= 0) {
       return false;
     }
 
-    frames[page_table[page_id]].pin_count--;
-
     if (is_dirty) {
-      frames[page_table[page_id]].is_dirty = is_dirty;
+      frame.is_dirty = is_dirty;
     }
 
-    return true;
+    return unpin(frame);
   }
   return false;
 }
 
+bool BufferPoolManager::unpinPage(Page *page, bool is_dirty) {
+  // the caller's pin keeps the frame from being evicted: no latch needed
+  Frame &frame = frameOf(page);
+  if (is_dirty) {
+    frame.is_dirty.store(true, std::memory_order_relaxed);
+  }
+  return unpin(frame);
+}
+
+bool BufferPoolManager::tryPin(Frame &frame, page_id_t page_id) {
+  int pins = frame.pin_count.load(std::memory_order_relaxed);
+  do {
+    if (pins < 0) {
+      return false; // free or being evicted
+    }
+  } while (!frame.pin_count.compare_exchange_weak(pins, pins + 1,
+                                                  std::memory_order_acquire));
+  // pinned: the frame can no longer be evicted, but it may have been
+  // reused for another page before the pin
+  if (frame.page_id.load(std::memory_order_relaxed) != page_id) {
+    unpin(frame);
+    return false;
+  }
+  return true;
+}
+
+void BufferPoolManager::swizzle(Frame &parent, std::size_t slot,
+                                Frame &child) {
+  std::atomic<Frame *> *swips = parent.swips.load(std::memory_order_relaxed);
+  if (swips == nullptr) {
+    parent.swip_storage.reset(new std::atomic<Frame *>[kMaxSwips]);
+    swips = parent.swip_storage.get();
+    for (std::size_t i = 0; i < kMaxSwips; i++) {
+      swips[i].store(nullptr, std::memory_order_relaxed);
+    }
+    parent.swips.store(swips, std::memory_order_release);
+  }
+
+  Frame *previous = swips[slot].load(std::memory_order_relaxed);
+  if (previous == &child) {
+    return;
+  }
+  if (previous != nullptr) {
+    auto &refs = previous->swizzled_by;
+    refs.erase(std::remove(refs.begin(), refs.end(), &swips[slot]),
+               refs.end());
+  }
+  swips[slot].store(&child, std::memory_order_release);
+  child.swizzled_by.push_back(&swips[slot]);
+}
+
+void BufferPoolManager::unswizzle(Frame &frame) {
+  // references to this frame fall back to page ids
+  for (std::atomic<Frame *> *swip : frame.swizzled_by) {
+    swip->store(nullptr, std::memory_order_release);
+  }
+  frame.swizzled_by.clear();
+
+  // and so do the references this page held to its children
+  std::atomic<Frame *> *swips = frame.swips.load(std::memory_order_relaxed);
+  if (swips == nullptr) {
+    return;
+  }
+  for (std::size_t slot = 0; slot < kMaxSwips; slot++) {
+    Frame *child = swips[slot].exchange(nullptr, std::memory_order_relaxed);
+    if (child != nullptr) {
+      auto &refs = child->swizzled_by;
+      refs.erase(std::remove(refs.begin(), refs.end(), &swips[slot]),
+                 refs.end());
+    }
+  }
+}
+
+Page *BufferPoolManager::fetchChild(Page *parent, std::size_t slot,
+                                    page_id_t child_id) {
+  bool swizzle_child = swizzling.load(std::memory_order_relaxed) &&
+                       slot < kMaxSwips;
+  if (swizzle_child) {
+    // announced, so a shrink cannot unmap the frame between reading the
+    // pointer and pinning it
+    std::atomic<int> &readers = swizzled_readers[readerSlot()].count;
+    readers.fetch_add(1);
+    std::atomic<Frame *> *swips =
+        frameOf(parent).swips.load(std::memory_order_acquire);
+    Frame *child = swips != nullptr
+                       ? swips[slot].load(std::memory_order_acquire)
+                       : nullptr;
+    bool pinned = child != nullptr && tryPin(*child, child_id);
+    readers.fetch_sub(1, std::memory_order_release);
+    if (pinned) {
+      child->referenced.store(true, std::memory_order_relaxed);
+      swizzled_hits.fetch_add(1, std::memory_order_relaxed);
+      return &child->page;
+    }
+  }
+
+  std::lock_guard<std::mutex> guard(latch);
+  Page *page = fetchPageLocked(child_id);
+  if (page != nullptr && swizzle_child) {
+    swizzle(frameOf(parent), slot, frameOf(page));
+  }
+  return page;
+}
+
 /*
 1. checks page is in memory
 2. writes page to disk
 */
 bool BufferPoolManager::flushPage(page_id_t page_id) {
+  std::lock_guard<std::mutex> guard(latch);
   if (page_table.count(page_id) > 0) {
     // write only if no other thread is accessing and its dirty
-    if (frames[page_table[page_id]].is_dirty) {
+    if (frameAt(page_table[page_id]).is_dirty) {
       bool success =
-          writePageToDisk(page_id, &frames[page_table[page_id]].page);
+          writePageToDisk(page_id, &frameAt(page_table[page_id]).page);
       if (success) {
-        frames[page_table[page_id]].is_dirty = false;
+        frameAt(page_table[page_id]).is_dirty = false;
       }
       return success;
     }
@@ -139,33 +542,44 @@ bool BufferPoolManager::flushPage(page_id_t page_id) {
 Allocate new page_id, initialize empty page
 */
 Page *BufferPoolManager::newPage(page_id_t *page_id) {
+  return newPage(PRIMARY_FILE_ID, page_id);
+}
 
-  if (free_frames.empty() && !evictPage()) {
+Page *BufferPoolManager::newPage(file_id_t file_id, page_id_t *page_id) {
+  std::lock_guard<std::mutex> guard(latch);
+  if (file_id >= files.size() || files[file_id].fd < 0) {
+    std::cerr << "Database file " << static_cast<int>(file_id)
+              << " not open\n";
     return nullptr;
   }
-
-  if (free_frames.empty()) {
+  if (files[file_id].num_pages >= MAX_PAGES_PER_FILE) {
+    std::cerr << "Database file " << files[file_id].path << " is full\n";
     return nullptr;
   }
 
-  frame_id_t availableFrameId = *free_frames.begin();
-  free_frames.pop_front();
+  partition_id_t partition_id = files[file_id].partition;
+  frame_id_t availableFrameId = acquireFrame(partition_id);
+  if (availableFrameId == INVALID_FRAME_ID) {
+    return nullptr;
+  }
 
   // allocate page id
-  *page_id = pageIdCounter++;
+  *page_id = makePageId(file_id, files[file_id].num_pages++);
 
   // update the frame
-  frames[availableFrameId].page_id = *page_id;
-  frames[availableFrameId].page.resetMemory();
-  frames[availableFrameId].page.setPageId(*page_id);
-  frames[availableFrameId].pin_count = 1;
-  frames[availableFrameId].is_dirty = true;
+  countAccess(availableFrameId);
+  frameAt(availableFrameId).page_id = *page_id;
+  frameAt(availableFrameId).page.resetMemory();
+  frameAt(availableFrameId).page.setPageId(*page_id);
+  frameAt(availableFrameId).is_dirty = true;
+  assignFrame(frameAt(availableFrameId), partition_id);
+  frameAt(availableFrameId).pin_count.store(1, std::memory_order_release);
 
   // update page table and LRU
   page_table[*page_id] = availableFrameId;
   updateLRU(availableFrameId);
 
-  return &frames[availableFrameId].page;
+  return &frameAt(availableFrameId).page;
 }
 
 /*
@@ -173,23 +587,28 @@ Page *BufferPoolManager::newPage(page_id_t *page_id) {
 2. remove page from buffer
 */
 bool BufferPoolManager::deletePage(page_id_t page_id) {
+  std::lock_guard<std::mutex> guard(latch);
   if (page_table.count(page_id) > 0) {
     frame_id_t frameId = page_table[page_id];
 
     // no other thread is accessing it
-    if (frames[frameId].pin_count == 0) {
+    int unpinned = 0;
+    if (frameAt(frameId).pin_count.compare_exchange_strong(unpinned,
+                                                           kNotResident)) {
+      unswizzle(frameAt(frameId));
 
-      // if page is dirty
-      if (frames[frameId].is_dirty) {
-        writePageToDisk(page_id, &frames[frameId].page);
+      // if page is dirty (a deleted temporary page is dead, not written)
+      if (frameAt(frameId).is_dirty && !files[fileOf(page_id)].temporary) {
+        writePageToDisk(page_id, &frameAt(frameId).page);
       }
+      dropFromTier(page_id);
       // update the frame
-      frames[frameId].page_id = INVALID_PAGE_ID;
-      frames[frameId].pin_count = 0;
-      frames[frameId].is_dirty = false;
+      frameAt(frameId).page_id = INVALID_PAGE_ID;
+      frameAt(frameId).is_dirty = false;
+      releaseFrame(frameAt(frameId));
 
       // add it to free frames
-      free_frames.push_back(frameId);
+      freeFrame(frameId);
 
       // update page table and lru list
       page_table.erase(page_id);
@@ -206,10 +625,1098 @@ bool BufferPoolManager::deletePage(page_id_t page_id) {
 1. writes all dirty pages to disk
 */
 void BufferPoolManager::flushAllDirtyPages() {
-  for (auto &frame : frames) {
+  std::lock_guard<std::mutex> guard(latch);
+  for (std::size_t i = 0; i < num_frames; i++) {
+    Frame &frame = frameAt(static_cast<frame_id_t>(i));
     if (frame.page_id != INVALID_PAGE_ID && frame.is_dirty) {
       writePageToDisk(frame.page_id, &frame.page);
       frame.is_dirty = false;
     }
   }
 }
+
+std::size_t BufferPoolManager::getPinnableFrames() {
+  std::lock_guard<std::mutex> guard(latch);
+  std::size_t pinned = 0;
+  for (std::size_t i = 0; i < pool_size; i++) {
+    Frame &frame = frameAt(static_cast<frame_id_t>(i));
+    pinned += frame.pin_count.load(std::memory_order_relaxed) > 0;
+  }
+  return pool_size - pinned;
+}
+
+page_id_t BufferPoolManager::allocatePages(std::size_t count,
+                                           file_id_t file_id) {
+  std::lock_guard<std::mutex> guard(latch);
+  if (file_id >= files.size() || files[file_id].fd < 0) {
+    std::cerr << "Database file " << static_cast<int>(file_id)
+              << " not open\n";
+    return INVALID_PAGE_ID;
+  }
+  DbFile &file = files[file_id];
+  if (count == 0 || file.num_pages + count > MAX_PAGES_PER_FILE) {
+    std::cerr << "Cannot allocate " << count << " pages in " << file.path
+              << "\n";
+    return INVALID_PAGE_ID;
+  }
+  page_id_t first = makePageId(file_id, file.num_pages);
+  file.num_pages += static_cast<uint32_t>(count);
+  return first;
+}
+
+bool BufferPoolManager::readPages(page_id_t first, std::size_t count,
+                                  char *data) {
+  std::lock_guard<std::mutex> guard(latch);
+  DbFile *file = fileFor(first);
+  if (file == nullptr) {
+    return false;
+  }
+  std::size_t length = count * PAGE_SIZE;
+  off_t offset = static_cast<off_t>(pageNumberOf(first)) * PAGE_SIZE;
+  ssize_t read = pread(file->fd, data, length, offset);
+  stats.disk_reads++;
+  std::size_t valid = read > 0 ? static_cast<std::size_t>(read) : 0;
+  // the tail of an extent that was never written
+  std::memset(data + valid, 0, length - valid);
+  return true;
+}
+
+bool BufferPoolManager::writePages(page_id_t first, std::size_t count,
+                                   const char *data) {
+  std::lock_guard<std::mutex> guard(latch);
+  DbFile *file = fileFor(first);
+  if (file == nullptr) {
+    return false;
+  }
+  preserveForSnapshot(first, count);
+  markChanged(first, count);
+  std::size_t length = count * PAGE_SIZE;
+  off_t offset = static_cast<off_t>(pageNumberOf(first)) * PAGE_SIZE;
+  ssize_t written = pwrite(file->fd, data, length, offset);
+  stats.disk_writes++;
+  notePreloadWrite(first, count);
+  for (std::size_t i = 0; i < count; i++) {
+    dropFromTier(static_cast<page_id_t>(first + i));
+  }
+  if (written != static_cast<ssize_t>(length)) {
+    std::cerr << "Failed to write pages " << first << ".."
+              << first + count - 1 << " to disk\n";
+    return false;
+  }
+  for (std::size_t i = 0; fileOf(first) == PRIMARY_FILE_ID && i < count;
+       i++) {
+    appendLog(PageLogType::PAGE, static_cast<page_id_t>(first + i),
+              data + i * PAGE_SIZE);
+  }
+  return true;
+}
+
+file_id_t BufferPoolManager::addFile(const std::string &path,
+                                     bool temporary) {
+  std::lock_guard<std::mutex> guard(latch);
+  for (std::size_t i = 0; i < files.size(); i++) {
+    if (files[i].fd >= 0 && files[i].path == path) {
+      return static_cast<file_id_t>(i);
+    }
+  }
+  if (files.size() >= INVALID_FILE_ID) {
+    std::cerr << "Too many database files\n";
+    return INVALID_FILE_ID;
+  }
+  DbFile file = openFile(path, temporary);
+  if (file.fd < 0) {
+    return INVALID_FILE_ID;
+  }
+  files.push_back(file);
+  return static_cast<file_id_t>(files.size() - 1);
+}
+
+file_id_t BufferPoolManager::openSpillFile() {
+  // unique per pool, so pools over the same database never share it
+  std::string path = files[PRIMARY_FILE_ID].path + ".spill.XXXXXX";
+  int fd = files.size() < INVALID_FILE_ID ? mkstemp(path.data()) : -1;
+  if (fd < 0) {
+    std::cerr << "Could not create a spill file, spilling to the DB file\n";
+    return PRIMARY_FILE_ID;
+  }
+  close(fd);
+  DbFile file = openFile(path, true);
+  if (file.fd < 0) {
+    unlink(path.c_str());
+    return PRIMARY_FILE_ID;
+  }
+  files.push_back(file);
+  return static_cast<file_id_t>(files.size() - 1);
+}
+
+file_id_t BufferPoolManager::getSpillFile() {
+  std::lock_guard<std::mutex> guard(latch);
+  if (spill_file == INVALID_FILE_ID) {
+    spill_file = openSpillFile();
+  }
+  return spill_file;
+}
+
+bool BufferPoolManager::dropFile(file_id_t file_id) {
+  std::lock_guard<std::mutex> guard(latch);
+  if (file_id == PRIMARY_FILE_ID || file_id >= files.size() ||
+      files[file_id].fd < 0) {
+    std::cerr << "Cannot drop database file " << static_cast<int>(file_id)
+              << "\n";
+    return false;
+  }
+  if (snapshot_fd >= 0) {
+    std::cerr << "Cannot drop database file " << files[file_id].path
+              << " while a snapshot is active\n";
+    return false;
+  }
+
+  // claim every resident page of the file; give them back if one is pinned
+  std::vector<frame_id_t> claimed;
+  for (const auto &entry : page_table) {
+    if (fileOf(entry.first) != file_id) {
+      continue;
+    }
+    int unpinned = 0;
+    if (!frameAt(entry.second).pin_count.compare_exchange_strong(
+            unpinned, kNotResident)) {
+      for (frame_id_t frame_id : claimed) {
+        frameAt(frame_id).pin_count.store(0);
+      }
+      std::cerr << "Cannot drop database file " << files[file_id].path
+                << " while page " << entry.first << " is pinned\n";
+      return false;
+    }
+    claimed.push_back(entry.second);
+  }
+
+  // discard them without writing back
+  for (frame_id_t frame_id : claimed) {
+    Frame &frame = frameAt(frame_id);
+    unswizzle(frame);
+    page_table.erase(frame.page_id);
+    removeFromLRU(frame_id);
+    frame.page_id = INVALID_PAGE_ID;
+    frame.is_dirty = false;
+    releaseFrame(frame);
+    freeFrame(frame_id);
+  }
+
+  for (std::size_t slot = 0; slot < tier_slots.size(); slot++) {
+    if (tier_slots[slot] != INVALID_PAGE_ID &&
+        fileOf(tier_slots[slot]) == file_id) {
+      dropFromTier(tier_slots[slot]);
+    }
+  }
+
+  DbFile &file = files[file_id];
+  close(file.fd);
+  file.fd = -1;
+  if (spill_file == file_id) {
+    spill_file = INVALID_FILE_ID;
+  }
+  if (unlink(file.path.c_str()) != 0) {
+    std::cerr << "Could not delete database file " << file.path << "\n";
+    return false;
+  }
+  return true;
+}
+
+partition_id_t BufferPoolManager::createPartition(const std::string &name,
+                                                 std::size_t minFrames,
+                                                 std::size_t maxFrames) {
+  std::lock_guard<std::mutex> guard(latch);
+  std::size_t reserved = minFrames;
+  for (const Partition &partition : partitions) {
+    reserved += partition.min_frames;
+  }
+  if (maxFrames == 0 || minFrames > maxFrames || reserved > pool_size ||
+      partitions.size() >= INVALID_PARTITION_ID) {
+    std::cerr << "Cannot create partition " << name << "\n";
+    return INVALID_PARTITION_ID;
+  }
+  partitions.push_back(Partition{name, minFrames, maxFrames});
+  return static_cast<partition_id_t>(partitions.size() - 1);
+}
+
+bool BufferPoolManager::setFilePartition(file_id_t file_id,
+                                         partition_id_t partition_id) {
+  std::lock_guard<std::mutex> guard(latch);
+  if (file_id >= files.size() || files[file_id].fd < 0 ||
+      partition_id >= partitions.size()) {
+    std::cerr << "Cannot assign file " << static_cast<int>(file_id)
+              << " to partition " << static_cast<int>(partition_id) << "\n";
+    return false;
+  }
+  files[file_id].partition = partition_id;
+  return true;
+}
+
+bool BufferPoolManager::addChunk() {
+  std::size_t bytes = kFramesPerChunk * sizeof(Frame);
+  void *memory = mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (memory == MAP_FAILED) {
+    std::cerr << "Could not map " << bytes << " bytes of frames\n";
+    return false;
+  }
+  Frame *chunk = static_cast<Frame *>(memory);
+  chunks.push_back(chunk);
+  // placed before the frames are first touched
+  chunk_nodes.push_back(static_cast<int>((chunks.size() - 1) % numa_nodes));
+  if (numa_configured && !numa_simulated) {
+    bindChunk(chunks.size() - 1, chunk_nodes.back());
+  }
+  for (std::size_t i = 0; i < kFramesPerChunk; i++) {
+    new (&chunk[i]) Frame();
+  }
+  page_offset = reinterpret_cast<char *>(&chunk[0].page) -
+                reinterpret_cast<char *>(&chunk[0]);
+  num_frames += kFramesPerChunk;
+  return true;
+}
+
+void BufferPoolManager::removeChunk() {
+  Frame *chunk = chunks.back();
+  for (std::size_t i = 0; i < kFramesPerChunk; i++) {
+    chunk[i].~Frame();
+  }
+  munmap(chunk, kFramesPerChunk * sizeof(Frame));
+  chunks.pop_back();
+  chunk_nodes.pop_back();
+  num_frames -= kFramesPerChunk;
+}
+
+bool BufferPoolManager::vacateFrame(frame_id_t frame_id) {
+  Frame &frame = frameAt(frame_id);
+  if (frame.page_id == INVALID_PAGE_ID) {
+    return true;
+  }
+  int unpinned = 0;
+  if (!frame.pin_count.compare_exchange_strong(unpinned, kNotResident)) {
+    return false;
+  }
+  unswizzle(frame);
+
+  if (num_free > 0) {
+    // keep the page resident: copy it into a surviving frame (on the same
+    // node if possible), which takes over its place in the LRU list
+    frame_id_t target_id = popFree(nodeOf(frame_id));
+    Frame &target = frameAt(target_id);
+    std::memcpy(target.page.getData(), frame.page.getData(), PAGE_SIZE);
+    target.page.setPageId(frame.page_id);
+    target.page_id = frame.page_id.load();
+    target.is_dirty = frame.is_dirty.load();
+    target.partition = frame.partition;
+    target.priority = frame.priority.load();
+    target.reused = frame.reused;
+    page_table[frame.page_id] = target_id;
+    auto position = lru_iterator[frame_id];
+    *position = target_id;
+    lru_iterator.erase(frame_id);
+    lru_iterator[target_id] = position;
+    target.pin_count.store(0, std::memory_order_release);
+    stats.migrations++;
+  } else {
+    if (frame.is_dirty) {
+      writePageToDisk(frame.page_id, &frame.page);
+    }
+    admitToTier(frame);
+    page_table.erase(frame.page_id);
+    removeFromLRU(frame_id);
+    releaseFrame(frame);
+    partitions[frame.partition].stats.evictions++;
+    stats.evictions++;
+  }
+  frame.page_id = INVALID_PAGE_ID;
+  frame.is_dirty = false;
+  return true;
+}
+
+bool BufferPoolManager::resize(std::size_t newSize) {
+  std::lock_guard<std::mutex> resizing(resize_mutex);
+  std::size_t old_size;
+  {
+    std::lock_guard<std::mutex> guard(latch);
+    std::size_t reserved = 0;
+    for (const Partition &partition : partitions) {
+      reserved += partition.min_frames;
+    }
+    if (newSize == 0 || newSize < reserved) {
+      std::cerr << "Cannot resize the buffer pool to " << newSize
+                << " frames\n";
+      return false;
+    }
+    old_size = pool_size;
+
+    if (newSize >= old_size) {
+      while (num_frames < newSize) {
+        if (!addChunk()) {
+          newSize = num_frames;
+          break;
+        }
+      }
+      pool_size = newSize;
+      for (std::size_t i = old_size; i < newSize; i++) {
+        freeFrame(static_cast<frame_id_t>(i));
+      }
+      return true;
+    }
+
+    // no new page goes into the removed frames from now on
+    pool_size = newSize;
+    for (auto &list : free_frames) {
+      list.remove_if([&](frame_id_t frame_id) {
+        bool removed = frame_id >= newSize;
+        num_free -= removed;
+        return removed;
+      });
+    }
+  }
+
+  // empty the removed frames a batch at a time, so readers and writers
+  // keep going in between; pinned pages are retried once unpinned
+  for (;;) {
+    bool vacated = true;
+    for (std::size_t start = newSize; start < old_size;
+         start += kResizeBatch) {
+      std::lock_guard<std::mutex> guard(latch);
+      std::size_t end = std::min(old_size, start + kResizeBatch);
+      for (std::size_t i = start; i < end; i++) {
+        vacated &= vacateFrame(static_cast<frame_id_t>(i));
+      }
+    }
+    if (vacated) {
+      break;
+    }
+    std::this_thread::yield();
+  }
+
+  // no swip points into the removed frames any more; wait out fetchChild
+  // calls that may have read one before it was cleared
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  for (ReaderSlot &slot : swizzled_readers) {
+    while (slot.count.load() != 0) {
+      std::this_thread::yield();
+    }
+  }
+
+  std::lock_guard<std::mutex> guard(latch);
+  while (num_frames - kFramesPerChunk >= pool_size) {
+    removeChunk(); // back to the OS
+  }
+  return true;
+}
+
+namespace {
+// node a thread was bound to with bindThreadToNode, -1 if none
+thread_local int bound_node = -1;
+} // namespace
+
+int BufferPoolManager::currentNode() const {
+  int node = bound_node;
+#ifdef SRIDB_HAVE_NUMA
+  if (node < 0 && numa_configured && !numa_simulated) {
+    node = numa_node_of_cpu(sched_getcpu());
+  }
+#endif
+  return node >= 0 && static_cast<std::size_t>(node) < numa_nodes ? node
+                                                                   : 0;
+}
+
+bool BufferPoolManager::bindChunk(std::size_t chunk, int node) {
+#ifdef SRIDB_HAVE_NUMA
+  unsigned long mask = 1UL << node;
+  // MPOL_MF_MOVE also migrates pages the frames already touched
+  if (mbind(chunks[chunk], kFramesPerChunk * sizeof(Frame), MPOL_BIND, &mask,
+            sizeof(mask) * 8, MPOL_MF_MOVE) != 0) {
+    std::cerr << "Could not bind frames to NUMA node " << node << "\n";
+    return false;
+  }
+  return true;
+#else
+  (void)chunk;
+  (void)node;
+  return false;
+#endif
+}
+
+bool BufferPoolManager::configureNuma(std::size_t numNodes, bool simulated) {
+  std::lock_guard<std::mutex> guard(latch);
+  if (numNodes == 0 || numNodes > 8 * sizeof(unsigned long)) {
+    std::cerr << "Invalid number of NUMA nodes " << numNodes << "\n";
+    return false;
+  }
+  if (!simulated) {
+#ifdef SRIDB_HAVE_NUMA
+    if (numa_available() < 0 ||
+        numNodes > static_cast<std::size_t>(numa_max_node()) + 1) {
+      std::cerr << "Machine does not have " << numNodes << " NUMA nodes\n";
+      return false;
+    }
+#else
+    std::cerr << "Built without libnuma: only simulated NUMA is available\n";
+    return false;
+#endif
+  }
+  numa_nodes = numNodes;
+  numa_configured = true;
+  numa_simulated = simulated;
+
+  for (std::size_t i = 0; i < chunks.size(); i++) {
+    chunk_nodes[i] = static_cast<int>(i % numa_nodes);
+    if (!simulated) {
+      bindChunk(i, chunk_nodes[i]);
+    }
+  }
+
+  // regroup the free frames by their new nodes
+  std::vector<frame_id_t> free_ids;
+  for (auto &list : free_frames) {
+    free_ids.insert(free_ids.end(), list.begin(), list.end());
+  }
+  free_frames.assign(numa_nodes, std::list<frame_id_t>());
+  num_free = 0;
+  for (frame_id_t frame_id : free_ids) {
+    freeFrame(frame_id);
+  }
+  return true;
+}
+
+bool BufferPoolManager::bindThreadToNode(int node) {
+  std::size_t nodes = getNumaNodes();
+  if (node >= 0 && static_cast<std::size_t>(node) >= nodes) {
+    std::cerr << "No NUMA node " << node << "\n";
+    return false;
+  }
+  bound_node = node;
+#ifdef SRIDB_HAVE_NUMA
+  bool simulated;
+  {
+    std::lock_guard<std::mutex> guard(latch);
+    simulated = !numa_configured || numa_simulated;
+  }
+  if (!simulated && numa_run_on_node(node) != 0) {
+    std::cerr << "Could not run on NUMA node " << node << "\n";
+    return false;
+  }
+#endif
+  return true;
+}
+
+bool BufferPoolManager::dumpHotSet(const std::string &path) {
+  std::vector<page_id_t> page_ids;
+  {
+    std::lock_guard<std::mutex> guard(latch);
+    std::vector<frame_id_t> frame_ids(lru_list.rbegin(), lru_list.rend());
+    std::stable_sort(frame_ids.begin(), frame_ids.end(),
+                     [this](frame_id_t a, frame_id_t b) {
+                       return frameAt(a).priority.load() >
+                              frameAt(b).priority.load();
+                     });
+    for (frame_id_t frame_id : frame_ids) {
+      if (!files[fileOf(frameAt(frame_id).page_id)].temporary) {
+        page_ids.push_back(frameAt(frame_id).page_id);
+      }
+    }
+  }
+
+  // written aside and renamed, so a crash never leaves a torn dump
+  std::string temp_path = path + ".tmp";
+  std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+  uint32_t count = static_cast<uint32_t>(page_ids.size());
+  out.write(reinterpret_cast<const char *>(&count), sizeof(count));
+  out.write(reinterpret_cast<const char *>(page_ids.data()),
+            static_cast<std::streamsize>(count * sizeof(page_id_t)));
+  out.close();
+  if (!out || std::rename(temp_path.c_str(), path.c_str()) != 0) {
+    std::cerr << "Could not write hot set to " << path << "\n";
+    return false;
+  }
+  return true;
+}
+
+bool BufferPoolManager::startHotSetDumps(const std::string &path,
+                                         std::chrono::milliseconds interval) {
+  if (dump_thread.joinable()) {
+    std::cerr << "Hot set dumps already running\n";
+    return false;
+  }
+  dump_thread = std::thread([this, path, interval] {
+    std::unique_lock<std::mutex> lock(warm_mutex);
+    while (!warm_cv.wait_for(lock, interval, [this] { return warm_stop; })) {
+      lock.unlock();
+      dumpHotSet(path);
+      lock.lock();
+    }
+  });
+  return true;
+}
+
+bool BufferPoolManager::preloadHotSet(const std::string &path,
+                                      bool background) {
+  std::ifstream in(path, std::ios::binary);
+  uint32_t count = 0;
+  if (!in.read(reinterpret_cast<char *>(&count), sizeof(count))) {
+    std::cerr << "Could not read hot set from " << path << "\n";
+    return false;
+  }
+  std::vector<page_id_t> page_ids(count);
+  if (!in.read(reinterpret_cast<char *>(page_ids.data()),
+               static_cast<std::streamsize>(count * sizeof(page_id_t)))) {
+    std::cerr << "Truncated hot set " << path << "\n";
+    return false;
+  }
+  // the hottest pages that fit
+  page_ids.resize(std::min<std::size_t>(page_ids.size(), getPoolSize()));
+
+  waitForPreload();
+  if (!background) {
+    preload(std::move(page_ids));
+    return true;
+  }
+  preload_thread = std::thread(&BufferPoolManager::preload, this,
+                               std::move(page_ids));
+  return true;
+}
+
+void BufferPoolManager::waitForPreload() {
+  if (preload_thread.joinable()) {
+    preload_thread.join();
+  }
+}
+
+void BufferPoolManager::preload(std::vector<page_id_t> page_ids) {
+  std::sort(page_ids.begin(), page_ids.end());
+  page_ids.erase(std::unique(page_ids.begin(), page_ids.end()),
+                 page_ids.end());
+  std::vector<char> buffer(kPreloadRun * PAGE_SIZE);
+
+  std::size_t i = 0;
+  while (i < page_ids.size()) {
+    {
+      std::lock_guard<std::mutex> warm_guard(warm_mutex);
+      if (warm_stop) {
+        return;
+      }
+    }
+    // the wanted pages within kPreloadRun pages of one file (ids of a
+    // file are contiguous): one read covers them and the gaps between
+    page_id_t first = page_ids[i];
+    std::size_t end = i + 1;
+    while (end < page_ids.size() && page_ids[end] - first < kPreloadRun &&
+           fileOf(page_ids[end]) == fileOf(first)) {
+      end++;
+    }
+    std::size_t count = page_ids[end - 1] - first + 1;
+
+    int fd;
+    {
+      std::lock_guard<std::mutex> guard(latch);
+      file_id_t file_id = fileOf(first);
+      fd = file_id < files.size() ? files[file_id].fd : -1;
+      preload_reading = fd >= 0;
+      preload_writes.clear();
+    }
+    if (fd >= 0) {
+      // the read runs without the latch, so traffic is not blocked
+      std::size_t length = count * PAGE_SIZE;
+      off_t offset = static_cast<off_t>(pageNumberOf(first)) * PAGE_SIZE;
+      ssize_t read = pread(fd, buffer.data(), length, offset);
+      std::size_t valid = read > 0 ? static_cast<std::size_t>(read) : 0;
+      std::memset(buffer.data() + valid, 0, length - valid);
+      if (!installPreloaded(first, &page_ids[i], end - i, buffer.data())) {
+        return; // no free frames left
+      }
+    }
+    i = end;
+  }
+}
+
+bool BufferPoolManager::writtenDuringPreload(page_id_t page_id) const {
+  for (const auto &[first, count] : preload_writes) {
+    if (page_id >= first && page_id - first < count) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool BufferPoolManager::installPreloaded(page_id_t first,
+                                         const page_id_t *page_ids,
+                                         std::size_t count,
+                                         const char *data) {
+  std::lock_guard<std::mutex> guard(latch);
+  stats.disk_reads++;
+  preload_reading = false;
+  file_id_t file_id = fileOf(first);
+  if (file_id >= files.size() || files[file_id].fd < 0) {
+    return true; // dropped meanwhile
+  }
+  partition_id_t partition_id = files[file_id].partition;
+  for (std::size_t i = 0; i < count; i++) {
+    page_id_t page_id = page_ids[i];
+    if (page_table.count(page_id) > 0 || writtenDuringPreload(page_id)) {
+      // already fetched by traffic, or written back since the read
+      continue;
+    }
+    const Partition &partition = partitions[partition_id];
+    if (partition.resident >= partition.max_frames) {
+      return true;
+    }
+    if (num_free <= reservedForOthers(partition_id)) {
+      return false;
+    }
+
+    frame_id_t frame_id = popFree(currentNode());
+    Frame &frame = frameAt(frame_id);
+    std::memcpy(frame.page.getData(), data + (page_id - first) * PAGE_SIZE,
+                PAGE_SIZE);
+    frame.page.setPageId(page_id);
+    frame.page_id = page_id;
+    frame.is_dirty = false;
+    assignFrame(frame, partition_id);
+    frame.pin_count.store(0, std::memory_order_release);
+    page_table[page_id] = frame_id;
+    // colder than pages fetched by traffic
+    lru_list.push_front(frame_id);
+    lru_iterator[frame_id] = lru_list.begin();
+    stats.preloaded++;
+  }
+  return true;
+}
+
+bool BufferPoolManager::enableSecondTier(const std::string &path,
+                                         std::size_t numPages,
+                                         TierAdmission admission) {
+  std::lock_guard<std::mutex> guard(latch);
+  if (tier_fd >= 0 || numPages == 0) {
+    std::cerr << "Cannot enable second tier " << path << "\n";
+    return false;
+  }
+  tier_fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (tier_fd < 0) {
+    std::cerr << "Could not open second tier " << path << "\n";
+    return false;
+  }
+  tier_path = path;
+  tier_admission = admission;
+  tier_slots.assign(numPages, INVALID_PAGE_ID);
+  tier_referenced.assign(numPages, 0);
+  tier_index.clear();
+  tier_hand = 0;
+  return true;
+}
+
+void BufferPoolManager::admitToTier(const Frame &frame) {
+  page_id_t page_id = frame.page_id;
+  if (tier_fd < 0 || files[fileOf(page_id)].temporary ||
+      tier_index.count(page_id) > 0) {
+    return; // off, not worth keeping, or already holds this version
+  }
+  if (tier_admission == TierAdmission::REUSED && !frame.reused) {
+    return;
+  }
+
+  // CLOCK: a slot referenced since the hand passed gets a second chance
+  while (tier_referenced[tier_hand]) {
+    tier_referenced[tier_hand] = 0;
+    tier_hand = (tier_hand + 1) % tier_slots.size();
+  }
+  uint32_t slot = static_cast<uint32_t>(tier_hand);
+  tier_hand = (tier_hand + 1) % tier_slots.size();
+  if (tier_slots[slot] != INVALID_PAGE_ID) {
+    tier_index.erase(tier_slots[slot]);
+    tier_slots[slot] = INVALID_PAGE_ID;
+  }
+
+  off_t offset = static_cast<off_t>(slot) * PAGE_SIZE;
+  if (pwrite(tier_fd, frame.page.getData(), PAGE_SIZE, offset) !=
+      PAGE_SIZE) {
+    std::cerr << "Failed to write page " << page_id << " to second tier\n";
+    return;
+  }
+  tier_slots[slot] = page_id;
+  tier_index[page_id] = slot;
+  stats.tier_writes++;
+}
+
+void BufferPoolManager::dropFromTier(page_id_t page_id) {
+  auto entry = tier_index.find(page_id);
+  if (entry != tier_index.end()) {
+    tier_slots[entry->second] = INVALID_PAGE_ID;
+    tier_referenced[entry->second] = 0;
+    tier_index.erase(entry);
+  }
+}
+
+bool BufferPoolManager::readFromTier(page_id_t page_id, Page *page) {
+  auto entry = tier_index.find(page_id);
+  if (entry == tier_index.end()) {
+    return false;
+  }
+  off_t offset = static_cast<off_t>(entry->second) * PAGE_SIZE;
+  if (pread(tier_fd, page->getData(), PAGE_SIZE, offset) != PAGE_SIZE) {
+    dropFromTier(page_id); // fall back to the DB file
+    return false;
+  }
+  tier_referenced[entry->second] = 1;
+  stats.tier_hits++;
+  page->setPageId(page_id);
+  return true;
+}
+
+bool BufferPoolManager::beginSnapshot(const std::string &path) {
+  std::lock_guard<std::mutex> guard(latch);
+  return beginSnapshotLocked(path);
+}
+
+bool BufferPoolManager::beginSnapshotLocked(const std::string &path) {
+  std::lock_guard<std::mutex> snapshot_guard(snapshot_mutex);
+  if (snapshot_fd >= 0) {
+    std::cerr << "A snapshot is already active\n";
+    return false;
+  }
+  int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    std::cerr << "Could not open snapshot area " << path << "\n";
+    return false;
+  }
+
+  // the snapshot is the DB files once the pool's changes are on disk
+  flushAllPages();
+  snapshot_pages.clear();
+  snapshot_fds.clear();
+  for (const DbFile &file : files) {
+    bool included = file.fd >= 0 && !file.temporary;
+    snapshot_pages.push_back(included ? file.num_pages : 0);
+    snapshot_fds.push_back(file.fd);
+  }
+  snapshot_index.clear();
+  snapshot_path = path;
+  snapshot_fd = fd;
+  return true;
+}
+
+bool BufferPoolManager::endSnapshot() {
+  std::lock_guard<std::mutex> guard(latch);
+  std::lock_guard<std::mutex> snapshot_guard(snapshot_mutex);
+  if (snapshot_fd < 0) {
+    return false;
+  }
+  close(snapshot_fd);
+  unlink(snapshot_path.c_str());
+  snapshot_fd = -1;
+  snapshot_pages.clear();
+  snapshot_fds.clear();
+  snapshot_index.clear();
+  return true;
+}
+
+void BufferPoolManager::preserveForSnapshot(page_id_t first,
+                                            std::size_t count) {
+  if (snapshot_fd < 0) {
+    return;
+  }
+  file_id_t file_id = fileOf(first);
+  std::lock_guard<std::mutex> snapshot_guard(snapshot_mutex);
+  char image[PAGE_SIZE];
+  for (std::size_t i = 0; i < count; i++) {
+    page_id_t page_id = static_cast<page_id_t>(first + i);
+    if (file_id >= snapshot_pages.size() ||
+        pageNumberOf(page_id) >= snapshot_pages[file_id] ||
+        snapshot_index.count(page_id) > 0) {
+      continue; // not in the snapshot, or preserved already
+    }
+    off_t offset = static_cast<off_t>(pageNumberOf(page_id)) * PAGE_SIZE;
+    ssize_t read = pread(files[file_id].fd, image, PAGE_SIZE, offset);
+    std::size_t valid = read > 0 ? static_cast<std::size_t>(read) : 0;
+    std::memset(image + valid, 0, PAGE_SIZE - valid);
+    uint32_t slot = static_cast<uint32_t>(snapshot_index.size());
+    if (pwrite(snapshot_fd, image, PAGE_SIZE,
+               static_cast<off_t>(slot) * PAGE_SIZE) != PAGE_SIZE) {
+      std::cerr << "Failed to preserve page " << page_id
+                << " for the snapshot\n";
+      continue;
+    }
+    snapshot_index[page_id] = slot;
+    stats.snapshot_copies++;
+  }
+}
+
+bool BufferPoolManager::readSnapshotPage(page_id_t page_id, char *data) {
+  std::lock_guard<std::mutex> snapshot_guard(snapshot_mutex);
+  file_id_t file_id = fileOf(page_id);
+  if (snapshot_fd < 0 || file_id >= snapshot_pages.size() ||
+      pageNumberOf(page_id) >= snapshot_pages[file_id]) {
+    return false;
+  }
+  // no write can preserve (and then overwrite) the page meanwhile
+  auto entry = snapshot_index.find(page_id);
+  int fd = entry != snapshot_index.end() ? snapshot_fd : snapshot_fds[file_id];
+  std::size_t page_number = entry != snapshot_index.end()
+                                ? entry->second
+                                : pageNumberOf(page_id);
+  ssize_t read = pread(fd, data, PAGE_SIZE,
+                       static_cast<off_t>(page_number) * PAGE_SIZE);
+  std::size_t valid = read > 0 ? static_cast<std::size_t>(read) : 0;
+  std::memset(data + valid, 0, PAGE_SIZE - valid);
+  return true;
+}
+
+std::size_t BufferPoolManager::getSnapshotPages(file_id_t file_id) {
+  std::lock_guard<std::mutex> snapshot_guard(snapshot_mutex);
+  return file_id < snapshot_pages.size() ? snapshot_pages[file_id] : 0;
+}
+
+bool BufferPoolManager::backupSnapshot(file_id_t file_id,
+                                       const std::string &dest) {
+  std::size_t pages = getSnapshotPages(file_id);
+  std::ofstream out(dest, std::ios::binary | std::ios::trunc);
+  if (pages == 0 || !out) {
+    std::cerr << "Cannot back up file " << static_cast<int>(file_id)
+              << " to " << dest << "\n";
+    return false;
+  }
+  char data[PAGE_SIZE];
+  for (std::size_t i = 0; i < pages; i++) {
+    if (!readSnapshotPage(makePageId(file_id, static_cast<uint32_t>(i)),
+                          data)) {
+      std::cerr << "Snapshot ended during the backup to " << dest << "\n";
+      return false;
+    }
+    out.write(data, PAGE_SIZE);
+  }
+  out.close();
+  return static_cast<bool>(out);
+}
+
+namespace {
+// backup file layout: a header, then count {page number, page} entries
+struct BackupHeader {
+  uint32_t magic;
+  uint32_t full;       // 1 for a full backup, 0 for a delta
+  uint32_t file_pages; // pages of the file when the backup was taken
+  uint32_t count;      // page entries that follow
+};
+constexpr uint32_t kBackupMagic = 0x53524442; // "SRDB"
+} // namespace
+
+void BufferPoolManager::markChanged(page_id_t first, std::size_t count) {
+  DbFile &file = files[fileOf(first)];
+  if (!file.tracking) {
+    return;
+  }
+  std::size_t last = pageNumberOf(first) + count - 1;
+  if (last / 64 >= file.changed.size()) {
+    file.changed.resize(last / 64 + 1);
+  }
+  for (std::size_t page = pageNumberOf(first); page <= last; page++) {
+    file.changed[page / 64] |= uint64_t(1) << (page % 64);
+  }
+}
+
+std::size_t BufferPoolManager::getChangedPages(file_id_t file_id) const {
+  std::lock_guard<std::mutex> guard(latch);
+  std::size_t changed = 0;
+  if (file_id < files.size()) {
+    for (uint64_t word : files[file_id].changed) {
+      changed += static_cast<std::size_t>(__builtin_popcountll(word));
+    }
+  }
+  return changed;
+}
+
+bool BufferPoolManager::backupFull(file_id_t file_id,
+                                   const std::string &dest) {
+  return backup(file_id, dest, true);
+}
+
+bool BufferPoolManager::backupIncremental(file_id_t file_id,
+                                          const std::string &dest) {
+  return backup(file_id, dest, false);
+}
+
+bool BufferPoolManager::backup(file_id_t file_id, const std::string &dest,
+                               bool full) {
+  std::vector<uint64_t> changed;
+  uint32_t file_pages;
+  {
+    std::lock_guard<std::mutex> guard(latch);
+    if (file_id >= files.size() || files[file_id].fd < 0 ||
+        files[file_id].temporary) {
+      std::cerr << "Cannot back up file " << static_cast<int>(file_id)
+                << "\n";
+      return false;
+    }
+    if (!full && !files[file_id].tracking) {
+      std::cerr << "No full backup of " << files[file_id].path
+                << " to base an incremental one on\n";
+      return false;
+    }
+    // the snapshot flushes the pool, so every change is on disk and
+    // marked; the bitmap is taken in the same latch section
+    if (!beginSnapshotLocked(dest + ".area")) {
+      return false;
+    }
+    changed.swap(files[file_id].changed);
+    files[file_id].tracking = true;
+    file_pages = snapshot_pages[file_id];
+  }
+
+  std::vector<uint32_t> pages;
+  for (uint32_t page = 0; page < file_pages; page++) {
+    bool marked = page / 64 < changed.size() &&
+                  ((changed[page / 64] >> (page % 64)) & 1) != 0;
+    if (full || marked) {
+      pages.push_back(page);
+    }
+  }
+  std::ofstream out(dest, std::ios::binary | std::ios::trunc);
+  BackupHeader header{kBackupMagic, full ? 1u : 0u, file_pages,
+                      static_cast<uint32_t>(pages.size())};
+  out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  char data[PAGE_SIZE];
+  bool ok = static_cast<bool>(out);
+  for (std::size_t i = 0; ok && i < pages.size(); i++) {
+    ok = readSnapshotPage(makePageId(file_id, pages[i]), data);
+    out.write(reinterpret_cast<const char *>(&pages[i]), sizeof(uint32_t));
+    out.write(data, PAGE_SIZE);
+  }
+  out.close();
+  ok = ok && static_cast<bool>(out);
+
+  if (!ok) {
+    // the changes go into the next backup instead
+    std::cerr << "Failed to write backup " << dest << "\n";
+    std::lock_guard<std::mutex> guard(latch);
+    std::vector<uint64_t> &current = files[file_id].changed;
+    current.resize(std::max(current.size(), changed.size()));
+    for (std::size_t i = 0; i < changed.size(); i++) {
+      current[i] |= changed[i];
+    }
+  }
+  endSnapshot();
+  return ok;
+}
+
+bool BufferPoolManager::restoreBackup(const std::vector<std::string> &backups,
+                                      const std::string &dest) {
+  int fd = open(dest.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    std::cerr << "Could not create " << dest << "\n";
+    return false;
+  }
+  bool ok = !backups.empty();
+  char data[PAGE_SIZE];
+  for (std::size_t b = 0; ok && b < backups.size(); b++) {
+    std::ifstream in(backups[b], std::ios::binary);
+    BackupHeader header;
+    if (!in.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+        header.magic != kBackupMagic || (b == 0) != (header.full == 1)) {
+      std::cerr << "Backup " << backups[b] << " is not "
+                << (b == 0 ? "a full" : "an incremental") << " backup\n";
+      ok = false;
+      break;
+    }
+    // the file had file_pages pages at the time of this backup
+    ok = ftruncate(fd, static_cast<off_t>(header.file_pages) * PAGE_SIZE) ==
+         0;
+    for (uint32_t i = 0; ok && i < header.count; i++) {
+      uint32_t page;
+      ok = in.read(reinterpret_cast<char *>(&page), sizeof(page)) &&
+           in.read(data, PAGE_SIZE) &&
+           pwrite(fd, data, PAGE_SIZE, static_cast<off_t>(page) * PAGE_SIZE) ==
+               PAGE_SIZE;
+    }
+    if (!ok) {
+      std::cerr << "Could not apply backup " << backups[b] << "\n";
+    }
+  }
+  close(fd);
+  return ok;
+}
+
+bool BufferPoolManager::appendLog(PageLogType type, page_id_t page_id,
+                                  const char *data) {
+  if (log_fd < 0) {
+    return false;
+  }
+  PageLogHeader header;
+  header.lsn = last_lsn + 1;
+  header.timestamp_us = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::system_clock::now().time_since_epoch())
+          .count());
+  header.page_id = page_id;
+  header.type = type;
+
+  // one write per record: a follower sees it whole or not at all
+  iovec iov[2] = {{&header, sizeof(header)},
+                  {const_cast<char *>(data),
+                   data != nullptr ? static_cast<std::size_t>(PAGE_SIZE) : 0}};
+  ssize_t length = static_cast<ssize_t>(iov[0].iov_len + iov[1].iov_len);
+  if (writev(log_fd, iov, 2) != length) {
+    std::cerr << "Failed to append to the page log\n";
+    return false;
+  }
+  last_lsn = header.lsn;
+  stats.log_records++;
+  return true;
+}
+
+bool BufferPoolManager::enableLogShipping(const std::string &path) {
+  std::lock_guard<std::mutex> guard(latch);
+  if (log_fd >= 0) {
+    std::cerr << "Log shipping is already enabled\n";
+    return false;
+  }
+  int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_APPEND, 0644);
+  if (fd < 0) {
+    std::cerr << "Could not open page log " << path << "\n";
+    return false;
+  }
+
+  // the base image: every page of the primary file as of now
+  flushAllPages();
+  log_fd = fd;
+  char data[PAGE_SIZE];
+  const DbFile &file = files[PRIMARY_FILE_ID];
+  for (uint32_t page = 0; page < file.num_pages; page++) {
+    ssize_t read = pread(file.fd, data, PAGE_SIZE,
+                         static_cast<off_t>(page) * PAGE_SIZE);
+    std::size_t valid = read > 0 ? static_cast<std::size_t>(read) : 0;
+    std::memset(data + valid, 0, PAGE_SIZE - valid);
+    if (!appendLog(PageLogType::PAGE, makePageId(PRIMARY_FILE_ID, page),
+                   data)) {
+      return false;
+    }
+  }
+  return appendLog(PageLogType::SYNC, INVALID_PAGE_ID, nullptr);
+}
+
+uint64_t BufferPoolManager::logSyncPoint() {
+  std::lock_guard<std::mutex> guard(latch);
+  if (log_fd < 0) {
+    std::cerr << "Log shipping is not enabled\n";
+    return 0;
+  }
+  flushAllPages();
+  return appendLog(PageLogType::SYNC, INVALID_PAGE_ID, nullptr) ? last_lsn
+                                                                 : 0;
+}
+
+bool BufferPoolManager::applyPageImage(page_id_t page_id, const char *data) {
+  std::lock_guard<std::mutex> guard(latch);
+  Page *page = fetchPageLocked(page_id);
+  if (page == nullptr) {
+    return false;
+  }
+  std::memcpy(page->getData(), data, PAGE_SIZE);
+  Frame &frame = frameOf(page);
+  frame.is_dirty = true;
+  unpin(frame);
+  DbFile &file = files[fileOf(page_id)];
+  file.num_pages = std::max(file.num_pages, pageNumberOf(page_id) + 1);
+  return true;
+}
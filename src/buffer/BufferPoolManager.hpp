@@ -1,8 +1,12 @@
 /* Buffer Pool Manager requirements
 1. Buffer Pool Manager has list of frames
 2. Each frame has a page associated with it and its meta data
-3. Buffer Pool Manager has only 1 DB file for now
-4. Each DB file has multiple pages
+3. Buffer Pool Manager keeps a registry of DB files: the primary file given
+to the constructor plus files added with addFile (e.g. temp spill data on a
+separate disk, or one file per table so dropping it deletes the file). Spill
+pages default to a temporary file of their own, created on first use
+4. Each DB file has multiple pages; a page id carries its file id, so one
+page table and one replacer serve every file
 5. Concurrency should be supported on the Buffer-Pool Manager (multiple should
 be able to access the pool)
 6. Ownership should be only movable as, concurrency should be supported
@@ -11,96 +15,330 @@ later based on access pattern]
 8. When Page is not present in the pool, has to be pulled from Disk and loaded
 in memory
 9. Modified Pages to be written back to disk
+10. Optional pointer swizzling: a child reference followed with fetchChild
+is cached in the parent's frame as a direct frame pointer, so later
+traversals pin the child with one atomic operation instead of a page table
+lookup under the latch. Evicting a page unswizzles every reference to it
+11. Named partitions isolate workloads (tenants, tables, batch jobs): every
+DB file belongs to a partition, and a partition has a minimum of reserved
+frames other partitions cannot take and a maximum it never exceeds, so a
+scan capped in its own partition replaces its own pages only
+12. Priority hints: a pinned page can be marked LOW / NORMAL / HIGH; the
+replacer evicts lower priorities first, LRU order within one priority
+13. resize grows or shrinks the pool while it is in use. Frames live in
+fixed chunks mapped from the OS, so growing never moves a frame; shrinking
+moves the pages of removed frames into free frames (or evicts them) a batch
+at a time, and unmaps every chunk that ends up unused
+14. NUMA placement: with configureNuma, frame chunks are spread over the
+nodes and their memory is bound to them (mbind); free frames are kept per
+node and a thread takes frames of its own node first. A simulated mode
+assigns nodes without binding, for machines with a single node
+15. Warm restart: the ids of the resident pages can be dumped (once or
+periodically) hottest first, and preloaded after a restart in sorted order
+with large reads spanning nearby pages, in the background while the pool serves
+traffic. Preloading only fills free frames and never evicts; a page written
+back while its read was in flight is skipped, the rest of the read is kept
+16. fetchPages pins a batch of pages at once: hits are resolved in one pass,
+frames for all misses are taken together and the misses are read as one
+batch of parallel reads (I/O threads), adjacent pages coalesced into one
+vectored read
+17. Optional second tier: a cache file on a fast local disk receives pages
+evicted from memory (clean copies, after any write-back) that pass its
+admission policy, and misses are read from it before the DB file. Its own
+index maps page ids to slots, replaced in CLOCK order; every write of a
+page to its DB file drops the page's copy, so the tier never holds a
+newer or older version than the file
+18. Copy-on-write snapshots: beginSnapshot flushes the dirty pages and
+freezes the DB files' contents as of that moment. While it is active, the
+first write of a snapshot page to its file preserves the old image in a
+snapshot area file, so a backup reader (readSnapshotPage / backupSnapshot)
+sees the point-in-time image while writers go on
+19. Incremental backups: once a DB file has had a full backup, every page
+written to it is marked in a change-tracking bitmap; an incremental backup
+copies only the marked pages (from a snapshot) into a compact delta file
+and starts a new bitmap. restoreBackup rebuilds the file from a full
+backup and the deltas taken after it
+20. Log shipping: with enableLogShipping, every page of the primary DB file
+written to disk is also appended to a page log (a shared file), after a
+base image of the whole file; logSyncPoint flushes the pool and appends a
+sync record. A LogFollower in another process tails the log and replays
+the images into its own pool
 */
 #pragma once
 #include "../storage/Page.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstddef>
 #include <cstdint>
-#include <fstream>
 #include <iosfwd>
 #include <iostream>
 #include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
-using frame_id_t = uint16_t;
+using frame_id_t = uint32_t;
 constexpr frame_id_t INVALID_FRAME_ID = static_cast<frame_id_t>(-1);
 
+using partition_id_t = uint8_t;
+constexpr partition_id_t DEFAULT_PARTITION_ID = 0;
+constexpr partition_id_t INVALID_PARTITION_ID =
+    static_cast<partition_id_t>(-1);
+
+// replacement priority of a resident page, reset to NORMAL when loaded
+enum class PagePriority : uint8_t { LOW, NORMAL, HIGH };
+
+// pages the second tier admits on eviction: every page, or only pages
+// that were hit again after being loaded (keeps scans out)
+enum class TierAdmission : uint8_t { ALL, REUSED };
+
+// page log record: a header, followed by the page image for PAGE records
+enum class PageLogType : uint32_t { PAGE = 1, SYNC = 2 };
+
+struct PageLogHeader {
+  uint64_t lsn;
+  uint64_t timestamp_us; // system clock of the primary when appended
+  page_id_t page_id;     // PAGE records
+  PageLogType type;
+};
+
+// I/O counters, updated under the pool latch
+struct BufferPoolStats {
+  std::size_t hits = 0;        // fetchPage found the page resident
+  std::size_t misses = 0;      // fetchPage had to load the page
+  std::size_t disk_reads = 0;  // reads from DB files
+  std::size_t disk_writes = 0;
+  std::size_t tier_hits = 0;   // misses read from the second tier
+  std::size_t tier_writes = 0; // evicted pages admitted to the tier
+  std::size_t snapshot_copies = 0; // old images preserved for a snapshot
+  std::size_t log_records = 0;     // appended to the page log
+  std::size_t evictions = 0;
+  std::size_t swizzled_hits = 0; // fetchChild followed a frame pointer
+  std::size_t migrations = 0; // pages moved out of frames removed by resize
+  // with NUMA configured: fetches / new pages served by a frame on the
+  // calling thread's node or on another node (swizzled hits not counted)
+  std::size_t local_accesses = 0;
+  std::size_t remote_accesses = 0;
+  std::size_t preloaded = 0; // pages loaded by preloadHotSet
+};
+
+// per partition, updated under the pool latch
+struct PartitionStats {
+  std::size_t hits = 0;
+  std::size_t misses = 0;
+  std::size_t evictions = 0; // pages of this partition replaced
+  std::size_t resident_frames = 0;
+};
+
 class BufferPoolManager {
 
 private:
+  // pin_count is kNotResident while a frame is free or being evicted, so a
+  // swizzled pointer can only pin a frame that holds a page
+  static constexpr int kNotResident = -1;
+  // child references cached per parent frame (a B+ tree node has fewer)
+  static constexpr std::size_t kMaxSwips = 512;
+
   struct Frame {
-    uint16_t page_id = INVALID_PAGE_ID;
+    std::atomic<page_id_t> page_id{INVALID_PAGE_ID};
     Page page;
-    int pin_count;
-    bool is_dirty;
+    std::atomic<int> pin_count{kNotResident};
+    std::atomic<bool> is_dirty{false};
+    // set by swizzled accesses, which bypass the LRU list: gives the frame
+    // a second chance before eviction
+    std::atomic<bool> referenced{false};
+    std::atomic<PagePriority> priority{PagePriority::NORMAL};
+    partition_id_t partition = DEFAULT_PARTITION_ID; // under the latch
+    bool reused = false; // hit since loaded (under the latch)
+
+    // swizzled child references of this page, indexed by child slot;
+    // allocated on first use and kept for the life of the pool
+    std::unique_ptr<std::atomic<Frame *>[]> swip_storage;
+    std::atomic<std::atomic<Frame *> *> swips{nullptr};
+    // swip slots of other frames that point at this one
+    std::vector<std::atomic<Frame *> *> swizzled_by;
   };
 
-  std::size_t pool_size;                                // frames size
+  // frames per chunk of memory mapped (and unmapped) as a whole
+  static constexpr std::size_t kFramesPerChunk = 256;
+  // frames vacated per latch acquisition while shrinking
+  static constexpr std::size_t kResizeBatch = 64;
+  // most pages (wanted ones and the gaps between) preloaded with one read
+  static constexpr std::size_t kPreloadRun = 32;
+
+  std::size_t pool_size; // usable frames: ids below it; the rest retire
   std::unordered_map<page_id_t, frame_id_t> page_table; // page table
-  std::vector<Frame> frames; // Fixed size Frames table
-  std::list<frame_id_t> free_frames;
+  std::vector<Frame *> chunks; // never moved, so Page pointers stay valid
+  std::vector<int> chunk_nodes; // NUMA node of each chunk
+  std::size_t numa_nodes = 1;
+  bool numa_configured = false;
+  bool numa_simulated = false;
+  std::size_t num_frames = 0;  // constructed frames, >= pool_size
+  std::ptrdiff_t page_offset = 0; // of Frame::page inside a Frame
+  std::vector<std::list<frame_id_t>> free_frames; // one list per node
+  std::size_t num_free = 0;
   std::list<frame_id_t> lru_list; // maintains access pattern
   std::unordered_map<frame_id_t, std::list<frame_id_t>::iterator>
       lru_iterator; // keeps track of the iterator of lru_list
-  std::fstream db_file;
-  std::string db_file_name;
 
-  //@ not default constructable and only movable
-  BufferPoolManager() = default;
-  BufferPoolManager(const BufferPoolManager &) = delete;
-  BufferPoolManager &operator=(const BufferPoolManager &) = delete;
+  // one open DB file; slots of dropped files keep fd -1 so their ids are
+  // never handed out again
+  struct DbFile {
+    std::string path;
+    int fd = -1;
+    uint32_t num_pages = 0; // next page number handed out
+    bool temporary = false; // deleted when dropped or on shutdown
+    partition_id_t partition = DEFAULT_PARTITION_ID;
+    // pages written since the last backup, once a full backup started
+    // the tracking
+    bool tracking = false;
+    std::vector<uint64_t> changed;
+  };
+  std::vector<DbFile> files; // indexed by file_id_t
 
-  bool readPageFromDisk(page_id_t page_id, Page *page) {
+  // marks count pages from first in their file's change bitmap
+  void markChanged(page_id_t first, std::size_t count);
 
-    if (!db_file.is_open()) {
-      std::cerr << "Database file not open\n";
-      return false;
-    }
+  // writes the pages of file_id (all, or those changed since the last
+  // backup) as of a snapshot into a backup file at dest
+  bool backup(file_id_t file_id, const std::string &dest, bool full);
 
-    // Page might be present in file or may not be
-    // seek to the position where the page exists
-    std::streampos offset = static_cast<std::streampos>(page_id) * PAGE_SIZE;
-    db_file.seekg(offset);
+  struct Partition {
+    std::string name;
+    std::size_t min_frames;
+    std::size_t max_frames;
+    std::size_t resident = 0;
+    PartitionStats stats{};
+  };
+  std::vector<Partition> partitions; // indexed by partition_id_t
+  // INVALID_FILE_ID until the first spill creates the default temp file
+  file_id_t spill_file = INVALID_FILE_ID;
 
-    if (db_file.fail()) {
-      // not present in file
-      page->resetMemory();
-      page->setPageId(page_id);
-      return true;
-    }
+  // pages written while a preload read is in flight ({first, count}
+  // ranges): only those pages of the read are stale and skipped
+  bool preload_reading = false;
+  std::vector<std::pair<page_id_t, std::size_t>> preload_writes;
 
-    db_file.read(page->getData(), PAGE_SIZE);
-    if (db_file.gcount() != PAGE_SIZE) {
-      page->resetMemory();
+  // records a write of count pages from first for the running preload read
+  void notePreloadWrite(page_id_t first, std::size_t count) {
+    if (preload_reading) {
+      preload_writes.emplace_back(first, count);
     }
-
-    page->setPageId(page_id);
-    db_file.clear();
-    return true;
   }
+  bool writtenDuringPreload(page_id_t page_id) const;
 
-  bool writePageToDisk(page_id_t page_id, Page *page) {
+  // warm restart threads and the flag that stops them
+  std::thread dump_thread;
+  std::thread preload_thread;
+  std::mutex warm_mutex;
+  std::condition_variable warm_cv;
+  bool warm_stop = false;
 
-    if (!db_file.is_open()) {
-      std::cerr << "Database file not open\n";
-      return false;
-    }
-    // Page might be present in file or may not be
-    // seek to the position where the page exists
-    std::streampos offset = static_cast<std::streampos>(page_id) * PAGE_SIZE;
-    db_file.seekp(offset);
+  void preload(std::vector<page_id_t> page_ids);
 
-    db_file.write(page->getData(), PAGE_SIZE);
-    db_file.flush();
+  // installs page_ids (count of them) into free frames from data, which
+  // holds the pages read from first on; false once the pool is full
+  bool installPreloaded(page_id_t first, const page_id_t *page_ids,
+                        std::size_t count, const char *data);
 
-    if (db_file.bad()) {
-      std::cerr << "Failed to write page " << page_id << " to disk\n";
-      return false;
-    }
+  // one read of count consecutive pages into the frames buffers[first..]
+  struct ReadRun {
+    int fd;
+    off_t offset;
+    std::size_t first;
+    std::size_t count;
+    ssize_t result = 0;
+  };
 
-    return true;
-  }
+  struct ReadBatch {
+    std::vector<ReadRun> runs;
+    std::vector<char *> buffers;
+    std::atomic<std::size_t> next{0}; // next run to claim
+  };
+
+  // I/O threads that share the runs of a batch with the caller; started
+  // by the first batch with more than one run
+  static constexpr std::size_t kIoThreads = 3;
+  std::vector<std::thread> io_threads;
+  std::mutex io_mutex;
+  std::condition_variable io_cv;
+  std::condition_variable io_done_cv;
+  ReadBatch *io_batch = nullptr;
+  std::size_t io_generation = 0;
+  std::size_t io_active = 0; // I/O threads working on io_batch
+  bool io_stop = false;
+
+  void ioWorker();
+
+  // claims and performs runs until none is left
+  static void runReads(ReadBatch &batch);
+
+  // performs every run of batch, in parallel if there are several
+  void readBatch(ReadBatch &batch);
+
+  // second tier cache file (enableSecondTier), -1 when off
+  int tier_fd = -1;
+  std::string tier_path;
+  TierAdmission tier_admission = TierAdmission::REUSED;
+  std::vector<page_id_t> tier_slots; // page cached in each slot
+  std::vector<uint8_t> tier_referenced; // CLOCK bits
+  std::unordered_map<page_id_t, uint32_t> tier_index;
+  std::size_t tier_hand = 0;
+
+  // copies the page of an evicted frame to the tier if admitted
+  void admitToTier(const Frame &frame);
+
+  void dropFromTier(page_id_t page_id);
+
+  // reads page_id from the tier; false if it holds no copy
+  bool readFromTier(page_id_t page_id, Page *page);
+
+  // active snapshot: pages of each file at its start and, for every page
+  // overwritten since, the slot of its old image in the area file.
+  // Writers change it under the latch, then snapshot_mutex; readers take
+  // only snapshot_mutex, which a write holds while preserving the image.
+  std::mutex snapshot_mutex;
+  int snapshot_fd = -1;
+  std::string snapshot_path;
+  std::vector<uint32_t> snapshot_pages; // per file, 0 for temporary ones
+  std::vector<int> snapshot_fds; // per file, read without the latch
+  std::unordered_map<page_id_t, uint32_t> snapshot_index;
+
+  // page log (enableLogShipping), -1 when off
+  int log_fd = -1;
+  uint64_t last_lsn = 0;
+
+  // appends a record to the page log (under the latch)
+  bool appendLog(PageLogType type, page_id_t page_id, const char *data);
+
+  // beginSnapshot with the latch held
+  bool beginSnapshotLocked(const std::string &path);
+
+  // saves the on-disk image of count pages from first before they are
+  // overwritten (under the latch)
+  void preserveForSnapshot(page_id_t first, std::size_t count);
+
+  //@ not default constructable and only movable
+  BufferPoolManager() = default;
+  BufferPoolManager(const BufferPoolManager &) = delete;
+  BufferPoolManager &operator=(const BufferPoolManager &) = delete;
+
+  // open file of page_id, nullptr (with a message) if there is none
+  DbFile *fileFor(page_id_t page_id);
+
+  bool readPageFromDisk(page_id_t page_id, Page *page);
+
+  bool writePageToDisk(page_id_t page_id, Page *page);
+
+  // opens (creating if needed) path; fd -1 on failure
+  static DbFile openFile(const std::string &path, bool temporary);
+  // creates the default spill file, a temporary file next to the primary
+  // one; the primary file if that fails
+  file_id_t openSpillFile();
 
   void updateLRU(frame_id_t frame_id) {
     if (lru_iterator.count(frame_id) > 0) {
@@ -120,56 +358,442 @@ private:
     }
   }
 
-  bool evictPage() {
+  partition_id_t partitionOf(page_id_t page_id) const {
+    file_id_t file_id = fileOf(page_id);
+    return file_id < files.size() ? files[file_id].partition
+                                  : DEFAULT_PARTITION_ID;
+  }
+
+  // frames still reserved for partitions other than partition_id
+  std::size_t reservedForOthers(partition_id_t partition_id) const {
+    std::size_t reserved = 0;
+    for (std::size_t i = 0; i < partitions.size(); i++) {
+      if (i != partition_id &&
+          partitions[i].resident < partitions[i].min_frames) {
+        reserved += partitions[i].min_frames - partitions[i].resident;
+      }
+    }
+    return reserved;
+  }
+
+  // replaces one unpinned page to make room for partition_id: lowest
+  // priority first, LRU order within a priority, never below another
+  // partition's minimum, and only its own pages once it is at its maximum
+  bool evictPage(partition_id_t partition_id) {
+    const Partition &requester = partitions[partition_id];
+    bool own_only = requester.resident >= requester.max_frames;
+    auto eligible = [&](const Frame &frame) {
+      const Partition &owner = partitions[frame.partition];
+      return frame.partition == partition_id ||
+             (!own_only && owner.resident > owner.min_frames);
+    };
+
     frame_id_t evictFrameId = INVALID_FRAME_ID;
-    for (auto frameId = lru_list.begin(); frameId != lru_list.end();
-         frameId++) {
-      Frame &frame = frames[*frameId];
-      if (frame.pin_count == 0) {
-        if (frame.is_dirty) {
-          writePageToDisk(frame.page_id, &frame.page);
+    // one pass per priority honoring the referenced bits (cleared as they
+    // are seen), then a last pass over every priority ignoring them
+    for (int pass = 0; pass < 4 && evictFrameId == INVALID_FRAME_ID;
+         pass++) {
+      for (auto frameId = lru_list.begin(); frameId != lru_list.end();
+           frameId++) {
+        Frame &frame = frameAt(*frameId);
+        if (!eligible(frame)) {
+          continue;
+        }
+        if (pass < 3) {
+          if (static_cast<int>(frame.priority.load()) != pass ||
+              frame.referenced.exchange(false)) {
+            continue;
+          }
+        }
+        int unpinned = 0;
+        if (frame.pin_count.compare_exchange_strong(unpinned, kNotResident)) {
+          if (frame.is_dirty) {
+            writePageToDisk(frame.page_id, &frame.page);
+          }
+          admitToTier(frame);
+          unswizzle(frame);
+          evictFrameId = *frameId;
+          break;
         }
-        evictFrameId = *frameId;
-        break;
       }
     }
 
     if (evictFrameId != INVALID_FRAME_ID) {
       // evict
+      Frame &frame = frameAt(evictFrameId);
       removeFromLRU(evictFrameId);
-      page_table.erase(frames[evictFrameId].page_id);
-      free_frames.push_back(evictFrameId);
-      frames[evictFrameId].page_id = INVALID_PAGE_ID;
+      page_table.erase(frame.page_id);
+      freeFrame(evictFrameId);
+      frame.page_id = INVALID_PAGE_ID;
+      releaseFrame(frame);
+      partitions[frame.partition].stats.evictions++;
+      stats.evictions++;
       return true;
     }
 
     return false;
   }
 
+  // a free frame for a page of partition_id, evicting as needed;
+  // INVALID_FRAME_ID if every candidate is pinned
+  frame_id_t acquireFrame(partition_id_t partition_id) {
+    const Partition &requester = partitions[partition_id];
+    if (requester.resident >= requester.max_frames) {
+      if (!evictPage(partition_id)) {
+        return INVALID_FRAME_ID;
+      }
+    }
+    while (num_free <= reservedForOthers(partition_id)) {
+      if (!evictPage(partition_id)) {
+        return INVALID_FRAME_ID;
+      }
+    }
+    return popFree(currentNode());
+  }
+
+  // accounts frame (already filled) to partition_id
+  void assignFrame(Frame &frame, partition_id_t partition_id) {
+    frame.partition = partition_id;
+    frame.priority.store(PagePriority::NORMAL, std::memory_order_relaxed);
+    frame.reused = false;
+    partitions[partition_id].resident++;
+  }
+
+  void releaseFrame(Frame &frame) { partitions[frame.partition].resident--; }
+
+  // frames removed by a shrink are not reused
+  void freeFrame(frame_id_t frame_id) {
+    if (frame_id < pool_size) {
+      free_frames[nodeOf(frame_id)].push_back(frame_id);
+      num_free++;
+    }
+  }
+
+  // a free frame, from node if it has one; num_free must be > 0
+  frame_id_t popFree(int node) {
+    std::list<frame_id_t> *list = &free_frames[node];
+    for (std::size_t i = 0; list->empty(); i++) {
+      list = &free_frames[i];
+    }
+    frame_id_t frame_id = list->front();
+    list->pop_front();
+    num_free--;
+    return frame_id;
+  }
+
+  int nodeOf(frame_id_t frame_id) const {
+    return chunk_nodes[frame_id / kFramesPerChunk];
+  }
+
+  void countAccess(frame_id_t frame_id) {
+    if (numa_configured) {
+      (nodeOf(frame_id) == currentNode() ? stats.local_accesses
+                                         : stats.remote_accesses)++;
+    }
+  }
+
+  // NUMA node of the calling thread, bounded by the configured nodes
+  int currentNode() const;
+
+  // binds the memory of chunk to node (real NUMA only)
+  bool bindChunk(std::size_t chunk, int node);
+
+  Frame &frameAt(frame_id_t frame_id) {
+    return chunks[frame_id / kFramesPerChunk][frame_id % kFramesPerChunk];
+  }
+
+  // maps and constructs / destroys and unmaps the last chunk of frames
+  bool addChunk();
+  void removeChunk();
+
+  // empties retiring frame_id: its page moves to a free frame, or is
+  // evicted when there is none. False while the page is pinned.
+  bool vacateFrame(frame_id_t frame_id);
+
+  std::mutex resize_mutex; // one resize at a time
+
+  // fetchChild fast paths in flight, spread over cache lines by thread;
+  // a shrink waits for them before unmapping frames
+  struct alignas(64) ReaderSlot {
+    std::atomic<int> count{0};
+  };
+  static constexpr std::size_t kReaderSlots = 16;
+  ReaderSlot swizzled_readers[kReaderSlots];
+
+  static std::size_t readerSlot() {
+    static std::atomic<std::size_t> next_slot{0};
+    thread_local std::size_t slot = next_slot++ % kReaderSlots;
+    return slot;
+  }
+
+  // on shutdown; temporary files are deleted, their pages are not written
   void flushAllPages() {
-    for (auto &frame : frames) {
-      if (frame.page_id != INVALID_PAGE_ID && frame.is_dirty) {
+    for (std::size_t i = 0; i < num_frames; i++) {
+      Frame &frame = frameAt(static_cast<frame_id_t>(i));
+      if (frame.page_id != INVALID_PAGE_ID && frame.is_dirty &&
+          !files[fileOf(frame.page_id)].temporary) {
         writePageToDisk(frame.page_id, &frame.page);
         frame.is_dirty = false;
       }
     }
   }
-  static page_id_t pageIdCounter;
+  Frame &frameOf(Page *page) {
+    return *reinterpret_cast<Frame *>(reinterpret_cast<char *>(page) -
+                                      page_offset);
+  }
+
+  // decrements a positive pin count; safe without the latch
+  static bool unpin(Frame &frame) {
+    int pins = frame.pin_count.load(std::memory_order_relaxed);
+    while (pins > 0) {
+      if (frame.pin_count.compare_exchange_weak(pins, pins - 1,
+                                                std::memory_order_release)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // pins frame if it still holds page_id; safe without the latch
+  static bool tryPin(Frame &frame, page_id_t page_id);
+
+  // both called with the latch held
+  void swizzle(Frame &parent, std::size_t slot, Frame &child);
+  void unswizzle(Frame &frame);
+
+  Page *fetchPageLocked(page_id_t page_id);
+
+  BufferPoolStats stats;
+  std::atomic<bool> swizzling{false};
+  std::atomic<std::size_t> swizzled_hits{0}; // counted without the latch
+
+  // guards the page table, frames metadata, replacer state and the file
+  // registry; page contents are protected by the pin protocol, not by this
+  // latch
+  mutable std::mutex latch;
 
 public:
   BufferPoolManager(const std::size_t poolSize, const std::string &fileName);
 
   Page *fetchPage(page_id_t page_id);
 
+  // pins the count pages of page_ids into pages, as count fetchPage calls
+  // would (duplicates are pinned once per occurrence), with the misses
+  // read as one batch. All or nothing: false, with no page pinned, when
+  // frames run out or a file is not open.
+  bool fetchPages(const page_id_t *page_ids, std::size_t count,
+                  Page **pages);
+
+  // fetches child_id, the child stored at slot of the pinned page parent.
+  // With swizzling on, the reference is cached in parent's frame and later
+  // calls skip the page table while the child stays resident.
+  Page *fetchChild(Page *parent, std::size_t slot, page_id_t child_id);
+
   bool unpinPage(page_id_t page_id, bool is_dirty);
 
+  // unpins a page returned by fetchPage / fetchChild / newPage without the
+  // page table lookup
+  bool unpinPage(Page *page, bool is_dirty);
+
+  void setSwizzling(bool enabled) { swizzling = enabled; }
+
+  // grows or shrinks the pool to newSize frames while it stays in use;
+  // waits for pages pinned in removed frames to be unpinned. False if
+  // newSize is 0 or below the partitions' reserved minimums.
+  bool resize(std::size_t newSize);
+
+  std::size_t getPoolSize() const {
+    std::lock_guard<std::mutex> guard(latch);
+    return pool_size;
+  }
+
+  // frames not pinned right now: how many more pages a caller can pin at
+  // once, if nobody else pins any
+  std::size_t getPinnableFrames();
+
+  // spreads frame chunks round-robin over numNodes NUMA nodes, existing
+  // ones included. Real mode binds (and moves) their memory to the nodes
+  // and needs that many nodes; simulated mode only tracks the placement.
+  bool configureNuma(std::size_t numNodes, bool simulated);
+
+  std::size_t getNumaNodes() const {
+    std::lock_guard<std::mutex> guard(latch);
+    return numa_nodes;
+  }
+
+  // makes the calling thread prefer frames of node: with real NUMA it is
+  // also pinned to the node's CPUs. -1 restores the default, the node of
+  // the CPU the thread runs on (node 0 in simulated mode).
+  bool bindThreadToNode(int node);
+
+  // bytes of frame chunks currently mapped
+  std::size_t getMemoryUsage() const {
+    std::lock_guard<std::mutex> guard(latch);
+    return chunks.size() * kFramesPerChunk * sizeof(Frame);
+  }
+
+  bool isSwizzling() const { return swizzling; }
+
   bool flushPage(page_id_t page_id);
 
+  // new page in the primary file
   Page *newPage(page_id_t *page_id);
 
+  // new page in file_id
+  Page *newPage(file_id_t file_id, page_id_t *page_id);
+
   bool deletePage(page_id_t page_id);
 
   void flushAllDirtyPages();
 
-  ~BufferPoolManager(); // Destructor to flush and close file
+  // reserves count consecutive page ids for a multi-page extent;
+  // INVALID_PAGE_ID when the file is full
+  page_id_t allocatePages(std::size_t count,
+                          file_id_t file_id = PRIMARY_FILE_ID);
+
+  // read / write count consecutive pages from first with a single I/O,
+  // bypassing the frames; pages past the end of the file read as zeros
+  bool readPages(page_id_t first, std::size_t count, char *data);
+  bool writePages(page_id_t first, std::size_t count, const char *data);
+
+  // number of page ids allocated so far in a file (pages on disk + new
+  // pages)
+  std::size_t getNumPages(file_id_t file_id = PRIMARY_FILE_ID) const {
+    std::lock_guard<std::mutex> guard(latch);
+    return file_id < files.size() ? files[file_id].num_pages : 0;
+  }
+
+  // registers a DB file and returns its id (the existing id if path is
+  // already open). A temporary file starts empty and is deleted on
+  // shutdown without writing its pages back. INVALID_FILE_ID on failure.
+  file_id_t addFile(const std::string &path, bool temporary = false);
+
+  // drops every page of the file from the pool without writing it back,
+  // closes and deletes the file. Fails if a page of it is pinned, and for
+  // the primary file.
+  bool dropFile(file_id_t file_id);
+
+  // file that operators spill temporary pages to (SpillWriter). By default
+  // a temporary file created on first use, so spills never grow the DB file
+  void setSpillFile(file_id_t file_id) {
+    std::lock_guard<std::mutex> guard(latch);
+    spill_file = file_id;
+  }
+
+  file_id_t getSpillFile();
+
+  BufferPoolStats getStats() const {
+    std::lock_guard<std::mutex> guard(latch);
+    BufferPoolStats result = stats;
+    result.swizzled_hits = swizzled_hits;
+    return result;
+  }
+
+  void resetStats() {
+    std::lock_guard<std::mutex> guard(latch);
+    stats = BufferPoolStats();
+    swizzled_hits = 0;
+    for (Partition &partition : partitions) {
+      partition.stats = PartitionStats();
+    }
+  }
+
+  // creates a partition holding at least minFrames frames once its pages
+  // are loaded, and at most maxFrames. The minimums of all partitions must
+  // fit in the pool. INVALID_PARTITION_ID on failure.
+  partition_id_t createPartition(const std::string &name,
+                                 std::size_t minFrames,
+                                 std::size_t maxFrames);
+
+  // pages of file_id loaded from now on belong to partition_id
+  bool setFilePartition(file_id_t file_id, partition_id_t partition_id);
+
+  // replacement priority hint for a page the caller has pinned
+  void setPagePriority(Page *page, PagePriority priority) {
+    frameOf(page).priority.store(priority, std::memory_order_relaxed);
+  }
+
+  PartitionStats getPartitionStats(partition_id_t partition_id) const {
+    std::lock_guard<std::mutex> guard(latch);
+    if (partition_id >= partitions.size()) {
+      return PartitionStats();
+    }
+    PartitionStats result = partitions[partition_id].stats;
+    result.resident_frames = partitions[partition_id].resident;
+    return result;
+  }
+
+  // caches evicted pages in a file of numPages slots at path (created,
+  // or truncated: the tier starts empty and is deleted with the pool)
+  bool enableSecondTier(const std::string &path, std::size_t numPages,
+                        TierAdmission admission = TierAdmission::REUSED);
+
+  // starts a snapshot of every DB file, preserving overwritten pages in a
+  // new area file at path; one snapshot at a time
+  bool beginSnapshot(const std::string &path);
+
+  // ends the snapshot and deletes its area file
+  bool endSnapshot();
+
+  // page_id as of the snapshot into data (PAGE_SIZE bytes); false if no
+  // snapshot is active or the page was allocated after it began
+  bool readSnapshotPage(page_id_t page_id, char *data);
+
+  // pages of file_id in the active snapshot
+  std::size_t getSnapshotPages(file_id_t file_id = PRIMARY_FILE_ID);
+
+  // writes the snapshot image of file_id to dest
+  bool backupSnapshot(file_id_t file_id, const std::string &dest);
+
+  // backup of every page of file_id into dest; starts (or restarts) the
+  // file's change tracking for incremental backups
+  bool backupFull(file_id_t file_id, const std::string &dest);
+
+  // backup of the pages of file_id written since its last backup; needs
+  // a full backup first (tracking is not kept across restarts)
+  bool backupIncremental(file_id_t file_id, const std::string &dest);
+
+  // pages of file_id the next incremental backup would copy
+  std::size_t getChangedPages(file_id_t file_id = PRIMARY_FILE_ID) const;
+
+  // rebuilds a DB file at dest from backups: a full backup followed by
+  // incremental ones, in the order they were taken
+  static bool restoreBackup(const std::vector<std::string> &backups,
+                            const std::string &dest);
+
+  // starts appending the primary file's page writes to a new page log at
+  // path, beginning with the file's current image and a sync record
+  bool enableLogShipping(const std::string &path);
+
+  // flushes the pool and appends a sync record: the log up to it is a
+  // consistent image as of this call. Its LSN, 0 on failure.
+  uint64_t logSyncPoint();
+
+  uint64_t getLastLsn() const {
+    std::lock_guard<std::mutex> guard(latch);
+    return last_lsn;
+  }
+
+  // overwrites page_id with data (PAGE_SIZE bytes) as a dirty page,
+  // extending the file if needed; used to replay shipped pages
+  bool applyPageImage(page_id_t page_id, const char *data);
+
+  // writes the ids of the resident pages to path, hottest first (higher
+  // priority, then more recently used). Ids carry file ids, so files must
+  // be added in the same order before the dump is preloaded.
+  bool dumpHotSet(const std::string &path);
+
+  // dumps the hot set every interval from a background thread until the
+  // pool is destroyed
+  bool startHotSetDumps(const std::string &path,
+                        std::chrono::milliseconds interval);
+
+  // loads the pages of a dump into free frames, hottest pool-size pages,
+  // read in page order with one read per span of nearby pages. In background
+  // mode it returns at once; waitForPreload() joins the loader.
+  bool preloadHotSet(const std::string &path, bool background);
+
+  void waitForPreload();
+
+  ~BufferPoolManager(); // Destructor to flush and close files
 };
\ No newline at end of file
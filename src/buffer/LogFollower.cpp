@@ -0,0 +1,110 @@
+#include "LogFollower.hpp"
+#include <chrono>
+#include <cstdio>
+#include <fcntl.h>
+#include <iostream>
+#include <mutex>
+#include <unistd.h>
+
+namespace {
+// the replica's DB file starts empty
+const std::string &removed(const std::string &path) {
+  std::remove(path.c_str());
+  return path;
+}
+} // namespace
+
+LogFollower::LogFollower(const std::string &logPath, std::size_t poolSize,
+                         const std::string &dbPath,
+                         std::size_t maxPendingBytes)
+    : bpm(poolSize, removed(dbPath)), max_pending_bytes(maxPendingBytes) {
+  log_fd = open(logPath.c_str(), O_RDONLY);
+  if (log_fd < 0) {
+    std::cerr << "Could not open page log " << logPath << "\n";
+  }
+}
+
+LogFollower::~LogFollower() {
+  if (log_fd >= 0) {
+    close(log_fd);
+  }
+}
+
+std::size_t LogFollower::poll() {
+  if (log_fd < 0) {
+    return 0;
+  }
+  std::size_t applied = 0;
+  uint64_t read_lsn = 0;
+  while (true) {
+    // records are appended whole, but may not be complete yet when read
+    PageLogHeader header;
+    if (pread(log_fd, &header, sizeof(header), offset) != sizeof(header)) {
+      break;
+    }
+    if (header.type == PageLogType::SYNC) {
+      offset += sizeof(header);
+      apply(header);
+      applied++;
+    } else {
+      PendingImage entry{header.page_id,
+                         offset + static_cast<off_t>(sizeof(header)),
+                         {}};
+      if (pending_bytes + PAGE_SIZE <= max_pending_bytes) {
+        entry.image.resize(PAGE_SIZE);
+        if (pread(log_fd, entry.image.data(), PAGE_SIZE, entry.offset) !=
+            PAGE_SIZE) {
+          break;
+        }
+        pending_bytes += PAGE_SIZE;
+      } else {
+        // over the cap: only make sure the image is complete
+        char last;
+        if (pread(log_fd, &last, 1, entry.offset + PAGE_SIZE - 1) != 1) {
+          break;
+        }
+      }
+      offset = entry.offset + PAGE_SIZE;
+      pending.push_back(std::move(entry));
+    }
+    read_lsn = header.lsn;
+  }
+
+  if (read_lsn != 0) {
+    std::unique_lock<std::shared_mutex> guard(apply_mutex);
+    status.read_lsn = read_lsn;
+  }
+  return applied;
+}
+
+void LogFollower::apply(const PageLogHeader &sync) {
+  // queries wait for the whole batch, so they see one sync point only
+  std::unique_lock<std::shared_mutex> guard(apply_mutex);
+  std::vector<char> buffer(PAGE_SIZE);
+  for (const PendingImage &entry : pending) {
+    const char *image = entry.image.data();
+    if (entry.image.empty()) {
+      image = buffer.data();
+      if (pread(log_fd, buffer.data(), PAGE_SIZE, entry.offset) !=
+          PAGE_SIZE) {
+        std::cerr << "Could not read back page " << entry.page_id
+                  << " from the log\n";
+        continue;
+      }
+    }
+    if (!bpm.applyPageImage(entry.page_id, image)) {
+      std::cerr << "Could not replay page " << entry.page_id << "\n";
+    }
+  }
+  pending.clear();
+  pending_bytes = 0;
+
+  uint64_t now_us = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::system_clock::now().time_since_epoch())
+          .count());
+  status.applied_lsn = sync.lsn;
+  status.sync_points++;
+  status.lag_seconds =
+      now_us > sync.timestamp_us ? (now_us - sync.timestamp_us) / 1e6 : 0;
+}
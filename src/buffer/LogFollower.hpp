@@ -0,0 +1,82 @@
+/* Log-shipping follower requirements
+1. Tails the page log a primary BufferPoolManager appends to with
+enableLogShipping; the log is a shared file, so the follower can run in
+another process on the same host
+2. Replays the shipped page images into its own BufferPoolManager over its
+own DB file: nothing is shared with the primary's pool
+3. Images are applied one sync point at a time under an exclusive lock;
+read-only queries hold the shared lock (readLock), so they always see the
+primary's file as of one sync point, never a half-applied batch
+4. Reports replication lag: LSNs read but not yet applied, and how old the
+last applied sync point was when it became visible
+5. Images waiting for their sync point are kept in memory up to a byte cap;
+past it only their log offsets are kept and the images are read back from
+the log when the sync point is applied, so a long batch cannot exhaust memory
+*/
+#pragma once
+
+#include "BufferPoolManager.hpp"
+#include <cstdint>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+struct ReplicationStatus {
+  uint64_t applied_lsn = 0; // last sync point applied
+  uint64_t read_lsn = 0;    // last record read from the log
+  std::size_t sync_points = 0;
+  double lag_seconds = 0; // primary sync point -> visible on the follower
+};
+
+class LogFollower {
+private:
+  int log_fd = -1;
+  off_t offset = 0; // of the next record to read
+  BufferPoolManager bpm;
+  std::shared_mutex apply_mutex;
+  ReplicationStatus status;
+
+  // a page image read since the last sync point
+  struct PendingImage {
+    page_id_t page_id;
+    off_t offset;            // of the image in the log
+    std::vector<char> image; // empty when over the cap: read back at apply
+  };
+  std::vector<PendingImage> pending;
+  std::size_t pending_bytes = 0; // of the images held in memory
+  std::size_t max_pending_bytes;
+
+  void apply(const PageLogHeader &sync);
+
+public:
+  // follows the page log at logPath into a pool of poolSize frames over
+  // the DB file dbPath (created, or truncated: replay starts from the
+  // base image at the head of the log); at most maxPendingBytes of images
+  // are buffered between sync points
+  LogFollower(const std::string &logPath, std::size_t poolSize,
+              const std::string &dbPath,
+              std::size_t maxPendingBytes = 64 << 20);
+  ~LogFollower();
+
+  LogFollower(const LogFollower &) = delete;
+  LogFollower &operator=(const LogFollower &) = delete;
+
+  bool isOpen() const { return log_fd >= 0; }
+
+  // reads the records appended since the last call and applies every
+  // complete sync point; returns the sync points applied
+  std::size_t poll();
+
+  // held by a read-only query for a consistent view of the pool
+  std::shared_lock<std::shared_mutex> readLock() {
+    return std::shared_lock<std::shared_mutex>(apply_mutex);
+  }
+
+  // pool holding the replica; read only, under readLock
+  BufferPoolManager *getBufferPool() { return &bpm; }
+
+  ReplicationStatus getStatus() {
+    std::shared_lock<std::shared_mutex> guard(apply_mutex);
+    return status;
+  }
+};
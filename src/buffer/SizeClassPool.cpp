@@ -0,0 +1,235 @@
+#include "SizeClassPool.hpp"
+#include <cstring>
+#include <iostream>
+
+SizeClassPool::SizeClassPool(BufferPoolManager *bufferPool,
+                             std::size_t budgetBytes)
+    : bpm(bufferPool), budget(budgetBytes) {
+  for (std::size_t c = 0; c < kNumClasses; c++) {
+    classes[c].stats.page_size = kMinPageSize * pagesOf(c);
+  }
+}
+
+SizeClassPool::~SizeClassPool() { flushAllDirtyPages(); }
+
+std::size_t SizeClassPool::classOf(std::size_t bytes) {
+  std::size_t size_class = 0;
+  while (size_class < kNumClasses &&
+         kMinPageSize * pagesOf(size_class) < bytes) {
+    size_class++;
+  }
+  return size_class; // kNumClasses when larger than kMaxPageSize
+}
+
+void SizeClassPool::touch(Frame &frame) {
+  frame.last_used = ++clock;
+  auto &lru = classes[frame.size_class].lru;
+  lru.splice(lru.end(), lru, frame.lru_pos);
+}
+
+bool SizeClassPool::writeBack(Frame &frame) {
+  if (!frame.is_dirty) {
+    return true;
+  }
+  if (!bpm->writePages(frame.page_id, pagesOf(frame.size_class),
+                       frame.data.get())) {
+    return false;
+  }
+  frame.is_dirty = false;
+  return true;
+}
+
+std::unique_ptr<char[]> SizeClassPool::evict(Frame &frame) {
+  writeBack(frame);
+  SizeClass &owner = classes[frame.size_class];
+  owner.lru.erase(frame.lru_pos);
+  owner.stats.evictions++;
+  owner.stats.resident_pages--;
+  requested -= frame.requested;
+
+  std::unique_ptr<char[]> data = std::move(frame.data);
+  page_table.erase(frame.page_id); // destroys frame
+  return data;
+}
+
+SizeClassPool::Frame *SizeClassPool::victim(std::size_t size_class) const {
+  for (Frame *frame : classes[size_class].lru) {
+    if (frame->pin_count == 0) {
+      return frame;
+    }
+  }
+  return nullptr;
+}
+
+std::unique_ptr<char[]> SizeClassPool::takeBuffer(std::size_t size_class) {
+  SizeClass &target = classes[size_class];
+  std::size_t size = target.stats.page_size;
+
+  // 1. a buffer this class already owns
+  if (!target.free_buffers.empty()) {
+    std::unique_ptr<char[]> data = std::move(target.free_buffers.back());
+    target.free_buffers.pop_back();
+    return data;
+  }
+
+  // 2. unused budget
+  if (allocated + size <= budget) {
+    allocated += size;
+    return std::unique_ptr<char[]>(new char[size]);
+  }
+
+  // 3. the coldest page of the same class
+  if (Frame *frame = victim(size_class)) {
+    return evict(*frame);
+  }
+
+  // 4. memory of the other classes: idle buffers, then the coldest pages
+  while (allocated + size > budget) {
+    std::size_t donor = kNumClasses;
+    for (std::size_t c = 0; c < kNumClasses; c++) {
+      if (!classes[c].free_buffers.empty()) {
+        donor = c;
+        break;
+      }
+    }
+    if (donor != kNumClasses) {
+      classes[donor].free_buffers.pop_back();
+      allocated -= classes[donor].stats.page_size;
+      continue;
+    }
+
+    Frame *coldest = nullptr;
+    for (std::size_t c = 0; c < kNumClasses; c++) {
+      Frame *frame = victim(c);
+      if (frame != nullptr &&
+          (coldest == nullptr || frame->last_used < coldest->last_used)) {
+        coldest = frame;
+      }
+    }
+    if (coldest == nullptr) {
+      std::cerr << "No memory for a " << size << " byte page\n";
+      return nullptr;
+    }
+    allocated -= classes[coldest->size_class].stats.page_size;
+    evict(*coldest); // buffer freed on return
+  }
+  allocated += size;
+  return std::unique_ptr<char[]>(new char[size]);
+}
+
+char *SizeClassPool::install(page_id_t page_id, std::size_t size_class,
+                             std::size_t bytes, std::unique_ptr<char[]> data,
+                             bool is_dirty) {
+  auto frame = std::make_unique<Frame>();
+  frame->page_id = page_id;
+  frame->size_class = size_class;
+  frame->requested = bytes;
+  frame->data = std::move(data);
+  frame->pin_count = 1;
+  frame->is_dirty = is_dirty;
+
+  SizeClass &owner = classes[size_class];
+  frame->lru_pos = owner.lru.insert(owner.lru.end(), frame.get());
+  owner.stats.resident_pages++;
+  requested += bytes;
+
+  Frame &installed = *frame;
+  page_table[page_id] = std::move(frame);
+  touch(installed);
+  return installed.data.get();
+}
+
+char *SizeClassPool::newPage(std::size_t bytes, page_id_t *page_id) {
+  std::lock_guard<std::mutex> guard(latch);
+  std::size_t size_class = classOf(bytes);
+  if (size_class == kNumClasses) {
+    std::cerr << "Page of " << bytes << " bytes exceeds the largest class\n";
+    return nullptr;
+  }
+  std::unique_ptr<char[]> data = takeBuffer(size_class);
+  if (data == nullptr) {
+    return nullptr;
+  }
+  *page_id = bpm->allocatePages(pagesOf(size_class));
+  if (*page_id == INVALID_PAGE_ID) {
+    classes[size_class].free_buffers.push_back(std::move(data));
+    return nullptr;
+  }
+  std::memset(data.get(), 0, classes[size_class].stats.page_size);
+  return install(*page_id, size_class, bytes, std::move(data), true);
+}
+
+char *SizeClassPool::fetchPage(page_id_t page_id, std::size_t bytes) {
+  std::lock_guard<std::mutex> guard(latch);
+  std::size_t size_class = classOf(bytes);
+  if (size_class == kNumClasses) {
+    std::cerr << "Page of " << bytes << " bytes exceeds the largest class\n";
+    return nullptr;
+  }
+
+  auto it = page_table.find(page_id);
+  if (it != page_table.end()) {
+    Frame &frame = *it->second;
+    if (frame.size_class != size_class) {
+      std::cerr << "Page " << page_id << " fetched with the wrong size\n";
+      return nullptr;
+    }
+    classes[size_class].stats.hits++;
+    frame.pin_count++;
+    touch(frame);
+    return frame.data.get();
+  }
+  classes[size_class].stats.misses++;
+
+  std::unique_ptr<char[]> data = takeBuffer(size_class);
+  if (data == nullptr) {
+    return nullptr;
+  }
+  if (!bpm->readPages(page_id, pagesOf(size_class), data.get())) {
+    classes[size_class].free_buffers.push_back(std::move(data));
+    return nullptr;
+  }
+  return install(page_id, size_class, bytes, std::move(data), false);
+}
+
+bool SizeClassPool::unpinPage(page_id_t page_id, bool is_dirty) {
+  std::lock_guard<std::mutex> guard(latch);
+  auto it = page_table.find(page_id);
+  if (it == page_table.end() || it->second->pin_count <= 0) {
+    return false;
+  }
+  if (is_dirty) {
+    it->second->is_dirty = true;
+  }
+  it->second->pin_count--;
+  return true;
+}
+
+bool SizeClassPool::flushPage(page_id_t page_id) {
+  std::lock_guard<std::mutex> guard(latch);
+  auto it = page_table.find(page_id);
+  if (it == page_table.end()) {
+    return false;
+  }
+  return writeBack(*it->second);
+}
+
+void SizeClassPool::flushAllDirtyPages() {
+  std::lock_guard<std::mutex> guard(latch);
+  for (auto &entry : page_table) {
+    writeBack(*entry.second);
+  }
+}
+
+SizeClassPoolStats SizeClassPool::getStats() const {
+  std::lock_guard<std::mutex> guard(latch);
+  SizeClassPoolStats result;
+  result.budget_bytes = budget;
+  result.allocated_bytes = allocated;
+  result.requested_bytes = requested;
+  for (const SizeClass &size_class : classes) {
+    result.classes.push_back(size_class.stats);
+    result.classes.back().free_buffers = size_class.free_buffers.size();
+  }
+  return result;
+}
@@ -0,0 +1,122 @@
+/* Size-class pool requirements
+1. Buffers variable-size pages for objects that do not fit the 4KB frames
+of the BufferPoolManager (blobs, large index nodes): a page of any size up
+to 256KB is fetched with one contiguous read instead of one fetch per 4KB
+2. Page sizes are rounded up to a power-of-two size class between 4KB and
+256KB; a page occupies that many consecutive page ids in the database file,
+reserved with BufferPoolManager::allocatePages
+3. All classes draw from one memory budget in bytes. A buffer is taken, in
+order, from the class's free list, from unused budget, by evicting the
+least recently used unpinned page of the same class, and finally by
+freeing memory of the other classes, least recently used page first
+4. Callers pass the page size on every fetch (the reference to a large
+object records it); the ids of a large page must not also be fetched
+through the BufferPoolManager
+5. Pages are pinned while in use and written back when evicted or flushed;
+one latch guards the pool, like the BufferPoolManager
+*/
+#pragma once
+
+#include "BufferPoolManager.hpp"
+#include <array>
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+struct SizeClassStats {
+  std::size_t page_size = 0;
+  std::size_t hits = 0;
+  std::size_t misses = 0;
+  std::size_t evictions = 0; // pages of this class written out for space
+  std::size_t resident_pages = 0;
+  std::size_t free_buffers = 0;
+};
+
+struct SizeClassPoolStats {
+  std::size_t budget_bytes = 0;
+  std::size_t allocated_bytes = 0; // resident pages plus free buffers
+  std::size_t requested_bytes = 0; // sizes callers asked for, resident pages
+  std::vector<SizeClassStats> classes;
+};
+
+class SizeClassPool {
+public:
+  static constexpr std::size_t kMinPageSize = PAGE_SIZE;       // 4KB
+  static constexpr std::size_t kMaxPageSize = 64 * PAGE_SIZE; // 256KB
+  static constexpr std::size_t kNumClasses = 7;
+
+private:
+  struct Frame {
+    page_id_t page_id;
+    std::size_t size_class;
+    std::size_t requested; // bytes the caller asked for
+    std::unique_ptr<char[]> data;
+    int pin_count = 0;
+    bool is_dirty = false;
+    uint64_t last_used = 0;
+    std::list<Frame *>::iterator lru_pos;
+  };
+
+  struct SizeClass {
+    std::list<Frame *> lru; // least recently used first
+    std::vector<std::unique_ptr<char[]>> free_buffers;
+    SizeClassStats stats;
+  };
+
+  BufferPoolManager *bpm;
+  std::size_t budget;
+  std::size_t allocated = 0;
+  std::size_t requested = 0;
+  uint64_t clock = 0; // orders accesses across classes
+  std::unordered_map<page_id_t, std::unique_ptr<Frame>> page_table;
+  std::array<SizeClass, kNumClasses> classes;
+  mutable std::mutex latch;
+
+  static std::size_t classOf(std::size_t bytes);
+  static std::size_t pagesOf(std::size_t size_class) {
+    return std::size_t{1} << size_class;
+  }
+
+  void touch(Frame &frame);
+  // writes out and drops an unpinned page, its buffer goes to the caller
+  std::unique_ptr<char[]> evict(Frame &frame);
+  // least recently used unpinned page of a class, nullptr if all pinned
+  Frame *victim(std::size_t size_class) const;
+  // a buffer for size_class following requirement 3, nullptr if every
+  // page is pinned
+  std::unique_ptr<char[]> takeBuffer(std::size_t size_class);
+  char *install(page_id_t page_id, std::size_t size_class,
+                std::size_t bytes, std::unique_ptr<char[]> data,
+                bool is_dirty);
+  bool writeBack(Frame &frame);
+
+public:
+  SizeClassPool(BufferPoolManager *bufferPool, std::size_t budgetBytes);
+  ~SizeClassPool(); // writes back dirty pages
+
+  SizeClassPool(const SizeClassPool &) = delete;
+  SizeClassPool &operator=(const SizeClassPool &) = delete;
+
+  // bytes a page of the given size occupies in memory and on disk
+  static std::size_t pageSizeFor(std::size_t bytes) {
+    return kMinPageSize * pagesOf(classOf(bytes));
+  }
+
+  // allocates a zeroed page of at least bytes (at most kMaxPageSize),
+  // returned pinned
+  char *newPage(std::size_t bytes, page_id_t *page_id);
+
+  // pinned page of the given size; nullptr when all memory is pinned
+  char *fetchPage(page_id_t page_id, std::size_t bytes);
+
+  bool unpinPage(page_id_t page_id, bool is_dirty);
+
+  bool flushPage(page_id_t page_id);
+
+  void flushAllDirtyPages();
+
+  SizeClassPoolStats getStats() const;
+};
@@ -0,0 +1,477 @@
+#include "Catalog.hpp"
+
+namespace {
+
+// column list <-> blob stored in a VARCHAR column of sys_meta
+// per column: u8 type, u8 nullable, u16 name length, name bytes
+std::string encodeColumns(const Schema &schema) {
+  std::string blob;
+  for (const Column &column : schema.getColumns()) {
+    uint16_t name_length = static_cast<uint16_t>(column.name.size());
+    blob.push_back(static_cast<char>(column.type));
+    blob.push_back(column.nullable ? 1 : 0);
+    blob.append(reinterpret_cast<const char *>(&name_length),
+                sizeof(name_length));
+    blob.append(column.name);
+  }
+  return blob;
+}
+
+Schema decodeColumns(std::string_view blob) {
+  std::vector<Column> columns;
+  std::size_t pos = 0;
+  while (pos < blob.size()) {
+    TypeId type = static_cast<TypeId>(blob[pos]);
+    bool nullable = blob[pos + 1] != 0;
+    uint16_t name_length;
+    memcpy(&name_length, blob.data() + pos + 2, sizeof(name_length));
+    pos += 2 + sizeof(name_length);
+    columns.emplace_back(std::string(blob.substr(pos, name_length)), type,
+                         nullable);
+    pos += name_length;
+  }
+  return Schema(std::move(columns));
+}
+
+// per index: u16 name length, name, root page id, u16 key count, u32 keys
+std::string encodeIndexes(const std::vector<IndexInfo> &indexes) {
+  std::string blob;
+  for (const IndexInfo &index : indexes) {
+    uint16_t name_length = static_cast<uint16_t>(index.name.size());
+    uint16_t key_count = static_cast<uint16_t>(index.key_columns.size());
+    blob.append(reinterpret_cast<const char *>(&name_length),
+                sizeof(name_length));
+    blob.append(index.name);
+    blob.append(reinterpret_cast<const char *>(&index.root_page_id),
+                sizeof(index.root_page_id));
+    blob.append(reinterpret_cast<const char *>(&key_count), sizeof(key_count));
+    blob.append(reinterpret_cast<const char *>(index.key_columns.data()),
+                key_count * sizeof(uint32_t));
+  }
+  return blob;
+}
+
+std::vector<IndexInfo> decodeIndexes(std::string_view blob) {
+  std::vector<IndexInfo> indexes;
+  std::size_t pos = 0;
+  while (pos < blob.size()) {
+    IndexInfo index;
+    uint16_t name_length;
+    uint16_t key_count;
+    memcpy(&name_length, blob.data() + pos, sizeof(name_length));
+    pos += sizeof(name_length);
+    index.name = std::string(blob.substr(pos, name_length));
+    pos += name_length;
+    memcpy(&index.root_page_id, blob.data() + pos, sizeof(page_id_t));
+    pos += sizeof(page_id_t);
+    memcpy(&key_count, blob.data() + pos, sizeof(key_count));
+    pos += sizeof(key_count);
+    index.key_columns.resize(key_count);
+    memcpy(index.key_columns.data(), blob.data() + pos,
+           key_count * sizeof(uint32_t));
+    pos += key_count * sizeof(uint32_t);
+    indexes.push_back(std::move(index));
+  }
+  return indexes;
+}
+
+// sys_tables columns
+enum DirectoryColumn : uint32_t {
+  DIR_OID,
+  DIR_NAME,
+  DIR_VERSION,
+  DIR_META_PAGE,
+  DIR_META_SLOT
+};
+
+// sys_meta columns
+enum MetaColumn : uint32_t {
+  META_OID,
+  META_ROOT_PAGE,
+  META_COLUMNS,
+  META_INDEXES,
+  META_ROW_COUNT,
+  META_PAGE_COUNT,
+  META_ENGINE
+};
+
+} // namespace
+
+Catalog::Catalog(BufferPoolManager *bufferPool)
+    : bpm(bufferPool),
+      directory_schema({Column("oid", TypeId::INTEGER, false),
+                        Column("name", TypeId::VARCHAR, false),
+                        Column("version", TypeId::BIGINT, false),
+                        Column("meta_page", TypeId::INTEGER, false),
+                        Column("meta_slot", TypeId::INTEGER, false)}),
+      meta_schema({Column("oid", TypeId::INTEGER, false),
+                   Column("root_page", TypeId::INTEGER, false),
+                   Column("columns", TypeId::VARCHAR, false),
+                   Column("indexes", TypeId::VARCHAR, false),
+                   Column("row_count", TypeId::BIGINT, false),
+                   Column("page_count", TypeId::BIGINT, false),
+                   Column("engine", TypeId::INTEGER, false)}) {
+
+  if (bpm->getNumPages() == 0) {
+    // brand new database file
+    valid = bootstrap();
+    return;
+  }
+
+  // only the header page is read at startup
+  Page *page = bpm->fetchPage(CATALOG_HEADER_PAGE_ID);
+  if (page == nullptr) {
+    std::cerr << "Could not read catalog header page\n";
+    return;
+  }
+  if (!page->isRecordDeleted(0) &&
+      page->getRecordLength(0) == sizeof(CatalogHeader)) {
+    memcpy(&header, page->getRecord(0), sizeof(CatalogHeader));
+  }
+  bpm->unpinPage(CATALOG_HEADER_PAGE_ID, false);
+
+  valid = header.magic == CATALOG_MAGIC;
+  if (!valid) {
+    std::cerr << "Page 0 does not hold a catalog header\n";
+  }
+}
+
+bool Catalog::bootstrap() {
+  page_id_t header_page_id;
+  Page *page = bpm->newPage(&header_page_id);
+  if (page == nullptr || header_page_id != CATALOG_HEADER_PAGE_ID) {
+    std::cerr << "Catalog header must be the first page of the database\n";
+    return false;
+  }
+  page->allocateRecord(sizeof(CatalogHeader));
+  bpm->unpinPage(header_page_id, true);
+
+  tables_heap = std::make_unique<TableHeap>(bpm);
+  meta_heap = std::make_unique<TableHeap>(bpm);
+  directory_loaded = true;
+
+  header.magic = CATALOG_MAGIC;
+  header.next_table_oid = 1;
+  header.version = 0;
+  header.tables_first_page_id = tables_heap->getFirstPageId();
+  header.meta_first_page_id = meta_heap->getFirstPageId();
+  return writeHeader();
+}
+
+bool Catalog::writeHeader() {
+  Page *page = bpm->fetchPage(CATALOG_HEADER_PAGE_ID);
+  if (page == nullptr) {
+    return false;
+  }
+  memcpy(page->getRecord(0), &header, sizeof(CatalogHeader));
+  bpm->unpinPage(CATALOG_HEADER_PAGE_ID, true);
+  return true;
+}
+
+TableHeap *Catalog::getTablesHeap() {
+  if (!tables_heap) {
+    tables_heap =
+        std::make_unique<TableHeap>(bpm, header.tables_first_page_id);
+  }
+  return tables_heap.get();
+}
+
+TableHeap *Catalog::getMetaHeap() {
+  if (!meta_heap) {
+    meta_heap = std::make_unique<TableHeap>(bpm, header.meta_first_page_id);
+  }
+  return meta_heap.get();
+}
+
+void Catalog::loadDirectory() {
+  if (directory_loaded || !valid) {
+    return;
+  }
+
+  // entries still cached from before a refresh, reattached if unchanged
+  std::unordered_map<table_oid_t, std::unique_ptr<TableInfo>> detached;
+  for (auto &item : directory) {
+    if (item.second.cached) {
+      detached[item.second.oid] = std::move(item.second.cached);
+    }
+  }
+  directory.clear();
+
+  getTablesHeap()->forEachRecord(
+      [&](const RID &rid, const char *data, uint16_t length) {
+        Tuple row(&directory_schema, data, length);
+        DirectoryEntry entry;
+        entry.oid = static_cast<table_oid_t>(row.getInteger(DIR_OID));
+        entry.version = static_cast<uint64_t>(row.getBigInt(DIR_VERSION));
+        entry.directory_rid = rid;
+        entry.meta_rid.page_id =
+            static_cast<page_id_t>(row.getInteger(DIR_META_PAGE));
+        entry.meta_rid.slot_num =
+            static_cast<uint16_t>(row.getInteger(DIR_META_SLOT));
+
+        auto cached = detached.find(entry.oid);
+        if (cached != detached.end() &&
+            cached->second->version == entry.version) {
+          entry.cached = std::move(cached->second);
+        }
+        directory.emplace(std::string(row.getVarchar(DIR_NAME)),
+                          std::move(entry));
+      });
+  directory_loaded = true;
+}
+
+Catalog::DirectoryEntry *Catalog::findEntry(const std::string &name) {
+  loadDirectory();
+  auto it = directory.find(name);
+  return it == directory.end() ? nullptr : &it->second;
+}
+
+bool Catalog::loadMetadata(const std::string &name, DirectoryEntry &entry) {
+  std::vector<char> record;
+  if (!getMetaHeap()->getRecord(entry.meta_rid, record)) {
+    std::cerr << "Missing metadata row for table " << name << "\n";
+    return false;
+  }
+
+  Tuple row(&meta_schema, record.data(), static_cast<uint16_t>(record.size()));
+  auto info = std::make_unique<TableInfo>();
+  info->oid = entry.oid;
+  info->name = name;
+  info->schema = decodeColumns(row.getVarchar(META_COLUMNS));
+  info->root_page_id = static_cast<page_id_t>(row.getInteger(META_ROOT_PAGE));
+  info->indexes = decodeIndexes(row.getVarchar(META_INDEXES));
+  info->stats.row_count = static_cast<uint64_t>(row.getBigInt(META_ROW_COUNT));
+  info->stats.page_count =
+      static_cast<uint64_t>(row.getBigInt(META_PAGE_COUNT));
+  info->engine = static_cast<StorageEngine>(row.getInteger(META_ENGINE));
+  info->version = entry.version;
+
+  entry.cached = std::move(info);
+  metadata_loads++;
+  return true;
+}
+
+void Catalog::buildDirectoryRow(TupleBuilder &builder, const std::string &name,
+                                const DirectoryEntry &entry) const {
+  builder.reset();
+  builder.setInteger(DIR_OID, static_cast<int32_t>(entry.oid));
+  builder.setVarchar(DIR_NAME, name);
+  builder.setBigInt(DIR_VERSION, static_cast<int64_t>(entry.version));
+  builder.setInteger(DIR_META_PAGE, entry.meta_rid.page_id);
+  builder.setInteger(DIR_META_SLOT, entry.meta_rid.slot_num);
+}
+
+void Catalog::buildMetaRow(TupleBuilder &builder, const TableInfo &info) const {
+  builder.reset();
+  builder.setInteger(META_OID, static_cast<int32_t>(info.oid));
+  builder.setInteger(META_ROOT_PAGE, info.root_page_id);
+  builder.setVarchar(META_COLUMNS, encodeColumns(info.schema));
+  builder.setVarchar(META_INDEXES, encodeIndexes(info.indexes));
+  builder.setBigInt(META_ROW_COUNT, static_cast<int64_t>(info.stats.row_count));
+  builder.setBigInt(META_PAGE_COUNT,
+                    static_cast<int64_t>(info.stats.page_count));
+  builder.setInteger(META_ENGINE, static_cast<int32_t>(info.engine));
+}
+
+bool Catalog::persistTable(TableInfo &info, DirectoryEntry &entry) {
+  TupleBuilder meta_row(meta_schema);
+  buildMetaRow(meta_row, info);
+  if (!meta_row.fitsInPage()) {
+    return false;
+  }
+  std::vector<char> record(meta_row.getSerializedLength());
+  meta_row.serializeTo(record.data());
+
+  // rewrite in place when the page has room, otherwise move the row: the
+  // old row is deleted only once the directory points at the new one, so a
+  // failure leaves the table's metadata intact
+  TableHeap *heap = getMetaHeap();
+  RID old_meta_rid = entry.meta_rid;
+  bool moved = !heap->updateRecord(entry.meta_rid, record.data(),
+                                   static_cast<uint16_t>(record.size()));
+  if (moved && !heap->insertTuple(meta_row, &entry.meta_rid)) {
+    return false;
+  }
+
+  // the directory row keeps its size, so it is always updated in place
+  uint64_t old_version = entry.version;
+  entry.version = header.version + 1;
+  TupleBuilder directory_row(directory_schema);
+  buildDirectoryRow(directory_row, info.name, entry);
+  record.resize(directory_row.getSerializedLength());
+  directory_row.serializeTo(record.data());
+  if (!getTablesHeap()->updateRecord(entry.directory_rid, record.data(),
+                                     static_cast<uint16_t>(record.size()))) {
+    if (moved) {
+      heap->deleteRecord(entry.meta_rid);
+      entry.meta_rid = old_meta_rid;
+    }
+    entry.version = old_version;
+    return false;
+  }
+  if (moved) {
+    heap->deleteRecord(old_meta_rid);
+  }
+
+  // the new version is used only once both rows are written
+  header.version = entry.version;
+  info.version = entry.version;
+  return writeHeader();
+}
+
+TableInfo *Catalog::createTable(const std::string &name, const Schema &schema,
+                                StorageEngine engine) {
+  if (!valid || findEntry(name) != nullptr) {
+    return nullptr;
+  }
+
+  // an empty slotted page is both an empty heap and an empty LSM manifest
+  TableHeap heap(bpm);
+  if (heap.getFirstPageId() == INVALID_PAGE_ID) {
+    return nullptr;
+  }
+
+  auto info = std::make_unique<TableInfo>();
+  info->oid = header.next_table_oid++;
+  info->name = name;
+  info->schema = schema;
+  info->root_page_id = heap.getFirstPageId();
+  info->engine = engine;
+  info->stats.page_count = 1;
+  info->version = ++header.version;
+
+  DirectoryEntry entry;
+  entry.oid = info->oid;
+  entry.version = info->version;
+
+  TupleBuilder meta_row(meta_schema);
+  buildMetaRow(meta_row, *info);
+  if (!getMetaHeap()->insertTuple(meta_row, &entry.meta_rid)) {
+    return nullptr;
+  }
+
+  TupleBuilder directory_row(directory_schema);
+  buildDirectoryRow(directory_row, name, entry);
+  if (!getTablesHeap()->insertTuple(directory_row, &entry.directory_rid)) {
+    getMetaHeap()->deleteRecord(entry.meta_rid);
+    return nullptr;
+  }
+
+  if (!writeHeader()) {
+    return nullptr;
+  }
+
+  TableInfo *result = info.get();
+  entry.cached = std::move(info);
+  directory.emplace(name, std::move(entry));
+  return result;
+}
+
+TableInfo *Catalog::getTable(const std::string &name) {
+  DirectoryEntry *entry = findEntry(name);
+  if (entry == nullptr) {
+    return nullptr;
+  }
+
+  if (!entry->cached || entry->cached->version != entry->version) {
+    if (!loadMetadata(name, *entry)) {
+      return nullptr;
+    }
+  }
+  return entry->cached.get();
+}
+
+bool Catalog::dropTable(const std::string &name) {
+  DirectoryEntry *entry = findEntry(name);
+  if (entry == nullptr) {
+    return false;
+  }
+
+  // heap pages of the table are not reclaimed (no free page list yet)
+  getTablesHeap()->deleteRecord(entry->directory_rid);
+  getMetaHeap()->deleteRecord(entry->meta_rid);
+  directory.erase(name);
+  header.version++;
+  return writeHeader();
+}
+
+bool Catalog::createIndex(const std::string &table_name,
+                          const IndexInfo &index) {
+  TableInfo *info = getTable(table_name);
+  if (info == nullptr) {
+    return false;
+  }
+  for (const IndexInfo &existing : info->indexes) {
+    if (existing.name == index.name) {
+      return false;
+    }
+  }
+
+  info->indexes.push_back(index);
+  if (!persistTable(*info, *findEntry(table_name))) {
+    info->indexes.pop_back();
+    return false;
+  }
+  return true;
+}
+
+bool Catalog::updateStatistics(const std::string &table_name,
+                               const TableStatistics &stats) {
+  TableInfo *info = getTable(table_name);
+  if (info == nullptr) {
+    return false;
+  }
+  TableStatistics old_stats = info->stats;
+  info->stats = stats;
+  if (!persistTable(*info, *findEntry(table_name))) {
+    info->stats = old_stats;
+    return false;
+  }
+  return true;
+}
+
+bool Catalog::updateRootPage(const std::string &table_name,
+                             page_id_t root_page_id) {
+  TableInfo *info = getTable(table_name);
+  if (info == nullptr) {
+    return false;
+  }
+  page_id_t old_root_page_id = info->root_page_id;
+  info->root_page_id = root_page_id;
+  if (!persistTable(*info, *findEntry(table_name))) {
+    info->root_page_id = old_root_page_id;
+    return false;
+  }
+  return true;
+}
+
+std::vector<std::string> Catalog::getTableNames() {
+  loadDirectory();
+  std::vector<std::string> names;
+  names.reserve(directory.size());
+  for (const auto &item : directory) {
+    names.push_back(item.first);
+  }
+  return names;
+}
+
+void Catalog::refresh() {
+  Page *page = bpm->fetchPage(CATALOG_HEADER_PAGE_ID);
+  if (page == nullptr) {
+    return;
+  }
+  CatalogHeader current;
+  memcpy(&current, page->getRecord(0), sizeof(CatalogHeader));
+  bpm->unpinPage(CATALOG_HEADER_PAGE_ID, false);
+
+  if (current.version == header.version) {
+    return;
+  }
+
+  // the heaps may have grown, reopen them and re-read the directory lazily;
+  // cached metadata survives for tables whose version did not move
+  header = current;
+  tables_heap.reset();
+  meta_heap.reset();
+  directory_loaded = false;
+}
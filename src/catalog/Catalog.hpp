@@ -0,0 +1,134 @@
+/* Catalog requirements
+1. Table metadata (columns, indexes, root page ids, statistics) lives in the
+database file itself, in pages accessed through the BufferPoolManager
+2. Page 0 is reserved for the catalog header, which points at two system heaps
+    - sys_tables : one small directory row per table (oid, name, version, where
+                   its metadata row is)
+    - sys_meta   : one row per table with the full metadata
+3. Opening a database only reads the header page, the directory is read on the
+first lookup and a table's metadata row on the first access to that table
+4. Every catalog change bumps a version number, cached entries are reused only
+while their version still matches the directory
+*/
+#pragma once
+
+#include "table/TableHeap.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using table_oid_t = uint32_t;
+
+static constexpr page_id_t CATALOG_HEADER_PAGE_ID = 0;
+
+struct IndexInfo {
+  std::string name;
+  std::vector<uint32_t> key_columns;
+  page_id_t root_page_id = INVALID_PAGE_ID;
+};
+
+struct TableStatistics {
+  uint64_t row_count = 0;
+  uint64_t page_count = 0;
+};
+
+// How a table stores its rows: a slotted-page heap updated in place, or an
+// LSM tree (lsm/LsmTree.hpp) whose manifest is the root page
+enum class StorageEngine : int32_t { HEAP, LSM };
+
+struct TableInfo {
+  table_oid_t oid;
+  std::string name;
+  Schema schema;
+  page_id_t root_page_id = INVALID_PAGE_ID; // heap first page / manifest
+  StorageEngine engine = StorageEngine::HEAP;
+  std::vector<IndexInfo> indexes;
+  TableStatistics stats;
+  uint64_t version = 0; // catalog version of the last change to this table
+};
+
+class Catalog {
+private:
+  struct CatalogHeader {
+    uint32_t magic;
+    table_oid_t next_table_oid;
+    uint64_t version;
+    page_id_t tables_first_page_id;
+    page_id_t meta_first_page_id;
+  };
+
+  struct DirectoryEntry {
+    table_oid_t oid;
+    uint64_t version;
+    RID directory_rid; // row in sys_tables
+    RID meta_rid;      // row in sys_meta
+    std::unique_ptr<TableInfo> cached;
+  };
+
+  static constexpr uint32_t CATALOG_MAGIC = 0x53524442; // "SRDB"
+
+  BufferPoolManager *bpm;
+  CatalogHeader header{};
+  bool valid = false;
+
+  std::unique_ptr<TableHeap> tables_heap; // opened on first use
+  std::unique_ptr<TableHeap> meta_heap;   // opened on first use
+  bool directory_loaded = false;
+  std::unordered_map<std::string, DirectoryEntry> directory;
+  std::size_t metadata_loads = 0;
+
+  Schema directory_schema;
+  Schema meta_schema;
+
+  bool bootstrap();
+  bool writeHeader();
+  TableHeap *getTablesHeap();
+  TableHeap *getMetaHeap();
+  void loadDirectory();
+  DirectoryEntry *findEntry(const std::string &name);
+  bool loadMetadata(const std::string &name, DirectoryEntry &entry);
+
+  void buildDirectoryRow(TupleBuilder &builder, const std::string &name,
+                         const DirectoryEntry &entry) const;
+  void buildMetaRow(TupleBuilder &builder, const TableInfo &info) const;
+
+  // persists info under a new catalog version
+  bool persistTable(TableInfo &info, DirectoryEntry &entry);
+
+public:
+  explicit Catalog(BufferPoolManager *bufferPool);
+
+  // false if the header page is missing or does not belong to a catalog
+  bool isValid() const { return valid; }
+
+  uint64_t getVersion() const { return header.version; }
+
+  // creates the table and its (empty) root page, nullptr if the name is
+  // taken
+  TableInfo *createTable(const std::string &name, const Schema &schema,
+                         StorageEngine engine = StorageEngine::HEAP);
+
+  // nullptr if the table does not exist; the pointer stays valid until the
+  // table changes or is dropped
+  TableInfo *getTable(const std::string &name);
+
+  bool dropTable(const std::string &name);
+
+  bool createIndex(const std::string &table_name, const IndexInfo &index);
+
+  bool updateStatistics(const std::string &table_name,
+                        const TableStatistics &stats);
+
+  bool updateRootPage(const std::string &table_name, page_id_t root_page_id);
+
+  std::vector<std::string> getTableNames();
+
+  // re-reads the header page; if another catalog instance changed the
+  // database, entries whose version moved are evicted from the cache
+  void refresh();
+
+  // number of tables whose metadata row has been decoded so far
+  std::size_t getMetadataLoads() const { return metadata_loads; }
+};
@@ -0,0 +1,247 @@
+/* Aggregate functions shared by the aggregation operators
+1. COUNT(*) counts rows, COUNT(col) counts non-NULL values
+2. SUM over BOOLEAN / INTEGER / BIGINT produces BIGINT, over DOUBLE a DOUBLE
+3. MIN / MAX keep the input type (numeric columns only)
+4. SUM / MIN / MAX of no values is NULL
+*/
+#pragma once
+
+#include "Vector.hpp"
+#include "storage/Schema.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+
+enum class AggregateType { COUNT_STAR, COUNT, SUM, MIN, MAX };
+
+struct AggregateSpec {
+  AggregateType type;
+  uint32_t col_idx = 0; // ignored by COUNT_STAR
+};
+
+inline TypeId getAggregateResultType(const AggregateSpec &spec,
+                                     const Schema &input) {
+  switch (spec.type) {
+  case AggregateType::COUNT_STAR:
+  case AggregateType::COUNT:
+    return TypeId::BIGINT;
+  case AggregateType::SUM:
+    return input.getType(spec.col_idx) == TypeId::DOUBLE ? TypeId::DOUBLE
+                                                         : TypeId::BIGINT;
+  case AggregateType::MIN:
+  case AggregateType::MAX:
+    return input.getType(spec.col_idx);
+  }
+  return TypeId::BIGINT;
+}
+
+// Running state of one aggregate; integer inputs accumulate in `integer`,
+// DOUBLE inputs in `decimal`
+struct AggregateState {
+  int64_t count = 0; // rows (COUNT_STAR) or non-NULL values seen
+  int64_t integer = 0;
+  double decimal = 0;
+
+  void update(AggregateType type, int64_t value) {
+    switch (type) {
+    case AggregateType::SUM:
+      integer += value;
+      break;
+    case AggregateType::MIN:
+      integer = count == 0 ? value : std::min(integer, value);
+      break;
+    case AggregateType::MAX:
+      integer = count == 0 ? value : std::max(integer, value);
+      break;
+    default:
+      break;
+    }
+    count++;
+  }
+
+  void update(AggregateType type, double value) {
+    switch (type) {
+    case AggregateType::SUM:
+      decimal += value;
+      break;
+    case AggregateType::MIN:
+      decimal = count == 0 ? value : std::min(decimal, value);
+      break;
+    case AggregateType::MAX:
+      decimal = count == 0 ? value : std::max(decimal, value);
+      break;
+    default:
+      break;
+    }
+    count++;
+  }
+
+  // folds a partial state (pre-aggregation, spilled partitions) into this one
+  void merge(AggregateType type, const AggregateState &other) {
+    if (other.count == 0) {
+      return;
+    }
+    switch (type) {
+    case AggregateType::COUNT_STAR:
+    case AggregateType::COUNT:
+      break;
+    case AggregateType::SUM:
+      integer += other.integer;
+      decimal += other.decimal;
+      break;
+    case AggregateType::MIN:
+      integer = count == 0 ? other.integer : std::min(integer, other.integer);
+      decimal = count == 0 ? other.decimal : std::min(decimal, other.decimal);
+      break;
+    case AggregateType::MAX:
+      integer = count == 0 ? other.integer : std::max(integer, other.integer);
+      decimal = count == 0 ? other.decimal : std::max(decimal, other.decimal);
+      break;
+    }
+    count += other.count;
+  }
+
+  void writeResult(AggregateType type, TypeId result_type, Vector &out,
+                   std::size_t row) const {
+    if (type == AggregateType::COUNT_STAR || type == AggregateType::COUNT) {
+      out.setNull(row, false);
+      out.getData<int64_t>()[row] = count;
+      return;
+    }
+
+    out.setNull(row, count == 0);
+    switch (result_type) {
+    case TypeId::BOOLEAN:
+      out.getData<char>()[row] = static_cast<char>(integer);
+      break;
+    case TypeId::INTEGER:
+      out.getData<int32_t>()[row] = static_cast<int32_t>(integer);
+      break;
+    case TypeId::BIGINT:
+      out.getData<int64_t>()[row] = integer;
+      break;
+    case TypeId::DOUBLE:
+      out.getData<double>()[row] = decimal;
+      break;
+    case TypeId::VARCHAR:
+      break;
+    }
+  }
+};
+
+// folds the visible rows of `vector` (selection may be null) into state
+inline void updateAggregate(AggregateState &state, const AggregateSpec &spec,
+                            const Vector &vector, const uint16_t *selection,
+                            std::size_t count) {
+  if (spec.type == AggregateType::COUNT_STAR) {
+    state.count += static_cast<int64_t>(count);
+    return;
+  }
+
+  const uint8_t *nulls = vector.getNulls();
+  // one tight loop per aggregate kind, the batch result is merged at the end
+  auto fold = [&](auto *values) {
+    using T = std::remove_const_t<std::remove_pointer_t<decltype(values)>>;
+    using Acc = std::conditional_t<std::is_same_v<T, double>, double, int64_t>;
+    AggregateState partial;
+    Acc acc = 0;
+    bool first = true;
+    for (std::size_t i = 0; i < count; i++) {
+      std::size_t row = selection != nullptr ? selection[i] : i;
+      if (nulls[row]) {
+        continue;
+      }
+      Acc value = static_cast<Acc>(values[row]);
+      switch (spec.type) {
+      case AggregateType::SUM:
+        acc += value;
+        break;
+      case AggregateType::MIN:
+        acc = first ? value : std::min(acc, value);
+        break;
+      case AggregateType::MAX:
+        acc = first ? value : std::max(acc, value);
+        break;
+      default:
+        break;
+      }
+      first = false;
+      partial.count++;
+    }
+    if constexpr (std::is_same_v<Acc, double>) {
+      partial.decimal = acc;
+    } else {
+      partial.integer = acc;
+    }
+    state.merge(spec.type, partial);
+  };
+
+  switch (vector.getType()) {
+  case TypeId::BOOLEAN:
+    fold(vector.getData<char>());
+    break;
+  case TypeId::INTEGER:
+    fold(vector.getData<int32_t>());
+    break;
+  case TypeId::BIGINT:
+    fold(vector.getData<int64_t>());
+    break;
+  case TypeId::DOUBLE:
+    fold(vector.getData<double>());
+    break;
+  case TypeId::VARCHAR:
+    // only COUNT is meaningful for strings
+    for (std::size_t i = 0; i < count; i++) {
+      std::size_t row = selection != nullptr ? selection[i] : i;
+      state.count += !nulls[row];
+    }
+    break;
+  }
+}
+
+// grouped variant: visible row i is folded into states[groups[i] * stride]
+// (states points at the first group's state for this aggregate)
+inline void updateGroupedAggregate(AggregateState *states, std::size_t stride,
+                                   const AggregateSpec &spec,
+                                   const Vector &vector,
+                                   const uint16_t *selection,
+                                   const uint32_t *groups, std::size_t count) {
+  if (spec.type == AggregateType::COUNT_STAR) {
+    for (std::size_t i = 0; i < count; i++) {
+      states[groups[i] * stride].count++;
+    }
+    return;
+  }
+
+  const uint8_t *nulls = vector.getNulls();
+  auto fold = [&](auto *values, auto widen) {
+    for (std::size_t i = 0; i < count; i++) {
+      std::size_t row = selection != nullptr ? selection[i] : i;
+      if (!nulls[row]) {
+        states[groups[i] * stride].update(spec.type, widen(values[row]));
+      }
+    }
+  };
+  auto to_integer = [](auto value) { return static_cast<int64_t>(value); };
+
+  switch (vector.getType()) {
+  case TypeId::BOOLEAN:
+    fold(vector.getData<char>(), to_integer);
+    break;
+  case TypeId::INTEGER:
+    fold(vector.getData<int32_t>(), to_integer);
+    break;
+  case TypeId::BIGINT:
+    fold(vector.getData<int64_t>(), to_integer);
+    break;
+  case TypeId::DOUBLE:
+    fold(vector.getData<double>(), [](double value) { return value; });
+    break;
+  case TypeId::VARCHAR:
+    for (std::size_t i = 0; i < count; i++) {
+      std::size_t row = selection != nullptr ? selection[i] : i;
+      states[groups[i] * stride].count += !nulls[row];
+    }
+    break;
+  }
+}
@@ -0,0 +1,45 @@
+#include "AggregateOperator.hpp"
+#include <string>
+
+AggregateOperator::AggregateOperator(std::unique_ptr<Operator> childOperator,
+                                     std::vector<AggregateSpec> aggregateSpecs)
+    : child(std::move(childOperator)), aggregates(std::move(aggregateSpecs)) {
+  std::vector<Column> columns;
+  for (std::size_t i = 0; i < aggregates.size(); i++) {
+    columns.emplace_back(
+        "agg_" + std::to_string(i),
+        getAggregateResultType(aggregates[i], child->getOutputSchema()));
+  }
+  output_schema = Schema(std::move(columns));
+}
+
+bool AggregateOperator::next(DataChunk &chunk) {
+  if (done) {
+    return false;
+  }
+  done = true;
+
+  std::vector<AggregateState> states(aggregates.size());
+  DataChunk input(child->getOutputSchema());
+  while (child->next(input)) {
+    const uint16_t *selection =
+        input.hasSelection() ? input.getSelection() : nullptr;
+    for (std::size_t i = 0; i < aggregates.size(); i++) {
+      updateAggregate(states[i], aggregates[i],
+                      input.getColumn(aggregates[i].col_idx), selection,
+                      input.getCount());
+    }
+  }
+  if (child->failed()) {
+    // aggregates over part of the input would look like a complete result
+    error = true;
+    return false;
+  }
+
+  for (std::size_t i = 0; i < aggregates.size(); i++) {
+    states[i].writeResult(aggregates[i].type, output_schema.getType(i),
+                          chunk.getColumn(static_cast<uint32_t>(i)), 0);
+  }
+  chunk.setSize(1);
+  return true;
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Aggregate.hpp"
+#include "Operator.hpp"
+#include <memory>
+#include <vector>
+
+// Aggregates without GROUP BY: drains the child one batch at a time and
+// produces a single row with one column per aggregate (none, with failed()
+// set, when the child stopped on an error)
+class AggregateOperator : public Operator {
+private:
+  std::unique_ptr<Operator> child;
+  std::vector<AggregateSpec> aggregates;
+  Schema output_schema;
+  bool done = false;
+  bool error = false;
+
+public:
+  AggregateOperator(std::unique_ptr<Operator> childOperator,
+                    std::vector<AggregateSpec> aggregateSpecs);
+
+  const Schema &getOutputSchema() const override { return output_schema; }
+
+  bool next(DataChunk &chunk) override;
+
+  bool failed() const override { return error; }
+};
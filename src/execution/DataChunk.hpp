@@ -0,0 +1,94 @@
+/* DataChunk requirements
+1. A DataChunk is a batch of rows stored as one Vector per output column
+2. `size` is the number of physical rows in the vectors
+3. Filters never move data, they narrow the selection vector, which lists the
+physical rows that are still alive
+*/
+#pragma once
+
+#include "Vector.hpp"
+#include "storage/Schema.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+class DataChunk {
+private:
+  std::vector<Vector> columns;
+  std::size_t size = 0;
+  bool has_selection = false;
+  std::vector<uint16_t> selection;
+  std::size_t selected_count = 0;
+
+public:
+  DataChunk() = default;
+
+  explicit DataChunk(const Schema &schema) { initialize(schema); }
+
+  void initialize(const Schema &schema) {
+    columns.resize(schema.getColumnCount());
+    for (uint32_t i = 0; i < schema.getColumnCount(); i++) {
+      columns[i].initialize(schema.getType(i));
+    }
+    selection.resize(VECTOR_SIZE);
+    reset();
+  }
+
+  void reset() {
+    size = 0;
+    has_selection = false;
+    selected_count = 0;
+  }
+
+  uint32_t getColumnCount() const {
+    return static_cast<uint32_t>(columns.size());
+  }
+
+  Vector &getColumn(uint32_t col_idx) { return columns[col_idx]; }
+
+  const Vector &getColumn(uint32_t col_idx) const { return columns[col_idx]; }
+
+  std::vector<Vector> &getColumns() { return columns; }
+
+  // physical rows loaded into the vectors
+  std::size_t getSize() const { return size; }
+
+  void setSize(std::size_t rows) {
+    size = rows;
+    has_selection = false;
+  }
+
+  // rows visible to the parent operator
+  std::size_t getCount() const {
+    return has_selection ? selected_count : size;
+  }
+
+  // physical row of the i-th visible row
+  uint16_t getRowIndex(std::size_t i) const {
+    return has_selection ? selection[i] : static_cast<uint16_t>(i);
+  }
+
+  bool hasSelection() const { return has_selection; }
+
+  const uint16_t *getSelection() const { return selection.data(); }
+
+  // scratch space for the next selection, commit it with setSelection
+  uint16_t *getSelectionBuffer() { return selection.data(); }
+
+  void setSelection(std::size_t count) {
+    has_selection = true;
+    selected_count = count;
+  }
+
+  // same size and selection as other (used when moving vectors between
+  // chunks)
+  void copyShape(const DataChunk &other) {
+    size = other.size;
+    has_selection = other.has_selection;
+    selected_count = other.selected_count;
+    if (has_selection) {
+      std::copy(other.selection.begin(),
+                other.selection.begin() + selected_count, selection.begin());
+    }
+  }
+};
@@ -0,0 +1,422 @@
+#include "ExternalSortOperator.hpp"
+#include "RowConversion.hpp"
+#include <algorithm>
+
+namespace {
+
+constexpr uint64_t kSignBit = 1ULL << 63;
+
+// order-preserving unsigned encoding of a non-NULL key value
+uint64_t encodeKey(const Tuple &tuple, uint32_t col_idx) {
+  switch (tuple.getSchema()->getType(col_idx)) {
+  case TypeId::BOOLEAN:
+    return tuple.getBoolean(col_idx) ? 1 : 0;
+  case TypeId::INTEGER:
+    return static_cast<uint64_t>(
+               static_cast<int64_t>(tuple.getInteger(col_idx))) ^
+           kSignBit;
+  case TypeId::BIGINT:
+    return static_cast<uint64_t>(tuple.getBigInt(col_idx)) ^ kSignBit;
+  case TypeId::DOUBLE: {
+    double value = tuple.getDouble(col_idx);
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    // negatives: flip everything, positives: flip the sign bit
+    return (bits & kSignBit) ? ~bits : bits | kSignBit;
+  }
+  case TypeId::VARCHAR: {
+    // first 8 bytes big-endian, shorter strings padded with zeros
+    std::string_view value = tuple.getVarchar(col_idx);
+    uint64_t prefix = 0;
+    for (std::size_t i = 0; i < sizeof(prefix); i++) {
+      prefix <<= 8;
+      if (i < value.size()) {
+        prefix |= static_cast<unsigned char>(value[i]);
+      }
+    }
+    return prefix;
+  }
+  }
+  return 0;
+}
+
+template <typename T> int compareValues(T a, T b) {
+  return a < b ? -1 : (b < a ? 1 : 0);
+}
+
+} // namespace
+
+ExternalSortOperator::ExternalSortOperator(
+    std::unique_ptr<Operator> childOperator, std::vector<SortKey> sortKeys,
+    BufferPoolManager *bufferPool, std::size_t memoryBudget,
+    std::size_t readAhead)
+    : child(std::move(childOperator)), keys(std::move(sortKeys)),
+      bpm(bufferPool), memory_budget(memoryBudget), read_ahead(readAhead),
+      schema(child->getOutputSchema()) {}
+
+ExternalSortOperator::~ExternalSortOperator() {
+  for (RunReader &reader : readers) {
+    reader.close();
+  }
+  for (SpillWriter &run : runs) {
+    run.release();
+  }
+}
+
+uint64_t ExternalSortOperator::normalizedPrefix(const Tuple &tuple) const {
+  const SortKey &key = keys.front();
+  // NULL is the smallest value; DESC inverts the whole encoding
+  uint64_t prefix =
+      tuple.isNull(key.col_idx) ? 0 : encodeKey(tuple, key.col_idx);
+  return key.ascending ? prefix : ~prefix;
+}
+
+int ExternalSortOperator::compareRows(const char *a, const char *b) const {
+  Tuple left(&schema, a, 0);
+  Tuple right(&schema, b, 0);
+  for (const SortKey &key : keys) {
+    uint32_t c = key.col_idx;
+    bool left_null = left.isNull(c);
+    bool right_null = right.isNull(c);
+    int cmp = 0;
+    if (left_null || right_null) {
+      cmp = compareValues(!left_null, !right_null);
+    } else {
+      switch (schema.getType(c)) {
+      case TypeId::BOOLEAN:
+        cmp = compareValues(left.getBoolean(c), right.getBoolean(c));
+        break;
+      case TypeId::INTEGER:
+        cmp = compareValues(left.getInteger(c), right.getInteger(c));
+        break;
+      case TypeId::BIGINT:
+        cmp = compareValues(left.getBigInt(c), right.getBigInt(c));
+        break;
+      case TypeId::DOUBLE:
+        cmp = compareValues(left.getDouble(c), right.getDouble(c));
+        break;
+      case TypeId::VARCHAR:
+        cmp = left.getVarchar(c).compare(right.getVarchar(c));
+        cmp = compareValues(cmp, 0);
+        break;
+      }
+    }
+    if (cmp != 0) {
+      return key.ascending ? cmp : -cmp;
+    }
+  }
+  return 0;
+}
+
+bool ExternalSortOperator::entryLess(const SortEntry &a, const SortEntry &b) {
+  if (a.prefix != b.prefix) {
+    return a.prefix < b.prefix;
+  }
+  stats.full_comparisons++;
+  return compareRows(rows.getRow(a.row), rows.getRow(b.row)) < 0;
+}
+
+void ExternalSortOperator::RunReader::fill() {
+  while (window.size() <= read_ahead && next_fetch < page_ids->size()) {
+    Page *page = bpm->fetchPage((*page_ids)[next_fetch]);
+    if (page == nullptr) {
+      // only read-ahead is lost while the window still holds a page
+      std::cerr << "Could not pin run page " << (*page_ids)[next_fetch]
+                << "\n";
+      error = window.empty();
+      return;
+    }
+    window.push_back(page);
+    next_fetch++;
+  }
+}
+
+bool ExternalSortOperator::RunReader::open() {
+  fill();
+  slot = 0;
+  row = nullptr;
+  if (window.empty()) {
+    return false;
+  }
+  if (window.front()->getNumberOfSlots() == 0) {
+    return advance();
+  }
+  row = window.front()->getRecord(0);
+  length = window.front()->getRecordLength(0);
+  return true;
+}
+
+bool ExternalSortOperator::RunReader::advance() {
+  slot++;
+  while (!window.empty() && slot >= window.front()->getNumberOfSlots()) {
+    // current page consumed: unpin it and pin one more page ahead
+    bpm->unpinPage((*page_ids)[next_fetch - window.size()], false);
+    window.pop_front();
+    slot = 0;
+    fill();
+  }
+  if (window.empty()) {
+    row = nullptr;
+    return false;
+  }
+  row = window.front()->getRecord(slot);
+  length = window.front()->getRecordLength(slot);
+  return true;
+}
+
+void ExternalSortOperator::RunReader::close() {
+  while (!window.empty()) {
+    bpm->unpinPage((*page_ids)[next_fetch - window.size()], false);
+    window.pop_front();
+  }
+  row = nullptr;
+}
+
+bool ExternalSortOperator::RunBeats::operator()(std::size_t a,
+                                                std::size_t b) const {
+  const RunReader &left = sort->readers[a];
+  const RunReader &right = sort->readers[b];
+  if (left.exhausted() || right.exhausted()) {
+    return !left.exhausted();
+  }
+  if (left.prefix != right.prefix) {
+    return left.prefix < right.prefix;
+  }
+  sort->stats.full_comparisons++;
+  int cmp = sort->compareRows(left.row, right.row);
+  // equal rows: lower run first keeps the merge stable
+  return cmp != 0 ? cmp < 0 : a < b;
+}
+
+bool ExternalSortOperator::spillRun() {
+  std::sort(entries.begin(), entries.end(),
+            [this](const SortEntry &a, const SortEntry &b) {
+              return entryLess(a, b);
+            });
+  SpillWriter run(bpm);
+  for (const SortEntry &entry : entries) {
+    if (!run.append(rows.getRow(entry.row), rows.getRowLength(entry.row))) {
+      error = true;
+      return false;
+    }
+  }
+  run.finish();
+  stats.runs++;
+  stats.spilled_rows += entries.size();
+  runs.push_back(std::move(run));
+  rows.clear();
+  std::vector<SortEntry>().swap(entries);
+  return true;
+}
+
+void ExternalSortOperator::consumeInput() {
+  DataChunk chunk(schema);
+  TupleBuilder builder(schema);
+
+  while (child->next(chunk)) {
+    for (std::size_t i = 0; i < chunk.getCount(); i++) {
+      uint16_t row = chunk.getRowIndex(i);
+      for (uint32_t c = 0; c < schema.getColumnCount(); c++) {
+        setBuilderFromVector(builder, c, chunk.getColumn(c), row);
+      }
+      // any row may have to be written to a run page
+      if (!builder.fitsInPage()) {
+        std::cerr << "Sort row does not fit in a run page\n";
+        error = true;
+        phase = Phase::DONE;
+        return;
+      }
+      rows.append(builder);
+      uint32_t index = static_cast<uint32_t>(rows.size() - 1);
+      entries.push_back(
+          SortEntry{normalizedPrefix(rows.getTuple(&schema, index)), index});
+
+      if (rows.getMemoryUsage() + entries.capacity() * sizeof(SortEntry) >
+              memory_budget &&
+          !spillRun()) {
+        phase = Phase::DONE;
+        return;
+      }
+    }
+  }
+  if (child->failed()) {
+    error = true;
+    phase = Phase::DONE;
+    return;
+  }
+
+  if (runs.empty()) {
+    // everything fit in memory
+    std::sort(entries.begin(), entries.end(),
+              [this](const SortEntry &a, const SortEntry &b) {
+                return entryLess(a, b);
+              });
+    phase = Phase::IN_MEMORY;
+    return;
+  }
+
+  if (!entries.empty() && !spillRun()) {
+    phase = Phase::DONE;
+    return;
+  }
+
+  // merge groups of runs until one final merge can take all of them
+  std::size_t fan_in = getMaxFanIn();
+  if (fan_in < 2 && runs.size() > 1) {
+    std::cerr << "Buffer pool too small to merge sort runs\n";
+    error = true;
+    phase = Phase::DONE;
+    return;
+  }
+  while (runs.size() > fan_in) {
+    if (!mergeIntermediate(0, fan_in)) {
+      error = true;
+      phase = Phase::DONE;
+      return;
+    }
+    stats.merge_passes++;
+  }
+  if (!startMerge(0, runs.size())) {
+    error = true;
+    phase = Phase::DONE;
+    return;
+  }
+  phase = Phase::MERGE;
+}
+
+std::size_t ExternalSortOperator::getMaxFanIn() const {
+  std::size_t pages_per_run = read_ahead + 1;
+  std::size_t by_budget =
+      std::max<std::size_t>(2, memory_budget / (pages_per_run * PAGE_SIZE));
+  // one frame is left for the output run of an intermediate merge
+  std::size_t frames = bpm->getPinnableFrames();
+  std::size_t by_pool = frames > 1 ? (frames - 1) / pages_per_run : 0;
+  return std::min(by_budget, by_pool);
+}
+
+bool ExternalSortOperator::startMerge(std::size_t first, std::size_t count) {
+  readers.clear();
+  readers.reserve(count);
+  for (std::size_t i = first; i < first + count; i++) {
+    readers.emplace_back(bpm, &runs[i].getPageIds(), read_ahead);
+  }
+  for (RunReader &reader : readers) {
+    reader.open();
+    if (reader.failed()) {
+      return false;
+    }
+    if (!reader.exhausted()) {
+      reader.prefix = normalizedPrefix(Tuple(&schema, reader.row, 0));
+    }
+  }
+  merge_tree = std::make_unique<LoserTree<RunBeats>>(readers.size(),
+                                                     RunBeats{this});
+  return true;
+}
+
+const ExternalSortOperator::RunReader *
+ExternalSortOperator::mergeHead() const {
+  if (readers.empty()) {
+    return nullptr;
+  }
+  const RunReader &reader = readers[merge_tree->winner()];
+  return reader.exhausted() ? nullptr : &reader;
+}
+
+bool ExternalSortOperator::mergeAdvance() {
+  RunReader &reader = readers[merge_tree->winner()];
+  if (reader.advance()) {
+    reader.prefix = normalizedPrefix(Tuple(&schema, reader.row, 0));
+  }
+  merge_tree->replay();
+  return !reader.failed();
+}
+
+void ExternalSortOperator::finishMerge(std::size_t first, std::size_t count) {
+  for (RunReader &reader : readers) {
+    reader.close();
+  }
+  readers.clear();
+  merge_tree.reset();
+  for (std::size_t i = first; i < first + count; i++) {
+    runs[i].release();
+  }
+  runs.erase(runs.begin() + first, runs.begin() + first + count);
+}
+
+bool ExternalSortOperator::mergeIntermediate(std::size_t first,
+                                             std::size_t count) {
+  SpillWriter merged(bpm);
+  if (!startMerge(first, count)) {
+    finishMerge(first, count);
+    return false;
+  }
+  for (const RunReader *head = mergeHead(); head != nullptr;
+       head = mergeHead()) {
+    if (!merged.append(head->row, head->length) || !mergeAdvance()) {
+      merged.release();
+      finishMerge(first, count);
+      return false;
+    }
+  }
+  merged.finish();
+  finishMerge(first, count);
+  runs.push_back(std::move(merged));
+  return true;
+}
+
+bool ExternalSortOperator::next(DataChunk &chunk) {
+  if (phase == Phase::INPUT) {
+    consumeInput();
+  }
+
+  std::size_t count = 0;
+  uint32_t columns = schema.getColumnCount();
+
+  if (phase == Phase::IN_MEMORY) {
+    count = std::min(VECTOR_SIZE, entries.size() - entry_cursor);
+    for (uint32_t c = 0; c < columns; c++) {
+      Vector &vector = chunk.getColumn(c);
+      for (std::size_t i = 0; i < count; i++) {
+        setVectorFromTuple(vector, i,
+                           Tuple(&schema,
+                                 rows.getRow(entries[entry_cursor + i].row),
+                                 0),
+                           c);
+      }
+    }
+    entry_cursor += count;
+    if (entry_cursor == entries.size()) {
+      rows.clear();
+      std::vector<SortEntry>().swap(entries);
+      phase = Phase::DONE;
+    }
+  } else if (phase == Phase::MERGE) {
+    // rows are copied out before the reader moves past their page
+    for (const RunReader *head = mergeHead(); head != nullptr;
+         head = mergeHead()) {
+      Tuple tuple(&schema, head->row, head->length);
+      for (uint32_t c = 0; c < columns; c++) {
+        setVectorFromTuple(chunk.getColumn(c), count, tuple, c);
+      }
+      count++;
+      if (!mergeAdvance()) {
+        // the rows gathered so far are never returned
+        finishMerge(0, runs.size());
+        error = true;
+        phase = Phase::DONE;
+        return false;
+      }
+      if (count == VECTOR_SIZE) {
+        break;
+      }
+    }
+    if (mergeHead() == nullptr) {
+      finishMerge(0, runs.size());
+      phase = Phase::DONE;
+    }
+  }
+
+  chunk.setSize(count);
+  return count > 0;
+}
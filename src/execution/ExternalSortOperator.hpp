@@ -0,0 +1,145 @@
+/* External sort requirements
+1. Sorts the child's rows on one or more key columns (ASC / DESC), NULLs
+sort before every value in ascending order and after them in descending order
+2. Rows are buffered in memory up to the memory budget; every full buffer is
+sorted and written as a run to temporary pages through the BufferPoolManager
+3. Each buffered row carries a normalized 8-byte prefix of its first key that
+compares correctly as an unsigned integer, so most comparisons never touch
+the row itself; ties fall back to a full key comparison
+4. Runs are combined with a k-way merge driven by a loser tree; every run
+reader keeps a window of pages pinned ahead of the row being merged
+5. When there are more runs than the budget allows to merge at once, groups
+of runs are merged into longer runs first (multi-pass merge); the fan-in is
+also capped so the readers' windows fit in the frames the pool can pin
+6. Inputs that fit in the budget never touch the buffer pool
+7. A run page that cannot be written or read stops the sort with failed()
+set instead of truncating the output
+*/
+#pragma once
+
+#include "LoserTree.hpp"
+#include "Operator.hpp"
+#include "RowCollection.hpp"
+#include "SpillWriter.hpp"
+#include <deque>
+#include <memory>
+#include <vector>
+
+struct SortKey {
+  uint32_t col_idx;
+  bool ascending = true;
+
+  SortKey(uint32_t col, bool asc = true) : col_idx(col), ascending(asc) {}
+};
+
+struct ExternalSortStats {
+  std::size_t runs = 0;            // runs written by run generation
+  std::size_t merge_passes = 0;    // intermediate merges before the final one
+  std::size_t spilled_rows = 0;    // rows written by run generation
+  std::size_t full_comparisons = 0; // prefix ties resolved on the rows
+};
+
+class ExternalSortOperator : public Operator {
+private:
+  struct SortEntry {
+    uint64_t prefix;
+    uint32_t row;
+  };
+
+  // Sequential reader over one run, pinning up to read_ahead pages past the
+  // one being consumed
+  class RunReader {
+  private:
+    BufferPoolManager *bpm;
+    const std::vector<page_id_t> *page_ids;
+    std::size_t read_ahead;
+    std::deque<Page *> window; // window.front() holds the current row
+    std::size_t next_fetch = 0;
+    uint16_t slot = 0;
+    bool error = false; // the next page of the run could not be pinned
+
+    void fill();
+
+  public:
+    uint64_t prefix = 0;
+    const char *row = nullptr;
+    uint16_t length = 0;
+
+    RunReader(BufferPoolManager *bufferPool, const std::vector<page_id_t> *ids,
+              std::size_t readAhead)
+        : bpm(bufferPool), page_ids(ids), read_ahead(readAhead) {}
+
+    // positions on the first row, false for an empty run
+    bool open();
+
+    // moves to the next row, false (and row == nullptr) at the end
+    bool advance();
+
+    // at the end of the run, or stopped by a read error
+    bool exhausted() const { return row == nullptr; }
+
+    bool failed() const { return error; }
+
+    // unpins whatever is still pinned
+    void close();
+  };
+
+  struct RunBeats {
+    ExternalSortOperator *sort;
+    bool operator()(std::size_t a, std::size_t b) const;
+  };
+
+  enum class Phase { INPUT, IN_MEMORY, MERGE, DONE };
+
+  std::unique_ptr<Operator> child;
+  std::vector<SortKey> keys;
+  BufferPoolManager *bpm;
+  std::size_t memory_budget;
+  std::size_t read_ahead;
+  const Schema &schema;
+
+  Phase phase = Phase::INPUT;
+  RowCollection rows;
+  std::vector<SortEntry> entries;
+  std::size_t entry_cursor = 0;
+
+  std::vector<SpillWriter> runs;
+  std::vector<RunReader> readers;
+  std::unique_ptr<LoserTree<RunBeats>> merge_tree;
+  bool error = false;
+  ExternalSortStats stats;
+
+  uint64_t normalizedPrefix(const Tuple &tuple) const;
+  int compareRows(const char *a, const char *b) const;
+  bool entryLess(const SortEntry &a, const SortEntry &b);
+
+  void consumeInput();
+  bool spillRun();
+  // 0 when the pool cannot pin the windows of two runs
+  std::size_t getMaxFanIn() const;
+  bool startMerge(std::size_t first, std::size_t count);
+  const RunReader *mergeHead() const;
+  // false if the reader moved past could not pin its next page
+  bool mergeAdvance();
+  void finishMerge(std::size_t first, std::size_t count);
+  bool mergeIntermediate(std::size_t first, std::size_t count);
+
+public:
+  // memory_budget bounds the bytes of buffered rows during run generation and
+  // the pages pinned during the merge (read_ahead + 1 per merged run, and
+  // never more than the pool's unpinned frames)
+  ExternalSortOperator(std::unique_ptr<Operator> childOperator,
+                       std::vector<SortKey> sortKeys,
+                       BufferPoolManager *bufferPool, std::size_t memoryBudget,
+                       std::size_t readAhead = 4);
+
+  ~ExternalSortOperator() override;
+
+  const Schema &getOutputSchema() const override { return schema; }
+
+  bool next(DataChunk &chunk) override;
+
+  bool failed() const override { return error; }
+
+  const ExternalSortStats &getStats() const { return stats; }
+};
@@ -0,0 +1,154 @@
+#include "FilterOperator.hpp"
+#include <limits>
+
+namespace {
+
+template <typename T> bool compare(CompareOp op, const T &lhs, const T &rhs) {
+  switch (op) {
+  case CompareOp::EQ:
+    return lhs == rhs;
+  case CompareOp::NE:
+    return lhs != rhs;
+  case CompareOp::LT:
+    return lhs < rhs;
+  case CompareOp::LE:
+    return lhs <= rhs;
+  case CompareOp::GT:
+    return lhs > rhs;
+  case CompareOp::GE:
+    return lhs >= rhs;
+  }
+  return false;
+}
+
+// the comparison is a template parameter so the loop body has no branch on
+// the operator, and rows are appended branch-free; values are widened to
+// the constant's type C
+template <typename T, typename C, typename Cmp>
+std::size_t selectLoop(const Vector &vector, C constant, DataChunk &chunk,
+                       Cmp cmp) {
+  const T *values = vector.getData<T>();
+  const uint8_t *nulls = vector.getNulls();
+  uint16_t *out = chunk.getSelectionBuffer();
+  std::size_t count = 0;
+
+  if (chunk.hasSelection()) {
+    const uint16_t *in = chunk.getSelection();
+    std::size_t in_count = chunk.getCount();
+    for (std::size_t i = 0; i < in_count; i++) {
+      uint16_t row = in[i];
+      out[count] = row;
+      count += !nulls[row] & cmp(static_cast<C>(values[row]), constant);
+    }
+  } else {
+    std::size_t size = chunk.getSize();
+    for (std::size_t row = 0; row < size; row++) {
+      out[count] = static_cast<uint16_t>(row);
+      count += !nulls[row] & cmp(static_cast<C>(values[row]), constant);
+    }
+  }
+  chunk.setSelection(count);
+  return count;
+}
+
+template <typename T, typename C = T>
+std::size_t selectFixed(const Vector &vector, CompareOp op, C constant,
+                        DataChunk &chunk) {
+  switch (op) {
+  case CompareOp::EQ:
+    return selectLoop<T>(vector, constant, chunk,
+                         [](C a, C b) { return a == b; });
+  case CompareOp::NE:
+    return selectLoop<T>(vector, constant, chunk,
+                         [](C a, C b) { return a != b; });
+  case CompareOp::LT:
+    return selectLoop<T>(vector, constant, chunk,
+                         [](C a, C b) { return a < b; });
+  case CompareOp::LE:
+    return selectLoop<T>(vector, constant, chunk,
+                         [](C a, C b) { return a <= b; });
+  case CompareOp::GT:
+    return selectLoop<T>(vector, constant, chunk,
+                         [](C a, C b) { return a > b; });
+  case CompareOp::GE:
+    return selectLoop<T>(vector, constant, chunk,
+                         [](C a, C b) { return a >= b; });
+  }
+  return 0;
+}
+
+// integer-family column: as double against a DOUBLE constant, otherwise as
+// int64 (narrowed to T when the constant fits, the common case)
+template <typename T>
+std::size_t selectInteger(const Vector &vector, CompareOp op,
+                          const Value &constant, DataChunk &chunk) {
+  if (FilterOperator::comparesAsDouble(vector.getType(), constant)) {
+    return selectFixed<T, double>(vector, op, constant.getDouble(), chunk);
+  }
+  int64_t value = constant.getBigInt();
+  if (value >= std::numeric_limits<T>::min() &&
+      value <= std::numeric_limits<T>::max()) {
+    return selectFixed<T>(vector, op, static_cast<T>(value), chunk);
+  }
+  return selectFixed<T, int64_t>(vector, op, value, chunk);
+}
+
+std::size_t selectVarchar(const Vector &vector, CompareOp op,
+                          std::string_view constant, DataChunk &chunk) {
+  uint16_t *out = chunk.getSelectionBuffer();
+  std::size_t in_count = chunk.getCount();
+  std::size_t count = 0;
+  for (std::size_t i = 0; i < in_count; i++) {
+    uint16_t row = chunk.getRowIndex(i);
+    if (!vector.isNull(row) && compare(op, vector.getString(row), constant)) {
+      out[count++] = row;
+    }
+  }
+  chunk.setSelection(count);
+  return count;
+}
+
+} // namespace
+
+std::size_t FilterOperator::select(DataChunk &chunk,
+                                   const Predicate &predicate) {
+  const Vector &vector = chunk.getColumn(predicate.col_idx);
+  const Value &constant = predicate.constant;
+
+  if (constant.isNull()) {
+    chunk.setSelection(0);
+    return 0;
+  }
+
+  switch (vector.getType()) {
+  case TypeId::BOOLEAN:
+    return selectInteger<char>(vector, predicate.op, constant, chunk);
+  case TypeId::INTEGER:
+    return selectInteger<int32_t>(vector, predicate.op, constant, chunk);
+  case TypeId::BIGINT:
+    return selectInteger<int64_t>(vector, predicate.op, constant, chunk);
+  case TypeId::DOUBLE:
+    return selectFixed<double>(vector, predicate.op, constant.getDouble(),
+                               chunk);
+  case TypeId::VARCHAR:
+    return selectVarchar(vector, predicate.op, constant.getVarchar(), chunk);
+  }
+  return 0;
+}
+
+bool FilterOperator::next(DataChunk &chunk) {
+  // pull until a batch keeps at least one row, so parents never see empties
+  while (child->next(chunk)) {
+    std::size_t remaining = chunk.getCount();
+    for (const Predicate &predicate : predicates) {
+      if (remaining == 0) {
+        break;
+      }
+      remaining = select(chunk, predicate);
+    }
+    if (remaining > 0) {
+      return true;
+    }
+  }
+  return false;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Operator.hpp"
+#include "Value.hpp"
+#include <memory>
+#include <vector>
+
+enum class CompareOp { EQ, NE, LT, LE, GT, GE };
+
+// <column> <op> <constant>; NULL never matches
+struct Predicate {
+  uint32_t col_idx;
+  CompareOp op;
+  Value constant;
+};
+
+// Keeps the rows satisfying all predicates (AND) by narrowing the chunk's
+// selection vector, no column data is copied
+class FilterOperator : public Operator {
+private:
+  std::unique_ptr<Operator> child;
+  std::vector<Predicate> predicates;
+
+public:
+  FilterOperator(std::unique_ptr<Operator> childOperator,
+                 std::vector<Predicate> filterPredicates)
+      : child(std::move(childOperator)),
+        predicates(std::move(filterPredicates)) {}
+
+  const Schema &getOutputSchema() const override {
+    return child->getOutputSchema();
+  }
+
+  bool next(DataChunk &chunk) override;
+
+  bool failed() const override { return child->failed(); }
+
+  // narrows chunk's selection to the rows matching predicate, returns the
+  // number of rows left
+  static std::size_t select(DataChunk &chunk, const Predicate &predicate);
+
+  // numeric coercion of column <op> constant, shared with zone map pruning:
+  // a DOUBLE on either side compares as double, integer-family columns
+  // against an integer constant compare as int64
+  static bool comparesAsDouble(TypeId columnType, const Value &constant) {
+    return columnType == TypeId::DOUBLE ||
+           constant.getType() == TypeId::DOUBLE;
+  }
+};
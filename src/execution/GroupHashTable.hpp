@@ -0,0 +1,112 @@
+#pragma once
+
+#include "Aggregate.hpp"
+#include "RowConversion.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+// Open-addressing (linear probing) map from an integer group key to a dense
+// group id; each group owns `stride` consecutive AggregateStates. NULL keys
+// form one extra group. Grows by doubling at 50% load.
+class GroupHashTable {
+private:
+  struct Entry {
+    int64_t key;
+    uint32_t group;
+    uint32_t occupied;
+  };
+
+  static constexpr uint32_t kNoGroup = UINT32_MAX;
+
+  std::size_t stride;
+  std::vector<Entry> entries;
+  uint64_t mask = 0;
+  std::vector<int64_t> keys; // by group id
+  std::vector<AggregateState> states;
+  uint32_t null_group = kNoGroup;
+
+  void place(int64_t key, uint32_t group) {
+    uint64_t pos = hashKey(key) & mask;
+    while (entries[pos].occupied) {
+      pos = (pos + 1) & mask;
+    }
+    entries[pos] = Entry{key, group, 1};
+  }
+
+  void grow() {
+    entries.assign(entries.size() * 2, Entry{0, 0, 0});
+    mask = entries.size() - 1;
+    for (uint32_t group = 0; group < keys.size(); group++) {
+      if (group != null_group) {
+        place(keys[group], group);
+      }
+    }
+  }
+
+  uint32_t addGroup(int64_t key) {
+    keys.push_back(key);
+    states.resize(states.size() + stride);
+    return static_cast<uint32_t>(keys.size() - 1);
+  }
+
+public:
+  explicit GroupHashTable(std::size_t aggregates = 0,
+                          std::size_t capacity = 16)
+      : stride(aggregates) {
+    std::size_t slots = 16;
+    while (slots < capacity * 2) {
+      slots <<= 1;
+    }
+    entries.assign(slots, Entry{0, 0, 0});
+    mask = slots - 1;
+  }
+
+  std::size_t size() const { return keys.size(); }
+
+  // drops every group but keeps the allocated slots
+  void clear() {
+    std::fill(entries.begin(), entries.end(), Entry{0, 0, 0});
+    keys.clear();
+    states.clear();
+    null_group = kNoGroup;
+  }
+
+  uint32_t findOrInsert(int64_t key, uint64_t hash) {
+    uint64_t pos = hash & mask;
+    while (entries[pos].occupied) {
+      if (entries[pos].key == key) {
+        return entries[pos].group;
+      }
+      pos = (pos + 1) & mask;
+    }
+    uint32_t group = addGroup(key);
+    entries[pos] = Entry{key, group, 1};
+    if (keys.size() * 2 > entries.size()) {
+      grow();
+    }
+    return group;
+  }
+
+  uint32_t findOrInsertNull() {
+    if (null_group == kNoGroup) {
+      null_group = addGroup(0);
+    }
+    return null_group;
+  }
+
+  bool isNullGroup(uint32_t group) const { return group == null_group; }
+
+  int64_t getKey(uint32_t group) const { return keys[group]; }
+
+  AggregateState *getStates(uint32_t group) {
+    return states.data() + group * stride;
+  }
+
+  const AggregateState *getStates(uint32_t group) const {
+    return states.data() + group * stride;
+  }
+
+  // first state of aggregate 0; group g, aggregate a is at [g * stride + a]
+  AggregateState *getStateArray() { return states.data(); }
+};
@@ -0,0 +1,450 @@
+#include "HashAggregateOperator.hpp"
+#include <algorithm>
+#include <string>
+#include <thread>
+
+namespace {
+
+// groups a worker pre-aggregates before flushing (fits in L2 with states)
+constexpr std::size_t kLocalGroups = 4 * VECTOR_SIZE;
+
+} // namespace
+
+HashAggregateOperator::HashAggregateOperator(
+    std::unique_ptr<ParallelSeqScan> parallelScan, uint32_t groupCol,
+    std::vector<AggregateSpec> aggregateSpecs, std::size_t numThreads,
+    BufferPoolManager *bufferPool, std::size_t memoryBudget,
+    uint32_t radixBits)
+    : scan(std::move(parallelScan)), group_col(groupCol),
+      aggregates(std::move(aggregateSpecs)),
+      num_threads(numThreads == 0 ? 1 : numThreads), bpm(bufferPool),
+      memory_budget(memoryBudget), radix_bits(radixBits),
+      workers(num_threads) {
+  const Schema &input = scan->getOutputSchema();
+  std::vector<Column> columns;
+  columns.push_back(input.getColumn(group_col));
+  for (std::size_t i = 0; i < aggregates.size(); i++) {
+    columns.emplace_back("agg_" + std::to_string(i),
+                         getAggregateResultType(aggregates[i], input));
+  }
+  output_schema = Schema(std::move(columns));
+
+  for (Worker &worker : workers) {
+    worker.table = GroupHashTable(aggregates.size(), kLocalGroups);
+    worker.partitions.resize(static_cast<std::size_t>(1) << radix_bits);
+    for (PartitionBuffer &partition : worker.partitions) {
+      partition.spill = SpillWriter(bpm);
+    }
+    worker.group_ids.resize(VECTOR_SIZE);
+  }
+}
+
+HashAggregateOperator::~HashAggregateOperator() {
+  for (Worker &worker : workers) {
+    for (PartitionBuffer &partition : worker.partitions) {
+      partition.spill.release();
+    }
+  }
+  for (SplitPartition &split : splits) {
+    split.spill.release();
+  }
+}
+
+void HashAggregateOperator::consume(Worker &worker, const DataChunk &chunk) {
+  std::size_t count = chunk.getCount();
+  if (worker.table.size() + count > kLocalGroups) {
+    flush(worker);
+  }
+
+  // resolve every row's group first: the state array may move while groups
+  // are added
+  const Vector &keys = chunk.getColumn(group_col);
+  for (std::size_t i = 0; i < count; i++) {
+    uint16_t row = chunk.getRowIndex(i);
+    if (keys.isNull(row)) {
+      worker.group_ids[i] = worker.table.findOrInsertNull();
+    } else {
+      int64_t key = getIntegerKey(keys, row);
+      worker.group_ids[i] = worker.table.findOrInsert(key, hashKey(key));
+    }
+  }
+
+  const uint16_t *selection =
+      chunk.hasSelection() ? chunk.getSelection() : nullptr;
+  for (std::size_t a = 0; a < aggregates.size(); a++) {
+    updateGroupedAggregate(worker.table.getStateArray() + a, aggregates.size(),
+                           aggregates[a],
+                           chunk.getColumn(aggregates[a].col_idx), selection,
+                           worker.group_ids.data(), count);
+  }
+}
+
+void HashAggregateOperator::flush(Worker &worker) {
+  std::size_t record_size = getRecordSize();
+  std::size_t flushed = 0;
+  GroupHashTable &table = worker.table;
+
+  for (uint32_t group = 0; group < table.size(); group++) {
+    // record: {key, is_null, states...}
+    int64_t header[2] = {table.getKey(group), table.isNullGroup(group)};
+    uint32_t partition =
+        table.isNullGroup(group) ? 0 : partitionOf(hashKey(header[0]));
+    std::vector<char> &bytes = worker.partitions[partition].bytes;
+    std::size_t start = bytes.size();
+    bytes.resize(start + record_size);
+    memcpy(bytes.data() + start, header, sizeof(header));
+    memcpy(bytes.data() + start + sizeof(header), table.getStates(group),
+           aggregates.size() * sizeof(AggregateState));
+    flushed += record_size;
+  }
+  worker.partial_groups += table.size();
+  table.clear();
+
+  if (memory_used.fetch_add(flushed) + flushed > memory_budget) {
+    spillLargest(worker);
+  }
+}
+
+void HashAggregateOperator::spillLargest(Worker &worker) {
+  std::size_t record_size = getRecordSize();
+  while (memory_used.load() > memory_budget) {
+    PartitionBuffer *largest = nullptr;
+    for (PartitionBuffer &partition : worker.partitions) {
+      if (largest == nullptr ||
+          partition.bytes.size() > largest->bytes.size()) {
+        largest = &partition;
+      }
+    }
+    if (largest == nullptr || largest->bytes.empty()) {
+      return; // the rest of the memory belongs to other workers
+    }
+
+    for (std::size_t offset = 0; offset < largest->bytes.size();
+         offset += record_size) {
+      if (!largest->spill.append(largest->bytes.data() + offset,
+                                 static_cast<uint16_t>(record_size))) {
+        // the groups are partly spilled: they cannot be merged correctly
+        std::cerr << "Could not spill partial groups\n";
+        error = true;
+        return;
+      }
+    }
+    largest->spill.finish();
+    worker.spilled_groups += largest->bytes.size() / record_size;
+    memory_used.fetch_sub(largest->bytes.size());
+    std::vector<char>().swap(largest->bytes);
+  }
+}
+
+void HashAggregateOperator::mergeRecord(GroupHashTable &table,
+                                        const char *record) const {
+  int64_t header[2];
+  memcpy(header, record, sizeof(header));
+  uint32_t group = header[1] ? table.findOrInsertNull()
+                             : table.findOrInsert(header[0],
+                                                  hashKey(header[0]));
+  AggregateState *states = table.getStates(group);
+  const char *partial = record + sizeof(header);
+  for (std::size_t a = 0; a < aggregates.size(); a++) {
+    AggregateState state;
+    memcpy(&state, partial + a * sizeof(AggregateState), sizeof(state));
+    states[a].merge(aggregates[a].type, state);
+  }
+}
+
+template <typename Visit>
+bool HashAggregateOperator::readSpill(const SpillWriter &spill,
+                                      Visit &&visit) const {
+  for (page_id_t page_id : spill.getPageIds()) {
+    Page *page = bpm->fetchPage(page_id);
+    if (page == nullptr) {
+      std::cerr << "Could not fetch spilled groups page " << page_id
+                << "\n";
+      return false;
+    }
+    bool ok = true;
+    for (uint16_t slot = 0; ok && slot < page->getNumberOfSlots(); slot++) {
+      ok = visit(page->getRecord(slot));
+    }
+    bpm->unpinPage(page_id, false);
+    if (!ok) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool HashAggregateOperator::splitRecord(std::vector<SplitPartition> &subs,
+                                        const char *record) const {
+  int64_t header[2];
+  memcpy(header, record, sizeof(header));
+  // every sub-partition has the same shift
+  uint32_t shift = subs[0].shift;
+  uint32_t sub = header[1] ? 0 : partitionOf(hashKey(header[0]), shift);
+  if (!subs[sub].spill.append(record,
+                              static_cast<uint16_t>(getRecordSize()))) {
+    std::cerr << "Could not spill split partial groups\n";
+    return false;
+  }
+  return true;
+}
+
+void HashAggregateOperator::pushSplits(std::vector<SplitPartition> &subs) {
+  for (SplitPartition &sub : subs) {
+    sub.spill.finish();
+    if (sub.spill.getRecordsWritten() > 0) {
+      splits.push_back(std::move(sub));
+    }
+  }
+}
+
+std::size_t
+HashAggregateOperator::getPartialBytes(std::size_t partition) const {
+  std::size_t bytes = 0;
+  for (const Worker &worker : workers) {
+    const PartitionBuffer &buffer = worker.partitions[partition];
+    bytes += buffer.bytes.size() +
+             buffer.spill.getRecordsWritten() * getRecordSize();
+  }
+  return bytes;
+}
+
+bool HashAggregateOperator::mergePartition(std::size_t partition) {
+  std::size_t record_size = getRecordSize();
+  GroupHashTable &table = results[partition];
+
+  for (Worker &worker : workers) {
+    PartitionBuffer &buffer = worker.partitions[partition];
+    for (std::size_t offset = 0; offset < buffer.bytes.size();
+         offset += record_size) {
+      mergeRecord(table, buffer.bytes.data() + offset);
+    }
+    memory_used.fetch_sub(buffer.bytes.size());
+    std::vector<char>().swap(buffer.bytes);
+
+    if (!readSpill(buffer.spill, [&](const char *record) {
+          mergeRecord(table, record);
+          return true;
+        })) {
+      return false;
+    }
+    buffer.spill.release();
+  }
+  return true;
+}
+
+bool HashAggregateOperator::splitPartition(std::size_t partition) {
+  std::size_t record_size = getRecordSize();
+  std::vector<SplitPartition> subs(static_cast<std::size_t>(1)
+                                   << radix_bits);
+  for (SplitPartition &sub : subs) {
+    sub.spill = SpillWriter(bpm);
+    sub.shift = radix_bits;
+  }
+  auto split = [&](const char *record) { return splitRecord(subs, record); };
+
+  bool ok = true;
+  for (Worker &worker : workers) {
+    PartitionBuffer &buffer = worker.partitions[partition];
+    for (std::size_t offset = 0; ok && offset < buffer.bytes.size();
+         offset += record_size) {
+      ok = split(buffer.bytes.data() + offset);
+    }
+    memory_used.fetch_sub(buffer.bytes.size());
+    std::vector<char>().swap(buffer.bytes);
+    ok = ok && readSpill(buffer.spill, split);
+    buffer.spill.release();
+  }
+  stats.split_partitions++;
+  pushSplits(subs);
+  return ok;
+}
+
+bool HashAggregateOperator::mergeSplit() {
+  SplitPartition split = std::move(splits.back());
+  splits.pop_back();
+
+  bool ok;
+  if (needsSplit(split.spill.getRecordsWritten() * getRecordSize(),
+                 split.shift)) {
+    std::vector<SplitPartition> subs(static_cast<std::size_t>(1)
+                                     << radix_bits);
+    for (SplitPartition &sub : subs) {
+      sub.spill = SpillWriter(bpm);
+      sub.shift = split.shift + radix_bits;
+    }
+    ok = readSpill(split.spill, [&](const char *record) {
+      return splitRecord(subs, record);
+    });
+    stats.split_partitions++;
+    pushSplits(subs);
+  } else {
+    split_groups = GroupHashTable(aggregates.size());
+    ok = readSpill(split.spill, [&](const char *record) {
+      mergeRecord(split_groups, record);
+      return true;
+    });
+    split_loaded = true;
+    stats.groups += split_groups.size();
+    stats.peak_merged_groups =
+        std::max(stats.peak_merged_groups, split_groups.size());
+  }
+  split.spill.release();
+  return ok;
+}
+
+bool HashAggregateOperator::aggregate() {
+  if (!scan->execute(num_threads,
+                     [this](std::size_t worker, DataChunk &chunk) {
+                       consume(workers[worker], chunk);
+                     })) {
+    // groups over part of the input would be wrong, not just incomplete
+    error = true;
+    return false;
+  }
+  for (Worker &worker : workers) {
+    flush(worker);
+    for (PartitionBuffer &partition : worker.partitions) {
+      partition.spill.finish();
+    }
+  }
+
+  std::size_t num_partitions = static_cast<std::size_t>(1) << radix_bits;
+  for (std::size_t p = 0; p < num_partitions; p++) {
+    bool spilled = false;
+    for (const Worker &worker : workers) {
+      spilled |= !worker.partitions[p].spill.getPageIds().empty();
+    }
+    stats.spilled_partitions += spilled;
+  }
+  for (const Worker &worker : workers) {
+    stats.partial_groups += worker.partial_groups;
+    stats.spilled_groups += worker.spilled_groups;
+  }
+  results.assign(num_partitions, GroupHashTable(aggregates.size()));
+  return !error;
+}
+
+bool HashAggregateOperator::mergeWindow() {
+  // final groups never outnumber the partial ones: the window's partial
+  // bytes bound what it holds in memory
+  std::size_t begin = merged_end;
+  if (needsSplit(getPartialBytes(begin), 0)) {
+    // results[begin] stays empty, its groups come from the splits
+    merged_end++;
+    if (!splitPartition(begin)) {
+      error = true;
+    }
+    return !error;
+  }
+  std::size_t bytes = getPartialBytes(merged_end++);
+  while (merged_end < results.size() && merged_end - begin < num_threads &&
+         bytes + getPartialBytes(merged_end) <= memory_budget) {
+    bytes += getPartialBytes(merged_end++);
+  }
+
+  // partitions are independent: workers claim them from a shared cursor
+  std::atomic<std::size_t> next_partition{begin};
+  auto merger = [&]() {
+    for (std::size_t p = next_partition.fetch_add(1); p < merged_end;
+         p = next_partition.fetch_add(1)) {
+      if (!mergePartition(p)) {
+        error = true;
+      }
+    }
+  };
+  std::size_t threads = std::min(num_threads, merged_end - begin);
+  if (threads <= 1) {
+    merger();
+  } else {
+    std::vector<std::thread> mergers;
+    mergers.reserve(threads);
+    for (std::size_t i = 0; i < threads; i++) {
+      mergers.emplace_back(merger);
+    }
+    for (std::thread &thread : mergers) {
+      thread.join();
+    }
+  }
+
+  std::size_t groups = 0;
+  for (std::size_t p = begin; p < merged_end; p++) {
+    groups += results[p].size();
+  }
+  stats.groups += groups;
+  stats.peak_merged_groups = std::max(stats.peak_merged_groups, groups);
+  return !error;
+}
+
+bool HashAggregateOperator::emitGroups(const GroupHashTable &table,
+                                       DataChunk &chunk, std::size_t *count) {
+  TypeId key_type = output_schema.getType(0);
+  Vector &keys = chunk.getColumn(0);
+
+  for (; group_cursor < table.size() && *count < VECTOR_SIZE;
+       group_cursor++, (*count)++) {
+    uint32_t group = static_cast<uint32_t>(group_cursor);
+    std::size_t row = *count;
+    keys.setNull(row, table.isNullGroup(group));
+    int64_t key = table.getKey(group);
+    if (key_type == TypeId::BOOLEAN) {
+      keys.getData<char>()[row] = static_cast<char>(key);
+    } else if (key_type == TypeId::INTEGER) {
+      keys.getData<int32_t>()[row] = static_cast<int32_t>(key);
+    } else {
+      keys.getData<int64_t>()[row] = key;
+    }
+
+    const AggregateState *states = table.getStates(group);
+    for (std::size_t a = 0; a < aggregates.size(); a++) {
+      uint32_t column = static_cast<uint32_t>(a + 1);
+      states[a].writeResult(aggregates[a].type, output_schema.getType(column),
+                            chunk.getColumn(column), row);
+    }
+  }
+  if (group_cursor < table.size()) {
+    return false;
+  }
+  group_cursor = 0;
+  return true;
+}
+
+bool HashAggregateOperator::next(DataChunk &chunk) {
+  if (error) {
+    return false;
+  }
+  if (!aggregated) {
+    aggregated = true;
+    if (!aggregate()) {
+      return false;
+    }
+  }
+
+  std::size_t count = 0;
+  while (count < VECTOR_SIZE) {
+    if (split_loaded) {
+      if (emitGroups(split_groups, chunk, &count)) {
+        split_groups = GroupHashTable();
+        split_loaded = false;
+      }
+    } else if (!splits.empty()) {
+      if (!mergeSplit()) {
+        error = true;
+        return false;
+      }
+    } else if (partition_cursor < results.size()) {
+      if (partition_cursor == merged_end && !mergeWindow()) {
+        return false;
+      }
+      if (emitGroups(results[partition_cursor], chunk, &count)) {
+        results[partition_cursor] = GroupHashTable();
+        partition_cursor++;
+      }
+    } else {
+      break;
+    }
+  }
+
+  chunk.setSize(count);
+  return count > 0;
+}
@@ -0,0 +1,151 @@
+/* Hash aggregation requirements
+1. GROUP BY one integer-family column (BOOLEAN / INTEGER / BIGINT) of a
+ParallelSeqScan's output; NULL keys form their own group
+2. Every worker pre-aggregates its batches in a small thread-local hash
+table; when it fills up, the partial groups are flushed into per-worker
+buffers, radix partitioned on the high bits of the key hash
+3. When the flushed partial groups exceed the memory budget, a worker writes
+its largest buffers to temporary pages through the BufferPoolManager
+4. Merge phase: partitions are claimed by the workers one at a time and their
+partial groups (buffered and spilled) are combined into the final groups, so
+partitions merge in parallel without any shared table
+5. Partitions are merged lazily, a window at a time: a window holds at most
+one partition per worker and no more partial groups than the memory budget.
+Its final groups are emitted and released before the next window is merged
+6. A partition whose partial groups alone exceed the memory budget is split
+on further bits of the key hash into spilled sub-partitions, which are
+merged and emitted one at a time (split again while still too large and
+hash bits remain)
+7. A scanned page or spill page that cannot be read (or a spill page that
+cannot be written) stops the aggregation with failed() set instead of
+producing wrong groups
+8. Output columns: the group key followed by one column per aggregate
+*/
+#pragma once
+
+#include "Aggregate.hpp"
+#include "GroupHashTable.hpp"
+#include "Operator.hpp"
+#include "ParallelSeqScan.hpp"
+#include "SpillWriter.hpp"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+struct HashAggregateStats {
+  std::size_t groups = 0;
+  std::size_t partial_groups = 0; // groups flushed by the pre-aggregation
+  std::size_t spilled_partitions = 0;
+  std::size_t spilled_groups = 0;
+  std::size_t peak_merged_groups = 0; // final groups held at one time
+  std::size_t split_partitions = 0;   // oversized partitions split again
+};
+
+class HashAggregateOperator : public Operator {
+private:
+  struct PartitionBuffer {
+    std::vector<char> bytes; // serialized partial groups
+    SpillWriter spill;
+  };
+
+  // one per worker, cache-line aligned so workers do not false-share
+  struct alignas(64) Worker {
+    GroupHashTable table;
+    std::vector<PartitionBuffer> partitions;
+    std::vector<uint32_t> group_ids;
+    std::size_t partial_groups = 0;
+    std::size_t spilled_groups = 0;
+  };
+
+  // partial groups of an oversized partition, partitioned on the hash bits
+  // after the first `shift`
+  struct SplitPartition {
+    SpillWriter spill;
+    uint32_t shift = 0;
+  };
+
+  std::unique_ptr<ParallelSeqScan> scan;
+  uint32_t group_col;
+  std::vector<AggregateSpec> aggregates;
+  std::size_t num_threads;
+  BufferPoolManager *bpm;
+  std::size_t memory_budget;
+  uint32_t radix_bits;
+  Schema output_schema;
+
+  std::vector<Worker> workers;
+  std::atomic<std::size_t> memory_used{0};
+  std::atomic<bool> error{false};
+  // final groups per partition, only [partition_cursor, merged_end) are
+  // filled
+  std::vector<GroupHashTable> results;
+  bool aggregated = false;
+  std::size_t partition_cursor = 0;
+  std::size_t merged_end = 0;
+  std::size_t group_cursor = 0;
+  // sub-partitions still to merge, taken last-in first-out
+  std::vector<SplitPartition> splits;
+  GroupHashTable split_groups;
+  bool split_loaded = false;
+  HashAggregateStats stats;
+
+  std::size_t getRecordSize() const {
+    return 2 * sizeof(int64_t) + aggregates.size() * sizeof(AggregateState);
+  }
+
+  // radix_bits of the hash after skipping the first `shift`
+  uint32_t partitionOf(uint64_t hash, uint32_t shift = 0) const {
+    if (radix_bits == 0) {
+      return 0;
+    }
+    return static_cast<uint32_t>((hash << shift) >> (64 - radix_bits));
+  }
+
+  // the partition is too large to merge and more hash bits remain
+  bool needsSplit(std::size_t bytes, uint32_t shift) const {
+    return bytes > memory_budget && radix_bits > 0 &&
+           shift + 2 * radix_bits <= 64;
+  }
+
+  void consume(Worker &worker, const DataChunk &chunk);
+  void flush(Worker &worker);
+  void spillLargest(Worker &worker);
+  void mergeRecord(GroupHashTable &table, const char *record) const;
+  // calls visit on every record of the spilled pages
+  template <typename Visit>
+  bool readSpill(const SpillWriter &spill, Visit &&visit) const;
+  bool splitRecord(std::vector<SplitPartition> &subs,
+                   const char *record) const;
+  void pushSplits(std::vector<SplitPartition> &subs);
+  // partial groups of a partition, buffered or spilled, in bytes
+  std::size_t getPartialBytes(std::size_t partition) const;
+  bool mergePartition(std::size_t partition);
+  bool splitPartition(std::size_t partition);
+  // splits the last sub-partition again or merges it into split_groups
+  bool mergeSplit();
+  // merges the next window of partitions from merged_end
+  bool mergeWindow();
+  bool aggregate();
+  // writes groups from group_cursor on; true once the table is exhausted
+  bool emitGroups(const GroupHashTable &table, DataChunk &chunk,
+                  std::size_t *count);
+
+public:
+  // memory_budget in bytes for flushed partial groups; 2^radix_bits
+  // partitions
+  HashAggregateOperator(std::unique_ptr<ParallelSeqScan> parallelScan,
+                        uint32_t groupCol,
+                        std::vector<AggregateSpec> aggregateSpecs,
+                        std::size_t numThreads, BufferPoolManager *bufferPool,
+                        std::size_t memoryBudget, uint32_t radixBits = 4);
+
+  ~HashAggregateOperator() override;
+
+  const Schema &getOutputSchema() const override { return output_schema; }
+
+  bool next(DataChunk &chunk) override;
+
+  bool failed() const override { return error; }
+
+  const HashAggregateStats &getStats() const { return stats; }
+};
@@ -0,0 +1,354 @@
+#include "HashJoinOperator.hpp"
+#include "RowConversion.hpp"
+
+namespace {
+
+// approximate bytes one in-memory build row costs (row + key + chain link +
+// table slots)
+constexpr std::size_t kRowOverhead =
+    sizeof(int64_t) + 2 * sizeof(uint32_t) + 32;
+
+} // namespace
+
+HashJoinOperator::HashJoinOperator(std::unique_ptr<Operator> buildChild,
+                                   std::unique_ptr<Operator> probeChild,
+                                   uint32_t buildKey, uint32_t probeKey,
+                                   BufferPoolManager *bufferPool,
+                                   std::size_t memoryBudget,
+                                   uint32_t radixBits)
+    : build_child(std::move(buildChild)), probe_child(std::move(probeChild)),
+      build_key(buildKey), probe_key(probeKey), bpm(bufferPool),
+      memory_budget(memoryBudget), radix_bits(radixBits),
+      partitions(static_cast<std::size_t>(1) << radixBits) {
+  output_schema = Schema::merge(build_child->getOutputSchema(),
+                                probe_child->getOutputSchema());
+  probe_chunk.initialize(probe_child->getOutputSchema());
+  for (Partition &partition : partitions) {
+    partition.build_spill = SpillWriter(bpm);
+    partition.probe_spill = SpillWriter(bpm);
+  }
+}
+
+bool HashJoinOperator::spillRow(SpillWriter &spill,
+                                const TupleBuilder &builder) {
+  scratch.resize(builder.getSerializedLength());
+  builder.serializeTo(scratch.data());
+  return spill.append(scratch.data(), static_cast<uint16_t>(scratch.size()));
+}
+
+bool HashJoinOperator::spillPartition(Partition &partition) {
+  for (std::size_t i = 0; i < partition.rows.size(); i++) {
+    if (!partition.build_spill.append(partition.rows.getRow(i),
+                                      partition.rows.getRowLength(i))) {
+      return false;
+    }
+  }
+  stats.spilled_partitions++;
+  stats.spilled_build_rows += partition.rows.size();
+  memory_used -= partition.rows.getMemoryUsage() +
+                 partition.keys.size() * kRowOverhead;
+  partition.rows.clear();
+  std::vector<int64_t>().swap(partition.keys);
+  partition.spilled = true;
+  return true;
+}
+
+void HashJoinOperator::buildTable(Partition &partition) {
+  partition.table.reset(partition.keys.size());
+  for (std::size_t i = 0; i < partition.keys.size(); i++) {
+    partition.table.insert(partition.keys[i], hashKey(partition.keys[i]),
+                           static_cast<uint32_t>(i));
+  }
+}
+
+bool HashJoinOperator::build() {
+  const Schema &build_schema = build_child->getOutputSchema();
+  DataChunk chunk(build_schema);
+  TupleBuilder builder(build_schema);
+
+  while (build_child->next(chunk)) {
+    const Vector &keys = chunk.getColumn(build_key);
+    for (std::size_t i = 0; i < chunk.getCount(); i++) {
+      uint16_t row = chunk.getRowIndex(i);
+      if (keys.isNull(row)) {
+        continue;
+      }
+      int64_t key = getIntegerKey(keys, row);
+      Partition &partition = partitions[partitionOf(hashKey(key))];
+
+      for (uint32_t c = 0; c < build_schema.getColumnCount(); c++) {
+        setBuilderFromVector(builder, c, chunk.getColumn(c), row);
+      }
+      // any build row may have to be spilled later
+      if (!builder.fitsInPage()) {
+        std::cerr << "Hash join build row does not fit in a spill page\n";
+        return false;
+      }
+
+      if (partition.spilled) {
+        if (!spillRow(partition.build_spill, builder)) {
+          return false;
+        }
+        stats.spilled_build_rows++;
+        continue;
+      }
+
+      std::size_t before = partition.rows.getMemoryUsage();
+      partition.rows.append(builder);
+      partition.keys.push_back(key);
+      memory_used += partition.rows.getMemoryUsage() - before + kRowOverhead;
+
+      // over budget: spill the largest partition still in memory
+      while (memory_used > memory_budget) {
+        Partition *largest = nullptr;
+        for (Partition &candidate : partitions) {
+          if (!candidate.spilled &&
+              (largest == nullptr ||
+               candidate.rows.size() > largest->rows.size())) {
+            largest = &candidate;
+          }
+        }
+        if (largest == nullptr || largest->rows.size() == 0) {
+          break;
+        }
+        if (!spillPartition(*largest)) {
+          return false;
+        }
+      }
+    }
+  }
+  if (build_child->failed()) {
+    return false;
+  }
+
+  for (Partition &partition : partitions) {
+    if (partition.spilled) {
+      partition.build_spill.finish();
+    } else {
+      buildTable(partition);
+    }
+  }
+  return true;
+}
+
+bool HashJoinOperator::loadSpilledPartition(Partition &partition) {
+  const Schema &build_schema = build_child->getOutputSchema();
+  for (page_id_t page_id : partition.build_spill.getPageIds()) {
+    Page *page = bpm->fetchPage(page_id);
+    if (page == nullptr) {
+      std::cerr << "Could not fetch spilled build page " << page_id << "\n";
+      return false;
+    }
+    for (uint16_t slot = 0; slot < page->getNumberOfSlots(); slot++) {
+      Tuple tuple(&build_schema, page->getRecord(slot),
+                  page->getRecordLength(slot));
+      partition.rows.append(tuple.getData(), tuple.getLength());
+      partition.keys.push_back(getIntegerKey(tuple, build_key));
+    }
+    bpm->unpinPage(page_id, false);
+  }
+  partition.build_spill.release();
+  buildTable(partition);
+  partition.spilled = false;
+  return true;
+}
+
+void HashJoinOperator::joinSpilledPartition(Partition &partition) {
+  spilled_join = std::make_unique<HashJoinOperator>(
+      std::make_unique<SeqScanOperator>(bpm,
+                                        partition.build_spill.getPageIds(),
+                                        build_child->getOutputSchema()),
+      std::make_unique<SeqScanOperator>(bpm,
+                                        partition.probe_spill.getPageIds(),
+                                        probe_child->getOutputSchema()),
+      build_key, probe_key, bpm, memory_budget, radix_bits);
+  spilled_join->radix_shift = radix_shift + radix_bits;
+  stats.repartitioned++;
+}
+
+void HashJoinOperator::releasePartition(Partition &partition) {
+  partition.build_spill.release();
+  partition.probe_spill.release();
+  partition.rows.clear();
+  std::vector<int64_t>().swap(partition.keys);
+  partition.table.reset(0);
+  partition.spilled = false;
+}
+
+bool HashJoinOperator::probe(const DataChunk &chunk) {
+  const Schema &probe_schema = probe_child->getOutputSchema();
+  const Vector &keys = chunk.getColumn(probe_key);
+  TupleBuilder builder(probe_schema);
+
+  for (std::size_t i = 0; i < chunk.getCount(); i++) {
+    uint16_t row = chunk.getRowIndex(i);
+    if (keys.isNull(row)) {
+      continue;
+    }
+    int64_t key = getIntegerKey(keys, row);
+    uint64_t hash = hashKey(key);
+    Partition &partition = partitions[partitionOf(hash)];
+
+    if (partition.spilled) {
+      // joined later, once the build partition is back in memory
+      for (uint32_t c = 0; c < probe_schema.getColumnCount(); c++) {
+        setBuilderFromVector(builder, c, chunk.getColumn(c), row);
+      }
+      if (!builder.fitsInPage()) {
+        std::cerr << "Hash join probe row does not fit in a spill page\n";
+        return false;
+      }
+      if (!spillRow(partition.probe_spill, builder)) {
+        return false;
+      }
+      stats.spilled_probe_rows++;
+      continue;
+    }
+
+    partition.table.forEachMatch(key, hash, [&](uint32_t build_row) {
+      matches.emplace_back(row, partition.rows.getRow(build_row));
+    });
+  }
+  return true;
+}
+
+void HashJoinOperator::emit(DataChunk &out) {
+  const Schema &build_schema = build_child->getOutputSchema();
+  uint32_t build_columns = build_schema.getColumnCount();
+  std::size_t count =
+      std::min(VECTOR_SIZE, matches.size() - match_cursor);
+  const auto *batch = matches.data() + match_cursor;
+
+  // column-at-a-time: build side from the stored rows, probe side from the
+  // probe chunk's vectors
+  for (uint32_t c = 0; c < build_columns; c++) {
+    Vector &vector = out.getColumn(c);
+    for (std::size_t i = 0; i < count; i++) {
+      setVectorFromTuple(vector, i, Tuple(&build_schema, batch[i].second, 0),
+                         c);
+    }
+  }
+  for (uint32_t c = 0; c < probe_chunk.getColumnCount(); c++) {
+    Vector &vector = out.getColumn(build_columns + c);
+    const Vector &source = probe_chunk.getColumn(c);
+    for (std::size_t i = 0; i < count; i++) {
+      copyVectorValue(vector, i, source, batch[i].first);
+    }
+  }
+
+  match_cursor += count;
+  out.setSize(count);
+}
+
+bool HashJoinOperator::fail() {
+  error = true;
+  phase = Phase::DONE;
+  return false;
+}
+
+bool HashJoinOperator::next(DataChunk &chunk) {
+  if (phase == Phase::BUILD) {
+    phase = Phase::PROBE;
+    if (!build()) {
+      return fail();
+    }
+  }
+
+  for (;;) {
+    if (match_cursor < matches.size()) {
+      emit(chunk);
+      return true;
+    }
+    matches.clear();
+    match_cursor = 0;
+
+    if (phase == Phase::PROBE) {
+      if (probe_child->next(probe_chunk)) {
+        if (!probe(probe_chunk)) {
+          return fail();
+        }
+        continue;
+      }
+      if (probe_child->failed()) {
+        return fail();
+      }
+      // the in-memory partitions are done with: free them for the spilled
+      for (Partition &partition : partitions) {
+        partition.probe_spill.finish();
+        if (!partition.spilled) {
+          releasePartition(partition);
+        }
+      }
+      memory_used = 0;
+      phase = Phase::SPILLED;
+      spilled_cursor = 0;
+    }
+
+    if (phase == Phase::SPILLED) {
+      if (spilled_join) {
+        if (spilled_join->next(chunk)) {
+          return true;
+        }
+        if (spilled_join->failed()) {
+          return fail();
+        }
+        const HashJoinStats &nested = spilled_join->getStats();
+        stats.spilled_partitions += nested.spilled_partitions;
+        stats.spilled_build_rows += nested.spilled_build_rows;
+        stats.spilled_probe_rows += nested.spilled_probe_rows;
+        stats.repartitioned += nested.repartitioned;
+        spilled_join.reset();
+        releasePartition(partitions[spilled_cursor]);
+        spilled_cursor++;
+      } else if (spilled_probe_scan) {
+        if (spilled_probe_scan->next(probe_chunk)) {
+          probe(probe_chunk);
+          continue;
+        }
+        if (spilled_probe_scan->failed()) {
+          return fail();
+        }
+        // partition done, give its memory and temp pages back
+        spilled_probe_scan.reset();
+        releasePartition(partitions[spilled_cursor]);
+        spilled_cursor++;
+      }
+
+      while (spilled_cursor < partitions.size() &&
+             !partitions[spilled_cursor].spilled) {
+        spilled_cursor++;
+      }
+      if (spilled_cursor == partitions.size()) {
+        phase = Phase::DONE;
+        return false;
+      }
+
+      Partition &partition = partitions[spilled_cursor];
+      if (partition.probe_spill.getRecordsWritten() == 0) {
+        // no probe row can match this partition
+        releasePartition(partition);
+        spilled_cursor++;
+        continue;
+      }
+      // still over budget: split it on the next radix bits, unless the
+      // hash has no bits left (then it is loaded whole)
+      std::size_t needed = partition.build_spill.getBytesWritten() +
+                           partition.build_spill.getRecordsWritten() *
+                               (kRowOverhead + sizeof(uint32_t));
+      if (needed > memory_budget && radix_bits > 0 &&
+          radix_shift + 2 * radix_bits <= 64) {
+        joinSpilledPartition(partition);
+        continue;
+      }
+      if (!loadSpilledPartition(partition)) {
+        return fail();
+      }
+      spilled_probe_scan = std::make_unique<SeqScanOperator>(
+          bpm, partition.probe_spill.getPageIds(),
+          probe_child->getOutputSchema());
+      continue;
+    }
+
+    return false;
+  }
+}
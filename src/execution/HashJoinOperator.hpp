@@ -0,0 +1,108 @@
+/* Hash join requirements
+1. Inner equi-join on one integer-family key (BOOLEAN / INTEGER / BIGINT),
+NULL keys never match
+2. Build rows are radix partitioned on the high bits of the key hash, every
+partition gets its own open-addressing hash table, small enough to stay in
+cache for moderate inputs
+3. When the build side exceeds the memory budget, whole partitions are
+spilled to temporary pages through the BufferPoolManager; probe rows that
+fall in a spilled partition are spilled too and joined partition by
+partition after the in-memory probe finishes
+4. A spilled partition that still exceeds the budget is joined by a nested
+join over its spill pages, partitioned on the next radix bits of the hash
+5. A spill page that cannot be written or read stops the join with
+failed() set instead of dropping rows
+6. Output columns: build columns followed by probe columns
+*/
+#pragma once
+
+#include "JoinHashTable.hpp"
+#include "Operator.hpp"
+#include "RowCollection.hpp"
+#include "SeqScanOperator.hpp"
+#include "SpillWriter.hpp"
+#include <memory>
+#include <utility>
+#include <vector>
+
+struct HashJoinStats {
+  std::size_t spilled_partitions = 0;
+  std::size_t spilled_build_rows = 0;
+  std::size_t spilled_probe_rows = 0;
+  std::size_t repartitioned = 0; // partitions joined by a nested join
+};
+
+class HashJoinOperator : public Operator {
+private:
+  struct Partition {
+    RowCollection rows;
+    std::vector<int64_t> keys;
+    JoinHashTable table;
+    bool spilled = false;
+    SpillWriter build_spill;
+    SpillWriter probe_spill;
+  };
+
+  enum class Phase { BUILD, PROBE, SPILLED, DONE };
+
+  std::unique_ptr<Operator> build_child;
+  std::unique_ptr<Operator> probe_child;
+  uint32_t build_key;
+  uint32_t probe_key;
+  BufferPoolManager *bpm;
+  std::size_t memory_budget;
+  uint32_t radix_bits;
+  uint32_t radix_shift = 0; // hash bits used by the enclosing joins
+  Schema output_schema;
+
+  std::vector<Partition> partitions;
+  std::size_t memory_used = 0;
+  Phase phase = Phase::BUILD;
+  std::size_t spilled_cursor = 0;
+  std::unique_ptr<SeqScanOperator> spilled_probe_scan;
+  std::unique_ptr<HashJoinOperator> spilled_join; // oversized partition
+  bool error = false;
+
+  DataChunk probe_chunk;
+  std::vector<std::pair<uint16_t, const char *>> matches; // probe row, build
+  std::size_t match_cursor = 0;
+  std::vector<char> scratch;
+  HashJoinStats stats;
+
+  uint32_t partitionOf(uint64_t hash) const {
+    if (radix_bits == 0) {
+      return 0;
+    }
+    return static_cast<uint32_t>((hash << radix_shift) >> (64 - radix_bits));
+  }
+
+  bool build();
+  bool spillRow(SpillWriter &spill, const TupleBuilder &builder);
+  bool spillPartition(Partition &partition);
+  void buildTable(Partition &partition);
+  bool loadSpilledPartition(Partition &partition);
+  // nested join over the spill pages, on the next radix bits
+  void joinSpilledPartition(Partition &partition);
+  void releasePartition(Partition &partition);
+  bool probe(const DataChunk &chunk);
+  void emit(DataChunk &out);
+  // stops the join after an error; returns false for next()
+  bool fail();
+
+public:
+  // memory_budget in bytes for build rows + hash tables;
+  // 2^radix_bits partitions (each spilled partition pins one page per side
+  // while it is being written)
+  HashJoinOperator(std::unique_ptr<Operator> buildChild,
+                   std::unique_ptr<Operator> probeChild, uint32_t buildKey,
+                   uint32_t probeKey, BufferPoolManager *bufferPool,
+                   std::size_t memoryBudget, uint32_t radixBits = 4);
+
+  const Schema &getOutputSchema() const override { return output_schema; }
+
+  bool next(DataChunk &chunk) override;
+
+  bool failed() const override { return error; }
+
+  const HashJoinStats &getStats() const { return stats; }
+};
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// Open-addressing (linear probing) multimap from int64 keys to row ids.
+// There is one 16-byte entry per distinct key, stored inline, so a probe
+// touches one or two consecutive cache lines instead of chasing bucket
+// chains. Rows with the same key are chained through next_row from the
+// entry's head, so duplicate keys cost O(1) each to insert.
+class JoinHashTable {
+private:
+  static constexpr uint32_t kNoRow = UINT32_MAX;
+
+  struct Entry {
+    int64_t key;
+    uint32_t head; // last row inserted with this key
+    uint32_t occupied;
+  };
+
+  std::vector<Entry> entries;
+  std::vector<uint32_t> next_row; // by row id, kNoRow ends a chain
+  uint64_t mask = 0;
+
+public:
+  // sizes the table for `rows` rows (row ids below rows) at <= 50% load
+  void reset(std::size_t rows) {
+    std::size_t capacity = 16;
+    while (capacity < rows * 2) {
+      capacity <<= 1;
+    }
+    entries.assign(capacity, Entry{0, kNoRow, 0});
+    next_row.assign(rows, kNoRow);
+    mask = capacity - 1;
+  }
+
+  std::size_t getMemoryUsage() const {
+    return entries.size() * sizeof(Entry) +
+           next_row.size() * sizeof(uint32_t);
+  }
+
+  void insert(int64_t key, uint64_t hash, uint32_t row) {
+    uint64_t pos = hash & mask;
+    while (entries[pos].occupied) {
+      if (entries[pos].key == key) {
+        next_row[row] = entries[pos].head;
+        entries[pos].head = row;
+        return;
+      }
+      pos = (pos + 1) & mask;
+    }
+    entries[pos] = Entry{key, row, 1};
+  }
+
+  // calls f(row) for every row with this key
+  template <typename F>
+  void forEachMatch(int64_t key, uint64_t hash, F f) const {
+    uint64_t pos = hash & mask;
+    while (entries[pos].occupied) {
+      if (entries[pos].key == key) {
+        for (uint32_t row = entries[pos].head; row != kNoRow;
+             row = next_row[row]) {
+          f(row);
+        }
+        return;
+      }
+      pos = (pos + 1) & mask;
+    }
+  }
+};
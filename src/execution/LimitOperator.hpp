@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Operator.hpp"
+#include <memory>
+
+// Passes through the first `limit` visible rows, then stops pulling
+class LimitOperator : public Operator {
+private:
+  std::unique_ptr<Operator> child;
+  std::size_t limit;
+  std::size_t produced = 0;
+
+public:
+  LimitOperator(std::unique_ptr<Operator> childOperator, std::size_t maxRows)
+      : child(std::move(childOperator)), limit(maxRows) {}
+
+  const Schema &getOutputSchema() const override {
+    return child->getOutputSchema();
+  }
+
+  bool next(DataChunk &chunk) override {
+    if (produced >= limit || !child->next(chunk)) {
+      return false;
+    }
+
+    std::size_t count = chunk.getCount();
+    if (produced + count > limit) {
+      // keep a prefix of the visible rows
+      std::size_t keep = limit - produced;
+      if (!chunk.hasSelection()) {
+        chunk.setSize(keep);
+      } else {
+        chunk.setSelection(keep);
+      }
+      count = keep;
+    }
+    produced += count;
+    return true;
+  }
+
+  bool failed() const override { return child->failed(); }
+};
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// Tournament tree for k-way merging. Internal nodes keep the loser of the
+// match below them, so replacing the winner costs log2(k) comparisons along
+// one leaf-to-root path (vs. ~2*log2(k) for a binary heap).
+// Beats(a, b) must return true when source a should be emitted before b.
+template <typename Beats> class LoserTree {
+private:
+  std::size_t k;
+  std::vector<std::size_t> tree; // tree[0] = winner, tree[1..k-1] = losers
+  Beats beats;
+
+  // leaves are the virtual nodes k..2k-1 of a heap-ordered tree
+  std::size_t build(std::size_t node) {
+    if (node >= k) {
+      return node - k;
+    }
+    std::size_t left = build(2 * node);
+    std::size_t right = build(2 * node + 1);
+    if (beats(left, right)) {
+      tree[node] = right;
+      return left;
+    }
+    tree[node] = left;
+    return right;
+  }
+
+public:
+  LoserTree(std::size_t sources, Beats beatsFn)
+      : k(sources), tree(sources == 0 ? 1 : sources), beats(beatsFn) {
+    if (k > 0) {
+      tree[0] = build(1);
+    }
+  }
+
+  std::size_t winner() const { return tree[0]; }
+
+  // call after the winning source advanced to its next element
+  void replay() {
+    std::size_t winner = tree[0];
+    for (std::size_t node = (winner + k) >> 1; node > 0; node >>= 1) {
+      if (beats(tree[node], winner)) {
+        std::swap(tree[node], winner);
+      }
+    }
+    tree[0] = winner;
+  }
+};
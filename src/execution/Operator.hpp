@@ -0,0 +1,26 @@
+/* Execution requirements
+1. Operators form a pull-based tree, but each call moves a whole batch
+(DataChunk of up to VECTOR_SIZE rows) instead of a single tuple
+2. The caller initializes the chunk with getOutputSchema() and passes the same
+chunk to every next() call so vectors are reused between batches
+3. next() returns false once the operator is exhausted, or once it had to
+stop on an error (e.g. no frame left for a spill page); failed() tells the
+two apart, so a truncated result is never mistaken for a complete one
+*/
+#pragma once
+
+#include "DataChunk.hpp"
+#include "storage/Schema.hpp"
+
+class Operator {
+public:
+  virtual ~Operator() = default;
+
+  virtual const Schema &getOutputSchema() const = 0;
+
+  // fills chunk with the next batch, false when there are no more rows
+  virtual bool next(DataChunk &chunk) = 0;
+
+  // true when next() returned false because of an error
+  virtual bool failed() const { return false; }
+};
@@ -0,0 +1,64 @@
+#include "ParallelAggregateOperator.hpp"
+#include <string>
+
+namespace {
+
+// one cache line per worker so partial states do not false-share
+struct alignas(64) WorkerStates {
+  std::vector<AggregateState> states;
+};
+
+} // namespace
+
+ParallelAggregateOperator::ParallelAggregateOperator(
+    std::unique_ptr<ParallelSeqScan> parallelScan,
+    std::vector<AggregateSpec> aggregateSpecs, std::size_t numThreads)
+    : scan(std::move(parallelScan)), aggregates(std::move(aggregateSpecs)),
+      num_threads(numThreads == 0 ? 1 : numThreads) {
+  std::vector<Column> columns;
+  for (std::size_t i = 0; i < aggregates.size(); i++) {
+    columns.emplace_back(
+        "agg_" + std::to_string(i),
+        getAggregateResultType(aggregates[i], scan->getOutputSchema()));
+  }
+  output_schema = Schema(std::move(columns));
+}
+
+bool ParallelAggregateOperator::next(DataChunk &chunk) {
+  if (done) {
+    return false;
+  }
+  done = true;
+
+  std::vector<WorkerStates> local(num_threads);
+  for (WorkerStates &worker : local) {
+    worker.states.resize(aggregates.size());
+  }
+
+  bool scanned =
+      scan->execute(num_threads, [&](std::size_t worker, DataChunk &input) {
+        const uint16_t *selection =
+            input.hasSelection() ? input.getSelection() : nullptr;
+        for (std::size_t i = 0; i < aggregates.size(); i++) {
+          updateAggregate(local[worker].states[i], aggregates[i],
+                          input.getColumn(aggregates[i].col_idx), selection,
+                          input.getCount());
+        }
+      });
+  if (!scanned) {
+    error = true;
+    return false;
+  }
+
+  // combine
+  for (std::size_t i = 0; i < aggregates.size(); i++) {
+    AggregateState result;
+    for (const WorkerStates &worker : local) {
+      result.merge(aggregates[i].type, worker.states[i]);
+    }
+    result.writeResult(aggregates[i].type, output_schema.getType(i),
+                       chunk.getColumn(static_cast<uint32_t>(i)), 0);
+  }
+  chunk.setSize(1);
+  return true;
+}
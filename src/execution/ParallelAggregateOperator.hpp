@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Aggregate.hpp"
+#include "Operator.hpp"
+#include "ParallelSeqScan.hpp"
+#include <memory>
+#include <vector>
+
+// Ungrouped aggregation over a ParallelSeqScan: every worker folds its
+// batches into its own states, the partial states are merged once at the end.
+// A scan that cannot read a page produces no row and sets failed()
+class ParallelAggregateOperator : public Operator {
+private:
+  std::unique_ptr<ParallelSeqScan> scan;
+  std::vector<AggregateSpec> aggregates;
+  std::size_t num_threads;
+  Schema output_schema;
+  bool done = false;
+  bool error = false;
+
+public:
+  ParallelAggregateOperator(std::unique_ptr<ParallelSeqScan> parallelScan,
+                            std::vector<AggregateSpec> aggregateSpecs,
+                            std::size_t numThreads);
+
+  const Schema &getOutputSchema() const override { return output_schema; }
+
+  bool next(DataChunk &chunk) override;
+
+  bool failed() const override { return error; }
+};
@@ -0,0 +1,70 @@
+#include "ParallelSeqScan.hpp"
+#include <thread>
+
+ParallelSeqScan::ParallelSeqScan(BufferPoolManager *bufferPool,
+                                 std::vector<page_id_t> pages,
+                                 const Schema &tableSchema,
+                                 std::vector<uint32_t> columnIds,
+                                 std::vector<Predicate> filterPredicates,
+                                 std::size_t morselPages)
+    : bpm(bufferPool), page_ids(std::move(pages)), table_schema(&tableSchema),
+      column_ids(std::move(columnIds)),
+      predicates(std::move(filterPredicates)), morsel_pages(morselPages) {
+  if (column_ids.empty()) {
+    for (uint32_t i = 0; i < table_schema->getColumnCount(); i++) {
+      column_ids.push_back(i);
+    }
+  }
+  output_schema = table_schema->project(column_ids);
+}
+
+bool ParallelSeqScan::execute(std::size_t num_threads,
+                              const Consumer &consumer) {
+  MorselQueue morsels(page_ids, morsel_pages);
+  std::atomic<bool> error{false};
+
+  auto worker = [&](std::size_t worker_id) {
+    DataChunk chunk(output_schema);
+    std::size_t begin;
+    std::size_t end;
+    while (morsels.next(&begin, &end)) {
+      SeqScanOperator scan(
+          bpm,
+          std::vector<page_id_t>(page_ids.begin() + begin,
+                                 page_ids.begin() + end),
+          *table_schema, column_ids);
+      while (scan.next(chunk)) {
+        std::size_t remaining = chunk.getCount();
+        for (const Predicate &predicate : predicates) {
+          if (remaining == 0) {
+            break;
+          }
+          remaining = FilterOperator::select(chunk, predicate);
+        }
+        if (remaining > 0) {
+          consumer(worker_id, chunk);
+        }
+      }
+      if (scan.failed()) {
+        error.store(true);
+        morsels.stop();
+        return;
+      }
+    }
+  };
+
+  if (num_threads <= 1) {
+    worker(0);
+    return !error.load();
+  }
+
+  std::vector<std::thread> workers;
+  workers.reserve(num_threads);
+  for (std::size_t i = 0; i < num_threads; i++) {
+    workers.emplace_back(worker, i);
+  }
+  for (std::thread &thread : workers) {
+    thread.join();
+  }
+  return !error.load();
+}
@@ -0,0 +1,73 @@
+/* Parallel scan requirements
+1. The table's page list is cut into morsels of a few pages each
+2. Workers claim the next morsel from a shared atomic cursor, so fast workers
+simply take more morsels and no thread idles while work remains
+3. Each worker scans and filters its morsels with its own operators and hands
+batches to a consumer together with its worker id, so consumers keep
+per-worker (thread-local) state and only combine at the end
+4. A page that cannot be read stops every worker and fails the scan, instead
+of looking like the end of its morsel
+*/
+#pragma once
+
+#include "FilterOperator.hpp"
+#include "SeqScanOperator.hpp"
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <vector>
+
+// Hands out [begin, end) page ranges of a page list
+class MorselQueue {
+private:
+  const std::vector<page_id_t> *page_ids;
+  std::size_t morsel_pages;
+  std::atomic<std::size_t> cursor{0};
+  std::atomic<bool> stopped{false};
+
+public:
+  MorselQueue(const std::vector<page_id_t> &pages, std::size_t morselPages)
+      : page_ids(&pages), morsel_pages(morselPages == 0 ? 1 : morselPages) {}
+
+  bool next(std::size_t *begin, std::size_t *end) {
+    if (stopped.load(std::memory_order_relaxed)) {
+      return false;
+    }
+    std::size_t start = cursor.fetch_add(morsel_pages);
+    if (start >= page_ids->size()) {
+      return false;
+    }
+    *begin = start;
+    *end = std::min(start + morsel_pages, page_ids->size());
+    return true;
+  }
+
+  // no further morsels are handed out
+  void stop() { stopped.store(true, std::memory_order_relaxed); }
+};
+
+class ParallelSeqScan {
+private:
+  BufferPoolManager *bpm;
+  std::vector<page_id_t> page_ids;
+  const Schema *table_schema;
+  std::vector<uint32_t> column_ids;
+  std::vector<Predicate> predicates; // over the scanned columns
+  Schema output_schema;
+  std::size_t morsel_pages;
+
+public:
+  using Consumer = std::function<void(std::size_t worker, DataChunk &chunk)>;
+
+  ParallelSeqScan(BufferPoolManager *bufferPool, std::vector<page_id_t> pages,
+                  const Schema &tableSchema, std::vector<uint32_t> columnIds,
+                  std::vector<Predicate> filterPredicates = {},
+                  std::size_t morselPages = 16);
+
+  const Schema &getOutputSchema() const { return output_schema; }
+
+  // runs num_threads workers until every morsel is scanned; consumer is
+  // called concurrently, once per non-empty batch. Returns false if a page
+  // could not be read (the consumer has then seen only part of the table)
+  bool execute(std::size_t num_threads, const Consumer &consumer);
+};
@@ -0,0 +1,34 @@
+#include "ProjectionOperator.hpp"
+#include <algorithm>
+
+ProjectionOperator::ProjectionOperator(std::unique_ptr<Operator> childOperator,
+                                       std::vector<uint32_t> columnIds)
+    : child(std::move(childOperator)), column_ids(std::move(columnIds)) {
+  output_schema = child->getOutputSchema().project(column_ids);
+  child_chunk.initialize(child->getOutputSchema());
+}
+
+bool ProjectionOperator::next(DataChunk &chunk) {
+  if (!child->next(child_chunk)) {
+    return false;
+  }
+
+  std::vector<bool> moved(child_chunk.getColumnCount(), false);
+  for (uint32_t i = 0; i < column_ids.size(); i++) {
+    uint32_t src = column_ids[i];
+    if (moved[src]) {
+      // column projected twice, second reference needs a real copy
+      chunk.getColumn(i) = chunk.getColumn(
+          static_cast<uint32_t>(std::find(column_ids.begin(),
+                                          column_ids.end(), src) -
+                                column_ids.begin()));
+      continue;
+    }
+    // the child gets back a vector of the same type to fill next time
+    std::swap(chunk.getColumn(i), child_chunk.getColumn(src));
+    moved[src] = true;
+  }
+
+  chunk.copyShape(child_chunk);
+  return true;
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "Operator.hpp"
+#include <memory>
+#include <vector>
+
+// Reorders / drops columns. Vectors are swapped between the child's chunk and
+// the output chunk, so a projection costs O(columns) per batch, not O(rows).
+class ProjectionOperator : public Operator {
+private:
+  std::unique_ptr<Operator> child;
+  std::vector<uint32_t> column_ids;
+  Schema output_schema;
+  DataChunk child_chunk;
+
+public:
+  ProjectionOperator(std::unique_ptr<Operator> childOperator,
+                     std::vector<uint32_t> columnIds);
+
+  const Schema &getOutputSchema() const override { return output_schema; }
+
+  bool next(DataChunk &chunk) override;
+
+  bool failed() const override { return child->failed(); }
+};
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "storage/Tuple.hpp"
+#include <cstdint>
+#include <vector>
+
+// Append-only in-memory collection of serialized rows (one contiguous byte
+// arena + an offset per row), used to materialize operator inputs
+class RowCollection {
+private:
+  std::vector<char> bytes;
+  std::vector<uint32_t> offsets; // row i = [offsets[i], offsets[i + 1])
+
+public:
+  RowCollection() { offsets.push_back(0); }
+
+  std::size_t size() const { return offsets.size() - 1; }
+
+  // bytes held by rows and offsets
+  std::size_t getMemoryUsage() const {
+    return bytes.capacity() + offsets.capacity() * sizeof(uint32_t);
+  }
+
+  void append(const char *data, uint16_t length) {
+    bytes.insert(bytes.end(), data, data + length);
+    offsets.push_back(static_cast<uint32_t>(bytes.size()));
+  }
+
+  void append(const TupleBuilder &builder) {
+    std::size_t start = bytes.size();
+    bytes.resize(start + builder.getSerializedLength());
+    builder.serializeTo(bytes.data() + start);
+    offsets.push_back(static_cast<uint32_t>(bytes.size()));
+  }
+
+  const char *getRow(std::size_t i) const { return bytes.data() + offsets[i]; }
+
+  uint16_t getRowLength(std::size_t i) const {
+    return static_cast<uint16_t>(offsets[i + 1] - offsets[i]);
+  }
+
+  Tuple getTuple(const Schema *schema, std::size_t i) const {
+    return Tuple(schema, getRow(i), getRowLength(i));
+  }
+
+  void clear() {
+    std::vector<char>().swap(bytes);
+    std::vector<uint32_t>(1, 0).swap(offsets);
+  }
+};
@@ -0,0 +1,105 @@
+/* Conversions between columnar vectors and serialized tuples
+Operators that have to materialize rows (join build sides, sort runs,
+spilled partitions) store them as Tuples and turn them back into vectors when
+producing output.
+*/
+#pragma once
+
+#include "Vector.hpp"
+#include "storage/Tuple.hpp"
+#include <cstring>
+
+// column `col_idx` of the builder <- vector[row]
+inline void setBuilderFromVector(TupleBuilder &builder, uint32_t col_idx,
+                                 const Vector &vector, std::size_t row) {
+  if (vector.isNull(row)) {
+    builder.setNull(col_idx);
+    return;
+  }
+  switch (vector.getType()) {
+  case TypeId::BOOLEAN:
+    builder.setBoolean(col_idx, vector.getData<char>()[row] != 0);
+    break;
+  case TypeId::INTEGER:
+    builder.setInteger(col_idx, vector.getData<int32_t>()[row]);
+    break;
+  case TypeId::BIGINT:
+    builder.setBigInt(col_idx, vector.getData<int64_t>()[row]);
+    break;
+  case TypeId::DOUBLE:
+    builder.setDouble(col_idx, vector.getData<double>()[row]);
+    break;
+  case TypeId::VARCHAR:
+    builder.setVarchar(col_idx, vector.getString(row));
+    break;
+  }
+}
+
+// vector[row] <- column `col_idx` of the tuple
+inline void setVectorFromTuple(Vector &vector, std::size_t row,
+                               const Tuple &tuple, uint32_t col_idx) {
+  bool is_null = tuple.isNull(col_idx);
+  vector.setNull(row, is_null);
+  if (is_null) {
+    return;
+  }
+  if (vector.getType() == TypeId::VARCHAR) {
+    vector.setString(row, tuple.getVarchar(col_idx));
+    return;
+  }
+  memcpy(vector.getSlot(row),
+         tuple.getData() + tuple.getSchema()->getOffset(col_idx),
+         getFixedSize(vector.getType()));
+}
+
+// dst[dst_row] <- src[src_row] (same type)
+inline void copyVectorValue(Vector &dst, std::size_t dst_row, const Vector &src,
+                            std::size_t src_row) {
+  bool is_null = src.isNull(src_row);
+  dst.setNull(dst_row, is_null);
+  if (is_null) {
+    return;
+  }
+  if (src.getType() == TypeId::VARCHAR) {
+    dst.setString(dst_row, src.getString(src_row));
+    return;
+  }
+  std::size_t width = getFixedSize(src.getType());
+  memcpy(dst.getSlot(dst_row),
+         reinterpret_cast<const char *>(src.getData<char>()) + src_row * width,
+         width);
+}
+
+// integer-family value widened to int64 (join / group keys)
+inline int64_t getIntegerKey(const Vector &vector, std::size_t row) {
+  switch (vector.getType()) {
+  case TypeId::BOOLEAN:
+    return vector.getData<char>()[row];
+  case TypeId::INTEGER:
+    return vector.getData<int32_t>()[row];
+  default:
+    return vector.getData<int64_t>()[row];
+  }
+}
+
+inline int64_t getIntegerKey(const Tuple &tuple, uint32_t col_idx) {
+  switch (tuple.getSchema()->getType(col_idx)) {
+  case TypeId::BOOLEAN:
+    return tuple.getBoolean(col_idx);
+  case TypeId::INTEGER:
+    return tuple.getInteger(col_idx);
+  default:
+    return tuple.getBigInt(col_idx);
+  }
+}
+
+// 64-bit finalizer (splitmix64), good enough to radix partition on high bits
+inline uint64_t hashKey(int64_t key) {
+  uint64_t x = static_cast<uint64_t>(key);
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9ULL;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebULL;
+  x ^= x >> 31;
+  return x;
+}
@@ -0,0 +1,114 @@
+#include "SeqScanOperator.hpp"
+
+SeqScanOperator::SeqScanOperator(BufferPoolManager *bufferPool,
+                                 std::vector<page_id_t> pages,
+                                 const Schema &tableSchema,
+                                 std::vector<uint32_t> columnIds)
+    : bpm(bufferPool), page_ids(std::move(pages)), table_schema(&tableSchema),
+      column_ids(std::move(columnIds)) {
+  if (column_ids.empty()) {
+    for (uint32_t i = 0; i < table_schema->getColumnCount(); i++) {
+      column_ids.push_back(i);
+    }
+  }
+  output_schema = table_schema->project(column_ids);
+}
+
+SeqScanOperator::~SeqScanOperator() {
+  if (current_page != nullptr) {
+    bpm->unpinPage(page_ids[page_cursor], false);
+  }
+}
+
+namespace {
+
+template <typename T>
+void gatherFixed(const char *const *records, std::size_t count,
+                 uint16_t offset, T *out) {
+  for (std::size_t i = 0; i < count; i++) {
+    memcpy(out + i, records[i] + offset, sizeof(T));
+  }
+}
+
+} // namespace
+
+void SeqScanOperator::decodeColumns(DataChunk &chunk, std::size_t begin,
+                                    std::size_t end) {
+  const char *const *batch = records.data() + begin;
+  std::size_t count = end - begin;
+
+  for (uint32_t i = 0; i < column_ids.size(); i++) {
+    uint32_t col_idx = column_ids[i];
+    Vector &vector = chunk.getColumn(i);
+
+    // null bits first, then one typed loop per column
+    uint8_t *nulls = vector.getNulls() + begin;
+    uint32_t null_byte = col_idx >> 3;
+    uint8_t null_mask = static_cast<uint8_t>(1 << (col_idx & 7));
+    for (std::size_t r = 0; r < count; r++) {
+      nulls[r] = (batch[r][null_byte] & null_mask) != 0;
+    }
+
+    uint16_t offset = table_schema->getOffset(col_idx);
+    switch (table_schema->getType(col_idx)) {
+    case TypeId::BOOLEAN:
+      gatherFixed(batch, count, offset, vector.getData<char>() + begin);
+      break;
+    case TypeId::INTEGER:
+      gatherFixed(batch, count, offset, vector.getData<int32_t>() + begin);
+      break;
+    case TypeId::BIGINT:
+      gatherFixed(batch, count, offset, vector.getData<int64_t>() + begin);
+      break;
+    case TypeId::DOUBLE:
+      gatherFixed(batch, count, offset, vector.getData<double>() + begin);
+      break;
+    case TypeId::VARCHAR:
+      for (std::size_t r = 0; r < count; r++) {
+        if (!nulls[r]) {
+          Tuple tuple(table_schema, batch[r], 0);
+          vector.setString(begin + r, tuple.getVarchar(col_idx));
+        }
+      }
+      break;
+    }
+  }
+}
+
+bool SeqScanOperator::next(DataChunk &chunk) {
+  std::size_t rows = 0;
+  records.resize(VECTOR_SIZE);
+
+  while (rows < VECTOR_SIZE && page_cursor < page_ids.size()) {
+    if (current_page == nullptr) {
+      current_page = bpm->fetchPage(page_ids[page_cursor]);
+      slot_cursor = 0;
+      if (current_page == nullptr) {
+        std::cerr << "Scan could not fetch page " << page_ids[page_cursor]
+                  << "\n";
+        break;
+      }
+    }
+
+    // collect this page's live records, decode them while it is pinned
+    std::size_t page_begin = rows;
+    uint16_t num_slots = current_page->getNumberOfSlots();
+    for (; slot_cursor < num_slots && rows < VECTOR_SIZE; slot_cursor++) {
+      if (!current_page->isRecordDeleted(slot_cursor)) {
+        records[rows++] = current_page->getRecord(slot_cursor);
+      }
+    }
+    decodeColumns(chunk, page_begin, rows);
+
+    if (slot_cursor == num_slots) {
+      bpm->unpinPage(page_ids[page_cursor], false);
+      current_page = nullptr;
+      page_cursor++;
+    }
+  }
+
+  chunk.setSize(rows);
+  // stopped short of the last page: a page could not be fetched
+  error = rows == 0 && page_cursor < page_ids.size();
+  return rows > 0;
+}
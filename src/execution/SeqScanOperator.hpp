@@ -0,0 +1,48 @@
+#pragma once
+
+#include "Operator.hpp"
+#include "buffer/BufferPoolManager.hpp"
+#include "table/TableHeap.hpp"
+#include <vector>
+
+// Decodes the records of a list of pages into column vectors. Each page is
+// fetched once, decoded while pinned and unpinned before moving on (a page
+// whose records straddle two batches stays pinned between the two calls).
+class SeqScanOperator : public Operator {
+private:
+  BufferPoolManager *bpm;
+  std::vector<page_id_t> page_ids;
+  const Schema *table_schema;
+  std::vector<uint32_t> column_ids; // table columns produced, in order
+  Schema output_schema;
+
+  std::size_t page_cursor = 0;
+  uint16_t slot_cursor = 0;
+  Page *current_page = nullptr;
+  bool error = false;
+
+  // records of the current batch, decoded column-at-a-time once gathered
+  std::vector<const char *> records;
+
+  void decodeColumns(DataChunk &chunk, std::size_t begin, std::size_t end);
+
+public:
+  // column_ids empty = all columns
+  SeqScanOperator(BufferPoolManager *bufferPool, std::vector<page_id_t> pages,
+                  const Schema &tableSchema,
+                  std::vector<uint32_t> columnIds = {});
+
+  SeqScanOperator(BufferPoolManager *bufferPool, const TableHeap &heap,
+                  const Schema &tableSchema,
+                  std::vector<uint32_t> columnIds = {})
+      : SeqScanOperator(bufferPool, heap.getPageIds(), tableSchema,
+                        std::move(columnIds)) {}
+
+  ~SeqScanOperator() override;
+
+  const Schema &getOutputSchema() const override { return output_schema; }
+
+  bool next(DataChunk &chunk) override;
+
+  bool failed() const override { return error; }
+};
@@ -0,0 +1,57 @@
+#include "SpillWriter.hpp"
+
+SpillWriter &SpillWriter::operator=(SpillWriter &&other) noexcept {
+  if (this != &other) {
+    finish();
+    bpm = other.bpm;
+    page_ids = std::move(other.page_ids);
+    current_page = other.current_page;
+    bytes_written = other.bytes_written;
+    records_written = other.records_written;
+    other.current_page = nullptr;
+    other.page_ids.clear();
+  }
+  return *this;
+}
+
+bool SpillWriter::append(const char *data, uint16_t length) {
+  char *record =
+      current_page != nullptr ? current_page->allocateRecord(length) : nullptr;
+
+  if (record == nullptr) {
+    finish();
+    page_id_t page_id;
+    current_page = bpm->newPage(bpm->getSpillFile(), &page_id);
+    if (current_page == nullptr) {
+      std::cerr << "Could not allocate spill page\n";
+      return false;
+    }
+    page_ids.push_back(page_id);
+    record = current_page->allocateRecord(length);
+    if (record == nullptr) {
+      return false;
+    }
+  }
+
+  memcpy(record, data, length);
+  bytes_written += length;
+  records_written++;
+  return true;
+}
+
+void SpillWriter::finish() {
+  if (current_page != nullptr) {
+    bpm->unpinPage(page_ids.back(), true);
+    current_page = nullptr;
+  }
+}
+
+void SpillWriter::release() {
+  finish();
+  for (page_id_t page_id : page_ids) {
+    bpm->deletePage(page_id);
+  }
+  page_ids.clear();
+  bytes_written = 0;
+  records_written = 0;
+}
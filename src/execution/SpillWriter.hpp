@@ -0,0 +1,50 @@
+/* Spill requirements
+1. Operators that run out of memory write serialized rows to temporary pages
+allocated with BufferPoolManager::newPage in the pool's spill file (a
+temporary file, truncated when created and deleted on shutdown, unless another
+file was registered)
+2. The page being filled stays pinned, finished pages are unpinned dirty and
+become ordinary eviction candidates (written out by evictPage when needed)
+3. Temporary pages are dropped from the pool with deletePage once consumed,
+without being written back
+*/
+#pragma once
+
+#include "buffer/BufferPoolManager.hpp"
+#include <utility>
+#include <vector>
+
+class SpillWriter {
+private:
+  BufferPoolManager *bpm = nullptr;
+  std::vector<page_id_t> page_ids;
+  Page *current_page = nullptr;
+  std::size_t bytes_written = 0;
+  std::size_t records_written = 0;
+
+public:
+  SpillWriter() = default;
+  explicit SpillWriter(BufferPoolManager *bufferPool) : bpm(bufferPool) {}
+
+  SpillWriter(const SpillWriter &) = delete;
+  SpillWriter &operator=(const SpillWriter &) = delete;
+  SpillWriter(SpillWriter &&other) noexcept { *this = std::move(other); }
+  SpillWriter &operator=(SpillWriter &&other) noexcept;
+
+  ~SpillWriter() { finish(); }
+
+  // false when no temp page can be allocated
+  bool append(const char *data, uint16_t length);
+
+  // unpins the page being filled
+  void finish();
+
+  const std::vector<page_id_t> &getPageIds() const { return page_ids; }
+
+  std::size_t getBytesWritten() const { return bytes_written; }
+
+  std::size_t getRecordsWritten() const { return records_written; }
+
+  // unpins and drops every spilled page from the pool
+  void release();
+};
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "storage/Schema.hpp"
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// A single typed constant (predicate operands, aggregate results)
+class Value {
+private:
+  TypeId type = TypeId::INTEGER;
+  bool is_null = true;
+  int64_t integer = 0; // BOOLEAN, INTEGER and BIGINT
+  double decimal = 0;
+  std::string varchar;
+
+public:
+  Value() = default;
+
+  static Value null(TypeId type) {
+    Value value;
+    value.type = type;
+    return value;
+  }
+
+  static Value boolean(bool v) { return fromInteger(TypeId::BOOLEAN, v); }
+
+  static Value integer32(int32_t v) { return fromInteger(TypeId::INTEGER, v); }
+
+  static Value bigint(int64_t v) { return fromInteger(TypeId::BIGINT, v); }
+
+  static Value doublePrecision(double v) {
+    Value value;
+    value.type = TypeId::DOUBLE;
+    value.is_null = false;
+    value.decimal = v;
+    return value;
+  }
+
+  static Value string(std::string_view v) {
+    Value value;
+    value.type = TypeId::VARCHAR;
+    value.is_null = false;
+    value.varchar.assign(v.data(), v.size());
+    return value;
+  }
+
+  TypeId getType() const { return type; }
+
+  bool isNull() const { return is_null; }
+
+  bool getBoolean() const { return integer != 0; }
+
+  int32_t getInteger() const { return static_cast<int32_t>(integer); }
+
+  int64_t getBigInt() const { return integer; }
+
+  // numeric value widened to double (INTEGER, BIGINT or DOUBLE)
+  double getDouble() const {
+    return type == TypeId::DOUBLE ? decimal : static_cast<double>(integer);
+  }
+
+  std::string_view getVarchar() const { return varchar; }
+
+private:
+  static Value fromInteger(TypeId type, int64_t v) {
+    Value value;
+    value.type = type;
+    value.is_null = false;
+    value.integer = v;
+    return value;
+  }
+};
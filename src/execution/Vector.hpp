@@ -0,0 +1,71 @@
+/* Vector requirements
+1. A Vector holds up to VECTOR_SIZE values of one column (columnar layout)
+2. Fixed-width values are stored contiguously so operators run tight loops
+3. NULLs are tracked in a byte-per-row mask
+4. VARCHAR values are copied out of the page, pages are unpinned as soon as
+their records are decoded
+*/
+#pragma once
+
+#include "storage/Schema.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+static constexpr std::size_t VECTOR_SIZE = 1024; // rows per batch
+
+class Vector {
+private:
+  TypeId type = TypeId::INTEGER;
+  std::vector<char> data;        // VECTOR_SIZE * fixed width
+  std::vector<uint8_t> nulls;    // 1 = NULL
+  std::vector<std::string> strs; // VARCHAR payloads
+
+public:
+  Vector() = default;
+
+  explicit Vector(TypeId vectorType) { initialize(vectorType); }
+
+  void initialize(TypeId vectorType) {
+    type = vectorType;
+    if (isVarlen(type)) {
+      data.clear();
+      strs.resize(VECTOR_SIZE);
+    } else {
+      data.assign(VECTOR_SIZE * getFixedSize(type), 0);
+      strs.clear();
+    }
+    nulls.assign(VECTOR_SIZE, 0);
+  }
+
+  TypeId getType() const { return type; }
+
+  template <typename T> T *getData() {
+    return reinterpret_cast<T *>(data.data());
+  }
+
+  template <typename T> const T *getData() const {
+    return reinterpret_cast<const T *>(data.data());
+  }
+
+  // raw slot of row i (fixed-width types only)
+  char *getSlot(std::size_t row) {
+    return data.data() + row * getFixedSize(type);
+  }
+
+  uint8_t *getNulls() { return nulls.data(); }
+
+  const uint8_t *getNulls() const { return nulls.data(); }
+
+  bool isNull(std::size_t row) const { return nulls[row] != 0; }
+
+  void setNull(std::size_t row, bool is_null) { nulls[row] = is_null; }
+
+  std::string_view getString(std::size_t row) const { return strs[row]; }
+
+  void setString(std::size_t row, std::string_view value) {
+    strs[row].assign(value.data(), value.size());
+  }
+};
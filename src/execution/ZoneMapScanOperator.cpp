@@ -0,0 +1,112 @@
+#include "ZoneMapScanOperator.hpp"
+#include <algorithm>
+
+namespace {
+
+template <typename T>
+bool rangeMayMatch(CompareOp op, T min, T max, T constant) {
+  switch (op) {
+  case CompareOp::EQ:
+    return min <= constant && constant <= max;
+  case CompareOp::NE:
+    return !(min == constant && max == constant);
+  case CompareOp::LT:
+    return min < constant;
+  case CompareOp::LE:
+    return min <= constant;
+  case CompareOp::GT:
+    return max > constant;
+  case CompareOp::GE:
+    return max >= constant;
+  }
+  return true;
+}
+
+} // namespace
+
+bool ZoneMapScanOperator::mayMatch(const Zone &zone, TypeId type,
+                                   const Predicate &predicate) {
+  // NULL never matches: all-NULL pages and NULL constants match nothing
+  if (!zone.has_values || predicate.constant.isNull()) {
+    return false;
+  }
+  // coerced exactly like FilterOperator::select, which filters the rows
+  if (type == TypeId::DOUBLE) {
+    return rangeMayMatch(predicate.op, zone.min_double, zone.max_double,
+                         predicate.constant.getDouble());
+  }
+  if (FilterOperator::comparesAsDouble(type, predicate.constant)) {
+    return rangeMayMatch(predicate.op, static_cast<double>(zone.min_int),
+                         static_cast<double>(zone.max_int),
+                         predicate.constant.getDouble());
+  }
+  return rangeMayMatch(predicate.op, zone.min_int, zone.max_int,
+                       predicate.constant.getBigInt());
+}
+
+ZoneMapScanOperator::ZoneMapScanOperator(
+    BufferPoolManager *bufferPool, const TableHeap &heap,
+    const Schema &tableSchema, const ZoneMap &zoneMap,
+    std::vector<Predicate> filterPredicates, std::vector<uint32_t> columnIds) {
+  // the filter reads predicate columns from the scan's output
+  for (const Predicate &predicate : filterPredicates) {
+    if (predicate.col_idx >= tableSchema.getColumnCount() ||
+        (!columnIds.empty() &&
+         std::find(columnIds.begin(), columnIds.end(), predicate.col_idx) ==
+             columnIds.end())) {
+      std::cerr << "Zone map scan predicate on column " << predicate.col_idx
+                << " which is not scanned\n";
+      error = true;
+    }
+  }
+
+  const std::vector<page_id_t> none;
+  std::vector<page_id_t> pages;
+  for (page_id_t page_id : error ? none : heap.getPageIds()) {
+    bool keep = true;
+    for (const Predicate &predicate : filterPredicates) {
+      const Zone *zone = zoneMap.getZone(page_id, predicate.col_idx);
+      if (zone != nullptr &&
+          !mayMatch(*zone, tableSchema.getType(predicate.col_idx),
+                    predicate)) {
+        keep = false;
+        break;
+      }
+    }
+    if (keep) {
+      pages.push_back(page_id);
+    }
+  }
+  stats.pages_total = heap.getPageIds().size();
+  stats.pages_skipped = stats.pages_total - pages.size();
+
+  for (Predicate predicate : filterPredicates) {
+    if (!columnIds.empty()) {
+      auto it = std::find(columnIds.begin(), columnIds.end(),
+                          predicate.col_idx);
+      predicate.col_idx = static_cast<uint32_t>(it - columnIds.begin());
+    }
+    predicates.push_back(std::move(predicate));
+  }
+  scan = std::make_unique<SeqScanOperator>(bufferPool, std::move(pages),
+                                           tableSchema, std::move(columnIds));
+}
+
+bool ZoneMapScanOperator::next(DataChunk &chunk) {
+  if (error) {
+    return false;
+  }
+  while (scan->next(chunk)) {
+    std::size_t remaining = chunk.getCount();
+    for (const Predicate &predicate : predicates) {
+      if (remaining == 0) {
+        break;
+      }
+      remaining = FilterOperator::select(chunk, predicate);
+    }
+    if (remaining > 0) {
+      return true;
+    }
+  }
+  return false;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "FilterOperator.hpp"
+#include "SeqScanOperator.hpp"
+#include "table/ZoneMap.hpp"
+#include <memory>
+
+struct ZoneMapScanStats {
+  std::size_t pages_total = 0;
+  std::size_t pages_skipped = 0;
+};
+
+// Sequential scan + filter that drops pages whose zone map ranges cannot
+// satisfy every predicate before any of them is fetched. Predicates refer to
+// table columns and must be part of the scanned columns: otherwise the scan
+// produces no rows and failed() is set.
+class ZoneMapScanOperator : public Operator {
+private:
+  std::vector<Predicate> predicates; // rewritten to output column positions
+  std::unique_ptr<SeqScanOperator> scan;
+  bool error = false; // a predicate column is not scanned
+  ZoneMapScanStats stats;
+
+public:
+  ZoneMapScanOperator(BufferPoolManager *bufferPool, const TableHeap &heap,
+                      const Schema &tableSchema, const ZoneMap &zoneMap,
+                      std::vector<Predicate> filterPredicates,
+                      std::vector<uint32_t> columnIds = {});
+
+  // false when no row of a page with this zone can satisfy predicate
+  static bool mayMatch(const Zone &zone, TypeId type,
+                       const Predicate &predicate);
+
+  const Schema &getOutputSchema() const override {
+    return scan->getOutputSchema();
+  }
+
+  bool next(DataChunk &chunk) override;
+
+  bool failed() const override { return error || scan->failed(); }
+
+  const ZoneMapScanStats &getStats() const { return stats; }
+};
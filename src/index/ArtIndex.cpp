@@ -0,0 +1,463 @@
+#include "ArtIndex.hpp"
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+bool ArtIndex::readLock(const Node *node, uint64_t *version) {
+  uint64_t v = node->version.load(std::memory_order_acquire);
+  while (v & kLocked) {
+    std::this_thread::yield();
+    v = node->version.load(std::memory_order_acquire);
+  }
+  if (v & kObsolete) {
+    return false;
+  }
+  *version = v;
+  return true;
+}
+
+bool ArtIndex::check(const Node *node, uint64_t version) {
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return node->version.load(std::memory_order_relaxed) == version;
+}
+
+bool ArtIndex::upgrade(Node *node, uint64_t version) {
+  return node->version.compare_exchange_strong(version, version + kLocked,
+                                               std::memory_order_acquire);
+}
+
+void ArtIndex::unlock(Node *node) {
+  // clears the lock bit and carries into the counter
+  node->version.fetch_add(kLocked, std::memory_order_release);
+}
+
+void ArtIndex::unlockObsolete(Node *node) {
+  node->version.fetch_add(kLocked | kObsolete, std::memory_order_release);
+}
+
+ArtIndex::Node *ArtIndex::getChild(const Node *node, uint8_t byte) {
+  switch (node->type) {
+  case NodeType::NODE4: {
+    auto *n = static_cast<const Node4 *>(node);
+    for (std::size_t i = 0; i < std::min<std::size_t>(n->count, 4); i++) {
+      if (n->keys[i] == byte) {
+        return n->children[i].load(std::memory_order_acquire);
+      }
+    }
+    return nullptr;
+  }
+  case NodeType::NODE16: {
+    auto *n = static_cast<const Node16 *>(node);
+    std::size_t count = std::min<std::size_t>(n->count, 16);
+#if defined(__SSE2__)
+    __m128i keys =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(n->keys));
+    __m128i cmp = _mm_cmpeq_epi8(_mm_set1_epi8(static_cast<char>(byte)), keys);
+    unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(cmp)) &
+                    ((1u << count) - 1);
+    if (mask != 0) {
+      return n->children[__builtin_ctz(mask)].load(std::memory_order_acquire);
+    }
+#else
+    for (std::size_t i = 0; i < count; i++) {
+      if (n->keys[i] == byte) {
+        return n->children[i].load(std::memory_order_acquire);
+      }
+    }
+#endif
+    return nullptr;
+  }
+  case NodeType::NODE48: {
+    auto *n = static_cast<const Node48 *>(node);
+    uint8_t slot = n->child_index[byte];
+    return slot < Node48::kEmpty
+               ? n->children[slot].load(std::memory_order_acquire)
+               : nullptr;
+  }
+  case NodeType::NODE256:
+    return static_cast<const Node256 *>(node)->children[byte].load(
+        std::memory_order_acquire);
+  }
+  return nullptr;
+}
+
+bool ArtIndex::isFull(const Node *node) {
+  switch (node->type) {
+  case NodeType::NODE4:
+    return node->count == 4;
+  case NodeType::NODE16:
+    return node->count == 16;
+  case NodeType::NODE48:
+    return node->count == 48;
+  case NodeType::NODE256:
+    return false;
+  }
+  return false;
+}
+
+void ArtIndex::addChild(Node *node, uint8_t byte, Node *child) {
+  // children are published before the count that makes them visible
+  switch (node->type) {
+  case NodeType::NODE4: {
+    auto *n = static_cast<Node4 *>(node);
+    n->keys[n->count] = byte;
+    n->children[n->count].store(child, std::memory_order_release);
+    break;
+  }
+  case NodeType::NODE16: {
+    auto *n = static_cast<Node16 *>(node);
+    n->keys[n->count] = byte;
+    n->children[n->count].store(child, std::memory_order_release);
+    break;
+  }
+  case NodeType::NODE48: {
+    auto *n = static_cast<Node48 *>(node);
+    n->children[n->count].store(child, std::memory_order_release);
+    n->child_index[byte] = static_cast<uint8_t>(n->count);
+    break;
+  }
+  case NodeType::NODE256:
+    static_cast<Node256 *>(node)->children[byte].store(
+        child, std::memory_order_release);
+    break;
+  }
+  node->count++;
+}
+
+void ArtIndex::changeChild(Node *node, uint8_t byte, Node *child) {
+  switch (node->type) {
+  case NodeType::NODE4: {
+    auto *n = static_cast<Node4 *>(node);
+    for (std::size_t i = 0; i < n->count; i++) {
+      if (n->keys[i] == byte) {
+        n->children[i].store(child, std::memory_order_release);
+      }
+    }
+    break;
+  }
+  case NodeType::NODE16: {
+    auto *n = static_cast<Node16 *>(node);
+    for (std::size_t i = 0; i < n->count; i++) {
+      if (n->keys[i] == byte) {
+        n->children[i].store(child, std::memory_order_release);
+      }
+    }
+    break;
+  }
+  case NodeType::NODE48: {
+    auto *n = static_cast<Node48 *>(node);
+    n->children[n->child_index[byte]].store(child, std::memory_order_release);
+    break;
+  }
+  case NodeType::NODE256:
+    static_cast<Node256 *>(node)->children[byte].store(
+        child, std::memory_order_release);
+    break;
+  }
+}
+
+ArtIndex::Node *ArtIndex::grow(const Node *node) {
+  Node *bigger = nullptr;
+  switch (node->type) {
+  case NodeType::NODE4: {
+    auto *n = static_cast<const Node4 *>(node);
+    bigger = new Node16();
+    for (std::size_t i = 0; i < n->count; i++) {
+      addChild(bigger, n->keys[i], n->children[i].load());
+    }
+    break;
+  }
+  case NodeType::NODE16: {
+    auto *n = static_cast<const Node16 *>(node);
+    bigger = new Node48();
+    for (std::size_t i = 0; i < n->count; i++) {
+      addChild(bigger, n->keys[i], n->children[i].load());
+    }
+    break;
+  }
+  case NodeType::NODE48: {
+    auto *n = static_cast<const Node48 *>(node);
+    bigger = new Node256();
+    for (std::size_t byte = 0; byte < 256; byte++) {
+      if (n->child_index[byte] != Node48::kEmpty) {
+        addChild(bigger, static_cast<uint8_t>(byte),
+                 n->children[n->child_index[byte]].load());
+      }
+    }
+    break;
+  }
+  case NodeType::NODE256:
+    return nullptr;
+  }
+  bigger->prefix_len = node->prefix_len;
+  memcpy(bigger->prefix, node->prefix, kMaxPrefix);
+  return bigger;
+}
+
+std::size_t ArtIndex::prefixMatch(const Node *node, uint64_t bytes,
+                                  std::size_t level) {
+  // a torn prefix_len is caught by the caller's version check
+  std::size_t len = std::min<std::size_t>(node->prefix_len, kMaxPrefix);
+  std::size_t i = 0;
+  while (i < len && node->prefix[i] == byteAt(bytes, level + i)) {
+    i++;
+  }
+  return i;
+}
+
+void ArtIndex::freeTree(Node *node) {
+  if (isLeaf(node)) {
+    delete asLeaf(node);
+    return;
+  }
+  for (std::size_t byte = 0; byte < 256; byte++) {
+    // grow copies children, so walking by byte visits each child once
+    Node *child = getChild(node, static_cast<uint8_t>(byte));
+    if (child != nullptr) {
+      freeTree(child);
+    }
+  }
+  switch (node->type) {
+  case NodeType::NODE4:
+    delete static_cast<Node4 *>(node);
+    break;
+  case NodeType::NODE16:
+    delete static_cast<Node16 *>(node);
+    break;
+  case NodeType::NODE48:
+    delete static_cast<Node48 *>(node);
+    break;
+  case NodeType::NODE256:
+    delete static_cast<Node256 *>(node);
+    break;
+  }
+}
+
+ArtIndex::~ArtIndex() {
+  freeTree(root);
+  // retired nodes share their children with their replacement
+  for (Node *node : retired) {
+    switch (node->type) {
+    case NodeType::NODE4:
+      delete static_cast<Node4 *>(node);
+      break;
+    case NodeType::NODE16:
+      delete static_cast<Node16 *>(node);
+      break;
+    default:
+      delete static_cast<Node48 *>(node);
+      break;
+    }
+  }
+}
+
+ArtIndex::Result ArtIndex::tryInsert(int64_t key, Leaf *leaf) {
+  uint64_t bytes = toBytes(key);
+  Node *parent = nullptr;
+  uint64_t parent_version = 0;
+  uint8_t parent_byte = 0;
+  Node *node = root;
+  uint64_t version;
+  if (!readLock(node, &version)) {
+    return Result::RESTART;
+  }
+
+  std::size_t level = 0;
+  while (true) {
+    std::size_t matched = prefixMatch(node, bytes, level);
+    if (matched < node->prefix_len) {
+      // the key leaves the compressed path: split it with a new Node4.
+      // The root has no prefix, so parent is set here.
+      if (!upgrade(parent, parent_version)) {
+        return Result::RESTART;
+      }
+      if (!upgrade(node, version)) {
+        unlock(parent);
+        return Result::RESTART;
+      }
+      auto *split = new Node4();
+      split->prefix_len = static_cast<uint8_t>(matched);
+      memcpy(split->prefix, node->prefix, matched);
+      addChild(split, byteAt(bytes, level + matched), tagLeaf(leaf));
+      addChild(split, node->prefix[matched], node);
+
+      std::size_t rest = node->prefix_len - matched - 1;
+      memmove(node->prefix, node->prefix + matched + 1, rest);
+      node->prefix_len = static_cast<uint8_t>(rest);
+      changeChild(parent, parent_byte, split);
+      unlock(node);
+      unlock(parent);
+      return Result::DONE;
+    }
+    level += node->prefix_len;
+
+    uint8_t byte = byteAt(bytes, level);
+    Node *child = getChild(node, byte);
+    if (!check(node, version)) {
+      return Result::RESTART;
+    }
+
+    if (child == nullptr) {
+      if (isFull(node)) {
+        // never the root (a Node256), so parent is set
+        if (!upgrade(parent, parent_version)) {
+          return Result::RESTART;
+        }
+        if (!upgrade(node, version)) {
+          unlock(parent);
+          return Result::RESTART;
+        }
+        Node *bigger = grow(node);
+        addChild(bigger, byte, tagLeaf(leaf));
+        changeChild(parent, parent_byte, bigger);
+        unlockObsolete(node);
+        unlock(parent);
+        std::lock_guard<std::mutex> lock(retired_mutex);
+        retired.push_back(node);
+      } else {
+        if (!upgrade(node, version)) {
+          return Result::RESTART;
+        }
+        if (parent != nullptr && !check(parent, parent_version)) {
+          unlock(node);
+          return Result::RESTART;
+        }
+        addChild(node, byte, tagLeaf(leaf));
+        unlock(node);
+      }
+      return Result::DONE;
+    }
+    if (parent != nullptr && !check(parent, parent_version)) {
+      return Result::RESTART;
+    }
+
+    if (isLeaf(child)) {
+      if (!upgrade(node, version)) {
+        return Result::RESTART;
+      }
+      Leaf *existing = asLeaf(child);
+      if (existing->key == key) {
+        unlock(node);
+        return Result::FAILED;
+      }
+      // both keys move into a Node4 holding their common bytes
+      uint64_t other = toBytes(existing->key);
+      std::size_t depth = level + 1;
+      std::size_t common = 0;
+      while (depth + common < 8 &&
+             byteAt(bytes, depth + common) == byteAt(other, depth + common)) {
+        common++;
+      }
+      auto *split = new Node4();
+      split->prefix_len = static_cast<uint8_t>(common);
+      for (std::size_t i = 0; i < common; i++) {
+        split->prefix[i] = byteAt(bytes, depth + i);
+      }
+      addChild(split, byteAt(bytes, depth + common), tagLeaf(leaf));
+      addChild(split, byteAt(other, depth + common), child);
+      changeChild(node, byte, split);
+      unlock(node);
+      return Result::DONE;
+    }
+
+    uint64_t child_version;
+    if (!readLock(child, &child_version) || !check(node, version)) {
+      return Result::RESTART;
+    }
+    parent = node;
+    parent_version = version;
+    parent_byte = byte;
+    node = child;
+    version = child_version;
+    level++;
+  }
+}
+
+bool ArtIndex::insert(int64_t key, const RID &rid) {
+  Leaf *leaf = new Leaf{key, rid};
+  while (true) {
+    switch (tryInsert(key, leaf)) {
+    case Result::DONE:
+      num_keys++;
+      return true;
+    case Result::FAILED:
+      delete leaf; // duplicate key
+      return false;
+    case Result::RESTART:
+      break;
+    }
+  }
+}
+
+ArtIndex::Result ArtIndex::tryLookup(int64_t key, RID *rid) const {
+  uint64_t bytes = toBytes(key);
+  const Node *node = root;
+  uint64_t version;
+  if (!readLock(node, &version)) {
+    return Result::RESTART;
+  }
+
+  std::size_t level = 0;
+  while (true) {
+    std::size_t prefix_len = node->prefix_len;
+    if (prefixMatch(node, bytes, level) < prefix_len) {
+      return check(node, version) ? Result::FAILED : Result::RESTART;
+    }
+    level += prefix_len;
+
+    Node *child = getChild(node, byteAt(bytes, level));
+    if (!check(node, version)) {
+      return Result::RESTART;
+    }
+    if (child == nullptr) {
+      return Result::FAILED;
+    }
+    if (isLeaf(child)) {
+      // leaves never change once published
+      const Leaf *leaf = asLeaf(child);
+      if (leaf->key != key) {
+        return Result::FAILED;
+      }
+      *rid = leaf->rid;
+      return Result::DONE;
+    }
+
+    uint64_t child_version;
+    if (!readLock(child, &child_version) || !check(node, version)) {
+      return Result::RESTART;
+    }
+    node = child;
+    version = child_version;
+    level++;
+  }
+}
+
+bool ArtIndex::lookup(int64_t key, RID *rid) const {
+  while (true) {
+    Result result = tryLookup(key, rid);
+    if (result != Result::RESTART) {
+      return result == Result::DONE;
+    }
+  }
+}
+
+bool ArtIndex::build(TableHeap &heap, const Schema &schema, uint32_t col) {
+  bool ok = true;
+  heap.forEachRecord([&](const RID &rid, const char *data, uint16_t length) {
+    Tuple tuple(&schema, data, length);
+    if (tuple.isNull(col)) {
+      return;
+    }
+    int64_t key = schema.getType(col) == TypeId::INTEGER
+                      ? tuple.getInteger(col)
+                      : tuple.getBigInt(col);
+    if (!insert(key, rid)) {
+      std::cerr << "Duplicate key " << key << " in ART index build\n";
+      ok = false;
+    }
+  });
+  return ok;
+}
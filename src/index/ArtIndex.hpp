@@ -0,0 +1,149 @@
+/* ART index requirements
+1. In-memory adaptive radix tree over unique int64 keys mapped to RIDs, for
+hot tables whose index fits in memory: a lookup follows at most 8 child
+pointers and never touches the BufferPoolManager
+2. Keys are compared as 8 big-endian bytes with the sign bit flipped, so
+byte order equals key order
+3. Inner nodes grow through four layouts as children are added:
+    - Node4  : up to 4 key bytes and children
+    - Node16 : up to 16, the key byte is searched with one SIMD compare
+    - Node48 : 256-entry byte -> slot index into 48 children
+    - Node256: one child pointer per byte
+4. Path compression: a node stores the bytes shared by everything below it,
+so chains of single-child nodes never exist; leaves hold the full key
+5. Optimistic lock coupling: every node carries a version word; readers
+never write shared memory and restart when a version they passed changed,
+writers lock only the one or two nodes they modify
+6. Nodes replaced while readers may still be looking at them are kept
+until the index is destroyed instead of being freed right away
+*/
+#pragma once
+
+#include "table/TableHeap.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+#include <mutex>
+#include <vector>
+
+class ArtIndex {
+private:
+  enum class NodeType : uint8_t { NODE4, NODE16, NODE48, NODE256 };
+
+  static constexpr std::size_t kMaxPrefix = 8;
+
+  // version word: bit 0 obsolete, bit 1 locked, the rest a counter
+  static constexpr uint64_t kObsolete = 1;
+  static constexpr uint64_t kLocked = 2;
+
+  // header shared by all inner nodes. Fields other than version are read
+  // without locks; readers validate what they saw with the version.
+  struct Node {
+    std::atomic<uint64_t> version{0};
+    NodeType type;
+    uint8_t prefix_len = 0;
+    uint16_t count = 0;
+    uint8_t prefix[kMaxPrefix] = {};
+
+    explicit Node(NodeType nodeType) : type(nodeType) {}
+  };
+
+  struct Node4 : Node {
+    uint8_t keys[4] = {};
+    std::atomic<Node *> children[4] = {};
+    Node4() : Node(NodeType::NODE4) {}
+  };
+
+  struct Node16 : Node {
+    uint8_t keys[16] = {};
+    std::atomic<Node *> children[16] = {};
+    Node16() : Node(NodeType::NODE16) {}
+  };
+
+  struct Node48 : Node {
+    static constexpr uint8_t kEmpty = 48;
+    uint8_t child_index[256];
+    std::atomic<Node *> children[48] = {};
+    Node48() : Node(NodeType::NODE48) {
+      std::fill(std::begin(child_index), std::end(child_index), kEmpty);
+    }
+  };
+
+  struct Node256 : Node {
+    std::atomic<Node *> children[256] = {};
+    Node256() : Node(NodeType::NODE256) {}
+  };
+
+  // leaves are stored in child slots as tagged pointers (low bit set)
+  struct Leaf {
+    int64_t key;
+    RID rid;
+  };
+
+  // DONE: inserted / found, FAILED: duplicate / absent
+  enum class Result { DONE, FAILED, RESTART };
+
+  Node256 *root;
+  std::atomic<std::size_t> num_keys{0};
+  std::mutex retired_mutex;
+  std::vector<Node *> retired; // replaced by a larger node
+
+  static uint64_t toBytes(int64_t key) {
+    return static_cast<uint64_t>(key) ^ (uint64_t{1} << 63);
+  }
+
+  // byte level of the key, 0 = most significant
+  static uint8_t byteAt(uint64_t bytes, std::size_t level) {
+    return level < 8 ? static_cast<uint8_t>(bytes >> (56 - 8 * level)) : 0;
+  }
+
+  static bool isLeaf(const Node *node) {
+    return reinterpret_cast<uintptr_t>(node) & 1;
+  }
+  static Node *tagLeaf(Leaf *leaf) {
+    return reinterpret_cast<Node *>(reinterpret_cast<uintptr_t>(leaf) | 1);
+  }
+  static Leaf *asLeaf(Node *node) {
+    return reinterpret_cast<Leaf *>(reinterpret_cast<uintptr_t>(node) & ~1);
+  }
+
+  // optimistic lock coupling; false means the operation must restart
+  static bool readLock(const Node *node, uint64_t *version);
+  static bool check(const Node *node, uint64_t version);
+  static bool upgrade(Node *node, uint64_t version);
+  static void unlock(Node *node);
+  static void unlockObsolete(Node *node);
+
+  static Node *getChild(const Node *node, uint8_t byte);
+  static bool isFull(const Node *node);
+  static void addChild(Node *node, uint8_t byte, Node *child);
+  static void changeChild(Node *node, uint8_t byte, Node *child);
+  // copy of a full node in the next larger layout
+  static Node *grow(const Node *node);
+  // number of prefix bytes of node that match bytes from level on
+  static std::size_t prefixMatch(const Node *node, uint64_t bytes,
+                                 std::size_t level);
+
+  static void freeTree(Node *node);
+
+  Result tryInsert(int64_t key, Leaf *leaf);
+  Result tryLookup(int64_t key, RID *rid) const;
+
+public:
+  ArtIndex() : root(new Node256()) {}
+  ~ArtIndex();
+
+  ArtIndex(const ArtIndex &) = delete;
+  ArtIndex &operator=(const ArtIndex &) = delete;
+
+  // false if the key exists; safe to call concurrently with any operation
+  bool insert(int64_t key, const RID &rid);
+
+  bool lookup(int64_t key, RID *rid) const;
+
+  std::size_t size() const { return num_keys.load(); }
+
+  // builds the index over column col (an integer column) of every row
+  bool build(TableHeap &heap, const Schema &schema, uint32_t col);
+};
@@ -0,0 +1,491 @@
+#include "BPlusTree.hpp"
+#include <algorithm>
+#include <cmath>
+
+BPlusTree::Node BPlusTree::view(Page *page) {
+  Node node;
+  node.page = page;
+  char *data = page->getData();
+  node.header = reinterpret_cast<NodeHeader *>(data);
+  node.keys = reinterpret_cast<int64_t *>(data + sizeof(NodeHeader));
+  if (node.isLeaf()) {
+    node.rids = reinterpret_cast<RID *>(data + sizeof(NodeHeader) +
+                                        LEAF_CAPACITY * sizeof(int64_t));
+  } else {
+    node.children = reinterpret_cast<page_id_t *>(
+        data + sizeof(NodeHeader) + INTERNAL_CAPACITY * sizeof(int64_t));
+    bpm->setPagePriority(page, PagePriority::HIGH);
+  }
+  return node;
+}
+
+BPlusTree::Node BPlusTree::fetchNode(page_id_t page_id) {
+  Page *page = bpm->fetchPage(page_id);
+  if (page == nullptr) {
+    std::cerr << "Could not fetch index page " << page_id << "\n";
+    return Node();
+  }
+  return view(page);
+}
+
+BPlusTree::Node BPlusTree::newNode(page_id_t *page_id, bool is_leaf) {
+  Page *page = bpm->newPage(page_id);
+  if (page == nullptr) {
+    std::cerr << "Could not allocate index page\n";
+    return Node();
+  }
+  auto *header = reinterpret_cast<NodeHeader *>(page->getData());
+  header->is_leaf = is_leaf;
+  header->key_count = 0;
+  header->next_page_id = INVALID_PAGE_ID;
+  return view(page);
+}
+
+page_id_t BPlusTree::findLeaf(int64_t key, std::vector<page_id_t> *path) {
+  page_id_t page_id = root_page_id;
+  for (;;) {
+    Node node = fetchNode(page_id);
+    if (node.page == nullptr) {
+      return INVALID_PAGE_ID;
+    }
+    if (node.isLeaf()) {
+      bpm->unpinPage(page_id, false);
+      return page_id;
+    }
+    if (path != nullptr) {
+      path->push_back(page_id);
+    }
+    std::size_t child =
+        std::upper_bound(node.keys, node.keys + node.header->key_count, key) -
+        node.keys;
+    page_id_t next = node.children[child];
+    bpm->unpinPage(page_id, false);
+    page_id = next;
+  }
+}
+
+BPlusTree::Node BPlusTree::descend(int64_t key) {
+  Node node = fetchNode(root_page_id);
+  while (node.page != nullptr && !node.isLeaf()) {
+    std::size_t child =
+        std::upper_bound(node.keys, node.keys + node.header->key_count, key) -
+        node.keys;
+    // parent stays pinned until the child is, so a swizzled reference in
+    // its frame stays valid
+    Page *page = bpm->fetchChild(node.page, child, node.children[child]);
+    if (page == nullptr) {
+      std::cerr << "Could not fetch index page " << node.children[child]
+                << "\n";
+    }
+    bpm->unpinPage(node.page, false);
+    node = page != nullptr ? view(page) : Node();
+  }
+  return node;
+}
+
+std::size_t BPlusTree::getHeight() {
+  std::size_t height = 0;
+  page_id_t page_id = root_page_id;
+  while (page_id != INVALID_PAGE_ID) {
+    Node node = fetchNode(page_id);
+    if (node.page == nullptr) {
+      break;
+    }
+    height++;
+    page_id_t next = node.isLeaf() ? INVALID_PAGE_ID : node.children[0];
+    bpm->unpinPage(page_id, false);
+    page_id = next;
+  }
+  return height;
+}
+
+bool BPlusTree::lookup(int64_t key, RID *rid) {
+  if (isEmpty()) {
+    return false;
+  }
+  if (filter != nullptr && !filter->mayContain(key)) {
+    filtered_lookups++;
+    return false;
+  }
+  Node leaf = descend(key);
+  if (leaf.page == nullptr) {
+    return false;
+  }
+  int64_t *end = leaf.keys + leaf.header->key_count;
+  int64_t *pos = std::lower_bound(leaf.keys, end, key);
+  bool found = pos != end && *pos == key;
+  if (found) {
+    *rid = leaf.rids[pos - leaf.keys];
+  }
+  bpm->unpinPage(leaf.page, false);
+  return found;
+}
+
+std::size_t BPlusTree::lookupBatch(const std::vector<int64_t> &keys,
+                                   std::vector<RID> *rids,
+                                   std::vector<bool> *found) {
+  rids->assign(keys.size(), RID());
+  found->assign(keys.size(), false);
+  if (isEmpty()) {
+    return 0;
+  }
+
+  // node each key is at; filtered keys drop out
+  std::vector<page_id_t> at(keys.size(), root_page_id);
+  std::vector<std::size_t> active;
+  for (std::size_t i = 0; i < keys.size(); i++) {
+    if (filter != nullptr && !filter->mayContain(keys[i])) {
+      filtered_lookups++;
+    } else {
+      active.push_back(i);
+    }
+  }
+
+  // nodes pinned per batch, so a batch always fits in the pool
+  std::size_t slice = std::min<std::size_t>(
+      kMaxBatchNodes, std::max<std::size_t>(1, bpm->getPoolSize() / 4));
+  std::size_t hits = 0;
+  std::vector<page_id_t> level;
+  std::vector<Page *> pages;
+  bool leaves = false;
+  while (!active.empty() && !leaves) {
+    // keys grouped by node, then the distinct nodes of this level fetched
+    // slice by slice, each slice as one batch
+    std::sort(active.begin(), active.end(),
+              [&](std::size_t a, std::size_t b) { return at[a] < at[b]; });
+    std::size_t begin = 0;
+    while (begin < active.size()) {
+      level.clear();
+      std::size_t end = begin;
+      for (; end < active.size(); end++) {
+        if (level.empty() || level.back() != at[active[end]]) {
+          if (level.size() == slice) {
+            break;
+          }
+          level.push_back(at[active[end]]);
+        }
+      }
+      pages.resize(level.size());
+      if (!bpm->fetchPages(level.data(), level.size(), pages.data())) {
+        std::cerr << "Could not fetch index pages\n";
+        return hits;
+      }
+
+      std::size_t n = 0;
+      Node node = view(pages[0]);
+      leaves = node.isLeaf(); // every leaf is on the same level
+      for (std::size_t j = begin; j < end; j++) {
+        std::size_t i = active[j];
+        if (level[n] != at[i]) {
+          node = view(pages[++n]);
+        }
+        int64_t *last = node.keys + node.header->key_count;
+        if (leaves) {
+          int64_t *pos = std::lower_bound(node.keys, last, keys[i]);
+          if (pos != last && *pos == keys[i]) {
+            (*rids)[i] = node.rids[pos - node.keys];
+            (*found)[i] = true;
+            hits++;
+          }
+        } else {
+          at[i] = node.children[std::upper_bound(node.keys, last, keys[i]) -
+                                node.keys];
+        }
+      }
+      for (Page *page : pages) {
+        bpm->unpinPage(page, false);
+      }
+      begin = end;
+    }
+  }
+  return hits;
+}
+
+void BPlusTree::scanRange(
+    int64_t low, int64_t high,
+    const std::function<void(int64_t, const RID &)> &f) {
+  if (isEmpty() || low > high) {
+    return;
+  }
+  page_id_t page_id = findLeaf(low, nullptr);
+  while (page_id != INVALID_PAGE_ID) {
+    Node leaf = fetchNode(page_id);
+    if (leaf.page == nullptr) {
+      return;
+    }
+    uint16_t count = leaf.header->key_count;
+    std::size_t i = std::lower_bound(leaf.keys, leaf.keys + count, low) -
+                    leaf.keys;
+    for (; i < count; i++) {
+      if (leaf.keys[i] > high) {
+        bpm->unpinPage(page_id, false);
+        return;
+      }
+      f(leaf.keys[i], leaf.rids[i]);
+    }
+    page_id_t next = leaf.header->next_page_id;
+    bpm->unpinPage(page_id, false);
+    page_id = next;
+  }
+}
+
+void BPlusTree::enableBloomFilter(std::size_t expected_keys,
+                                  std::size_t bits_per_key) {
+  filter = std::make_unique<BloomFilter>(expected_keys, bits_per_key);
+  scanRange(INT64_MIN, INT64_MAX,
+            [this](int64_t key, const RID &) { filter->insert(key); });
+}
+
+bool BPlusTree::insert(int64_t key, const RID &rid) {
+  // a failed insert only leaves a false positive behind
+  if (filter != nullptr) {
+    filter->insert(key);
+  }
+  if (isEmpty()) {
+    Node root = newNode(&root_page_id, true);
+    if (root.page == nullptr) {
+      root_page_id = INVALID_PAGE_ID;
+      return false;
+    }
+    root.keys[0] = key;
+    root.rids[0] = rid;
+    root.header->key_count = 1;
+    bpm->unpinPage(root_page_id, true);
+    return true;
+  }
+
+  std::vector<page_id_t> path;
+  page_id_t leaf_id = findLeaf(key, &path);
+  Node leaf = fetchNode(leaf_id);
+  if (leaf.page == nullptr) {
+    return false;
+  }
+
+  uint16_t count = leaf.header->key_count;
+  std::size_t pos =
+      std::lower_bound(leaf.keys, leaf.keys + count, key) - leaf.keys;
+  if (pos < count && leaf.keys[pos] == key) {
+    bpm->unpinPage(leaf_id, false);
+    return false;
+  }
+
+  if (count < LEAF_CAPACITY) {
+    std::copy_backward(leaf.keys + pos, leaf.keys + count,
+                       leaf.keys + count + 1);
+    std::copy_backward(leaf.rids + pos, leaf.rids + count,
+                       leaf.rids + count + 1);
+    leaf.keys[pos] = key;
+    leaf.rids[pos] = rid;
+    leaf.header->key_count++;
+    bpm->unpinPage(leaf_id, true);
+    return true;
+  }
+
+  // split: upper half moves to a new right sibling
+  page_id_t right_id;
+  Node right = newNode(&right_id, true);
+  if (right.page == nullptr) {
+    bpm->unpinPage(leaf_id, false);
+    return false;
+  }
+
+  std::vector<int64_t> keys(leaf.keys, leaf.keys + count);
+  std::vector<RID> rids(leaf.rids, leaf.rids + count);
+  keys.insert(keys.begin() + pos, key);
+  rids.insert(rids.begin() + pos, rid);
+
+  std::size_t left_count = keys.size() / 2;
+  std::copy(keys.begin(), keys.begin() + left_count, leaf.keys);
+  std::copy(rids.begin(), rids.begin() + left_count, leaf.rids);
+  std::copy(keys.begin() + left_count, keys.end(), right.keys);
+  std::copy(rids.begin() + left_count, rids.end(), right.rids);
+  leaf.header->key_count = static_cast<uint16_t>(left_count);
+  right.header->key_count = static_cast<uint16_t>(keys.size() - left_count);
+  right.header->next_page_id = leaf.header->next_page_id;
+  leaf.header->next_page_id = right_id;
+
+  int64_t separator = right.keys[0];
+  bpm->unpinPage(leaf_id, true);
+  bpm->unpinPage(right_id, true);
+  return insertIntoParent(path, leaf_id, separator, right_id);
+}
+
+bool BPlusTree::insertIntoParent(std::vector<page_id_t> &path, page_id_t left,
+                                 int64_t separator, page_id_t right) {
+  if (path.empty()) {
+    // the root split
+    page_id_t new_root_id;
+    Node root = newNode(&new_root_id, false);
+    if (root.page == nullptr) {
+      return false;
+    }
+    root.keys[0] = separator;
+    root.children[0] = left;
+    root.children[1] = right;
+    root.header->key_count = 1;
+    bpm->unpinPage(new_root_id, true);
+    root_page_id = new_root_id;
+    return true;
+  }
+
+  page_id_t parent_id = path.back();
+  path.pop_back();
+  Node parent = fetchNode(parent_id);
+  if (parent.page == nullptr) {
+    return false;
+  }
+
+  uint16_t count = parent.header->key_count;
+  std::size_t pos =
+      std::upper_bound(parent.keys, parent.keys + count, separator) -
+      parent.keys;
+
+  if (count < INTERNAL_CAPACITY) {
+    std::copy_backward(parent.keys + pos, parent.keys + count,
+                       parent.keys + count + 1);
+    std::copy_backward(parent.children + pos + 1,
+                       parent.children + count + 1,
+                       parent.children + count + 2);
+    parent.keys[pos] = separator;
+    parent.children[pos + 1] = right;
+    parent.header->key_count++;
+    bpm->unpinPage(parent_id, true);
+    return true;
+  }
+
+  page_id_t sibling_id;
+  Node sibling = newNode(&sibling_id, false);
+  if (sibling.page == nullptr) {
+    bpm->unpinPage(parent_id, false);
+    return false;
+  }
+
+  std::vector<int64_t> keys(parent.keys, parent.keys + count);
+  std::vector<page_id_t> children(parent.children,
+                                  parent.children + count + 1);
+  keys.insert(keys.begin() + pos, separator);
+  children.insert(children.begin() + pos + 1, right);
+
+  // the middle key moves up, it is not kept in either half
+  std::size_t middle = keys.size() / 2;
+  int64_t up = keys[middle];
+  std::copy(keys.begin(), keys.begin() + middle, parent.keys);
+  std::copy(children.begin(), children.begin() + middle + 1,
+            parent.children);
+  std::copy(keys.begin() + middle + 1, keys.end(), sibling.keys);
+  std::copy(children.begin() + middle + 1, children.end(), sibling.children);
+  parent.header->key_count = static_cast<uint16_t>(middle);
+  sibling.header->key_count =
+      static_cast<uint16_t>(keys.size() - middle - 1);
+
+  bpm->unpinPage(parent_id, true);
+  bpm->unpinPage(sibling_id, true);
+  return insertIntoParent(path, parent_id, up, sibling_id);
+}
+
+namespace {
+
+// per-node entry counts that spread `total` entries evenly over as few nodes
+// as possible with at most `per_node` each
+std::vector<std::size_t> distribute(std::size_t total, std::size_t per_node) {
+  std::size_t nodes = (total + per_node - 1) / per_node;
+  std::vector<std::size_t> counts(nodes, total / nodes);
+  for (std::size_t i = 0; i < total % nodes; i++) {
+    counts[i]++;
+  }
+  return counts;
+}
+
+} // namespace
+
+bool BPlusTree::bulkLoad(const std::vector<std::pair<int64_t, RID>> &entries,
+                         double fill_factor) {
+  if (!isEmpty()) {
+    std::cerr << "Bulk load needs an empty tree\n";
+    return false;
+  }
+  if (entries.empty()) {
+    return true;
+  }
+  for (std::size_t i = 1; i < entries.size(); i++) {
+    if (entries[i - 1].first >= entries[i].first) {
+      std::cerr << "Bulk load input is not sorted by unique key\n";
+      return false;
+    }
+  }
+  fill_factor = std::clamp(fill_factor, 0.01, 1.0);
+
+  // level being built: {first key, page id} of every node, in key order
+  std::vector<std::pair<int64_t, page_id_t>> level;
+
+  // leaves: every leaf is allocated before the previous one is written out,
+  // so it can be linked and the pages reach the disk in order
+  std::size_t leaf_fill = std::max<std::size_t>(
+      1, static_cast<std::size_t>(std::floor(LEAF_CAPACITY * fill_factor)));
+  std::vector<std::size_t> counts = distribute(entries.size(), leaf_fill);
+  level.reserve(counts.size());
+
+  page_id_t leaf_id;
+  Node leaf = newNode(&leaf_id, true);
+  if (leaf.page == nullptr) {
+    return false;
+  }
+  std::size_t next_entry = 0;
+  for (std::size_t l = 0; l < counts.size(); l++) {
+    for (std::size_t i = 0; i < counts[l]; i++, next_entry++) {
+      leaf.keys[i] = entries[next_entry].first;
+      leaf.rids[i] = entries[next_entry].second;
+      if (filter != nullptr) {
+        filter->insert(entries[next_entry].first);
+      }
+    }
+    leaf.header->key_count = static_cast<uint16_t>(counts[l]);
+    level.emplace_back(leaf.keys[0], leaf_id);
+
+    page_id_t next_id = INVALID_PAGE_ID;
+    Node next;
+    if (l + 1 < counts.size()) {
+      next = newNode(&next_id, true);
+      if (next.page == nullptr) {
+        bpm->unpinPage(leaf_id, true);
+        return false;
+      }
+    }
+    leaf.header->next_page_id = next_id;
+    bpm->unpinPage(leaf_id, true);
+    bpm->flushPage(leaf_id);
+    leaf = next;
+    leaf_id = next_id;
+  }
+
+  // internal levels, bottom-up, until a single root remains
+  std::size_t fanout = std::max<std::size_t>(
+      2, static_cast<std::size_t>(
+             std::floor((INTERNAL_CAPACITY + 1) * fill_factor)));
+  while (level.size() > 1) {
+    std::vector<std::pair<int64_t, page_id_t>> parents;
+    counts = distribute(level.size(), fanout);
+    std::size_t next_child = 0;
+    for (std::size_t children : counts) {
+      page_id_t node_id;
+      Node node = newNode(&node_id, false);
+      if (node.page == nullptr) {
+        return false;
+      }
+      for (std::size_t i = 0; i < children; i++, next_child++) {
+        node.children[i] = level[next_child].second;
+        if (i > 0) {
+          node.keys[i - 1] = level[next_child].first;
+        }
+      }
+      node.header->key_count = static_cast<uint16_t>(children - 1);
+      parents.emplace_back(level[next_child - children].first, node_id);
+      bpm->unpinPage(node_id, true);
+      bpm->flushPage(node_id);
+    }
+    level = std::move(parents);
+  }
+
+  root_page_id = level.front().second;
+  return true;
+}
@@ -0,0 +1,123 @@
+/* B+ tree index requirements
+1. Unique int64 keys mapped to RIDs, every node is one Page fetched through
+the BufferPoolManager (fetch -> use -> unpin)
+2. Leaves hold sorted {key, RID} arrays and are chained left to right through
+next_page_id for range scans
+3. Internal nodes hold n separator keys and n + 1 children; child i covers
+[key[i - 1], key[i])
+4. Inserts split full nodes in half and push the separator up, growing a new
+root when the old one splits
+5. bulkLoad builds a tree from sorted input bottom-up: leaves are filled in
+key order up to the fill factor and written out as soon as they are
+complete, then every internal level is built from the level below, so pages
+are allocated and written sequentially instead of being split at random
+6. The root page id is owned by the caller (e.g. IndexInfo::root_page_id)
+7. An optional in-memory Bloom filter over all keys answers most lookups of
+absent keys without fetching a single page; it is rebuilt from the leaves
+when enabled on an existing tree
+8. Point lookups descend with BufferPoolManager::fetchChild, so when the
+pool's swizzling mode is on, resident nodes are reached by frame pointer
+9. Internal nodes are hinted HIGH priority to the buffer pool replacer, so
+the upper levels every lookup passes through outlive leaf and scan pages
+10. lookupBatch descends for a batch of keys one level at a time, fetching
+the distinct nodes of each level with BufferPoolManager::fetchPages so
+their misses are read together
+*/
+#pragma once
+
+#include "BloomFilter.hpp"
+#include "buffer/BufferPoolManager.hpp"
+#include "table/TableHeap.hpp"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+class BPlusTree {
+private:
+  struct alignas(8) NodeHeader {
+    uint16_t is_leaf;
+    uint16_t key_count;
+    page_id_t next_page_id; // right sibling (leaves only)
+  };
+
+  BufferPoolManager *bpm;
+  page_id_t root_page_id;
+  std::unique_ptr<BloomFilter> filter;
+  std::size_t filtered_lookups = 0; // lookups answered by the filter
+
+  // pinned page + views into its node layout
+  struct Node {
+    Page *page = nullptr;
+    NodeHeader *header = nullptr;
+    int64_t *keys = nullptr;
+    RID *rids = nullptr;          // leaves
+    page_id_t *children = nullptr; // internal nodes
+
+    bool isLeaf() const { return header->is_leaf != 0; }
+  };
+
+  // also hints internal nodes HIGH to the replacer
+  Node view(Page *page);
+  Node fetchNode(page_id_t page_id);
+  Node newNode(page_id_t *page_id, bool is_leaf);
+
+  // leaf that would contain key; path receives the internal nodes visited
+  page_id_t findLeaf(int64_t key, std::vector<page_id_t> *path);
+
+  // pinned leaf that would contain key, found with coupled pins and
+  // BufferPoolManager::fetchChild so swizzled references are followed
+  Node descend(int64_t key);
+
+  bool insertIntoParent(std::vector<page_id_t> &path, page_id_t left,
+                        int64_t separator, page_id_t right);
+
+public:
+  static constexpr std::size_t LEAF_CAPACITY =
+      (PAGE_SIZE - sizeof(NodeHeader)) / (sizeof(int64_t) + sizeof(RID));
+  static constexpr std::size_t INTERNAL_CAPACITY =
+      (PAGE_SIZE - sizeof(NodeHeader) - sizeof(page_id_t)) /
+      (sizeof(int64_t) + sizeof(page_id_t));
+
+  // most nodes lookupBatch fetches (and pins) with one fetchPages call
+  static constexpr std::size_t kMaxBatchNodes = 64;
+
+  // opens the tree rooted at rootPageId (INVALID_PAGE_ID = empty tree)
+  explicit BPlusTree(BufferPoolManager *bufferPool,
+                     page_id_t rootPageId = INVALID_PAGE_ID)
+      : bpm(bufferPool), root_page_id(rootPageId) {}
+
+  page_id_t getRootPageId() const { return root_page_id; }
+
+  bool isEmpty() const { return root_page_id == INVALID_PAGE_ID; }
+
+  // levels from root to leaves (0 for an empty tree)
+  std::size_t getHeight();
+
+  // false if the key exists or no page could be allocated
+  bool insert(int64_t key, const RID &rid);
+
+  bool lookup(int64_t key, RID *rid);
+
+  // looks up every key of keys: found[i] and rids[i] as lookup(keys[i])
+  // would set them. Returns the number of keys found.
+  std::size_t lookupBatch(const std::vector<int64_t> &keys,
+                          std::vector<RID> *rids, std::vector<bool> *found);
+
+  // builds a filter sized for expected_keys and keeps it updated on insert
+  void enableBloomFilter(std::size_t expected_keys,
+                         std::size_t bits_per_key = 10);
+
+  std::size_t getFilteredLookups() const { return filtered_lookups; }
+
+  // calls f(key, rid) for every key in [low, high] in key order
+  void scanRange(int64_t low, int64_t high,
+                 const std::function<void(int64_t, const RID &)> &f);
+
+  // builds the tree from entries sorted by strictly increasing key; only
+  // valid on an empty tree. fill_factor in (0, 1] is the fraction of each
+  // node's capacity used, leaving room for later inserts
+  bool bulkLoad(const std::vector<std::pair<int64_t, RID>> &entries,
+                double fill_factor = 1.0);
+};
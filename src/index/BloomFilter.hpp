@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// Split-block Bloom filter over int64 keys. A key maps to one 32-byte block
+// (half a cache line) and sets one bit in each of the block's 8 words, so
+// an insert or probe touches a single cache line and the 8 word tests are
+// independent lanes the compiler can vectorize.
+class BloomFilter {
+private:
+  struct alignas(32) Block {
+    uint32_t words[8];
+  };
+
+  static constexpr uint32_t kSalt[8] = {0x47b6137bU, 0x44974d91U,
+                                        0x8824ad5bU, 0xa2b7289dU,
+                                        0x705495c7U, 0x2df1424bU,
+                                        0x9efc4947U, 0x5c6bfb31U};
+
+  std::vector<Block> blocks;
+
+  static uint64_t hash(int64_t key) {
+    // murmur3 finalizer, independent of the partitioning hash
+    uint64_t x = static_cast<uint64_t>(key);
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return x;
+  }
+
+  std::size_t blockIndex(uint64_t h) const {
+    // high 32 bits pick the block (multiply-shift instead of modulo)
+    return ((h >> 32) * blocks.size()) >> 32;
+  }
+
+public:
+  // ~bits_per_key bits per expected key; 10 gives about 1% false positives
+  explicit BloomFilter(std::size_t expected_keys = 0,
+                       std::size_t bits_per_key = 10) {
+    std::size_t bits = expected_keys * bits_per_key;
+    std::size_t num_blocks = (bits + 255) / 256;
+    blocks.assign(num_blocks == 0 ? 1 : num_blocks, Block{});
+  }
+
+  std::size_t getMemoryUsage() const { return blocks.size() * sizeof(Block); }
+
+  void insert(int64_t key) {
+    uint64_t h = hash(key);
+    Block &block = blocks[blockIndex(h)];
+    uint32_t low = static_cast<uint32_t>(h);
+    for (int i = 0; i < 8; i++) {
+      block.words[i] |= 1U << ((low * kSalt[i]) >> 27);
+    }
+  }
+
+  // false: the key was never inserted; true: it probably was
+  bool mayContain(int64_t key) const {
+    uint64_t h = hash(key);
+    const Block &block = blocks[blockIndex(h)];
+    uint32_t low = static_cast<uint32_t>(h);
+    uint32_t missing = 0;
+    for (int i = 0; i < 8; i++) {
+      missing |= ~block.words[i] & (1U << ((low * kSalt[i]) >> 27));
+    }
+    return missing == 0;
+  }
+};
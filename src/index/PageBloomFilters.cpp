@@ -0,0 +1,108 @@
+#include "PageBloomFilters.hpp"
+#include <algorithm>
+
+PageBloomFilters::PageBloomFilters(BufferPoolManager *bufferPool,
+                                   const Schema &tableSchema, uint32_t colIdx,
+                                   std::size_t bitsPerKey)
+    : bpm(bufferPool), schema(&tableSchema), col_idx(colIdx),
+      bits_per_key(bitsPerKey) {}
+
+int64_t PageBloomFilters::getKey(const Tuple &tuple) const {
+  switch (schema->getType(col_idx)) {
+  case TypeId::BOOLEAN:
+    return tuple.getBoolean(col_idx);
+  case TypeId::INTEGER:
+    return tuple.getInteger(col_idx);
+  default:
+    return tuple.getBigInt(col_idx);
+  }
+}
+
+BloomFilter &PageBloomFilters::filterFor(page_id_t page_id) {
+  auto it = page_index.find(page_id);
+  if (it != page_index.end()) {
+    return filters[it->second];
+  }
+  // a page we have not seen yet: size it for a page full of minimal rows
+  std::size_t row_size = std::max<std::size_t>(8, schema->getFixedLength());
+  page_index[page_id] = filters.size();
+  page_ids.push_back(page_id);
+  filters.emplace_back(PAGE_SIZE / row_size, bits_per_key);
+  return filters.back();
+}
+
+bool PageBloomFilters::build(TableHeap &heap) {
+  page_ids.clear();
+  filters.clear();
+  page_index.clear();
+
+  std::vector<int64_t> keys;
+  for (page_id_t page_id : heap.getPageIds()) {
+    Page *page = bpm->fetchPage(page_id);
+    if (page == nullptr) {
+      std::cerr << "Could not fetch page " << page_id << " for filters\n";
+      return false;
+    }
+    keys.clear();
+    for (uint16_t slot = 0; slot < page->getNumberOfSlots(); slot++) {
+      if (page->isRecordDeleted(slot)) {
+        continue;
+      }
+      Tuple tuple = Tuple::fromPage(schema, *page, slot);
+      if (!tuple.isNull(col_idx)) {
+        keys.push_back(getKey(tuple));
+      }
+    }
+    bpm->unpinPage(page_id, false);
+
+    page_index[page_id] = filters.size();
+    page_ids.push_back(page_id);
+    filters.emplace_back(keys.size(), bits_per_key);
+    for (int64_t key : keys) {
+      filters.back().insert(key);
+    }
+  }
+  return true;
+}
+
+void PageBloomFilters::add(const RID &rid, int64_t key) {
+  filterFor(rid.page_id).insert(key);
+}
+
+std::size_t PageBloomFilters::lookup(
+    int64_t key, const std::function<void(const RID &, const Tuple &)> &f) {
+  std::size_t matches = 0;
+  for (std::size_t i = 0; i < page_ids.size(); i++) {
+    if (!filters[i].mayContain(key)) {
+      pages_skipped++;
+      continue;
+    }
+    Page *page = bpm->fetchPage(page_ids[i]);
+    if (page == nullptr) {
+      continue;
+    }
+    pages_fetched++;
+    for (uint16_t slot = 0; slot < page->getNumberOfSlots(); slot++) {
+      if (page->isRecordDeleted(slot)) {
+        continue;
+      }
+      Tuple tuple = Tuple::fromPage(schema, *page, slot);
+      if (!tuple.isNull(col_idx) && getKey(tuple) == key) {
+        matches++;
+        if (f) {
+          f(RID{page_ids[i], slot}, tuple);
+        }
+      }
+    }
+    bpm->unpinPage(page_ids[i], false);
+  }
+  return matches;
+}
+
+std::size_t PageBloomFilters::getMemoryUsage() const {
+  std::size_t bytes = 0;
+  for (const BloomFilter &filter : filters) {
+    bytes += filter.getMemoryUsage();
+  }
+  return bytes;
+}
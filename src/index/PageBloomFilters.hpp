@@ -0,0 +1,54 @@
+/* Per-page Bloom filter requirements
+1. One BloomFilter per heap page summarizes the values of one integer-family
+column (BOOLEAN / INTEGER / BIGINT) stored on that page
+2. Point lookups consult the filters first and only fetch the pages whose
+filter may contain the key, so absent keys cost no page fetches at all
+3. Filters live in memory; they are built with one pass over the heap and
+kept current by calling add() after every insert
+*/
+#pragma once
+
+#include "BloomFilter.hpp"
+#include "table/TableHeap.hpp"
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+class PageBloomFilters {
+private:
+  BufferPoolManager *bpm;
+  const Schema *schema;
+  uint32_t col_idx;
+  std::size_t bits_per_key;
+
+  std::vector<page_id_t> page_ids;
+  std::vector<BloomFilter> filters; // parallel to page_ids
+  std::unordered_map<page_id_t, std::size_t> page_index;
+  std::size_t pages_fetched = 0;
+  std::size_t pages_skipped = 0;
+
+  BloomFilter &filterFor(page_id_t page_id);
+  int64_t getKey(const Tuple &tuple) const;
+
+public:
+  PageBloomFilters(BufferPoolManager *bufferPool, const Schema &tableSchema,
+                   uint32_t colIdx, std::size_t bitsPerKey = 10);
+
+  // (re)builds the filters of every page of the heap
+  bool build(TableHeap &heap);
+
+  // records that `key` was inserted at rid
+  void add(const RID &rid, int64_t key);
+
+  // calls f for every live row whose column equals key, returns the number
+  // of matches
+  std::size_t
+  lookup(int64_t key,
+         const std::function<void(const RID &, const Tuple &)> &f = nullptr);
+
+  std::size_t getPagesFetched() const { return pages_fetched; }
+
+  std::size_t getPagesSkipped() const { return pages_skipped; }
+
+  std::size_t getMemoryUsage() const;
+};
@@ -0,0 +1,72 @@
+/* Arena requirements
+1. Hands out 8-byte aligned memory from large blocks with a single atomic
+add in the common case, so concurrent writers never share a lock
+2. A writer that overruns the current block installs a new one under a
+small mutex; oversized requests get a block of their own
+3. Memory is only released when the arena is destroyed, every pointer stays
+valid until then
+*/
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class Arena {
+private:
+  struct Block {
+    std::unique_ptr<char[]> data;
+    std::size_t size;
+    std::atomic<std::size_t> used{0};
+
+    explicit Block(std::size_t bytes)
+        : data(new char[bytes]), size(bytes) {}
+  };
+
+  static constexpr std::size_t kBlockSize = 64 << 10;
+
+  std::mutex block_mutex; // guards blocks and replacing current
+  std::vector<std::unique_ptr<Block>> blocks;
+  std::atomic<Block *> current{nullptr};
+  std::atomic<std::size_t> memory_usage{0};
+
+  Block *addBlock(std::size_t bytes) {
+    blocks.push_back(std::make_unique<Block>(bytes));
+    return blocks.back().get();
+  }
+
+public:
+  Arena() { current.store(addBlock(kBlockSize), std::memory_order_release); }
+
+  Arena(const Arena &) = delete;
+  Arena &operator=(const Arena &) = delete;
+
+  char *allocate(std::size_t bytes) {
+    bytes = (bytes + 7) & ~static_cast<std::size_t>(7);
+    memory_usage.fetch_add(bytes, std::memory_order_relaxed);
+    if (bytes > kBlockSize / 4) {
+      std::lock_guard<std::mutex> lock(block_mutex);
+      return addBlock(bytes)->data.get();
+    }
+    while (true) {
+      Block *block = current.load(std::memory_order_acquire);
+      std::size_t offset =
+          block->used.fetch_add(bytes, std::memory_order_relaxed);
+      if (offset + bytes <= block->size) {
+        return block->data.get() + offset;
+      }
+      // block exhausted: the first writer to get here replaces it
+      std::lock_guard<std::mutex> lock(block_mutex);
+      if (current.load(std::memory_order_relaxed) == block) {
+        current.store(addBlock(kBlockSize), std::memory_order_release);
+      }
+    }
+  }
+
+  // bytes handed out so far
+  std::size_t getMemoryUsage() const {
+    return memory_usage.load(std::memory_order_relaxed);
+  }
+};
@@ -0,0 +1,581 @@
+#include "LsmTree.hpp"
+#include <algorithm>
+#include <limits>
+#include <queue>
+
+namespace {
+
+struct ManifestHeader {
+  uint32_t magic;
+  uint32_t num_runs;
+  uint64_t next_seq;
+};
+
+struct ManifestRun {
+  uint64_t seq;
+  uint32_t level;
+  page_id_t first_page_id;
+};
+
+// one sorted input of a merge: a memtable snapshot or an SSTable cursor
+struct MergeInput {
+  struct Row {
+    int64_t key;
+    bool tombstone;
+    std::string value;
+  };
+
+  std::vector<Row> rows;
+  std::size_t pos = 0;
+  std::unique_ptr<SSTable::Iterator> it;
+
+  bool valid() const { return it ? it->valid() : pos < rows.size(); }
+  bool failed() const { return it && it->failed(); }
+  int64_t key() const { return it ? it->key() : rows[pos].key; }
+  bool tombstone() const {
+    return it ? it->tombstone() : rows[pos].tombstone;
+  }
+  std::string_view value() const {
+    return it ? it->value() : std::string_view(rows[pos].value);
+  }
+  void next() {
+    if (it) {
+      it->next();
+    } else {
+      pos++;
+    }
+  }
+};
+
+MergeInput snapshot(const MemTable &table, int64_t low, int64_t high) {
+  MergeInput input;
+  table.forEach(low, high,
+                [&](int64_t key, bool tombstone, std::string_view value) {
+                  input.rows.push_back({key, tombstone, std::string(value)});
+                });
+  return input;
+}
+
+// Walks the union of inputs in key order. inputs[0] is the newest; of all
+// versions of a key only the newest one is returned. Stops as soon as an
+// input fails: the keys after it could come from older versions.
+class MergeCursor {
+private:
+  std::vector<MergeInput> &inputs;
+  std::priority_queue<std::pair<int64_t, std::size_t>,
+                      std::vector<std::pair<int64_t, std::size_t>>,
+                      std::greater<>>
+      heap;
+  bool error = false;
+
+public:
+  explicit MergeCursor(std::vector<MergeInput> &mergeInputs)
+      : inputs(mergeInputs) {
+    for (std::size_t i = 0; i < inputs.size(); i++) {
+      error = error || inputs[i].failed();
+      if (inputs[i].valid()) {
+        heap.push({inputs[i].key(), i});
+      }
+    }
+  }
+
+  bool valid() const { return !error && !heap.empty(); }
+
+  bool failed() const { return error; }
+
+  const MergeInput &current() const { return inputs[heap.top().second]; }
+
+  // skips every version of the current key
+  void next() {
+    int64_t key = heap.top().first;
+    while (!heap.empty() && heap.top().first == key) {
+      std::size_t i = heap.top().second;
+      heap.pop();
+      inputs[i].next();
+      error = error || inputs[i].failed();
+      if (inputs[i].valid()) {
+        heap.push({inputs[i].key(), i});
+      }
+    }
+  }
+};
+
+std::size_t levelBytes(const std::vector<std::shared_ptr<SSTable>> &level) {
+  std::size_t bytes = 0;
+  for (const auto &run : level) {
+    bytes += run->getSizeBytes();
+  }
+  return bytes;
+}
+
+// true if no level deeper than level holds a run
+bool isBottom(const std::vector<std::vector<std::shared_ptr<SSTable>>> &levels,
+              std::size_t level) {
+  for (std::size_t i = level + 1; i < levels.size(); i++) {
+    if (!levels[i].empty()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+LsmTree::LsmTree(BufferPoolManager *bufferPool, page_id_t manifestPageId,
+                 LsmOptions lsmOptions)
+    : bpm(bufferPool), manifest_page_id(manifestPageId),
+      options(lsmOptions), memtable(std::make_shared<MemTable>()),
+      version(std::make_shared<Version>()) {
+  if (!loadManifest()) {
+    std::cerr << "Could not load LSM manifest " << manifest_page_id << "\n";
+  }
+  if (options.background) {
+    worker = std::thread(&LsmTree::backgroundLoop, this);
+  }
+}
+
+LsmTree::~LsmTree() {
+  flush();
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stop = true;
+  }
+  work_cv.notify_all();
+  if (worker.joinable()) {
+    worker.join();
+  }
+  writeManifest(*version);
+}
+
+bool LsmTree::loadManifest() {
+  Page *page = bpm->fetchPage(manifest_page_id);
+  if (page == nullptr) {
+    return false;
+  }
+  if (page->getNumberOfSlots() == 0) {
+    bpm->unpinPage(manifest_page_id, false);
+    return true;
+  }
+
+  ManifestHeader header;
+  memcpy(&header, page->getRecord(0), sizeof(header));
+  if (header.magic != MANIFEST_MAGIC) {
+    bpm->unpinPage(manifest_page_id, false);
+    return false;
+  }
+  std::vector<ManifestRun> runs(header.num_runs);
+  for (uint32_t i = 0; i < header.num_runs; i++) {
+    memcpy(&runs[i], page->getRecord(static_cast<uint16_t>(i + 1)),
+           sizeof(ManifestRun));
+  }
+  bpm->unpinPage(manifest_page_id, false);
+
+  auto v = std::make_shared<Version>();
+  for (const ManifestRun &run : runs) {
+    auto table =
+        SSTable::open(bpm, run.seq, run.first_page_id, options.bits_per_key);
+    if (table == nullptr) {
+      return false;
+    }
+    if (v->levels.size() <= run.level) {
+      v->levels.resize(run.level + 1);
+    }
+    v->levels[run.level].push_back(std::move(table));
+  }
+  for (auto &level : v->levels) {
+    std::sort(level.begin(), level.end(), [](const auto &a, const auto &b) {
+      return a->getSeq() > b->getSeq();
+    });
+  }
+  next_seq = header.next_seq;
+  version = std::move(v);
+  return true;
+}
+
+bool LsmTree::writeManifest(const Version &v) {
+  Page *page = bpm->fetchPage(manifest_page_id);
+  if (page == nullptr) {
+    return false;
+  }
+  page->resetMemory();
+  page->setPageId(manifest_page_id);
+
+  std::vector<ManifestRun> runs;
+  for (std::size_t level = 0; level < v.levels.size(); level++) {
+    for (const auto &run : v.levels[level]) {
+      runs.push_back({run->getSeq(), static_cast<uint32_t>(level),
+                      run->getFirstPageId()});
+    }
+  }
+  ManifestHeader header{MANIFEST_MAGIC, static_cast<uint32_t>(runs.size()),
+                        next_seq};
+  bool ok = page->insertRecord(reinterpret_cast<const char *>(&header),
+                               sizeof(header));
+  for (const ManifestRun &run : runs) {
+    ok = ok && page->insertRecord(reinterpret_cast<const char *>(&run),
+                                  sizeof(run));
+  }
+  if (!ok) {
+    std::cerr << "LSM manifest does not fit in one page\n";
+  }
+  bpm->unpinPage(manifest_page_id, true);
+  bpm->flushPage(manifest_page_id);
+  return ok;
+}
+
+bool LsmTree::put(int64_t key, std::string_view value) {
+  return write(key, value, false);
+}
+
+bool LsmTree::remove(int64_t key) { return write(key, {}, true); }
+
+bool LsmTree::write(int64_t key, std::string_view value, bool tombstone) {
+  while (true) {
+    {
+      // memtable is only replaced under the exclusive latch
+      std::shared_lock<std::shared_mutex> latch(write_latch);
+      if (memtable->getMemoryUsage() < options.memtable_bytes) {
+        memtable->put(key, value, tombstone);
+        puts.fetch_add(1, std::memory_order_relaxed);
+        bytes_ingested.fetch_add(sizeof(key) + value.size(),
+                                 std::memory_order_relaxed);
+        return true;
+      }
+    }
+
+    // memtable full: swap it out, or stall while the previous one is still
+    // being flushed
+    std::unique_lock<std::mutex> lock(mutex);
+    if (io_error) {
+      return false;
+    }
+    if (memtable->getMemoryUsage() < options.memtable_bytes) {
+      continue; // another writer swapped it
+    }
+    if (immutable == nullptr) {
+      swapMemTable();
+      if (options.background) {
+        work_cv.notify_one();
+      } else {
+        while (hasWork()) {
+          if (busy) {
+            done_cv.wait(lock);
+          } else {
+            runStep(lock);
+          }
+        }
+      }
+    } else if (options.background || busy) {
+      done_cv.wait(lock);
+    } else {
+      runStep(lock);
+    }
+  }
+}
+
+void LsmTree::swapMemTable() {
+  // waits for writers still inserting into the old memtable
+  std::unique_lock<std::shared_mutex> latch(write_latch);
+  immutable = std::move(memtable);
+  memtable = std::make_shared<MemTable>();
+}
+
+bool LsmTree::get(int64_t key, std::string *value) {
+  std::shared_ptr<MemTable> mem;
+  std::shared_ptr<MemTable> imm;
+  std::shared_ptr<const Version> v;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stats.gets++;
+    mem = memtable;
+    imm = immutable;
+    v = version;
+  }
+  // memtables are safe to read concurrently and the runs never change:
+  // probe without the lock
+  for (MemTable *table : {mem.get(), imm.get()}) {
+    LsmLookup result =
+        table != nullptr ? table->get(key, value) : LsmLookup::ABSENT;
+    if (result != LsmLookup::ABSENT) {
+      return result == LsmLookup::FOUND;
+    }
+  }
+
+  // an unreadable run also ends the search: an older run may hold a value
+  // the unreadable one overwrote or deleted
+
+  LsmReadCost cost;
+  LsmLookup result = LsmLookup::ABSENT;
+  for (const auto &level : v->levels) {
+    for (const auto &run : level) {
+      result = run->get(key, value, &cost);
+      if (result != LsmLookup::ABSENT) {
+        break;
+      }
+    }
+    if (result != LsmLookup::ABSENT) {
+      break;
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(mutex);
+  stats.reads.runs_probed += cost.runs_probed;
+  stats.reads.bloom_negatives += cost.bloom_negatives;
+  stats.reads.pages_read += cost.pages_read;
+  if (result == LsmLookup::IO_ERROR) {
+    stats.read_errors++;
+  }
+  return result == LsmLookup::FOUND;
+}
+
+bool LsmTree::scan(int64_t low, int64_t high,
+                   const std::function<void(int64_t, std::string_view)> &f) {
+  std::vector<MergeInput> inputs;
+  std::shared_ptr<const Version> v;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    inputs.push_back(snapshot(*memtable, low, high));
+    if (immutable != nullptr) {
+      inputs.push_back(snapshot(*immutable, low, high));
+    }
+    v = version;
+  }
+  for (const auto &level : v->levels) {
+    for (const auto &run : level) {
+      MergeInput input;
+      input.it = std::make_unique<SSTable::Iterator>(run.get(), low);
+      inputs.push_back(std::move(input));
+    }
+  }
+
+  MergeCursor cursor(inputs);
+  for (; cursor.valid(); cursor.next()) {
+    const MergeInput &entry = cursor.current();
+    if (entry.key() > high) {
+      break;
+    }
+    if (!entry.tombstone()) {
+      f(entry.key(), entry.value());
+    }
+  }
+  if (cursor.failed()) {
+    std::lock_guard<std::mutex> lock(mutex);
+    stats.read_errors++;
+    return false;
+  }
+  return true;
+}
+
+void LsmTree::flush() {
+  std::unique_lock<std::mutex> lock(mutex);
+  if (!memtable->empty()) {
+    while (immutable != nullptr && !io_error) {
+      if (options.background || busy) {
+        done_cv.wait(lock);
+      } else {
+        runStep(lock);
+      }
+    }
+    if (immutable == nullptr) {
+      swapMemTable();
+    }
+  }
+  if (options.background) {
+    work_cv.notify_one();
+  }
+  while (immutable != nullptr && !io_error) {
+    if (options.background || busy) {
+      done_cv.wait(lock);
+    } else {
+      runStep(lock);
+    }
+  }
+}
+
+void LsmTree::waitForCompactions() {
+  std::unique_lock<std::mutex> lock(mutex);
+  if (options.background) {
+    work_cv.notify_one();
+  }
+  while (busy || hasWork()) {
+    if (options.background || busy) {
+      done_cv.wait(lock);
+    } else {
+      runStep(lock);
+    }
+  }
+}
+
+LsmStats LsmTree::getStats() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  LsmStats result = stats;
+  result.puts = puts.load(std::memory_order_relaxed);
+  result.bytes_ingested = bytes_ingested.load(std::memory_order_relaxed);
+  return result;
+}
+
+std::vector<std::size_t> LsmTree::getRunsPerLevel() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  std::vector<std::size_t> runs;
+  for (const auto &level : version->levels) {
+    runs.push_back(level.size());
+  }
+  return runs;
+}
+
+bool LsmTree::pickCompaction(const Version &v, Compaction *job) const {
+  const auto &levels = v.levels;
+  for (std::size_t i = 0; i < levels.size(); i++) {
+    bool full;
+    if (options.style == CompactionStyle::TIERED || i == 0) {
+      full = levels[i].size() >= options.l0_compaction_trigger;
+    } else {
+      std::size_t max_bytes = options.level_base_bytes;
+      for (std::size_t l = 1; l < i; l++) {
+        max_bytes *= options.level_ratio;
+      }
+      full = levelBytes(levels[i]) > max_bytes;
+    }
+    if (!full) {
+      continue;
+    }
+
+    job->inputs = levels[i];
+    job->output_level = i + 1;
+    if (options.style == CompactionStyle::LEVELED && i + 1 < levels.size()) {
+      // leveled: the next level's single run is rewritten with the input
+      job->inputs.insert(job->inputs.end(), levels[i + 1].begin(),
+                         levels[i + 1].end());
+    }
+    std::size_t oldest = options.style == CompactionStyle::LEVELED
+                             ? job->output_level
+                             : job->output_level - 1;
+    job->drop_tombstones = isBottom(levels, oldest);
+    return true;
+  }
+  return false;
+}
+
+bool LsmTree::hasWork() const {
+  if (io_error) {
+    return false;
+  }
+  Compaction job;
+  return immutable != nullptr || pickCompaction(*version, &job);
+}
+
+void LsmTree::runStep(std::unique_lock<std::mutex> &lock) {
+  busy = true;
+  uint64_t seq = next_seq++;
+  auto v = std::make_shared<Version>(*version);
+
+  if (immutable != nullptr) {
+    std::shared_ptr<MemTable> imm = immutable;
+    lock.unlock();
+    auto run = flushMemTable(*imm, seq);
+    lock.lock();
+    if (run == nullptr) {
+      std::cerr << "LSM flush failed, tree is read-only\n";
+      io_error = true;
+    } else {
+      if (v->levels.empty()) {
+        v->levels.resize(1);
+      }
+      v->levels[0].insert(v->levels[0].begin(), run);
+      stats.flushes++;
+      stats.bytes_written += run->getSizeBytes();
+      version = v;
+      immutable.reset();
+      writeManifest(*v);
+    }
+  } else {
+    Compaction job;
+    if (pickCompaction(*v, &job)) {
+      lock.unlock();
+      auto run = merge(job, seq);
+      lock.lock();
+      if (run == nullptr) {
+        std::cerr << "LSM compaction failed, tree is read-only\n";
+        io_error = true;
+      } else {
+        for (auto &level : v->levels) {
+          level.erase(std::remove_if(level.begin(), level.end(),
+                                     [&](const auto &table) {
+                                       return std::find(job.inputs.begin(),
+                                                        job.inputs.end(),
+                                                        table) !=
+                                              job.inputs.end();
+                                     }),
+                      level.end());
+        }
+        if (v->levels.size() <= job.output_level) {
+          v->levels.resize(job.output_level + 1);
+        }
+        if (run->getNumEntries() > 0) {
+          auto &out = v->levels[job.output_level];
+          out.insert(out.begin(), run);
+        }
+        stats.compactions++;
+        stats.bytes_written += run->getSizeBytes();
+        version = v;
+        writeManifest(*v);
+        // pages are freed once the last reader drops its version
+        for (const auto &input : job.inputs) {
+          input->markObsolete();
+        }
+      }
+    }
+  }
+  busy = false;
+  done_cv.notify_all();
+}
+
+void LsmTree::backgroundLoop() {
+  std::unique_lock<std::mutex> lock(mutex);
+  while (!stop) {
+    if (!busy && hasWork()) {
+      runStep(lock);
+    } else {
+      work_cv.wait(lock);
+    }
+  }
+}
+
+std::shared_ptr<SSTable> LsmTree::flushMemTable(const MemTable &table,
+                                                uint64_t seq) {
+  SSTableBuilder builder(bpm, seq);
+  bool ok = true;
+  table.forEach(std::numeric_limits<int64_t>::min(),
+                std::numeric_limits<int64_t>::max(),
+                [&](int64_t key, bool tombstone, std::string_view value) {
+                  ok = ok && builder.add(key, tombstone, value);
+                });
+  return ok ? builder.finish(options.bits_per_key) : nullptr;
+}
+
+std::shared_ptr<SSTable> LsmTree::merge(const Compaction &job, uint64_t seq) {
+  std::vector<MergeInput> inputs;
+  for (const auto &run : job.inputs) {
+    MergeInput input;
+    input.it = std::make_unique<SSTable::Iterator>(
+        run.get(), std::numeric_limits<int64_t>::min());
+    inputs.push_back(std::move(input));
+  }
+
+  SSTableBuilder builder(bpm, seq);
+  MergeCursor cursor(inputs);
+  for (; cursor.valid(); cursor.next()) {
+    const MergeInput &entry = cursor.current();
+    if (job.drop_tombstones && entry.tombstone()) {
+      continue;
+    }
+    if (!builder.add(entry.key(), entry.tombstone(), entry.value())) {
+      return nullptr;
+    }
+  }
+  // a partial output must not replace the inputs: their rows would be lost
+  if (cursor.failed()) {
+    return nullptr;
+  }
+  return builder.finish(options.bits_per_key);
+}
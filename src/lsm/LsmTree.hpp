@@ -0,0 +1,146 @@
+/* LSM tree requirements
+1. Writes (put / remove) only touch an in-memory MemTable; a full memtable
+becomes immutable and is flushed as a new SSTable into level 0, so the write
+path never updates pages in place
+2. Compaction merges runs into the next level:
+    - LEVELED: level 0 is merged into level 1 once it holds
+      l0_compaction_trigger runs, level i >= 1 holds a single run and is
+      merged into level i + 1 when it outgrows level_base_bytes * ratio^(i-1)
+    - TIERED : every level collects up to l0_compaction_trigger runs and
+      merges them all into one new run of the next level
+   Tombstones are dropped when the output has no older level below it
+3. Flushes and compactions run on a background thread (or inline when
+background is off); readers and writers only hold the tree mutex to swap
+pointers, never during I/O. Writers insert into the lock-free memtable
+concurrently and only take the mutex once it is full
+4. Reads check memtable, immutable memtable, then runs newest to oldest; the
+first component that knows the key answers
+5. The set of runs is persisted in a manifest page (the table's root page),
+so the tree reopens from the same page after a restart
+*/
+#pragma once
+
+#include "MemTable.hpp"
+#include "SSTable.hpp"
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+enum class CompactionStyle { LEVELED, TIERED };
+
+struct LsmOptions {
+  std::size_t memtable_bytes = 4 << 20;
+  std::size_t l0_compaction_trigger = 4;
+  std::size_t level_base_bytes = 16 << 20; // LEVELED: size of level 1
+  std::size_t level_ratio = 10;
+  CompactionStyle style = CompactionStyle::LEVELED;
+  std::size_t bits_per_key = 10;
+  bool background = true;
+};
+
+struct LsmStats {
+  std::size_t puts = 0;
+  std::size_t gets = 0;
+  std::size_t flushes = 0;
+  std::size_t compactions = 0;
+  std::size_t bytes_ingested = 0; // key + value bytes written by users
+  std::size_t bytes_written = 0;  // SSTable pages written
+  std::size_t read_errors = 0;    // gets / scans failed on a run's page
+  LsmReadCost reads;
+};
+
+class LsmTree {
+private:
+  struct Version {
+    // levels[0] newest run first; every level ordered newest first
+    std::vector<std::vector<std::shared_ptr<SSTable>>> levels;
+  };
+
+  struct Compaction {
+    std::vector<std::shared_ptr<SSTable>> inputs; // newest first
+    std::size_t output_level = 0;
+    bool drop_tombstones = false;
+  };
+
+  static constexpr uint32_t MANIFEST_MAGIC = 0x4c534d31; // "LSM1"
+
+  BufferPoolManager *bpm;
+  page_id_t manifest_page_id;
+  LsmOptions options;
+
+  mutable std::mutex mutex;
+  std::condition_variable work_cv; // background thread waits for work
+  std::condition_variable done_cv; // writers wait for flushes
+  // held shared while inserting into memtable, exclusively to replace it
+  std::shared_mutex write_latch;
+  std::shared_ptr<MemTable> memtable;
+  std::shared_ptr<MemTable> immutable;
+  std::shared_ptr<const Version> version;
+  uint64_t next_seq = 1;
+  bool busy = false; // a flush or compaction is in progress
+  bool stop = false;
+  bool io_error = false; // a flush failed; further writes are refused
+  std::thread worker;
+  LsmStats stats;
+  std::atomic<std::size_t> puts{0};           // kept outside stats so
+  std::atomic<std::size_t> bytes_ingested{0}; // writers skip the mutex
+
+  bool loadManifest();
+  bool writeManifest(const Version &v);
+
+  bool write(int64_t key, std::string_view value, bool tombstone);
+  // moves the full memtable to immutable; called with the lock held
+  void swapMemTable();
+
+  bool pickCompaction(const Version &v, Compaction *job) const;
+  bool hasWork() const;
+  // one flush or compaction step; called with the lock held, releases it
+  // during I/O
+  void runStep(std::unique_lock<std::mutex> &lock);
+  void backgroundLoop();
+
+  std::shared_ptr<SSTable> flushMemTable(const MemTable &table,
+                                         uint64_t seq);
+  std::shared_ptr<SSTable> merge(const Compaction &job, uint64_t seq);
+
+public:
+  // opens the tree whose manifest is manifestPageId; an empty page (e.g. a
+  // freshly allocated table root) is an empty tree
+  LsmTree(BufferPoolManager *bufferPool, page_id_t manifestPageId,
+          LsmOptions lsmOptions = {});
+
+  // flushes the memtable, finishes background work, writes the manifest
+  ~LsmTree();
+
+  LsmTree(const LsmTree &) = delete;
+  LsmTree &operator=(const LsmTree &) = delete;
+
+  page_id_t getManifestPageId() const { return manifest_page_id; }
+
+  bool put(int64_t key, std::string_view value);
+
+  bool remove(int64_t key);
+
+  // false if the key is absent, or if a run's page could not be read
+  // (counted in read_errors)
+  bool get(int64_t key, std::string *value);
+
+  // calls f(key, value) for every live key in [low, high], in key order;
+  // false if a run's page could not be read, f then saw only a prefix
+  bool scan(int64_t low, int64_t high,
+            const std::function<void(int64_t, std::string_view)> &f);
+
+  // writes the memtable out as a level-0 run and waits for it
+  void flush();
+
+  // waits until no flush or compaction is pending
+  void waitForCompactions();
+
+  LsmStats getStats() const;
+
+  std::vector<std::size_t> getRunsPerLevel() const;
+};
@@ -0,0 +1,118 @@
+#include "MemTable.hpp"
+#include <cstring>
+#include <new>
+#include <random>
+
+MemTable::MemTable() : head(newNode(0, nullptr, kMaxHeight)) {}
+
+const MemTable::Value *MemTable::newValue(std::string_view value,
+                                          bool tombstone) {
+  char *memory = arena.allocate(offsetof(Value, data) + value.size());
+  Value *result = reinterpret_cast<Value *>(memory);
+  result->length = static_cast<uint32_t>(value.size());
+  result->tombstone = tombstone;
+  if (!value.empty()) {
+    memcpy(result->data, value.data(), value.size());
+  }
+  return result;
+}
+
+MemTable::Node *MemTable::newNode(int64_t key, const Value *value,
+                                  int height) {
+  std::size_t bytes =
+      sizeof(Node) + (height - 1) * sizeof(std::atomic<Node *>);
+  Node *node = new (arena.allocate(bytes)) Node;
+  node->key = key;
+  node->value.store(value, std::memory_order_relaxed);
+  for (int level = 0; level < height; level++) {
+    new (&node->next[level]) std::atomic<Node *>(nullptr);
+  }
+  return node;
+}
+
+int MemTable::randomHeight() {
+  // each level holds a quarter of the nodes of the level below
+  thread_local std::minstd_rand rng(std::random_device{}());
+  int height = 1;
+  while (height < kMaxHeight && rng() % 4 == 0) {
+    height++;
+  }
+  return height;
+}
+
+MemTable::Node *MemTable::findLess(Node *start, int64_t key, int level,
+                                   Node **next) {
+  Node *node = start;
+  *next = node->getNext(level);
+  while (*next != nullptr && (*next)->key < key) {
+    node = *next;
+    *next = node->getNext(level);
+  }
+  return node;
+}
+
+MemTable::Node *MemTable::seek(int64_t key) const {
+  Node *node = head;
+  Node *next = nullptr;
+  for (int level = max_height.load(std::memory_order_relaxed) - 1; level >= 0;
+       level--) {
+    node = findLess(node, key, level, &next);
+  }
+  return next;
+}
+
+void MemTable::put(int64_t key, std::string_view value, bool tombstone) {
+  const Value *new_value = newValue(value, tombstone);
+
+  Node *preds[kMaxHeight];
+  Node *succs[kMaxHeight];
+  Node *node = head;
+  for (int level = kMaxHeight - 1; level >= 0; level--) {
+    node = findLess(node, key, level, &succs[level]);
+    preds[level] = node;
+  }
+  if (succs[0] != nullptr && succs[0]->key == key) {
+    succs[0]->value.store(new_value, std::memory_order_release);
+    return;
+  }
+
+  int height = randomHeight();
+  int current = max_height.load(std::memory_order_relaxed);
+  while (height > current &&
+         !max_height.compare_exchange_weak(current, height,
+                                           std::memory_order_relaxed)) {
+  }
+
+  Node *inserted = newNode(key, new_value, height);
+  for (int level = 0; level < height; level++) {
+    while (true) {
+      inserted->next[level].store(succs[level], std::memory_order_relaxed);
+      if (preds[level]->next[level].compare_exchange_strong(
+              succs[level], inserted, std::memory_order_release,
+              std::memory_order_acquire)) {
+        break;
+      }
+      // another writer linked a node here first: find the new neighbours
+      preds[level] = findLess(preds[level], key, level, &succs[level]);
+      if (level == 0 && succs[0] != nullptr && succs[0]->key == key) {
+        // it inserted the same key: ours was never linked, overwrite theirs
+        succs[0]->value.store(new_value, std::memory_order_release);
+        return;
+      }
+    }
+  }
+  count.fetch_add(1, std::memory_order_relaxed);
+}
+
+LsmLookup MemTable::get(int64_t key, std::string *value) const {
+  Node *node = seek(key);
+  if (node == nullptr || node->key != key) {
+    return LsmLookup::ABSENT;
+  }
+  const Value *entry = node->value.load(std::memory_order_acquire);
+  if (entry->tombstone) {
+    return LsmLookup::DELETED;
+  }
+  value->assign(entry->data, entry->length);
+  return LsmLookup::FOUND;
+}
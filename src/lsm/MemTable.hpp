@@ -0,0 +1,88 @@
+/* MemTable requirements
+1. Sorted in-memory write buffer of the LSM tree: a skiplist whose nodes and
+values live in an Arena, so a write never allocates from the global heap
+2. Lock-free: concurrent put calls link their nodes with compare-and-swap
+level by level, readers and ordered iteration never block and may run
+alongside writers
+3. Nodes are never unlinked; overwriting a key swaps the node's value pointer,
+and deletes are kept as tombstones so they shadow older values in the sorted
+runs below
+4. Memory usage is what the arena handed out; the tree flushes the memtable
+into sorted pages once it passes the configured size
+*/
+#pragma once
+
+#include "Arena.hpp"
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Outcome of a point lookup in one LSM component; IO_ERROR (a run's page
+// could not be read) must stop the lookup, older components may be stale
+enum class LsmLookup { FOUND, DELETED, ABSENT, IO_ERROR };
+
+class MemTable {
+private:
+  struct Value {
+    uint32_t length;
+    bool tombstone;
+    char data[1]; // length bytes
+
+    std::string_view view() const { return std::string_view(data, length); }
+  };
+
+  struct Node {
+    int64_t key;
+    std::atomic<const Value *> value;
+    std::atomic<Node *> next[1]; // one per level, height entries
+
+    Node *getNext(int level) const {
+      return next[level].load(std::memory_order_acquire);
+    }
+  };
+
+  static constexpr int kMaxHeight = 12;
+
+  Arena arena;
+  Node *head;
+  std::atomic<int> max_height{1};
+  std::atomic<std::size_t> count{0};
+
+  const Value *newValue(std::string_view value, bool tombstone);
+  Node *newNode(int64_t key, const Value *value, int height);
+  static int randomHeight();
+
+  // last node < key on level, starting at start; *next receives the
+  // successor that was compared, which a later re-read could miss
+  static Node *findLess(Node *start, int64_t key, int level, Node **next);
+
+  // first node >= key, nullptr at the end
+  Node *seek(int64_t key) const;
+
+public:
+  MemTable();
+
+  MemTable(const MemTable &) = delete;
+  MemTable &operator=(const MemTable &) = delete;
+
+  // safe to call from any number of threads at once
+  void put(int64_t key, std::string_view value, bool tombstone);
+
+  LsmLookup get(int64_t key, std::string *value) const;
+
+  std::size_t size() const { return count.load(std::memory_order_relaxed); }
+
+  bool empty() const { return size() == 0; }
+
+  std::size_t getMemoryUsage() const { return arena.getMemoryUsage(); }
+
+  // calls f(key, tombstone, value) for every entry in [low, high], in order
+  template <typename F> void forEach(int64_t low, int64_t high, F f) const {
+    for (Node *node = seek(low); node != nullptr && node->key <= high;
+         node = node->getNext(0)) {
+      const Value *value = node->value.load(std::memory_order_acquire);
+      f(node->key, value->tombstone, value->view());
+    }
+  }
+};
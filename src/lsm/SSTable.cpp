@@ -0,0 +1,242 @@
+#include "SSTable.hpp"
+#include <algorithm>
+
+namespace {
+
+int64_t recordKey(Page *page, uint16_t slot) {
+  int64_t key;
+  memcpy(&key, page->getRecord(slot), sizeof(key));
+  return key;
+}
+
+} // namespace
+
+SSTable::~SSTable() {
+  if (obsolete) {
+    for (page_id_t page_id : page_ids) {
+      bpm->deletePage(page_id);
+    }
+  }
+}
+
+std::shared_ptr<SSTable> SSTable::open(BufferPoolManager *bpm, uint64_t seq,
+                                       page_id_t first_page_id,
+                                       std::size_t bits_per_key) {
+  auto table = std::make_shared<SSTable>(bpm, seq);
+  std::vector<int64_t> keys;
+  page_id_t page_id = first_page_id;
+  while (page_id != INVALID_PAGE_ID) {
+    Page *page = bpm->fetchPage(page_id);
+    if (page == nullptr) {
+      std::cerr << "Could not fetch SSTable page " << page_id << "\n";
+      return nullptr;
+    }
+    table->page_ids.push_back(page_id);
+    for (uint16_t slot = 0; slot < page->getNumberOfSlots(); slot++) {
+      keys.push_back(recordKey(page, slot));
+      if (slot == 0) {
+        table->fences.push_back(keys.back());
+      }
+    }
+    page_id_t next = page->getNextPageId();
+    bpm->unpinPage(page_id, false);
+    page_id = next;
+  }
+  table->num_entries = keys.size();
+  table->filter = BloomFilter(keys.size(), bits_per_key);
+  for (int64_t key : keys) {
+    table->filter.insert(key);
+  }
+  return table;
+}
+
+LsmLookup SSTable::get(int64_t key, std::string *value,
+                       LsmReadCost *cost) const {
+  cost->runs_probed++;
+  if (fences.empty() || key < fences.front()) {
+    return LsmLookup::ABSENT;
+  }
+  if (!filter.mayContain(key)) {
+    cost->bloom_negatives++;
+    return LsmLookup::ABSENT;
+  }
+
+  std::size_t page_idx =
+      std::upper_bound(fences.begin(), fences.end(), key) - fences.begin() -
+      1;
+  Page *page = bpm->fetchPage(page_ids[page_idx]);
+  if (page == nullptr) {
+    std::cerr << "Could not fetch SSTable page " << page_ids[page_idx]
+              << "\n";
+    return LsmLookup::IO_ERROR;
+  }
+  cost->pages_read++;
+
+  // records are stored in key order: binary search the slots
+  LsmLookup result = LsmLookup::ABSENT;
+  int low = 0;
+  int high = page->getNumberOfSlots() - 1;
+  while (low <= high) {
+    int mid = (low + high) / 2;
+    int64_t mid_key = recordKey(page, static_cast<uint16_t>(mid));
+    if (mid_key < key) {
+      low = mid + 1;
+    } else if (mid_key > key) {
+      high = mid - 1;
+    } else {
+      const char *record = page->getRecord(static_cast<uint16_t>(mid));
+      if (record[sizeof(int64_t)]) {
+        result = LsmLookup::DELETED;
+      } else {
+        uint16_t length = page->getRecordLength(static_cast<uint16_t>(mid));
+        value->assign(record + kRecordHeader, length - kRecordHeader);
+        result = LsmLookup::FOUND;
+      }
+      break;
+    }
+  }
+  bpm->unpinPage(page_ids[page_idx], false);
+  return result;
+}
+
+SSTable::Iterator::Iterator(const SSTable *sstable, int64_t low)
+    : table(sstable) {
+  if (table->fences.empty()) {
+    return;
+  }
+  auto fence =
+      std::upper_bound(table->fences.begin(), table->fences.end(), low);
+  page_idx = fence == table->fences.begin()
+                 ? 0
+                 : static_cast<std::size_t>(fence - table->fences.begin() - 1);
+  load();
+  while (valid() && key() < low) {
+    next();
+  }
+}
+
+void SSTable::Iterator::load() {
+  slot = 0;
+  while (page_idx < table->page_ids.size()) {
+    page = table->bpm->fetchPage(table->page_ids[page_idx]);
+    if (page == nullptr) {
+      std::cerr << "Could not fetch SSTable page "
+                << table->page_ids[page_idx] << "\n";
+      error = true;
+      return;
+    }
+    if (page->getNumberOfSlots() > 0) {
+      return;
+    }
+    release();
+    page_idx++;
+  }
+}
+
+void SSTable::Iterator::release() {
+  if (page != nullptr) {
+    table->bpm->unpinPage(table->page_ids[page_idx], false);
+    page = nullptr;
+  }
+}
+
+int64_t SSTable::Iterator::key() const { return recordKey(page, slot); }
+
+bool SSTable::Iterator::tombstone() const {
+  return page->getRecord(slot)[sizeof(int64_t)] != 0;
+}
+
+std::string_view SSTable::Iterator::value() const {
+  const char *record = page->getRecord(slot);
+  return std::string_view(record + kRecordHeader,
+                          page->getRecordLength(slot) - kRecordHeader);
+}
+
+void SSTable::Iterator::next() {
+  if (++slot < page->getNumberOfSlots()) {
+    return;
+  }
+  release();
+  page_idx++;
+  load();
+}
+
+SSTableBuilder::SSTableBuilder(BufferPoolManager *bufferPool, uint64_t seq)
+    : bpm(bufferPool), table(std::make_shared<SSTable>(bufferPool, seq)) {}
+
+SSTableBuilder::~SSTableBuilder() {
+  if (current != nullptr) {
+    sealCurrent(INVALID_PAGE_ID);
+  }
+  if (table != nullptr) {
+    // abandoned or failed build: drop whatever was written
+    table->markObsolete();
+  }
+}
+
+void SSTableBuilder::sealCurrent(page_id_t next_page_id) {
+  current->setNextPageId(next_page_id);
+  page_id_t page_id = table->page_ids.back();
+  bpm->unpinPage(page_id, true);
+  // written right away, so the run reaches the disk in page order
+  bpm->flushPage(page_id);
+  current = nullptr;
+}
+
+bool SSTableBuilder::add(int64_t key, bool tombstone, std::string_view value) {
+  if (failed) {
+    return false;
+  }
+  // checked before the uint16 cast, which would store the entry cut short
+  if (SSTable::kRecordHeader + value.size() > Page::MAX_RECORD_LENGTH) {
+    std::cerr << "SSTable entry larger than a page\n";
+    failed = true;
+    return false;
+  }
+  record.resize(SSTable::kRecordHeader + value.size());
+  memcpy(record.data(), &key, sizeof(key));
+  record[sizeof(int64_t)] = tombstone ? 1 : 0;
+  memcpy(record.data() + SSTable::kRecordHeader, value.data(), value.size());
+  uint16_t length = static_cast<uint16_t>(record.size());
+
+  char *slot = current != nullptr ? current->allocateRecord(length) : nullptr;
+  if (slot == nullptr) {
+    page_id_t page_id;
+    Page *page = bpm->newPage(&page_id);
+    if (page == nullptr) {
+      std::cerr << "Could not allocate SSTable page\n";
+      failed = true;
+      return false;
+    }
+    if (current != nullptr) {
+      sealCurrent(page_id);
+    }
+    current = page;
+    table->page_ids.push_back(page_id);
+    table->fences.push_back(key);
+    slot = current->allocateRecord(length);
+    if (slot == nullptr) {
+      std::cerr << "SSTable entry larger than a page\n";
+      failed = true;
+      return false;
+    }
+  }
+  memcpy(slot, record.data(), length);
+  keys.push_back(key);
+  return true;
+}
+
+std::shared_ptr<SSTable> SSTableBuilder::finish(std::size_t bits_per_key) {
+  if (current != nullptr) {
+    sealCurrent(INVALID_PAGE_ID);
+  }
+  if (failed) {
+    return nullptr;
+  }
+  table->num_entries = keys.size();
+  table->filter = BloomFilter(keys.size(), bits_per_key);
+  for (int64_t key : keys) {
+    table->filter.insert(key);
+  }
+  return std::move(table);
+}
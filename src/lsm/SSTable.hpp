@@ -0,0 +1,122 @@
+/* SSTable requirements
+1. An immutable sorted run of {key, tombstone, value} entries stored in
+ordinary slotted Pages, one record per entry, chained through next_page_id
+and written front to back (page-aligned, sequential writes)
+2. Fence keys (first key of every page) and a Bloom filter stay in memory, so
+a point lookup touches at most one page and usually none for absent keys
+3. An SSTable replaced by a compaction is marked obsolete; its pages are
+dropped once the last reader releases it
+*/
+#pragma once
+
+#include "MemTable.hpp"
+#include "buffer/BufferPoolManager.hpp"
+#include "index/BloomFilter.hpp"
+#include <atomic>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+// counters of one read, summed into LsmStats
+struct LsmReadCost {
+  std::size_t runs_probed = 0;
+  std::size_t bloom_negatives = 0;
+  std::size_t pages_read = 0;
+};
+
+class SSTable {
+private:
+  BufferPoolManager *bpm;
+  uint64_t seq; // creation order, larger = newer
+  std::vector<page_id_t> page_ids;
+  std::vector<int64_t> fences; // first key of each page
+  std::size_t num_entries = 0;
+  BloomFilter filter;
+  std::atomic<bool> obsolete{false};
+
+  friend class SSTableBuilder;
+
+public:
+  // entry header in a record: key, then 1 byte tombstone flag, then value
+  static constexpr std::size_t kRecordHeader = sizeof(int64_t) + 1;
+
+  SSTable(BufferPoolManager *bufferPool, uint64_t sequence)
+      : bpm(bufferPool), seq(sequence) {}
+
+  ~SSTable();
+
+  // reopens a run from its first page, rebuilding fences and filter
+  static std::shared_ptr<SSTable> open(BufferPoolManager *bpm, uint64_t seq,
+                                       page_id_t first_page_id,
+                                       std::size_t bits_per_key);
+
+  uint64_t getSeq() const { return seq; }
+
+  page_id_t getFirstPageId() const {
+    return page_ids.empty() ? INVALID_PAGE_ID : page_ids.front();
+  }
+
+  std::size_t getNumPages() const { return page_ids.size(); }
+
+  std::size_t getNumEntries() const { return num_entries; }
+
+  std::size_t getSizeBytes() const { return page_ids.size() * PAGE_SIZE; }
+
+  void markObsolete() { obsolete = true; }
+
+  LsmLookup get(int64_t key, std::string *value, LsmReadCost *cost) const;
+
+  // Forward cursor over the entries; keeps the current page pinned
+  class Iterator {
+  private:
+    const SSTable *table;
+    std::size_t page_idx = 0;
+    uint16_t slot = 0;
+    Page *page = nullptr;
+    bool error = false; // a page could not be read
+
+    void load();
+    void release();
+
+  public:
+    // positioned on the first entry >= low
+    Iterator(const SSTable *sstable, int64_t low);
+    ~Iterator() { release(); }
+
+    Iterator(const Iterator &) = delete;
+    Iterator &operator=(const Iterator &) = delete;
+
+    // false at the end of the run, or after a read error
+    bool valid() const { return page != nullptr; }
+    // the cursor stopped on a page it could not read, not at the end
+    bool failed() const { return error; }
+    int64_t key() const;
+    bool tombstone() const;
+    std::string_view value() const;
+    void next();
+  };
+};
+
+// Writes a new SSTable from entries added in strictly increasing key order
+class SSTableBuilder {
+private:
+  BufferPoolManager *bpm;
+  std::shared_ptr<SSTable> table;
+  Page *current = nullptr;
+  std::vector<int64_t> keys; // for the Bloom filter
+  std::vector<char> record;
+  bool failed = false;
+
+  void sealCurrent(page_id_t next_page_id);
+
+public:
+  SSTableBuilder(BufferPoolManager *bufferPool, uint64_t seq);
+  ~SSTableBuilder();
+
+  bool add(int64_t key, bool tombstone, std::string_view value);
+
+  std::size_t getNumEntries() const { return keys.size(); }
+
+  // nullptr if any page could not be written
+  std::shared_ptr<SSTable> finish(std::size_t bits_per_key);
+};
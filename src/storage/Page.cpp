@@ -15,41 +15,54 @@ void Page::resetMemory() {
   header->num_of_slots = 0;
   header->free_space_start = sizeof(PageHeader);
   header->free_space_end = PAGE_SIZE;
+  header->next_page_id = INVALID_PAGE_ID;
   page_id = INVALID_PAGE_ID;
 }
 
 bool Page::insertRecord(const char *data, uint16_t length) {
+  char *record = allocateRecord(length);
+  if (record == nullptr) {
+    return false;
+  }
+
+  memcpy(record, data, length);
+  return true;
+}
+
+char *Page::allocateRecord(uint16_t length) {
 
   // steps involved
   // 1. Find the offset to insert the data
-  // 2. Insert the data using memcpy
-  // 3. Add entry to Slot array
-  // 4. update the header
+  // 2. Add entry to Slot array
+  // 3. update the header
+  // 4. hand the record space back to the caller to fill
 
   PageHeader *header = getHeader();
-  // Slot *slot = getSlot(header->num_of_slots);
+
+  if (length > header->free_space_end) {
+    return nullptr;
+  }
 
   uint16_t new_record_start = header->free_space_end - length;
   uint16_t slot_array_end =
       (sizeof(PageHeader) + (header->num_of_slots + 1) * sizeof(Slot));
 
   if (slot_array_end >= new_record_start) {
-    return false;
+    return nullptr;
   }
 
-  // growing backward
-  memcpy(buffer + new_record_start, data, length);
-
-  // growing forward
+  // growing forward (slot may hold stale bytes left behind by compaction)
   Slot *new_slot = getSlot(header->num_of_slots);
   new_slot->length = length;
   new_slot->offset = new_record_start;
+  new_slot->isDeleted = false;
 
   header->num_of_slots++;
   header->free_space_start = slot_array_end;
   header->free_space_end = new_record_start;
 
-  return true;
+  // growing backward
+  return buffer + new_record_start;
 }
 
 bool Page::insertRecordSmart(char *data, uint16_t length) {
@@ -84,6 +97,13 @@ char *Page::getRecord(uint16_t slot_num) {
   return (buffer + slot->offset);
 }
 
+uint16_t Page::getRecordLength(uint16_t slot_num) {
+  if (slot_num >= getHeader()->num_of_slots) {
+    return 0;
+  }
+  return getSlot(slot_num)->length;
+}
+
 bool Page::deleteRecord(uint16_t slot_num) {
   PageHeader *header = getHeader();
   if (slot_num >= header->num_of_slots) {
@@ -151,10 +171,11 @@ bool Page::updateRecord(uint16_t slot_num, char *data, int length) {
     return true;
   }
 
-  // check for space
-  uint16_t new_free_space_start = header->free_space_end - length;
-  uint16_t new_slot_offset =
-      sizeof(PageHeader) + (header->num_of_slots + 1) * sizeof(Slot);
+  // check for space (signed: a record longer than the free space must not
+  // wrap around to a large offset)
+  int new_free_space_start = header->free_space_end - length;
+  int new_slot_offset = static_cast<int>(
+      sizeof(PageHeader) + (header->num_of_slots + 1) * sizeof(Slot));
 
   if (new_slot_offset >= new_free_space_start) {
     return false;
@@ -169,10 +190,10 @@ bool Page::updateRecord(uint16_t slot_num, char *data, int length) {
   memcpy(buffer + new_free_space_start, data, length);
 
   // update slot
-  slot->offset = new_free_space_start;
+  slot->offset = static_cast<uint16_t>(new_free_space_start);
   slot->length = length;
 
-  header->free_space_end = new_free_space_start;
+  header->free_space_end = static_cast<uint16_t>(new_free_space_start);
 
   return true;
 }
@@ -4,8 +4,26 @@
 #include <cstring>
 
 const int PAGE_SIZE = 4096; // 4KB Page size
-using page_id_t = uint16_t;
+// page id = file id (high 8 bits) | page number within the file (24 bits)
+using page_id_t = uint32_t;
+using file_id_t = uint8_t;
 static constexpr page_id_t INVALID_PAGE_ID = static_cast<page_id_t>(-1);
+static constexpr file_id_t PRIMARY_FILE_ID = 0;
+static constexpr file_id_t INVALID_FILE_ID = static_cast<file_id_t>(-1);
+static constexpr uint32_t PAGE_NUMBER_BITS = 24;
+static constexpr uint32_t MAX_PAGES_PER_FILE = uint32_t{1} << PAGE_NUMBER_BITS;
+
+constexpr page_id_t makePageId(file_id_t file_id, uint32_t page_number) {
+  return (static_cast<page_id_t>(file_id) << PAGE_NUMBER_BITS) | page_number;
+}
+
+constexpr file_id_t fileOf(page_id_t page_id) {
+  return static_cast<file_id_t>(page_id >> PAGE_NUMBER_BITS);
+}
+
+constexpr uint32_t pageNumberOf(page_id_t page_id) {
+  return page_id & (MAX_PAGES_PER_FILE - 1);
+}
 // 4KB Page
 class Page {
 private:
@@ -13,6 +31,7 @@ private:
     uint16_t num_of_slots;     // indicates number of records in the Page
     uint16_t free_space_start; // free space start  (grows forward)
     uint16_t free_space_end;   // free space start (grows backward)
+    page_id_t next_page_id;    // next page of the same table (chain)
   };
 
   struct Slot {
@@ -21,7 +40,7 @@ private:
     bool isDeleted;  // flag to indicate that this slot is deleted
   };
 
-  char buffer[PAGE_SIZE];
+  alignas(8) char buffer[PAGE_SIZE]; // 8-aligned for index node layouts
 
   PageHeader *getHeader() { return (PageHeader *)(buffer); }
 
@@ -32,16 +51,34 @@ private:
   page_id_t page_id = INVALID_PAGE_ID;
 
 public:
+  // longest record an empty page can hold
+  static constexpr uint16_t MAX_RECORD_LENGTH =
+      PAGE_SIZE - sizeof(PageHeader) - sizeof(Slot) - 1;
+
   Page();
 
   uint16_t getNumberOfRecords();
 
+  // slots including deleted ones, for iterating with isRecordDeleted
+  uint16_t getNumberOfSlots() { return getHeader()->num_of_slots; }
+
+  bool isRecordDeleted(uint16_t slot_num) {
+    return slot_num >= getHeader()->num_of_slots ||
+           getSlot(slot_num)->isDeleted;
+  }
+
   void printStats();
 
   bool insertRecord(const char *data, uint16_t length);
 
+  // Reserves a new slot of `length` bytes and returns a pointer to its
+  // storage so callers can serialize in place (nullptr when the page is full)
+  char *allocateRecord(uint16_t length);
+
   char *getRecord(uint16_t slot_num);
 
+  uint16_t getRecordLength(uint16_t slot_num);
+
   bool updateRecord(uint16_t slot_num, char *data, int length);
 
   bool deleteRecord(uint16_t slot_num);
@@ -64,6 +101,12 @@ public:
 
   void setPageId(const page_id_t pageId) { page_id = pageId; }
 
+  page_id_t getNextPageId() { return getHeader()->next_page_id; }
+
+  void setNextPageId(const page_id_t pageId) {
+    getHeader()->next_page_id = pageId;
+  }
+
   // Add these for BufferPoolManager access
   char *getData() { return buffer; }
   const char *getData() const { return buffer; }
@@ -0,0 +1,41 @@
+#include "Schema.hpp"
+
+Schema::Schema(std::vector<Column> cols) : columns(std::move(cols)) {
+  null_bitmap_size = static_cast<uint16_t>((columns.size() + 7) / 8);
+
+  // lay the fixed slots out right after the null bitmap, in column order
+  uint16_t offset = null_bitmap_size;
+  offsets.reserve(columns.size());
+  for (uint32_t i = 0; i < columns.size(); i++) {
+    offsets.push_back(offset);
+    offset += getFixedSize(columns[i].type);
+    if (isVarlen(columns[i].type)) {
+      varlen_columns.push_back(i);
+    }
+  }
+  fixed_length = offset;
+}
+
+int Schema::getColumnIndex(const std::string &name) const {
+  for (uint32_t i = 0; i < columns.size(); i++) {
+    if (columns[i].name == name) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
+Schema Schema::merge(const Schema &left, const Schema &right) {
+  std::vector<Column> cols = left.columns;
+  cols.insert(cols.end(), right.columns.begin(), right.columns.end());
+  return Schema(std::move(cols));
+}
+
+Schema Schema::project(const std::vector<uint32_t> &col_idxs) const {
+  std::vector<Column> cols;
+  cols.reserve(col_idxs.size());
+  for (uint32_t idx : col_idxs) {
+    cols.push_back(columns[idx]);
+  }
+  return Schema(std::move(cols));
+}
@@ -0,0 +1,87 @@
+/* Schema requirements
+1. A Schema is an ordered list of typed columns
+2. Fixed-width columns live at offsets precomputed once per Schema, so reading
+a column never parses the columns before it
+3. Every column is nullable unless marked otherwise, nulls are tracked in a
+bitmap at the start of the record
+4. Variable-length columns (VARCHAR) keep a fixed {offset, length} entry in the
+fixed region and store their bytes after it
+*/
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+enum class TypeId : uint8_t { BOOLEAN, INTEGER, BIGINT, DOUBLE, VARCHAR };
+
+// bytes a column occupies in the fixed region of a tuple
+// (VARCHAR stores its {uint16 offset, uint16 length} entry there)
+inline uint16_t getFixedSize(TypeId type) {
+  switch (type) {
+  case TypeId::BOOLEAN:
+    return 1;
+  case TypeId::INTEGER:
+    return 4;
+  case TypeId::BIGINT:
+  case TypeId::DOUBLE:
+    return 8;
+  case TypeId::VARCHAR:
+    return 4;
+  }
+  return 0;
+}
+
+inline bool isVarlen(TypeId type) { return type == TypeId::VARCHAR; }
+
+struct Column {
+  std::string name;
+  TypeId type;
+  bool nullable = true;
+
+  Column(std::string columnName, TypeId columnType, bool isNullable = true)
+      : name(std::move(columnName)), type(columnType), nullable(isNullable) {}
+};
+
+class Schema {
+private:
+  std::vector<Column> columns;
+  std::vector<uint16_t> offsets;         // offset of each column in a tuple
+  std::vector<uint32_t> varlen_columns;  // indexes of VARCHAR columns
+  uint16_t null_bitmap_size = 0;         // bytes used by the null bitmap
+  uint16_t fixed_length = 0; // null bitmap + all fixed slots (no varlen data)
+
+public:
+  Schema() = default;
+  explicit Schema(std::vector<Column> cols);
+
+  uint32_t getColumnCount() const {
+    return static_cast<uint32_t>(columns.size());
+  }
+
+  const Column &getColumn(uint32_t col_idx) const { return columns[col_idx]; }
+
+  const std::vector<Column> &getColumns() const { return columns; }
+
+  TypeId getType(uint32_t col_idx) const { return columns[col_idx].type; }
+
+  uint16_t getOffset(uint32_t col_idx) const { return offsets[col_idx]; }
+
+  uint16_t getNullBitmapSize() const { return null_bitmap_size; }
+
+  uint16_t getFixedLength() const { return fixed_length; }
+
+  const std::vector<uint32_t> &getVarlenColumns() const {
+    return varlen_columns;
+  }
+
+  // returns -1 when no column has that name
+  int getColumnIndex(const std::string &name) const;
+
+  // concatenation of two schemas (used for join outputs)
+  static Schema merge(const Schema &left, const Schema &right);
+
+  // schema holding only the given columns, in the given order
+  Schema project(const std::vector<uint32_t> &col_idxs) const;
+};
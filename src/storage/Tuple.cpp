@@ -0,0 +1,93 @@
+#include "Tuple.hpp"
+#include <algorithm>
+
+Tuple Tuple::fromPage(const Schema *schema, Page &page, uint16_t slot_num) {
+  char *record = page.getRecord(slot_num);
+  if (record == nullptr) {
+    return Tuple();
+  }
+  return Tuple(schema, record, page.getRecordLength(slot_num));
+}
+
+TupleBuilder::TupleBuilder(const Schema &tupleSchema)
+    : schema(&tupleSchema), fixed(tupleSchema.getFixedLength(), 0),
+      varlen(tupleSchema.getColumnCount()) {
+  reset();
+}
+
+void TupleBuilder::reset() {
+  std::fill(fixed.begin(), fixed.end(), 0);
+  // all columns start out NULL
+  for (uint32_t i = 0; i < schema->getColumnCount(); i++) {
+    fixed[i >> 3] |= static_cast<char>(1 << (i & 7));
+  }
+  for (uint32_t col_idx : schema->getVarlenColumns()) {
+    varlen[col_idx].clear();
+  }
+}
+
+void TupleBuilder::setNull(uint32_t col_idx) {
+  fixed[col_idx >> 3] |= static_cast<char>(1 << (col_idx & 7));
+  if (isVarlen(schema->getType(col_idx))) {
+    varlen[col_idx].clear();
+  }
+}
+
+void TupleBuilder::setVarchar(uint32_t col_idx, std::string_view value) {
+  clearNull(col_idx);
+  varlen[col_idx].assign(value.data(), value.size());
+}
+
+void TupleBuilder::setFrom(uint32_t col_idx, const Tuple &tuple,
+                           uint32_t src_idx) {
+  if (tuple.isNull(src_idx)) {
+    setNull(col_idx);
+    return;
+  }
+
+  if (isVarlen(schema->getType(col_idx))) {
+    setVarchar(col_idx, tuple.getVarchar(src_idx));
+    return;
+  }
+
+  clearNull(col_idx);
+  memcpy(fixed.data() + schema->getOffset(col_idx),
+         tuple.getData() + tuple.getSchema()->getOffset(src_idx),
+         getFixedSize(schema->getType(col_idx)));
+}
+
+std::size_t TupleBuilder::getSerializedLength() const {
+  std::size_t length = fixed.size();
+  for (uint32_t col_idx : schema->getVarlenColumns()) {
+    length += varlen[col_idx].size();
+  }
+  return length;
+}
+
+void TupleBuilder::serializeTo(char *dst) const {
+  memcpy(dst, fixed.data(), fixed.size());
+
+  // append varlen bytes and patch their {offset, length} entries
+  uint16_t varlen_offset = static_cast<uint16_t>(fixed.size());
+  for (uint32_t col_idx : schema->getVarlenColumns()) {
+    const std::string &value = varlen[col_idx];
+    uint16_t entry[2] = {varlen_offset, static_cast<uint16_t>(value.size())};
+    memcpy(dst + schema->getOffset(col_idx), entry, sizeof(entry));
+    memcpy(dst + varlen_offset, value.data(), value.size());
+    varlen_offset += entry[1];
+  }
+}
+
+bool TupleBuilder::insertInto(Page &page) const {
+  // checked first: a wrapped uint16 length would be overrun by serializeTo
+  if (!fitsInPage()) {
+    return false;
+  }
+  char *record =
+      page.allocateRecord(static_cast<uint16_t>(getSerializedLength()));
+  if (record == nullptr) {
+    return false;
+  }
+  serializeTo(record);
+  return true;
+}
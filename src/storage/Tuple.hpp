@@ -0,0 +1,139 @@
+/* Tuple layout (all offsets relative to the start of the record)
+
+  +-------------+---------------------------------+-------------------+
+  | null bitmap | fixed slots (Schema::getOffset) | varlen bytes ...  |
+  +-------------+---------------------------------+-------------------+
+
+1. bit i of the null bitmap is set when column i is NULL
+2. fixed-width columns are stored at their precomputed offset
+3. a VARCHAR slot holds {uint16 offset, uint16 length} pointing into the
+varlen area, so every column is reachable in O(1)
+*/
+#pragma once
+
+#include "Page.hpp"
+#include "Schema.hpp"
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Read-only view over a serialized tuple (typically a record inside a Page)
+class Tuple {
+private:
+  const Schema *schema = nullptr;
+  const char *data = nullptr;
+  uint16_t length = 0;
+
+  template <typename T> T readFixed(uint32_t col_idx) const {
+    T value;
+    memcpy(&value, data + schema->getOffset(col_idx), sizeof(T));
+    return value;
+  }
+
+public:
+  Tuple() = default;
+  Tuple(const Schema *tupleSchema, const char *tupleData, uint16_t tupleLength)
+      : schema(tupleSchema), data(tupleData), length(tupleLength) {}
+
+  // view over the record stored in `slot_num` (invalid if it does not exist)
+  static Tuple fromPage(const Schema *schema, Page &page, uint16_t slot_num);
+
+  bool isValid() const { return data != nullptr; }
+
+  const Schema *getSchema() const { return schema; }
+
+  const char *getData() const { return data; }
+
+  uint16_t getLength() const { return length; }
+
+  bool isNull(uint32_t col_idx) const {
+    return (data[col_idx >> 3] >> (col_idx & 7)) & 1;
+  }
+
+  bool getBoolean(uint32_t col_idx) const {
+    return data[schema->getOffset(col_idx)] != 0;
+  }
+
+  int32_t getInteger(uint32_t col_idx) const {
+    return readFixed<int32_t>(col_idx);
+  }
+
+  int64_t getBigInt(uint32_t col_idx) const {
+    return readFixed<int64_t>(col_idx);
+  }
+
+  double getDouble(uint32_t col_idx) const {
+    return readFixed<double>(col_idx);
+  }
+
+  std::string_view getVarchar(uint32_t col_idx) const {
+    uint16_t entry[2]; // {offset, length}
+    memcpy(entry, data + schema->getOffset(col_idx), sizeof(entry));
+    return std::string_view(data + entry[0], entry[1]);
+  }
+};
+
+// Builds a tuple for a Schema and serializes it into any buffer, including
+// space reserved directly inside a Page
+class TupleBuilder {
+private:
+  const Schema *schema;
+  std::vector<char> fixed;          // null bitmap + fixed slots
+  std::vector<std::string> varlen;  // values of VARCHAR columns, by column
+
+  template <typename T> void writeFixed(uint32_t col_idx, T value) {
+    clearNull(col_idx);
+    memcpy(fixed.data() + schema->getOffset(col_idx), &value, sizeof(T));
+  }
+
+  void clearNull(uint32_t col_idx) {
+    fixed[col_idx >> 3] &= static_cast<char>(~(1 << (col_idx & 7)));
+  }
+
+public:
+  explicit TupleBuilder(const Schema &tupleSchema);
+
+  const Schema &getSchema() const { return *schema; }
+
+  // every column back to NULL, varlen values dropped
+  void reset();
+
+  void setNull(uint32_t col_idx);
+
+  void setBoolean(uint32_t col_idx, bool value) {
+    writeFixed<char>(col_idx, value ? 1 : 0);
+  }
+
+  void setInteger(uint32_t col_idx, int32_t value) {
+    writeFixed(col_idx, value);
+  }
+
+  void setBigInt(uint32_t col_idx, int64_t value) {
+    writeFixed(col_idx, value);
+  }
+
+  void setDouble(uint32_t col_idx, double value) {
+    writeFixed(col_idx, value);
+  }
+
+  void setVarchar(uint32_t col_idx, std::string_view value);
+
+  // copies column `src_idx` of `tuple` into column `col_idx` (same type)
+  void setFrom(uint32_t col_idx, const Tuple &tuple, uint32_t src_idx);
+
+  std::size_t getSerializedLength() const;
+
+  // false when the row is too long to be stored as a page record
+  bool fitsInPage() const {
+    return getSerializedLength() <= Page::MAX_RECORD_LENGTH;
+  }
+
+  // writes getSerializedLength() bytes to dst
+  void serializeTo(char *dst) const;
+
+  // serializes straight into a newly allocated record of the page; false
+  // when the page is full or the row does not fit in a page at all
+  bool insertInto(Page &page) const;
+};
@@ -0,0 +1,163 @@
+#include "TableHeap.hpp"
+
+TableHeap::TableHeap(BufferPoolManager *bufferPool, file_id_t fileId)
+    : bpm(bufferPool) {
+  Page *page = bpm->newPage(fileId, &first_page_id);
+  if (page == nullptr) {
+    std::cerr << "Could not allocate first page of table heap\n";
+    return;
+  }
+  page_ids.push_back(first_page_id);
+  bpm->unpinPage(first_page_id, true);
+}
+
+TableHeap::TableHeap(BufferPoolManager *bufferPool, page_id_t firstPageId)
+    : bpm(bufferPool), first_page_id(firstPageId) {
+  page_id_t page_id = first_page_id;
+  while (page_id != INVALID_PAGE_ID) {
+    Page *page = bpm->fetchPage(page_id);
+    if (page == nullptr) {
+      std::cerr << "Could not fetch page " << page_id << " of table heap\n";
+      return;
+    }
+    page_ids.push_back(page_id);
+    page_id_t next_page_id = page->getNextPageId();
+    bpm->unpinPage(page_id, false);
+    page_id = next_page_id;
+  }
+}
+
+Page *TableHeap::appendPage() {
+  page_id_t new_page_id;
+  Page *new_page = bpm->newPage(fileOf(first_page_id), &new_page_id);
+  if (new_page == nullptr) {
+    return nullptr;
+  }
+
+  if (!page_ids.empty()) {
+    Page *last_page = bpm->fetchPage(page_ids.back());
+    if (last_page == nullptr) {
+      bpm->unpinPage(new_page_id, true);
+      return nullptr;
+    }
+    last_page->setNextPageId(new_page_id);
+    bpm->unpinPage(page_ids.back(), true);
+  } else {
+    first_page_id = new_page_id;
+  }
+
+  page_ids.push_back(new_page_id);
+  return new_page;
+}
+
+bool TableHeap::insertRecord(const char *data, uint16_t length, RID *rid) {
+  if (page_ids.empty()) {
+    return false;
+  }
+
+  page_id_t page_id = page_ids.back();
+  Page *page = bpm->fetchPage(page_id);
+  if (page == nullptr) {
+    return false;
+  }
+
+  char *record = page->allocateRecord(length);
+  if (record == nullptr) {
+    // last page is full, continue on a fresh one
+    bpm->unpinPage(page_id, false);
+    page = appendPage();
+    if (page == nullptr) {
+      return false;
+    }
+    page_id = page_ids.back();
+    record = page->allocateRecord(length);
+    if (record == nullptr) {
+      // larger than an empty page
+      bpm->unpinPage(page_id, true);
+      return false;
+    }
+  }
+
+  memcpy(record, data, length);
+  if (zone_map != nullptr) {
+    zone_map->update(page_id, Tuple(zone_map->getSchema(), record, length));
+  }
+  if (rid != nullptr) {
+    rid->page_id = page_id;
+    rid->slot_num = page->getNumberOfSlots() - 1;
+  }
+  bpm->unpinPage(page_id, true);
+  return true;
+}
+
+bool TableHeap::insertTuple(const TupleBuilder &builder, RID *rid) {
+  if (!builder.fitsInPage()) {
+    std::cerr << "Tuple of " << builder.getSerializedLength()
+              << " bytes does not fit in a page\n";
+    return false;
+  }
+  std::vector<char> record(builder.getSerializedLength());
+  builder.serializeTo(record.data());
+  return insertRecord(record.data(), static_cast<uint16_t>(record.size()), rid);
+}
+
+bool TableHeap::getRecord(const RID &rid, std::vector<char> &out) {
+  Page *page = bpm->fetchPage(rid.page_id);
+  if (page == nullptr) {
+    return false;
+  }
+
+  bool found = !page->isRecordDeleted(rid.slot_num);
+  if (found) {
+    const char *record = page->getRecord(rid.slot_num);
+    out.assign(record, record + page->getRecordLength(rid.slot_num));
+  }
+  bpm->unpinPage(rid.page_id, false);
+  return found;
+}
+
+bool TableHeap::updateRecord(const RID &rid, const char *data,
+                             uint16_t length) {
+  Page *page = bpm->fetchPage(rid.page_id);
+  if (page == nullptr) {
+    return false;
+  }
+
+  bool success =
+      page->updateRecord(rid.slot_num, const_cast<char *>(data), length);
+  if (success && zone_map != nullptr) {
+    zone_map->update(rid.page_id, Tuple(zone_map->getSchema(), data, length));
+  }
+  bpm->unpinPage(rid.page_id, success);
+  return success;
+}
+
+bool TableHeap::deleteRecord(const RID &rid) {
+  Page *page = bpm->fetchPage(rid.page_id);
+  if (page == nullptr) {
+    return false;
+  }
+
+  bool success = page->deleteRecord(rid.slot_num);
+  bpm->unpinPage(rid.page_id, success);
+  return success;
+}
+
+void TableHeap::forEachRecord(
+    const std::function<void(const RID &, const char *, uint16_t)> &visitor) {
+  for (page_id_t page_id : page_ids) {
+    Page *page = bpm->fetchPage(page_id);
+    if (page == nullptr) {
+      std::cerr << "Could not fetch page " << page_id << " of table heap\n";
+      return;
+    }
+
+    for (uint16_t slot = 0; slot < page->getNumberOfSlots(); slot++) {
+      if (!page->isRecordDeleted(slot)) {
+        visitor(RID{page_id, slot}, page->getRecord(slot),
+                page->getRecordLength(slot));
+      }
+    }
+    bpm->unpinPage(page_id, false);
+  }
+}
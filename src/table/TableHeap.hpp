@@ -0,0 +1,67 @@
+/* Table Heap requirements
+1. A table is a chain of slotted Pages linked through the page header
+2. All page accesses go through the BufferPoolManager (fetch -> use -> unpin)
+3. Records are addressed by RID = {page_id, slot_num}
+4. Inserts go to the last page of the chain, a new page is linked when full
+5. An attached ZoneMap is widened on every insert and update
+6. All pages of a heap live in the DB file of its first page, so a table
+created in its own file is dropped by dropping the file
+*/
+#pragma once
+
+#include "buffer/BufferPoolManager.hpp"
+#include "ZoneMap.hpp"
+#include "storage/Tuple.hpp"
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+struct RID {
+  page_id_t page_id = INVALID_PAGE_ID;
+  uint16_t slot_num = 0;
+
+  bool operator==(const RID &other) const {
+    return page_id == other.page_id && slot_num == other.slot_num;
+  }
+};
+
+class TableHeap {
+private:
+  BufferPoolManager *bpm;
+  page_id_t first_page_id = INVALID_PAGE_ID;
+  std::vector<page_id_t> page_ids; // chain order, last one takes inserts
+  ZoneMap *zone_map = nullptr;
+
+  // links a fresh page after the current last page
+  Page *appendPage();
+
+public:
+  // creates a new heap with a single empty page in file fileId
+  explicit TableHeap(BufferPoolManager *bufferPool,
+                     file_id_t fileId = PRIMARY_FILE_ID);
+
+  // opens an existing heap by walking its page chain
+  TableHeap(BufferPoolManager *bufferPool, page_id_t firstPageId);
+
+  page_id_t getFirstPageId() const { return first_page_id; }
+
+  const std::vector<page_id_t> &getPageIds() const { return page_ids; }
+
+  // keeps zone_map current from now on (build() it first for existing rows)
+  void setZoneMap(ZoneMap *zoneMap) { zone_map = zoneMap; }
+
+  bool insertRecord(const char *data, uint16_t length, RID *rid = nullptr);
+
+  bool insertTuple(const TupleBuilder &builder, RID *rid = nullptr);
+
+  // copies the record at rid into out
+  bool getRecord(const RID &rid, std::vector<char> &out);
+
+  bool updateRecord(const RID &rid, const char *data, uint16_t length);
+
+  bool deleteRecord(const RID &rid);
+
+  // calls visitor for every live record, in chain order
+  void forEachRecord(
+      const std::function<void(const RID &, const char *, uint16_t)> &visitor);
+};
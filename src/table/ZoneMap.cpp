@@ -0,0 +1,78 @@
+#include "ZoneMap.hpp"
+#include "TableHeap.hpp"
+#include <algorithm>
+
+ZoneMap::ZoneMap(const Schema &tableSchema,
+                 std::vector<uint32_t> trackedColumns)
+    : schema(&tableSchema), columns(std::move(trackedColumns)),
+      column_slot(tableSchema.getColumnCount(), -1) {
+  for (std::size_t i = 0; i < columns.size(); i++) {
+    column_slot[columns[i]] = static_cast<int32_t>(i);
+  }
+}
+
+bool ZoneMap::build(BufferPoolManager *bpm, TableHeap &heap) {
+  zones.clear();
+  for (page_id_t page_id : heap.getPageIds()) {
+    Page *page = bpm->fetchPage(page_id);
+    if (page == nullptr) {
+      std::cerr << "Could not fetch page " << page_id << " for zone map\n";
+      return false;
+    }
+    zones[page_id].resize(columns.size());
+    for (uint16_t slot = 0; slot < page->getNumberOfSlots(); slot++) {
+      if (!page->isRecordDeleted(slot)) {
+        update(page_id, Tuple::fromPage(schema, *page, slot));
+      }
+    }
+    bpm->unpinPage(page_id, false);
+  }
+  return true;
+}
+
+void ZoneMap::update(page_id_t page_id, const Tuple &tuple) {
+  std::vector<Zone> &page_zones = zones[page_id];
+  page_zones.resize(columns.size());
+
+  for (std::size_t i = 0; i < columns.size(); i++) {
+    uint32_t col = columns[i];
+    if (tuple.isNull(col)) {
+      continue;
+    }
+    Zone &zone = page_zones[i];
+    if (schema->getType(col) == TypeId::DOUBLE) {
+      double value = tuple.getDouble(col);
+      zone.min_double =
+          zone.has_values ? std::min(zone.min_double, value) : value;
+      zone.max_double =
+          zone.has_values ? std::max(zone.max_double, value) : value;
+    } else {
+      int64_t value;
+      switch (schema->getType(col)) {
+      case TypeId::BOOLEAN:
+        value = tuple.getBoolean(col);
+        break;
+      case TypeId::INTEGER:
+        value = tuple.getInteger(col);
+        break;
+      default:
+        value = tuple.getBigInt(col);
+        break;
+      }
+      zone.min_int = zone.has_values ? std::min(zone.min_int, value) : value;
+      zone.max_int = zone.has_values ? std::max(zone.max_int, value) : value;
+    }
+    zone.has_values = true;
+  }
+}
+
+const Zone *ZoneMap::getZone(page_id_t page_id, uint32_t col_idx) const {
+  if (!isTracked(col_idx)) {
+    return nullptr;
+  }
+  auto it = zones.find(page_id);
+  if (it == zones.end()) {
+    return nullptr;
+  }
+  return &it->second[column_slot[col_idx]];
+}
@@ -0,0 +1,52 @@
+/* Zone map requirements
+1. For chosen numeric columns (BOOLEAN / INTEGER / BIGINT / DOUBLE) keep the
+min and max non-NULL value of every heap page in memory
+2. A TableHeap with an attached zone map widens the page's ranges on every
+insert and update; deletes leave them as they are (still a superset)
+3. Scans consult the ranges before fetching a page and skip pages whose range
+cannot satisfy the predicate; a page without a zone must be scanned
+*/
+#pragma once
+
+#include "buffer/BufferPoolManager.hpp"
+#include "storage/Tuple.hpp"
+#include <unordered_map>
+#include <vector>
+
+class TableHeap;
+
+struct Zone {
+  bool has_values = false; // false: no non-NULL value seen on the page
+  int64_t min_int = 0;     // BOOLEAN / INTEGER / BIGINT
+  int64_t max_int = 0;
+  double min_double = 0; // DOUBLE
+  double max_double = 0;
+};
+
+class ZoneMap {
+private:
+  const Schema *schema;
+  std::vector<uint32_t> columns;          // tracked table columns
+  std::vector<int32_t> column_slot;       // table column -> index or -1
+  std::unordered_map<page_id_t, std::vector<Zone>> zones; // per page
+
+public:
+  ZoneMap(const Schema &tableSchema, std::vector<uint32_t> trackedColumns);
+
+  const Schema *getSchema() const { return schema; }
+
+  bool isTracked(uint32_t col_idx) const {
+    return col_idx < column_slot.size() && column_slot[col_idx] >= 0;
+  }
+
+  // recomputes every page's zones with one pass over the heap
+  bool build(BufferPoolManager *bpm, TableHeap &heap);
+
+  // widens the zones of page_id with the tuple's values
+  void update(page_id_t page_id, const Tuple &tuple);
+
+  // nullptr when the page or the column is not summarized
+  const Zone *getZone(page_id_t page_id, uint32_t col_idx) const;
+
+  std::size_t getNumPages() const { return zones.size(); }
+};
@@ -0,0 +1,147 @@
+#include "index/ArtIndex.hpp"
+#include <gtest/gtest.h>
+#include <random>
+#include <thread>
+#include <unordered_map>
+
+class ArtIndexTest : public ::testing::Test {
+protected:
+  ArtIndex index;
+
+  static RID ridFor(int64_t key) {
+    return RID{static_cast<page_id_t>(key & 0xffff),
+               static_cast<uint16_t>((key >> 16) & 0xff)};
+  }
+};
+
+TEST_F(ArtIndexTest, InsertAndLookup) {
+  RID rid;
+  EXPECT_FALSE(index.lookup(7, &rid));
+
+  ASSERT_TRUE(index.insert(7, ridFor(7)));
+  ASSERT_TRUE(index.insert(-7, ridFor(-7)));
+  EXPECT_FALSE(index.insert(7, ridFor(8))); // keys are unique
+
+  ASSERT_TRUE(index.lookup(7, &rid));
+  EXPECT_EQ(rid, ridFor(7));
+  ASSERT_TRUE(index.lookup(-7, &rid));
+  EXPECT_EQ(rid, ridFor(-7));
+  EXPECT_FALSE(index.lookup(6, &rid));
+  EXPECT_EQ(index.size(), 2u);
+}
+
+TEST_F(ArtIndexTest, DenseKeysGrowEveryNodeType) {
+  // 0..99999 fills inner nodes on the last bytes up to Node256
+  for (int64_t key = 0; key < 100000; key++) {
+    ASSERT_TRUE(index.insert(key, ridFor(key)));
+  }
+  RID rid;
+  for (int64_t key = 0; key < 100000; key++) {
+    ASSERT_TRUE(index.lookup(key, &rid)) << key;
+    EXPECT_EQ(rid, ridFor(key));
+  }
+  EXPECT_FALSE(index.lookup(100000, &rid));
+  EXPECT_FALSE(index.lookup(-1, &rid));
+}
+
+TEST_F(ArtIndexTest, SplitsCompressedPaths) {
+  // keys that share long prefixes and then diverge at different bytes
+  std::vector<int64_t> keys = {0x0102030405060708, 0x0102030405060709,
+                               0x0102030405ff0000, 0x01020304aa000000,
+                               0x0102ffffffffffff, 0x7f00000000000000,
+                               -0x0102030405060708};
+  for (int64_t key : keys) {
+    ASSERT_TRUE(index.insert(key, ridFor(key)));
+  }
+  RID rid;
+  for (int64_t key : keys) {
+    ASSERT_TRUE(index.lookup(key, &rid)) << key;
+    EXPECT_EQ(rid, ridFor(key));
+  }
+  EXPECT_FALSE(index.lookup(0x0102030405060700, &rid));
+  EXPECT_FALSE(index.lookup(0x0102030400000000, &rid));
+  EXPECT_FALSE(index.lookup(0x0100000000000000, &rid));
+}
+
+TEST_F(ArtIndexTest, RandomKeysMatchHashMap) {
+  std::mt19937_64 rng(11);
+  std::unordered_map<int64_t, RID> expected;
+  for (int i = 0; i < 200000; i++) {
+    int64_t key = static_cast<int64_t>(rng());
+    bool fresh = expected.emplace(key, ridFor(key)).second;
+    EXPECT_EQ(index.insert(key, ridFor(key)), fresh);
+  }
+  EXPECT_EQ(index.size(), expected.size());
+  RID rid;
+  for (const auto &[key, value] : expected) {
+    ASSERT_TRUE(index.lookup(key, &rid));
+    EXPECT_EQ(rid, value);
+    EXPECT_FALSE(index.lookup(key ^ 1, &rid) && !expected.count(key ^ 1));
+  }
+}
+
+TEST_F(ArtIndexTest, ConcurrentInsertsAndLookups) {
+  constexpr int kThreads = 8;
+  constexpr int64_t kPerThread = 30000;
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; t++) {
+    threads.emplace_back([&, t] {
+      std::mt19937_64 rng(t);
+      for (int64_t i = 0; i < kPerThread; i++) {
+        // interleaved dense keys plus scattered ones, all distinct
+        int64_t key = i * kThreads + t;
+        EXPECT_TRUE(index.insert(key, ridFor(key)));
+        // scattered key of the same residue, far above the dense range
+        int64_t sparse = static_cast<int64_t>(
+            ((rng() >> 8) | 1) * kThreads + static_cast<uint64_t>(t));
+        index.insert(sparse, ridFor(sparse));
+        RID rid;
+        if (i > 0) {
+          int64_t seen = (i - 1) * kThreads + t;
+          ASSERT_TRUE(index.lookup(seen, &rid)) << seen;
+          EXPECT_EQ(rid, ridFor(seen));
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  RID rid;
+  for (int64_t key = 0; key < kThreads * kPerThread; key++) {
+    ASSERT_TRUE(index.lookup(key, &rid)) << key;
+    EXPECT_EQ(rid, ridFor(key));
+  }
+}
+
+TEST_F(ArtIndexTest, BuildFromHeap) {
+  std::string db_file = "test_art_index.db";
+  std::remove(db_file.c_str());
+  {
+    BufferPoolManager bpm(16, db_file);
+    Schema schema({Column("id", TypeId::BIGINT, false),
+                   Column("name", TypeId::VARCHAR)});
+    TableHeap heap(&bpm);
+    TupleBuilder row(schema);
+    std::unordered_map<int64_t, RID> rids;
+    for (int64_t i = 0; i < 5000; i++) {
+      row.reset();
+      row.setBigInt(0, i * 13);
+      row.setVarchar(1, "row" + std::to_string(i));
+      RID rid;
+      ASSERT_TRUE(heap.insertTuple(row, &rid));
+      rids[i * 13] = rid;
+    }
+
+    ASSERT_TRUE(index.build(heap, schema, 0));
+    EXPECT_EQ(index.size(), rids.size());
+    RID rid;
+    for (const auto &[key, expected] : rids) {
+      ASSERT_TRUE(index.lookup(key, &rid));
+      EXPECT_EQ(rid, expected);
+    }
+  }
+  std::remove(db_file.c_str());
+}
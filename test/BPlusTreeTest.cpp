@@ -0,0 +1,176 @@
+#include "index/BPlusTree.hpp"
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <random>
+#include <thread>
+
+class BPlusTreeTest : public ::testing::Test {
+protected:
+  BufferPoolManager *bpm;
+  std::string db_file = "test_bplus_tree.db";
+  static constexpr int kKeys = 50000;
+
+  void SetUp() override {
+    std::remove(db_file.c_str());
+    // far fewer frames than index pages: nodes are evicted and re-read
+    bpm = new BufferPoolManager(32, db_file);
+  }
+
+  void TearDown() override {
+    delete bpm;
+    std::remove(db_file.c_str());
+  }
+
+  static RID ridFor(int64_t key) {
+    return RID{static_cast<page_id_t>(key % 1000),
+               static_cast<uint16_t>(key % 97)};
+  }
+
+  std::vector<std::pair<int64_t, RID>> sortedEntries() {
+    std::vector<std::pair<int64_t, RID>> entries;
+    for (int64_t i = 0; i < kKeys; i++) {
+      entries.emplace_back(i * 3, ridFor(i * 3));
+    }
+    return entries;
+  }
+
+  void expectContents(BPlusTree &tree) {
+    RID rid;
+    for (int64_t i = 0; i < kKeys; i++) {
+      ASSERT_TRUE(tree.lookup(i * 3, &rid)) << i * 3;
+      EXPECT_EQ(rid, ridFor(i * 3));
+      EXPECT_FALSE(tree.lookup(i * 3 + 1, &rid));
+    }
+
+    int64_t expected = 300;
+    tree.scanRange(300, 9000, [&](int64_t key, const RID &value) {
+      EXPECT_EQ(key, expected);
+      EXPECT_EQ(value, ridFor(key));
+      expected += 3;
+    });
+    EXPECT_EQ(expected, 9003);
+  }
+};
+
+TEST_F(BPlusTreeTest, InsertAndLookup) {
+  BPlusTree tree(bpm);
+  EXPECT_TRUE(tree.isEmpty());
+
+  auto entries = sortedEntries();
+  std::shuffle(entries.begin(), entries.end(), std::mt19937(42));
+  for (const auto &[key, rid] : entries) {
+    ASSERT_TRUE(tree.insert(key, rid));
+  }
+  EXPECT_FALSE(tree.insert(3, RID{})); // duplicate
+  EXPECT_GE(tree.getHeight(), 2u);
+  expectContents(tree);
+}
+
+TEST_F(BPlusTreeTest, BulkLoadMatchesInserts) {
+  BPlusTree tree(bpm);
+  ASSERT_TRUE(tree.bulkLoad(sortedEntries()));
+  expectContents(tree);
+
+  // packed leaves: ceil(50000 / LEAF_CAPACITY) leaves under a 2-level tree
+  EXPECT_EQ(tree.getHeight(), 2u);
+
+  // the tree keeps accepting inserts after a bulk load
+  EXPECT_TRUE(tree.insert(1, RID{1, 1}));
+  RID rid;
+  ASSERT_TRUE(tree.lookup(1, &rid));
+  EXPECT_EQ(rid, (RID{1, 1}));
+}
+
+TEST_F(BPlusTreeTest, FillFactorLeavesRoomInLeaves) {
+  BPlusTree packed(bpm);
+  ASSERT_TRUE(packed.bulkLoad(sortedEntries(), 1.0));
+  std::size_t packed_pages = bpm->getNumPages();
+
+  BPlusTree sparse(bpm);
+  ASSERT_TRUE(sparse.bulkLoad(sortedEntries(), 0.5));
+  std::size_t sparse_pages = bpm->getNumPages() - packed_pages;
+
+  EXPECT_GE(sparse_pages, 2 * packed_pages - 2);
+  expectContents(sparse);
+
+  // reopen from the root page id
+  BPlusTree reopened(bpm, sparse.getRootPageId());
+  expectContents(reopened);
+}
+
+TEST_F(BPlusTreeTest, BulkLoadRejectsUnsortedInput) {
+  auto entries = sortedEntries();
+  std::swap(entries[10], entries[11]);
+  BPlusTree tree(bpm);
+  EXPECT_FALSE(tree.bulkLoad(entries));
+  EXPECT_TRUE(tree.isEmpty());
+
+  BPlusTree loaded(bpm);
+  ASSERT_TRUE(loaded.bulkLoad(sortedEntries()));
+  EXPECT_FALSE(loaded.bulkLoad(sortedEntries())); // not empty
+}
+
+TEST_F(BPlusTreeTest, SwizzledLookupsSurviveEvictions) {
+  BPlusTree tree(bpm);
+  ASSERT_TRUE(tree.bulkLoad(sortedEntries()));
+  bpm->setSwizzling(true);
+
+  // the 32-frame pool cannot hold the tree: references are swizzled,
+  // evicted and swizzled again while the results stay correct
+  expectContents(tree);
+  expectContents(tree);
+  EXPECT_GT(bpm->getStats().swizzled_hits, 0u);
+}
+
+TEST_F(BPlusTreeTest, ConcurrentSwizzledLookups) {
+  BPlusTree tree(bpm);
+  ASSERT_TRUE(tree.bulkLoad(sortedEntries()));
+  bpm->setSwizzling(true);
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([&, t] {
+      RID rid;
+      for (int64_t i = t; i < kKeys; i += 4) {
+        ASSERT_TRUE(tree.lookup(i * 3, &rid)) << i * 3;
+        EXPECT_EQ(rid, ridFor(i * 3));
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+}
+
+TEST_F(BPlusTreeTest, LookupBatchMatchesLookups) {
+  BPlusTree tree(bpm);
+  ASSERT_TRUE(tree.bulkLoad(sortedEntries()));
+
+  // present and absent keys, unsorted, with duplicates; far more leaves
+  // than the 32 frames hold
+  std::mt19937_64 rng(9);
+  std::vector<int64_t> keys(3000);
+  for (int64_t &key : keys) {
+    key = static_cast<int64_t>(rng() % (kKeys * 3 + 100));
+  }
+  keys.push_back(keys[0]);
+  std::vector<RID> rids;
+  std::vector<bool> found;
+  std::size_t hits = tree.lookupBatch(keys, &rids, &found);
+
+  std::size_t expected = 0;
+  for (std::size_t i = 0; i < keys.size(); i++) {
+    RID rid;
+    bool present = tree.lookup(keys[i], &rid);
+    ASSERT_EQ(found[i], present) << keys[i];
+    if (present) {
+      EXPECT_EQ(rids[i], rid);
+      expected++;
+    }
+  }
+  EXPECT_EQ(hits, expected);
+  EXPECT_GT(hits, 0u);
+
+  BPlusTree empty(bpm);
+  EXPECT_EQ(empty.lookupBatch(keys, &rids, &found), 0u);
+}
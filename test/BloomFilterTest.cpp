@@ -0,0 +1,103 @@
+#include "index/BPlusTree.hpp"
+#include "index/PageBloomFilters.hpp"
+#include <gtest/gtest.h>
+
+TEST(BloomFilterTest, NoFalseNegativesAndFewFalsePositives) {
+  constexpr int kKeys = 100000;
+  BloomFilter filter(kKeys, 10);
+  for (int64_t i = 0; i < kKeys; i++) {
+    filter.insert(i * 2);
+  }
+  std::size_t false_positives = 0;
+  for (int64_t i = 0; i < kKeys; i++) {
+    ASSERT_TRUE(filter.mayContain(i * 2));
+    false_positives += filter.mayContain(i * 2 + 1);
+  }
+  // ~1% expected at 10 bits per key
+  EXPECT_LT(false_positives, static_cast<std::size_t>(kKeys / 50));
+}
+
+class BloomFilterIndexTest : public ::testing::Test {
+protected:
+  BufferPoolManager *bpm;
+  std::string db_file = "test_bloom_filter.db";
+  static constexpr int kKeys = 20000;
+
+  void SetUp() override {
+    std::remove(db_file.c_str());
+    bpm = new BufferPoolManager(32, db_file);
+  }
+
+  void TearDown() override {
+    delete bpm;
+    std::remove(db_file.c_str());
+  }
+};
+
+TEST_F(BloomFilterIndexTest, TreeSkipsFetchesForAbsentKeys) {
+  std::vector<std::pair<int64_t, RID>> entries;
+  for (int64_t i = 0; i < kKeys; i++) {
+    entries.emplace_back(i * 2, RID{static_cast<page_id_t>(i), 0});
+  }
+  BPlusTree tree(bpm);
+  tree.enableBloomFilter(kKeys);
+  ASSERT_TRUE(tree.bulkLoad(entries));
+  ASSERT_TRUE(tree.insert(-5, RID{7, 7}));
+
+  bpm->resetStats();
+  RID rid;
+  for (int64_t i = 0; i < kKeys; i++) {
+    ASSERT_FALSE(tree.lookup(i * 2 + 1, &rid));
+  }
+  BufferPoolStats stats = bpm->getStats();
+  EXPECT_GT(tree.getFilteredLookups(),
+            static_cast<std::size_t>(kKeys * 9 / 10));
+  EXPECT_LT(stats.hits + stats.misses, static_cast<std::size_t>(kKeys / 5));
+
+  // present keys still found, including the one inserted after the load
+  for (int64_t i = 0; i < kKeys; i += 97) {
+    ASSERT_TRUE(tree.lookup(i * 2, &rid));
+    EXPECT_EQ(rid.page_id, i);
+  }
+  ASSERT_TRUE(tree.lookup(-5, &rid));
+
+  // a reopened tree rebuilds its filter from the leaves
+  BPlusTree reopened(bpm, tree.getRootPageId());
+  reopened.enableBloomFilter(kKeys);
+  EXPECT_TRUE(reopened.lookup(-5, &rid));
+  EXPECT_FALSE(reopened.lookup(3, &rid));
+}
+
+TEST_F(BloomFilterIndexTest, PageFiltersSkipPages) {
+  Schema schema({Column("id", TypeId::BIGINT, false),
+                 Column("name", TypeId::VARCHAR)});
+  TableHeap heap(bpm);
+  TupleBuilder row(schema);
+  for (int64_t i = 0; i < kKeys; i++) {
+    row.setBigInt(0, i);
+    row.setVarchar(1, "row" + std::to_string(i));
+    ASSERT_TRUE(heap.insertTuple(row));
+  }
+
+  PageBloomFilters filters(bpm, schema, 0);
+  ASSERT_TRUE(filters.build(heap));
+  std::size_t pages = heap.getPageIds().size();
+
+  // present key: only the page holding it (plus rare false positives)
+  std::size_t matches = filters.lookup(1234, [](const RID &, const Tuple &t) {
+    EXPECT_EQ(t.getVarchar(1), "row1234");
+  });
+  EXPECT_EQ(matches, 1u);
+  EXPECT_LT(filters.getPagesFetched(), 1 + pages / 10);
+
+  // absent key: nearly every page skipped
+  EXPECT_EQ(filters.lookup(kKeys + 5), 0u);
+  EXPECT_GT(filters.getPagesSkipped(), 2 * pages - pages / 10);
+
+  // rows inserted after the build are found once added
+  RID rid;
+  row.setBigInt(0, -1);
+  ASSERT_TRUE(heap.insertTuple(row, &rid));
+  filters.add(rid, -1);
+  EXPECT_EQ(filters.lookup(-1), 1u);
+}
@@ -1,6 +1,10 @@
 #include "buffer/BufferPoolManager.hpp"
+#include <chrono>
 #include <cstring>
+#include <fstream>
 #include <gtest/gtest.h>
+#include <random>
+#include <thread>
 
 // Test record structure
 struct TestRecord {
@@ -331,4 +335,831 @@ TEST_F(BufferPoolManagerTest, DataPersistsAcrossInstances) {
     EXPECT_EQ(rec->id, 999);
     EXPECT_STREQ(rec->data, "Persistent Data");
   }
-}
\ No newline at end of file
+}
+// ============ SWIZZLING TESTS ============
+
+TEST_F(BufferPoolManagerTest, FetchChildFollowsSwizzledPointer) {
+  bpm->setSwizzling(true);
+  page_id_t parent_id, child_id;
+  Page *parent = bpm->newPage(&parent_id);
+  Page *child = bpm->newPage(&child_id);
+  TestRecord rec = {7, "Child"};
+  child->insertRecord((char *)&rec, sizeof(TestRecord));
+  bpm->unpinPage(child, true);
+
+  // first access goes through the page table and swizzles the reference
+  Page *first = bpm->fetchChild(parent, 3, child_id);
+  ASSERT_EQ(first, child);
+  bpm->unpinPage(first, false);
+  EXPECT_EQ(bpm->getStats().swizzled_hits, 0u);
+
+  Page *second = bpm->fetchChild(parent, 3, child_id);
+  ASSERT_EQ(second, child);
+  EXPECT_EQ(bpm->getStats().swizzled_hits, 1u);
+
+  // a swizzled child is pinned like any other page
+  EXPECT_FALSE(bpm->deletePage(child_id));
+  bpm->unpinPage(second, false);
+  bpm->unpinPage(parent, false);
+}
+
+TEST_F(BufferPoolManagerTest, EvictionUnswizzles) {
+  bpm->setSwizzling(true);
+  page_id_t parent_id, child_id, other_id;
+  Page *parent = bpm->newPage(&parent_id);
+  Page *child = bpm->newPage(&child_id);
+  TestRecord rec = {11, "Child"};
+  child->insertRecord((char *)&rec, sizeof(TestRecord));
+  bpm->unpinPage(child, true);
+  bpm->unpinPage(bpm->fetchChild(parent, 0, child_id), false);
+
+  // 3 frames, parent pinned: two new pages push the child out
+  for (int i = 0; i < 2; i++) {
+    bpm->newPage(&other_id);
+    bpm->unpinPage(other_id, true);
+  }
+
+  // the stale frame pointer is gone: the child is read back from disk
+  bpm->resetStats();
+  Page *reloaded = bpm->fetchChild(parent, 0, child_id);
+  ASSERT_NE(reloaded, nullptr);
+  EXPECT_EQ(bpm->getStats().swizzled_hits, 0u);
+  EXPECT_EQ(bpm->getStats().disk_reads, 1u);
+  EXPECT_EQ(((TestRecord *)reloaded->getRecord(0))->id, 11);
+  bpm->unpinPage(reloaded, false);
+  bpm->unpinPage(parent, false);
+}
+
+TEST_F(BufferPoolManagerTest, SwizzlingOffUsesPageTable) {
+  page_id_t parent_id, child_id;
+  Page *parent = bpm->newPage(&parent_id);
+  bpm->newPage(&child_id);
+  bpm->unpinPage(child_id, false);
+  for (int i = 0; i < 3; i++) {
+    bpm->unpinPage(bpm->fetchChild(parent, 0, child_id), false);
+  }
+  EXPECT_EQ(bpm->getStats().swizzled_hits, 0u);
+  bpm->unpinPage(parent, false);
+}
+
+// ============ MULTI-FILE TESTS ============
+
+TEST_F(BufferPoolManagerTest, PagesOfAddedFileLiveInThatFile) {
+  std::string extra_file = "test_bpm_extra.db";
+  std::remove(extra_file.c_str());
+  file_id_t file_id = bpm->addFile(extra_file);
+  ASSERT_NE(file_id, INVALID_FILE_ID);
+  EXPECT_EQ(bpm->addFile(extra_file), file_id); // already registered
+
+  page_id_t page_id;
+  Page *page = bpm->newPage(file_id, &page_id);
+  ASSERT_NE(page, nullptr);
+  EXPECT_EQ(fileOf(page_id), file_id);
+  EXPECT_EQ(pageNumberOf(page_id), 0u);
+  TestRecord rec = {5, "Extra"};
+  page->insertRecord((char *)&rec, sizeof(TestRecord));
+  bpm->unpinPage(page_id, true);
+  EXPECT_EQ(bpm->getNumPages(), 0u); // primary file untouched
+
+  // reopen: the page comes back from the added file
+  delete bpm;
+  bpm = new BufferPoolManager(3, db_file);
+  ASSERT_EQ(bpm->addFile(extra_file), file_id);
+  EXPECT_EQ(bpm->getNumPages(file_id), 1u);
+  page = bpm->fetchPage(page_id);
+  ASSERT_NE(page, nullptr);
+  EXPECT_EQ(((TestRecord *)page->getRecord(0))->id, 5);
+  bpm->unpinPage(page_id, false);
+  std::remove(extra_file.c_str());
+}
+
+TEST_F(BufferPoolManagerTest, DropFileDiscardsItsPages) {
+  std::string extra_file = "test_bpm_drop.db";
+  file_id_t file_id = bpm->addFile(extra_file);
+  page_id_t dropped_id, kept_id;
+  bpm->newPage(file_id, &dropped_id);
+  bpm->newPage(&kept_id);
+  bpm->unpinPage(kept_id, true);
+
+  EXPECT_FALSE(bpm->dropFile(PRIMARY_FILE_ID));
+  EXPECT_FALSE(bpm->dropFile(file_id)); // page still pinned
+  bpm->unpinPage(dropped_id, true);
+  bpm->resetStats();
+  ASSERT_TRUE(bpm->dropFile(file_id));
+
+  EXPECT_EQ(bpm->getStats().disk_writes, 0u); // not written back
+  EXPECT_FALSE(std::ifstream(extra_file).good());
+  EXPECT_EQ(bpm->fetchPage(dropped_id), nullptr);
+  page_id_t page_id;
+  EXPECT_EQ(bpm->newPage(file_id, &page_id), nullptr);
+  Page *kept = bpm->fetchPage(kept_id);
+  ASSERT_NE(kept, nullptr);
+  bpm->unpinPage(kept_id, false);
+}
+
+TEST_F(BufferPoolManagerTest, TemporaryFileHoldsSpillPages) {
+  std::string temp_file = "test_bpm_temp.db";
+  file_id_t file_id = bpm->addFile(temp_file, true);
+  ASSERT_NE(file_id, INVALID_FILE_ID);
+  bpm->setSpillFile(file_id);
+  EXPECT_EQ(bpm->getSpillFile(), file_id);
+
+  // spilled pages are evicted to the temp file like any other page
+  std::vector<page_id_t> ids(5);
+  for (int i = 0; i < 5; i++) {
+    Page *page = bpm->newPage(bpm->getSpillFile(), &ids[i]);
+    TestRecord rec = {i, "Spill"};
+    page->insertRecord((char *)&rec, sizeof(TestRecord));
+    bpm->unpinPage(ids[i], true);
+  }
+  for (int i = 0; i < 5; i++) {
+    Page *page = bpm->fetchPage(ids[i]);
+    ASSERT_NE(page, nullptr);
+    EXPECT_EQ(((TestRecord *)page->getRecord(0))->id, i);
+    bpm->unpinPage(ids[i], false);
+  }
+  EXPECT_EQ(bpm->getNumPages(), 0u);
+
+  delete bpm; // deletes the temp file
+  bpm = new BufferPoolManager(3, db_file);
+  EXPECT_FALSE(std::ifstream(temp_file).good());
+}
+
+TEST_F(BufferPoolManagerTest, SpillsDefaultToTemporaryFile) {
+  file_id_t spill_file = bpm->getSpillFile();
+  ASSERT_NE(spill_file, PRIMARY_FILE_ID);
+  EXPECT_EQ(bpm->getSpillFile(), spill_file);
+
+  std::vector<page_id_t> ids(5);
+  for (page_id_t &page_id : ids) {
+    ASSERT_NE(bpm->newPage(spill_file, &page_id), nullptr);
+    bpm->unpinPage(page_id, true);
+  }
+  EXPECT_EQ(bpm->getNumPages(), 0u); // the DB file does not grow
+  EXPECT_EQ(bpm->getNumPages(spill_file), 5u);
+
+  // consumed spill pages are dropped without being written back
+  bpm->resetStats();
+  for (page_id_t page_id : ids) {
+    bpm->deletePage(page_id);
+  }
+  EXPECT_EQ(bpm->getStats().disk_writes, 0u);
+}
+
+// ============ PARTITION AND PRIORITY TESTS ============
+
+TEST_F(BufferPoolManagerTest, LowerPriorityIsEvictedFirst) {
+  page_id_t ids[3], extra_id;
+  for (page_id_t &id : ids) {
+    Page *page = bpm->newPage(&id);
+    if (id == 0) {
+      bpm->setPagePriority(page, PagePriority::HIGH);
+    }
+    if (id == 2) {
+      bpm->setPagePriority(page, PagePriority::LOW);
+    }
+    bpm->unpinPage(id, true);
+  }
+
+  // LRU order is 0, 1, 2: the LOW page goes first, then NORMAL, then HIGH
+  bpm->newPage(&extra_id);
+  bpm->unpinPage(extra_id, false);
+  bpm->newPage(&extra_id);
+  bpm->unpinPage(extra_id, false);
+  bpm->resetStats();
+  bpm->unpinPage(bpm->fetchPage(ids[0]), false);
+  EXPECT_EQ(bpm->getStats().hits, 1u);
+  bpm->unpinPage(bpm->fetchPage(ids[2]), false);
+  EXPECT_EQ(bpm->getStats().misses, 1u);
+}
+
+TEST_F(BufferPoolManagerTest, PartitionMaximumCapsItsFrames) {
+  std::string batch_file = "test_bpm_batch.db";
+  std::remove(batch_file.c_str());
+  {
+    BufferPoolManager pool(8, db_file);
+    partition_id_t batch = pool.createPartition("batch", 0, 2);
+    ASSERT_NE(batch, INVALID_PARTITION_ID);
+    file_id_t file_id = pool.addFile(batch_file);
+    ASSERT_TRUE(pool.setFilePartition(file_id, batch));
+
+    std::vector<page_id_t> hot(4);
+    for (page_id_t &id : hot) {
+      pool.newPage(&id);
+      pool.unpinPage(id, true);
+    }
+    // a long scan of the batch file replaces its own two frames only
+    for (int i = 0; i < 20; i++) {
+      page_id_t id;
+      ASSERT_NE(pool.newPage(file_id, &id), nullptr);
+      pool.unpinPage(id, true);
+    }
+    EXPECT_EQ(pool.getPartitionStats(batch).resident_frames, 2u);
+    EXPECT_EQ(pool.getPartitionStats(batch).evictions, 18u);
+
+    pool.resetStats();
+    for (page_id_t id : hot) {
+      pool.unpinPage(pool.fetchPage(id), false);
+    }
+    EXPECT_EQ(pool.getPartitionStats(DEFAULT_PARTITION_ID).hits, 4u);
+    EXPECT_EQ(pool.getPartitionStats(DEFAULT_PARTITION_ID).misses, 0u);
+  }
+  std::remove(batch_file.c_str());
+}
+
+TEST_F(BufferPoolManagerTest, PartitionMinimumIsReserved) {
+  std::string oltp_file = "test_bpm_oltp.db";
+  std::remove(oltp_file.c_str());
+  {
+    BufferPoolManager pool(6, db_file);
+    EXPECT_EQ(pool.createPartition("too big", 7, 7), INVALID_PARTITION_ID);
+    partition_id_t oltp = pool.createPartition("oltp", 3, 6);
+    ASSERT_NE(oltp, INVALID_PARTITION_ID);
+    file_id_t file_id = pool.addFile(oltp_file);
+    pool.setFilePartition(file_id, oltp);
+
+    // the default partition may only use the 3 unreserved frames
+    for (int i = 0; i < 10; i++) {
+      page_id_t id;
+      ASSERT_NE(pool.newPage(&id), nullptr);
+      pool.unpinPage(id, true);
+    }
+    EXPECT_EQ(pool.getPartitionStats(DEFAULT_PARTITION_ID).resident_frames,
+              3u);
+
+    std::vector<page_id_t> oltp_pages(3);
+    for (page_id_t &id : oltp_pages) {
+      ASSERT_NE(pool.newPage(file_id, &id), nullptr);
+      pool.unpinPage(id, true);
+    }
+    for (int i = 0; i < 10; i++) {
+      page_id_t id;
+      pool.newPage(&id);
+      pool.unpinPage(id, true);
+    }
+    pool.resetStats();
+    for (page_id_t id : oltp_pages) {
+      pool.unpinPage(pool.fetchPage(id), false);
+    }
+    EXPECT_EQ(pool.getPartitionStats(oltp).hits, 3u);
+  }
+  std::remove(oltp_file.c_str());
+}
+
+// ============ BATCHED FETCH TESTS ============
+
+TEST_F(BufferPoolManagerTest, FetchPagesCoalescesAdjacentMisses) {
+  delete bpm;
+  bpm = new BufferPoolManager(64, db_file);
+  std::vector<page_id_t> ids(40);
+  for (page_id_t &id : ids) {
+    Page *page = bpm->newPage(&id);
+    TestRecord rec = {static_cast<int>(id), "Batch"};
+    page->insertRecord((char *)&rec, sizeof(TestRecord));
+    bpm->unpinPage(id, true);
+  }
+  delete bpm;
+  bpm = new BufferPoolManager(64, db_file);
+
+  Page *resident = bpm->fetchPage(ids[10]);
+  bpm->resetStats();
+  // runs 3..6, 20..21, 30, a hit, and a duplicate
+  std::vector<page_id_t> batch = {ids[30], ids[4], ids[3], ids[10],
+                                  ids[5],  ids[21], ids[6], ids[20], ids[4]};
+  std::vector<Page *> pages(batch.size());
+  ASSERT_TRUE(bpm->fetchPages(batch.data(), batch.size(), pages.data()));
+  BufferPoolStats stats = bpm->getStats();
+  EXPECT_EQ(stats.disk_reads, 3u);
+  EXPECT_EQ(stats.misses, 7u);
+  EXPECT_EQ(stats.hits, 1u);
+  EXPECT_EQ(pages[3], resident);
+  for (std::size_t i = 0; i < batch.size(); i++) {
+    ASSERT_NE(pages[i], nullptr);
+    EXPECT_EQ(((TestRecord *)pages[i]->getRecord(0))->id,
+              static_cast<int>(batch[i]));
+    EXPECT_TRUE(bpm->unpinPage(pages[i], false));
+  }
+  // pinned once per occurrence
+  EXPECT_FALSE(bpm->unpinPage(ids[4], false));
+  EXPECT_TRUE(bpm->unpinPage(resident, false));
+}
+
+TEST_F(BufferPoolManagerTest, FetchPagesIsAllOrNothing) {
+  std::vector<page_id_t> ids(4);
+  for (page_id_t &id : ids) {
+    bpm->newPage(&id);
+    bpm->unpinPage(id, true);
+  }
+  Page *resident = bpm->fetchPage(ids[3]);
+
+  // four pages do not fit in three frames
+  std::vector<Page *> pages(4);
+  EXPECT_FALSE(bpm->fetchPages(ids.data(), 4, pages.data()));
+  EXPECT_EQ(pages[3], nullptr);
+  // the hit was unpinned again and the frames were given back
+  EXPECT_TRUE(bpm->unpinPage(resident, false));
+  EXPECT_FALSE(bpm->unpinPage(ids[3], false));
+  ASSERT_TRUE(bpm->fetchPages(ids.data(), 3, pages.data()));
+  for (int i = 0; i < 3; i++) {
+    EXPECT_TRUE(bpm->unpinPage(pages[i], false));
+  }
+}
+
+// ============ SECOND TIER TESTS ============
+
+TEST_F(BufferPoolManagerTest, ReusedPagesAreReadBackFromSecondTier) {
+  const std::string tier_file = "test_bpm_tier.cache";
+  ASSERT_TRUE(bpm->enableSecondTier(tier_file, 16));
+  EXPECT_FALSE(bpm->enableSecondTier(tier_file, 16));
+  std::vector<page_id_t> ids(6);
+  for (page_id_t &id : ids) {
+    Page *page = bpm->newPage(&id);
+    TestRecord rec = {static_cast<int>(id), "Tier"};
+    page->insertRecord((char *)&rec, sizeof(TestRecord));
+    bpm->unpinPage(id, true);
+  }
+  // loaded once: not admitted
+  EXPECT_EQ(bpm->getStats().tier_writes, 0u);
+
+  for (int i = 0; i < 2; i++) {
+    bpm->unpinPage(bpm->fetchPage(ids[0]), false);
+  }
+  for (int i = 1; i <= 3; i++) {
+    bpm->unpinPage(bpm->fetchPage(ids[i]), false);
+  }
+  EXPECT_EQ(bpm->getStats().tier_writes, 1u);
+
+  bpm->resetStats();
+  Page *page = bpm->fetchPage(ids[0]);
+  ASSERT_NE(page, nullptr);
+  EXPECT_EQ(((TestRecord *)page->getRecord(0))->id, static_cast<int>(ids[0]));
+  BufferPoolStats stats = bpm->getStats();
+  EXPECT_EQ(stats.tier_hits, 1u);
+  EXPECT_EQ(stats.disk_reads, 0u);
+  bpm->unpinPage(page, false);
+
+  delete bpm; // the tier file goes with the pool
+  bpm = new BufferPoolManager(3, db_file);
+  EXPECT_FALSE(std::ifstream(tier_file).good());
+}
+
+TEST_F(BufferPoolManagerTest, WriteBackDropsStaleTierCopy) {
+  ASSERT_TRUE(bpm->enableSecondTier("test_bpm_tier.cache", 8,
+                                    TierAdmission::ALL));
+  std::vector<page_id_t> ids(5);
+  for (page_id_t &id : ids) {
+    Page *page = bpm->newPage(&id);
+    TestRecord rec = {1, "Old"};
+    page->insertRecord((char *)&rec, sizeof(TestRecord));
+    bpm->unpinPage(id, true);
+  }
+  // pages 0 and 1 were evicted after their write-back and admitted
+  EXPECT_EQ(bpm->getStats().tier_writes, 2u);
+
+  // page 0 comes from the tier, is changed and written back on eviction
+  Page *page = bpm->fetchPage(ids[0]);
+  ((TestRecord *)page->getRecord(0))->id = 2;
+  bpm->unpinPage(page, true);
+  EXPECT_EQ(bpm->getStats().tier_hits, 1u);
+  for (int i = 2; i < 5; i++) {
+    bpm->unpinPage(bpm->fetchPage(ids[i]), false);
+  }
+
+  // no stale copy survives: the change is read back, from either tier
+  page = bpm->fetchPage(ids[0]);
+  EXPECT_EQ(((TestRecord *)page->getRecord(0))->id, 2);
+  bpm->unpinPage(page, false);
+}
+
+// ============ SNAPSHOT TESTS ============
+
+TEST_F(BufferPoolManagerTest, SnapshotSeesPointInTimeImage) {
+  const std::string area = "test_bpm_snapshot.area";
+  std::vector<page_id_t> ids(5);
+  for (page_id_t &id : ids) {
+    Page *page = bpm->newPage(&id);
+    TestRecord rec = {1, "Before"};
+    page->insertRecord((char *)&rec, sizeof(TestRecord));
+    bpm->unpinPage(id, true);
+  }
+  char data[PAGE_SIZE];
+  EXPECT_FALSE(bpm->readSnapshotPage(ids[0], data));
+  ASSERT_TRUE(bpm->beginSnapshot(area));
+  EXPECT_FALSE(bpm->beginSnapshot(area));
+  EXPECT_EQ(bpm->getSnapshotPages(), 5u);
+
+  // overwrite three pages twice, and add one
+  for (int round = 0; round < 2; round++) {
+    for (int i = 0; i < 3; i++) {
+      Page *page = bpm->fetchPage(ids[i]);
+      ((TestRecord *)page->getRecord(0))->id = 2 + round;
+      bpm->unpinPage(page, true);
+    }
+    bpm->flushAllDirtyPages();
+  }
+  page_id_t added;
+  bpm->newPage(&added);
+  bpm->unpinPage(added, true);
+  EXPECT_EQ(bpm->getStats().snapshot_copies, 3u);
+
+  Page snapshot_page;
+  for (page_id_t id : ids) {
+    ASSERT_TRUE(bpm->readSnapshotPage(id, snapshot_page.getData()));
+    EXPECT_EQ(((TestRecord *)snapshot_page.getRecord(0))->id, 1) << id;
+  }
+  EXPECT_FALSE(bpm->readSnapshotPage(added, data));
+
+  // the live pages have moved on
+  Page *page = bpm->fetchPage(ids[0]);
+  EXPECT_EQ(((TestRecord *)page->getRecord(0))->id, 3);
+  bpm->unpinPage(page, false);
+
+  EXPECT_TRUE(bpm->endSnapshot());
+  EXPECT_FALSE(bpm->endSnapshot());
+  EXPECT_FALSE(bpm->readSnapshotPage(ids[0], data));
+  EXPECT_FALSE(std::ifstream(area).good());
+}
+
+TEST_F(BufferPoolManagerTest, BackupWhileWriting) {
+  delete bpm;
+  bpm = new BufferPoolManager(16, db_file);
+  std::vector<page_id_t> ids(200);
+  for (page_id_t &id : ids) {
+    Page *page = bpm->newPage(&id);
+    TestRecord rec = {1, "Before"};
+    page->insertRecord((char *)&rec, sizeof(TestRecord));
+    bpm->unpinPage(id, true);
+  }
+  ASSERT_TRUE(bpm->beginSnapshot("test_bpm_snapshot.area"));
+
+  // a writer keeps changing (and evicting) pages during the backup
+  std::atomic<bool> stop{false};
+  std::thread writer([&] {
+    std::mt19937 rng(4);
+    while (!stop) {
+      Page *page = bpm->fetchPage(ids[rng() % ids.size()]);
+      ((TestRecord *)page->getRecord(0))->id++;
+      bpm->unpinPage(page, true);
+    }
+  });
+  const std::string backup = "test_bpm_backup.db";
+  bool backed_up = bpm->backupSnapshot(PRIMARY_FILE_ID, backup);
+  stop = true;
+  writer.join();
+  ASSERT_TRUE(backed_up);
+  bpm->endSnapshot();
+
+  std::ifstream in(backup, std::ios::binary);
+  Page page;
+  for (page_id_t id : ids) {
+    ASSERT_TRUE(in.read(page.getData(), PAGE_SIZE));
+    EXPECT_EQ(((TestRecord *)page.getRecord(0))->id, 1) << id;
+  }
+  std::remove(backup.c_str());
+}
+
+// ============ INCREMENTAL BACKUP TESTS ============
+
+TEST_F(BufferPoolManagerTest, IncrementalBackupsRestoreTheFile) {
+  auto setStamp = [this](page_id_t id, int stamp) {
+    Page *page = bpm->fetchPage(id);
+    ((TestRecord *)page->getRecord(0))->id = stamp;
+    bpm->unpinPage(page, true);
+  };
+  std::vector<page_id_t> ids(50);
+  for (page_id_t &id : ids) {
+    Page *page = bpm->newPage(&id);
+    TestRecord rec = {1, "Base"};
+    page->insertRecord((char *)&rec, sizeof(TestRecord));
+    bpm->unpinPage(id, true);
+  }
+  const std::vector<std::string> backups = {
+      "test_bpm_backup.full", "test_bpm_backup.delta1",
+      "test_bpm_backup.delta2"};
+  EXPECT_FALSE(bpm->backupIncremental(PRIMARY_FILE_ID, backups[1]));
+  ASSERT_TRUE(bpm->backupFull(PRIMARY_FILE_ID, backups[0]));
+
+  setStamp(ids[3], 2);
+  setStamp(ids[7], 2);
+  ASSERT_TRUE(bpm->backupIncremental(PRIMARY_FILE_ID, backups[1]));
+  EXPECT_EQ(bpm->getChangedPages(), 0u);
+
+  setStamp(ids[7], 3);
+  page_id_t added;
+  Page *page = bpm->newPage(&added);
+  TestRecord rec = {4, "Added"};
+  page->insertRecord((char *)&rec, sizeof(TestRecord));
+  bpm->unpinPage(added, true);
+  ASSERT_TRUE(bpm->backupIncremental(PRIMARY_FILE_ID, backups[2]));
+
+  // the deltas hold only the changed pages
+  const std::size_t entry = sizeof(uint32_t) + PAGE_SIZE;
+  std::ifstream delta(backups[1], std::ios::binary | std::ios::ate);
+  EXPECT_EQ(static_cast<std::size_t>(delta.tellg()), 16 + 2 * entry);
+
+  const std::string restored = "test_bpm_restored.db";
+  EXPECT_FALSE(BufferPoolManager::restoreBackup({backups[1]}, restored));
+  ASSERT_TRUE(BufferPoolManager::restoreBackup(backups, restored));
+  {
+    BufferPoolManager copy(4, restored);
+    EXPECT_EQ(copy.getNumPages(), 51u);
+    ids.push_back(added);
+    for (page_id_t id : ids) {
+      Page *original = bpm->fetchPage(id);
+      Page *page = copy.fetchPage(id);
+      ASSERT_NE(page, nullptr);
+      EXPECT_EQ(((TestRecord *)page->getRecord(0))->id,
+                ((TestRecord *)original->getRecord(0))->id)
+          << id;
+      copy.unpinPage(page, false);
+      bpm->unpinPage(original, false);
+    }
+  }
+  std::remove(restored.c_str());
+  for (const std::string &file : backups) {
+    std::remove(file.c_str());
+  }
+}
+
+// ============ RESIZE TESTS ============
+
+class BufferPoolResizeTest : public ::testing::Test {
+protected:
+  std::string db_file = "test_bpm_resize.db";
+
+  void SetUp() override { std::remove(db_file.c_str()); }
+  void TearDown() override { std::remove(db_file.c_str()); }
+
+  // creates count pages whose first record holds their page id
+  static std::vector<page_id_t> stampPages(BufferPoolManager &pool,
+                                           int count) {
+    std::vector<page_id_t> ids(count);
+    for (page_id_t &id : ids) {
+      Page *page = pool.newPage(&id);
+      TestRecord rec = {static_cast<int>(id), "Stamp"};
+      page->insertRecord((char *)&rec, sizeof(TestRecord));
+      pool.unpinPage(id, true);
+    }
+    return ids;
+  }
+
+  static bool hasStamp(Page *page, page_id_t id) {
+    return page != nullptr &&
+           ((TestRecord *)page->getRecord(0))->id == static_cast<int>(id);
+  }
+};
+
+TEST_F(BufferPoolResizeTest, GrowAddsFrames) {
+  BufferPoolManager pool(3, db_file);
+  ASSERT_TRUE(pool.resize(300));
+  EXPECT_EQ(pool.getPoolSize(), 300u);
+
+  auto ids = stampPages(pool, 300);
+  pool.resetStats();
+  for (page_id_t id : ids) {
+    Page *page = pool.fetchPage(id);
+    EXPECT_TRUE(hasStamp(page, id));
+    pool.unpinPage(id, false);
+  }
+  EXPECT_EQ(pool.getStats().misses, 0u);
+}
+
+TEST_F(BufferPoolResizeTest, ShrinkKeepsPagesAndUnmapsChunks) {
+  BufferPoolManager pool(1024, db_file);
+  std::size_t full_memory = pool.getMemoryUsage();
+  auto ids = stampPages(pool, 600);
+
+  // a pinned page in a removed frame moves once it is unpinned
+  Page *pinned = pool.fetchPage(ids[500]);
+  ASSERT_NE(pinned, nullptr);
+  std::atomic<bool> done{false};
+  std::thread shrinker([&] {
+    EXPECT_TRUE(pool.resize(200));
+    done = true;
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_FALSE(done);
+  EXPECT_TRUE(hasStamp(pinned, ids[500])); // still valid while pinned
+  pool.unpinPage(ids[500], false);
+  shrinker.join();
+
+  EXPECT_EQ(pool.getPoolSize(), 200u);
+  EXPECT_LT(pool.getMemoryUsage(), full_memory / 2);
+  BufferPoolStats stats = pool.getStats();
+  EXPECT_GT(stats.migrations + stats.evictions, 0u);
+  for (page_id_t id : ids) {
+    Page *page = pool.fetchPage(id);
+    ASSERT_TRUE(hasStamp(page, id)) << id;
+    pool.unpinPage(id, false);
+  }
+  EXPECT_FALSE(pool.resize(0));
+}
+
+TEST_F(BufferPoolResizeTest, ResizeUnderConcurrentLoad) {
+  BufferPoolManager pool(512, db_file);
+  auto ids = stampPages(pool, 2000);
+  pool.setSwizzling(true);
+
+  std::atomic<bool> stop{false};
+  std::atomic<int> errors{0};
+  std::vector<std::thread> workers;
+  for (int t = 0; t < 4; t++) {
+    workers.emplace_back([&, t] {
+      std::mt19937 rng(t);
+      while (!stop) {
+        // a few hot parents with swizzled references to random children
+        Page *parent = pool.fetchPage(ids[rng() % 8]);
+        std::size_t child = rng() % 400;
+        Page *page = pool.fetchChild(parent, child, ids[child]);
+        if (!hasStamp(page, ids[child])) {
+          errors++;
+        }
+        if (page != nullptr) {
+          pool.unpinPage(page, false);
+        }
+        pool.unpinPage(parent, false);
+      }
+    });
+  }
+  for (std::size_t size : {64, 1024, 128, 700, 256, 512}) {
+    ASSERT_TRUE(pool.resize(size));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  }
+  stop = true;
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  EXPECT_EQ(errors, 0);
+  EXPECT_EQ(pool.getPoolSize(), 512u);
+  EXPECT_GT(pool.getStats().swizzled_hits, 0u);
+}
+
+TEST_F(BufferPoolResizeTest, ShrinkRespectsPartitionMinimums) {
+  BufferPoolManager pool(100, db_file);
+  ASSERT_NE(pool.createPartition("reserved", 60, 100), INVALID_PARTITION_ID);
+  EXPECT_FALSE(pool.resize(50));
+  EXPECT_TRUE(pool.resize(60));
+}
+
+TEST_F(BufferPoolResizeTest, ThreadsTakeFramesOfTheirNode) {
+  // two chunks of 256 frames, one per simulated node
+  BufferPoolManager pool(2 * 256, db_file);
+  EXPECT_FALSE(pool.configureNuma(0, true));
+  ASSERT_TRUE(pool.configureNuma(2, true));
+  EXPECT_EQ(pool.getNumaNodes(), 2u);
+  EXPECT_FALSE(pool.bindThreadToNode(2));
+
+  std::vector<std::thread> workers;
+  for (int node = 0; node < 2; node++) {
+    workers.emplace_back([&pool, node] {
+      ASSERT_TRUE(pool.bindThreadToNode(node));
+      for (int i = 0; i < 100; i++) {
+        page_id_t page_id;
+        ASSERT_NE(pool.newPage(&page_id), nullptr);
+        pool.unpinPage(page_id, true);
+      }
+    });
+  }
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  BufferPoolStats stats = pool.getStats();
+  EXPECT_EQ(stats.local_accesses, 200u);
+  EXPECT_EQ(stats.remote_accesses, 0u);
+}
+
+TEST_F(BufferPoolResizeTest, NodeWithoutFreeFramesBorrowsRemoteOnes) {
+  const std::size_t chunk = 256; // frames per chunk, i.e. per node
+  BufferPoolManager pool(2 * chunk, db_file);
+  ASSERT_TRUE(pool.configureNuma(2, true));
+  ASSERT_TRUE(pool.bindThreadToNode(0));
+  std::vector<page_id_t> ids(chunk + 10);
+  for (page_id_t &page_id : ids) {
+    ASSERT_NE(pool.newPage(&page_id), nullptr); // all stay pinned
+  }
+  BufferPoolStats stats = pool.getStats();
+  EXPECT_EQ(stats.local_accesses, chunk);
+  EXPECT_EQ(stats.remote_accesses, 10u);
+  for (page_id_t page_id : ids) {
+    pool.unpinPage(page_id, false);
+  }
+  ASSERT_TRUE(pool.bindThreadToNode(-1));
+}
+
+// ============ WARM RESTART TESTS ============
+
+class WarmRestartTest : public BufferPoolResizeTest {
+protected:
+  std::string hot_file = "test_bpm_hot_set.bin";
+
+  void SetUp() override {
+    BufferPoolResizeTest::SetUp();
+    std::remove(hot_file.c_str());
+  }
+  void TearDown() override {
+    BufferPoolResizeTest::TearDown();
+    std::remove(hot_file.c_str());
+  }
+};
+
+TEST_F(WarmRestartTest, PreloadRestoresHottestPagesWithOneRead) {
+  std::vector<page_id_t> ids;
+  {
+    BufferPoolManager pool(32, db_file);
+    ids = stampPages(pool, 100);
+    for (int round = 0; round < 3; round++) {
+      for (int i = 50; i < 70; i++) {
+        pool.unpinPage(pool.fetchPage(ids[i]), false);
+      }
+    }
+    ASSERT_TRUE(pool.dumpHotSet(hot_file));
+  }
+
+  // room for the 16 most recently used pages only
+  BufferPoolManager pool(16, db_file);
+  EXPECT_FALSE(pool.preloadHotSet("missing_hot_set.bin", false));
+  ASSERT_TRUE(pool.preloadHotSet(hot_file, false));
+  BufferPoolStats stats = pool.getStats();
+  EXPECT_EQ(stats.preloaded, 16u);
+  EXPECT_EQ(stats.disk_reads, 1u);
+
+  for (int i = 54; i < 70; i++) {
+    Page *page = pool.fetchPage(ids[i]);
+    EXPECT_TRUE(hasStamp(page, ids[i]));
+    pool.unpinPage(page, false);
+  }
+  stats = pool.getStats();
+  EXPECT_EQ(stats.hits, 16u);
+  EXPECT_EQ(stats.misses, 0u);
+}
+
+TEST_F(WarmRestartTest, BackgroundPreloadWhileServing) {
+  std::vector<page_id_t> ids;
+  {
+    BufferPoolManager pool(256, db_file);
+    ids = stampPages(pool, 200);
+    ASSERT_TRUE(pool.startHotSetDumps(hot_file,
+                                      std::chrono::milliseconds(5)));
+    EXPECT_FALSE(pool.startHotSetDumps(hot_file,
+                                       std::chrono::milliseconds(5)));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  } // the dump thread stops with the pool
+  std::ifstream dump(hot_file, std::ios::binary);
+  ASSERT_TRUE(dump.good());
+
+  BufferPoolManager pool(128, db_file);
+  ASSERT_TRUE(pool.preloadHotSet(hot_file, true));
+  // traffic races the loader; both must see intact pages
+  for (int i = 0; i < 200; i += 3) {
+    Page *page = pool.fetchPage(ids[i]);
+    EXPECT_TRUE(hasStamp(page, ids[i]));
+    pool.unpinPage(page, true);
+  }
+  pool.waitForPreload();
+  for (int i = 0; i < 200; i++) {
+    Page *page = pool.fetchPage(ids[i]);
+    EXPECT_TRUE(hasStamp(page, ids[i]));
+    pool.unpinPage(page, false);
+  }
+  EXPECT_GT(pool.getStats().preloaded, 0u);
+}
+
+TEST_F(WarmRestartTest, PreloadKeepsPagesDespiteUnrelatedWrites) {
+  const int hot = 2048;
+  std::vector<page_id_t> ids;
+  {
+    BufferPoolManager pool(hot, db_file);
+    ids = stampPages(pool, hot + 64);
+    for (int i = 0; i < hot; i++) {
+      pool.unpinPage(pool.fetchPage(ids[i]), false);
+    }
+    ASSERT_TRUE(pool.dumpHotSet(hot_file));
+  }
+
+  BufferPoolManager pool(2 * hot, db_file);
+  std::atomic<bool> stop{false};
+  std::atomic<int> writes{0};
+  // steady write-backs of pages outside the hot set
+  std::thread writer([&] {
+    for (int i = 0; !stop.load(); i = (i + 1) % 64) {
+      page_id_t page_id = ids[hot + i];
+      pool.unpinPage(pool.fetchPage(page_id), true);
+      pool.flushPage(page_id);
+      writes++;
+    }
+  });
+  while (writes.load() < 100) {
+    std::this_thread::yield();
+  }
+  ASSERT_TRUE(pool.preloadHotSet(hot_file, true));
+  pool.waitForPreload();
+  stop = true;
+  writer.join();
+
+  EXPECT_EQ(pool.getStats().preloaded, static_cast<std::size_t>(hot));
+  for (int i = 0; i < hot; i++) {
+    Page *page = pool.fetchPage(ids[i]);
+    EXPECT_TRUE(hasStamp(page, ids[i]));
+    pool.unpinPage(page, false);
+  }
+}
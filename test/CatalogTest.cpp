@@ -0,0 +1,157 @@
+#include "catalog/Catalog.hpp"
+#include <gtest/gtest.h>
+
+class CatalogTest : public ::testing::Test {
+protected:
+  std::string db_file = "test_catalog.db";
+  Schema users_schema{{Column("id", TypeId::INTEGER, false),
+                       Column("name", TypeId::VARCHAR),
+                       Column("score", TypeId::DOUBLE)}};
+
+  void SetUp() override { std::remove(db_file.c_str()); }
+
+  void TearDown() override { std::remove(db_file.c_str()); }
+};
+
+TEST_F(CatalogTest, BootstrapReservesHeaderPage) {
+  BufferPoolManager bpm(8, db_file);
+  Catalog catalog(&bpm);
+
+  ASSERT_TRUE(catalog.isValid());
+  EXPECT_EQ(catalog.getVersion(), 0u);
+  // header + sys_tables + sys_meta
+  EXPECT_EQ(bpm.getNumPages(), 3u);
+}
+
+TEST_F(CatalogTest, CreateAndGetTable) {
+  BufferPoolManager bpm(8, db_file);
+  Catalog catalog(&bpm);
+
+  TableInfo *created = catalog.createTable("users", users_schema);
+  ASSERT_NE(created, nullptr);
+  EXPECT_NE(created->root_page_id, INVALID_PAGE_ID);
+
+  // names are unique
+  EXPECT_EQ(catalog.createTable("users", users_schema), nullptr);
+
+  TableInfo *info = catalog.getTable("users");
+  ASSERT_EQ(info, created);
+  EXPECT_EQ(info->schema.getColumnCount(), 3u);
+  EXPECT_EQ(catalog.getTable("missing"), nullptr);
+}
+
+TEST_F(CatalogTest, PersistsAndLoadsLazily) {
+  page_id_t root_page_id;
+  {
+    BufferPoolManager bpm(8, db_file);
+    Catalog catalog(&bpm);
+    for (int i = 0; i < 200; i++) {
+      ASSERT_NE(catalog.createTable("t" + std::to_string(i), users_schema),
+                nullptr);
+    }
+    root_page_id = catalog.getTable("t42")->root_page_id;
+
+    IndexInfo index{"t42_pk", {0}, 77};
+    ASSERT_TRUE(catalog.createIndex("t42", index));
+    ASSERT_TRUE(catalog.updateStatistics("t42", {1000, 12}));
+  }
+
+  BufferPoolManager bpm(8, db_file);
+  Catalog catalog(&bpm);
+  ASSERT_TRUE(catalog.isValid());
+  EXPECT_EQ(catalog.getMetadataLoads(), 0u);
+
+  TableInfo *info = catalog.getTable("t42");
+  ASSERT_NE(info, nullptr);
+  // only the table that was asked for is decoded
+  EXPECT_EQ(catalog.getMetadataLoads(), 1u);
+
+  EXPECT_EQ(info->root_page_id, root_page_id);
+  EXPECT_EQ(info->schema.getColumn(1).name, "name");
+  EXPECT_EQ(info->schema.getType(2), TypeId::DOUBLE);
+  EXPECT_FALSE(info->schema.getColumn(0).nullable);
+  ASSERT_EQ(info->indexes.size(), 1u);
+  EXPECT_EQ(info->indexes[0].name, "t42_pk");
+  EXPECT_EQ(info->indexes[0].root_page_id, 77);
+  EXPECT_EQ(info->stats.row_count, 1000u);
+  EXPECT_EQ(info->stats.page_count, 12u);
+
+  EXPECT_EQ(catalog.getTableNames().size(), 200u);
+
+  // creating after reopening does not reuse pages of existing tables
+  TableInfo *extra = catalog.createTable("extra", users_schema);
+  ASSERT_NE(extra, nullptr);
+  EXPECT_GT(extra->root_page_id, root_page_id);
+}
+
+TEST_F(CatalogTest, DropTable) {
+  BufferPoolManager bpm(8, db_file);
+  Catalog catalog(&bpm);
+  catalog.createTable("users", users_schema);
+  uint64_t version = catalog.getVersion();
+
+  ASSERT_TRUE(catalog.dropTable("users"));
+  EXPECT_GT(catalog.getVersion(), version);
+  EXPECT_EQ(catalog.getTable("users"), nullptr);
+  EXPECT_FALSE(catalog.dropTable("users"));
+  EXPECT_NE(catalog.createTable("users", users_schema), nullptr);
+}
+
+TEST_F(CatalogTest, RefreshInvalidatesChangedTablesOnly) {
+  BufferPoolManager bpm(8, db_file);
+  Catalog reader(&bpm);
+  reader.createTable("a", users_schema);
+  reader.createTable("b", users_schema);
+
+  // a second catalog instance over the same pool changes table "b"
+  Catalog writer(&bpm);
+  ASSERT_TRUE(writer.updateStatistics("b", {5, 1}));
+  ASSERT_NE(writer.createTable("c", users_schema), nullptr);
+
+  TableInfo *a = reader.getTable("a");
+  EXPECT_EQ(reader.getTable("b")->stats.row_count, 0u); // still stale
+  std::size_t loads = reader.getMetadataLoads();
+
+  reader.refresh();
+  EXPECT_EQ(reader.getVersion(), writer.getVersion());
+  EXPECT_EQ(reader.getTable("a"), a); // unchanged entry kept
+  EXPECT_EQ(reader.getTable("b")->stats.row_count, 5u);
+  EXPECT_NE(reader.getTable("c"), nullptr);
+  EXPECT_EQ(reader.getMetadataLoads(), loads + 2);
+}
+
+TEST_F(CatalogTest, FailedMoveKeepsOldMetadata) {
+  BufferPoolManager bpm(8, db_file);
+  Catalog catalog(&bpm);
+  ASSERT_NE(catalog.createTable("a", users_schema), nullptr);
+  ASSERT_NE(catalog.createTable("b", users_schema), nullptr);
+  ASSERT_TRUE(catalog.createIndex("a", {std::string(2000, 'x'), {0}}));
+  uint64_t version = catalog.getVersion();
+
+  // every page pinned: the grown row can neither stay in place nor move to
+  // a new page
+  std::vector<page_id_t> pinned;
+  for (page_id_t page_id = 0;
+       page_id < static_cast<page_id_t>(bpm.getNumPages()); page_id++) {
+    ASSERT_NE(bpm.fetchPage(page_id), nullptr);
+    pinned.push_back(page_id);
+  }
+  page_id_t page_id;
+  while (bpm.newPage(&page_id) != nullptr) {
+    pinned.push_back(page_id);
+  }
+  EXPECT_FALSE(catalog.createIndex("a", {std::string(1500, 'y'), {1}}));
+  for (page_id_t id : pinned) {
+    bpm.unpinPage(id, false);
+  }
+
+  EXPECT_EQ(catalog.getVersion(), version);
+  EXPECT_EQ(catalog.getTable("a")->indexes.size(), 1u);
+
+  // the persisted rows are unchanged too
+  Catalog reopened(&bpm);
+  TableInfo *info = reopened.getTable("a");
+  ASSERT_NE(info, nullptr);
+  EXPECT_EQ(info->indexes.size(), 1u);
+  EXPECT_EQ(info->version, version);
+}
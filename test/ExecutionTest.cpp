@@ -0,0 +1,197 @@
+#include "execution/AggregateOperator.hpp"
+#include "execution/FilterOperator.hpp"
+#include "execution/LimitOperator.hpp"
+#include "execution/ProjectionOperator.hpp"
+#include "execution/SeqScanOperator.hpp"
+#include <gtest/gtest.h>
+
+class ExecutionTest : public ::testing::Test {
+protected:
+  BufferPoolManager *bpm;
+  TableHeap *heap;
+  std::string db_file = "test_execution.db";
+  Schema schema{{Column("id", TypeId::BIGINT, false),
+                 Column("category", TypeId::INTEGER),
+                 Column("price", TypeId::DOUBLE),
+                 Column("name", TypeId::VARCHAR)}};
+  static constexpr int kRows = 5000;
+
+  void SetUp() override {
+    std::remove(db_file.c_str());
+    bpm = new BufferPoolManager(16, db_file);
+    heap = new TableHeap(bpm);
+
+    // id = i, category = i % 10 (NULL when i % 100 == 99), price = i / 2
+    TupleBuilder builder(schema);
+    for (int i = 0; i < kRows; i++) {
+      builder.reset();
+      builder.setBigInt(0, i);
+      if (i % 100 != 99) {
+        builder.setInteger(1, i % 10);
+      }
+      builder.setDouble(2, i / 2.0);
+      builder.setVarchar(3, "item" + std::to_string(i));
+      ASSERT_TRUE(heap->insertTuple(builder));
+    }
+  }
+
+  void TearDown() override {
+    delete heap;
+    delete bpm;
+    std::remove(db_file.c_str());
+  }
+
+  std::unique_ptr<Operator> scan(std::vector<uint32_t> columns = {}) {
+    return std::make_unique<SeqScanOperator>(bpm, *heap, schema, columns);
+  }
+
+  // visible rows of all batches
+  std::size_t drain(Operator &op) {
+    DataChunk chunk(op.getOutputSchema());
+    std::size_t rows = 0;
+    while (op.next(chunk)) {
+      EXPECT_LE(chunk.getCount(), VECTOR_SIZE);
+      rows += chunk.getCount();
+    }
+    return rows;
+  }
+};
+
+TEST_F(ExecutionTest, ScanProducesBatches) {
+  SeqScanOperator op(bpm, *heap, schema);
+  DataChunk chunk(op.getOutputSchema());
+
+  ASSERT_TRUE(op.next(chunk));
+  EXPECT_EQ(chunk.getSize(), VECTOR_SIZE);
+  EXPECT_EQ(chunk.getColumn(0).getData<int64_t>()[17], 17);
+  EXPECT_EQ(chunk.getColumn(3).getString(17), "item17");
+  EXPECT_TRUE(chunk.getColumn(1).isNull(99));
+
+  std::size_t rows = chunk.getSize();
+  while (op.next(chunk)) {
+    rows += chunk.getSize();
+  }
+  EXPECT_EQ(rows, static_cast<std::size_t>(kRows));
+}
+
+TEST_F(ExecutionTest, ScanSubsetOfColumns) {
+  SeqScanOperator op(bpm, *heap, schema, {2, 0});
+  ASSERT_EQ(op.getOutputSchema().getColumnCount(), 2u);
+  EXPECT_EQ(op.getOutputSchema().getType(0), TypeId::DOUBLE);
+
+  DataChunk chunk(op.getOutputSchema());
+  ASSERT_TRUE(op.next(chunk));
+  EXPECT_DOUBLE_EQ(chunk.getColumn(0).getData<double>()[10], 5.0);
+  EXPECT_EQ(chunk.getColumn(1).getData<int64_t>()[10], 10);
+}
+
+TEST_F(ExecutionTest, FilterUsesSelectionVector) {
+  // category = 3 AND id < 1000 -> ids 3, 13, ..., 993
+  FilterOperator filter(
+      scan(), {{1, CompareOp::EQ, Value::integer32(3)},
+               {0, CompareOp::LT, Value::bigint(1000)}});
+
+  DataChunk chunk(filter.getOutputSchema());
+  ASSERT_TRUE(filter.next(chunk));
+  EXPECT_TRUE(chunk.hasSelection());
+  EXPECT_EQ(chunk.getSize(), VECTOR_SIZE); // rows were not moved
+  ASSERT_EQ(chunk.getCount(), 100u);
+  for (std::size_t i = 0; i < chunk.getCount(); i++) {
+    int64_t id = chunk.getColumn(0).getData<int64_t>()[chunk.getRowIndex(i)];
+    EXPECT_EQ(id % 10, 3);
+  }
+  EXPECT_FALSE(filter.next(chunk)); // later batches have no match
+}
+
+TEST_F(ExecutionTest, FilterSkipsNulls) {
+  FilterOperator filter(scan(), {{1, CompareOp::GE, Value::integer32(0)}});
+  EXPECT_EQ(drain(filter), static_cast<std::size_t>(kRows - kRows / 100));
+}
+
+TEST_F(ExecutionTest, FilterOnVarchar) {
+  FilterOperator filter(scan(), {{3, CompareOp::EQ, Value::string("item42")}});
+  EXPECT_EQ(drain(filter), 1u);
+}
+
+TEST_F(ExecutionTest, ProjectionAfterFilter) {
+  auto filter = std::make_unique<FilterOperator>(
+      scan(), std::vector<Predicate>{{0, CompareOp::GE, Value::bigint(4990)}});
+  ProjectionOperator projection(std::move(filter), {3, 0});
+
+  DataChunk chunk(projection.getOutputSchema());
+  ASSERT_TRUE(projection.next(chunk));
+  ASSERT_EQ(chunk.getCount(), 10u);
+  EXPECT_EQ(chunk.getColumn(0).getString(chunk.getRowIndex(0)), "item4990");
+  EXPECT_EQ(chunk.getColumn(1).getData<int64_t>()[chunk.getRowIndex(9)],
+            4999);
+  EXPECT_FALSE(projection.next(chunk));
+}
+
+TEST_F(ExecutionTest, LimitStopsEarly) {
+  LimitOperator limit(scan(), 1500);
+  EXPECT_EQ(drain(limit), 1500u);
+
+  auto filter = std::make_unique<FilterOperator>(
+      scan(), std::vector<Predicate>{{1, CompareOp::EQ, Value::integer32(7)}});
+  LimitOperator limited_filter(std::move(filter), 5);
+  EXPECT_EQ(drain(limited_filter), 5u);
+}
+
+TEST_F(ExecutionTest, UngroupedAggregates) {
+  auto filter = std::make_unique<FilterOperator>(
+      scan(), std::vector<Predicate>{{0, CompareOp::LT, Value::bigint(100)}});
+  AggregateOperator aggregate(std::move(filter),
+                              {{AggregateType::COUNT_STAR},
+                               {AggregateType::COUNT, 1},
+                               {AggregateType::SUM, 0},
+                               {AggregateType::MAX, 2},
+                               {AggregateType::MIN, 1}});
+
+  DataChunk chunk(aggregate.getOutputSchema());
+  ASSERT_TRUE(aggregate.next(chunk));
+  EXPECT_EQ(chunk.getColumn(0).getData<int64_t>()[0], 100);
+  EXPECT_EQ(chunk.getColumn(1).getData<int64_t>()[0], 99); // one NULL
+  EXPECT_EQ(chunk.getColumn(2).getData<int64_t>()[0], 4950);
+  EXPECT_DOUBLE_EQ(chunk.getColumn(3).getData<double>()[0], 49.5);
+  EXPECT_EQ(chunk.getColumn(4).getData<int32_t>()[0], 0);
+  EXPECT_FALSE(aggregate.next(chunk));
+}
+
+TEST_F(ExecutionTest, ScanUnpinsPages) {
+  {
+    SeqScanOperator op(bpm, *heap, schema);
+    drain(op);
+  }
+  // every page unpinned: the 16-frame pool can still hand out new pages
+  for (int i = 0; i < 16; i++) {
+    page_id_t page_id;
+    ASSERT_NE(bpm->newPage(&page_id), nullptr);
+  }
+}
+
+TEST_F(ExecutionTest, ScanFailurePassesThroughOperators) {
+  // every frame pinned by other pages: no table page can be fetched
+  std::vector<page_id_t> pinned;
+  page_id_t page_id;
+  while (bpm->newPage(&page_id) != nullptr) {
+    pinned.push_back(page_id);
+  }
+
+  auto filter = std::make_unique<FilterOperator>(
+      scan(), std::vector<Predicate>{
+                  {1, CompareOp::EQ, Value::integer32(3)}});
+  auto projection = std::make_unique<ProjectionOperator>(
+      std::move(filter), std::vector<uint32_t>{0});
+  LimitOperator limit(std::move(projection), 10);
+  EXPECT_EQ(drain(limit), 0u);
+  EXPECT_TRUE(limit.failed());
+
+  AggregateOperator aggregate(scan(), {{AggregateType::COUNT_STAR}});
+  DataChunk chunk(aggregate.getOutputSchema());
+  EXPECT_FALSE(aggregate.next(chunk));
+  EXPECT_TRUE(aggregate.failed());
+
+  for (page_id_t id : pinned) {
+    bpm->unpinPage(id, false);
+  }
+}
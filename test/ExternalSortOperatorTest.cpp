@@ -0,0 +1,179 @@
+#include "execution/ExternalSortOperator.hpp"
+#include "execution/SeqScanOperator.hpp"
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <tuple>
+
+class ExternalSortOperatorTest : public ::testing::Test {
+protected:
+  BufferPoolManager *bpm;
+  TableHeap *table;
+  std::string db_file = "test_external_sort.db";
+  Schema schema{{Column("id", TypeId::INTEGER, false),
+                 Column("score", TypeId::DOUBLE),
+                 Column("name", TypeId::VARCHAR)}};
+  static constexpr int kRows = 20000;
+
+  void SetUp() override {
+    std::remove(db_file.c_str());
+    bpm = new BufferPoolManager(128, db_file);
+    table = new TableHeap(bpm);
+
+    // scores repeat (and go negative) so ties fall through to the name key
+    TupleBuilder row(schema);
+    for (int i = 0; i < kRows; i++) {
+      int key = static_cast<int>((i * 7919LL) % kRows);
+      row.setInteger(0, key);
+      if (i % 97 == 3) {
+        row.setNull(1);
+      } else {
+        row.setDouble(1, (key % 50) - 25.5);
+      }
+      row.setVarchar(2, "name_" + std::to_string(kRows - key));
+      ASSERT_TRUE(table->insertTuple(row));
+    }
+  }
+
+  // pins all but frames frames of the pool with new pages
+  std::vector<page_id_t> pinAllBut(std::size_t frames) {
+    std::vector<page_id_t> pinned(bpm->getPoolSize() - frames);
+    for (page_id_t &page_id : pinned) {
+      EXPECT_NE(bpm->newPage(&page_id), nullptr);
+    }
+    return pinned;
+  }
+
+  void unpinAll(const std::vector<page_id_t> &pinned) {
+    for (page_id_t page_id : pinned) {
+      bpm->unpinPage(page_id, false);
+    }
+  }
+
+  void TearDown() override {
+    delete table;
+    delete bpm;
+    std::remove(db_file.c_str());
+  }
+
+  using Row = std::tuple<int32_t, bool, double, std::string>;
+
+  std::vector<Row> runSort(std::vector<SortKey> keys,
+                           std::size_t memory_budget,
+                           ExternalSortStats *stats,
+                           bool *failed = nullptr) {
+    ExternalSortOperator sort(
+        std::make_unique<SeqScanOperator>(bpm, *table, schema),
+        std::move(keys), bpm, memory_budget, 2);
+    std::vector<Row> result;
+    DataChunk chunk(sort.getOutputSchema());
+    while (sort.next(chunk)) {
+      for (std::size_t i = 0; i < chunk.getCount(); i++) {
+        std::size_t row = chunk.getRowIndex(i);
+        bool null_score = chunk.getColumn(1).isNull(row);
+        result.emplace_back(
+            chunk.getColumn(0).getData<int32_t>()[row], null_score,
+            null_score ? 0.0 : chunk.getColumn(1).getData<double>()[row],
+            std::string(chunk.getColumn(2).getString(row)));
+      }
+    }
+    *stats = sort.getStats();
+    if (failed != nullptr) {
+      *failed = sort.failed();
+    } else {
+      EXPECT_FALSE(sort.failed());
+    }
+    return result;
+  }
+};
+
+TEST_F(ExternalSortOperatorTest, InMemorySort) {
+  ExternalSortStats stats;
+  auto result = runSort({SortKey(0)}, 64 << 20, &stats);
+
+  EXPECT_EQ(stats.runs, 0u);
+  ASSERT_EQ(result.size(), static_cast<std::size_t>(kRows));
+  for (int i = 0; i < kRows; i++) {
+    EXPECT_EQ(std::get<0>(result[i]), i);
+  }
+}
+
+TEST_F(ExternalSortOperatorTest, SpilledSortMatchesInMemory) {
+  ExternalSortStats stats;
+  auto result = runSort({SortKey(0, false)}, 64 << 10, &stats);
+
+  EXPECT_GT(stats.runs, 1u);
+  EXPECT_EQ(stats.spilled_rows, static_cast<std::size_t>(kRows));
+  ASSERT_EQ(result.size(), static_cast<std::size_t>(kRows));
+  for (int i = 0; i < kRows; i++) {
+    EXPECT_EQ(std::get<0>(result[i]), kRows - 1 - i);
+  }
+}
+
+TEST_F(ExternalSortOperatorTest, MultiPassMergeWithNullsAndStrings) {
+  // score ASC (NULLs first), then name DESC
+  ExternalSortStats in_memory_stats;
+  auto expected = runSort({SortKey(1), SortKey(2, false)}, 64 << 20,
+                          &in_memory_stats);
+
+  // 16KB budget: fan-in of 2 runs, so several intermediate merges
+  ExternalSortStats stats;
+  auto result = runSort({SortKey(1), SortKey(2, false)}, 16 << 10, &stats);
+  EXPECT_GT(stats.runs, 2u);
+  EXPECT_GT(stats.merge_passes, 0u);
+  EXPECT_EQ(result, expected);
+
+  ASSERT_EQ(result.size(), static_cast<std::size_t>(kRows));
+  EXPECT_TRUE(std::get<1>(result.front()));
+  for (std::size_t i = 1; i < result.size(); i++) {
+    const Row &prev = result[i - 1];
+    const Row &cur = result[i];
+    if (std::get<1>(prev) != std::get<1>(cur)) {
+      EXPECT_TRUE(std::get<1>(prev)); // NULL block comes first
+      continue;
+    }
+    ASSERT_LE(std::get<2>(prev), std::get<2>(cur));
+    if (std::get<2>(prev) == std::get<2>(cur)) {
+      ASSERT_GE(std::get<3>(prev), std::get<3>(cur));
+    }
+  }
+}
+
+TEST_F(ExternalSortOperatorTest, TempPagesAreReleased) {
+  ExternalSortStats stats;
+  runSort({SortKey(2)}, 32 << 10, &stats);
+  ASSERT_GT(stats.runs, 1u);
+
+  // every run page unpinned and dropped: every frame can be reused
+  std::vector<page_id_t> ids(128);
+  for (page_id_t &page_id : ids) {
+    ASSERT_NE(bpm->newPage(&page_id), nullptr);
+  }
+}
+
+TEST_F(ExternalSortOperatorTest, FanInFitsInPinnableFrames) {
+  ExternalSortStats in_memory_stats;
+  auto expected = runSort({SortKey(0)}, 64 << 20, &in_memory_stats);
+
+  // the budget alone would merge every run at once (3 frames per run), the
+  // 8 free frames only fit 2 runs
+  auto pinned = pinAllBut(8);
+  ExternalSortStats stats;
+  auto result = runSort({SortKey(0)}, 256 << 10, &stats);
+  unpinAll(pinned);
+
+  EXPECT_GT(stats.runs, 2u);
+  EXPECT_GT(stats.merge_passes, 0u);
+  EXPECT_EQ(result, expected);
+}
+
+TEST_F(ExternalSortOperatorTest, PoolTooSmallToMergeFails) {
+  // 4 free frames cannot hold the windows of 2 runs
+  auto pinned = pinAllBut(4);
+  ExternalSortStats stats;
+  bool failed = false;
+  runSort({SortKey(0)}, 64 << 10, &stats, &failed);
+  unpinAll(pinned);
+
+  EXPECT_GT(stats.runs, 1u);
+  EXPECT_TRUE(failed);
+}
@@ -0,0 +1,196 @@
+#include "execution/HashAggregateOperator.hpp"
+#include <gtest/gtest.h>
+#include <map>
+
+class HashAggregateOperatorTest : public ::testing::Test {
+protected:
+  BufferPoolManager *bpm;
+  TableHeap *heap;
+  std::string db_file = "test_hash_aggregate.db";
+  Schema schema{{Column("id", TypeId::BIGINT, false),
+                 Column("group_key", TypeId::INTEGER),
+                 Column("value", TypeId::DOUBLE)}};
+  static constexpr int kRows = 30000;
+  static constexpr int kGroups = 5000;
+
+  struct Expected {
+    int64_t count = 0;
+    int64_t sum_id = 0;
+    double max_value = 0;
+  };
+  // key -1 stands for the NULL group
+  std::map<int64_t, Expected> expected;
+
+  void SetUp() override {
+    std::remove(db_file.c_str());
+    bpm = new BufferPoolManager(64, db_file);
+    heap = new TableHeap(bpm);
+
+    TupleBuilder builder(schema);
+    for (int i = 0; i < kRows; i++) {
+      int64_t key = (i * 7919LL) % kGroups;
+      builder.setBigInt(0, i);
+      if (i % 1000 == 999) {
+        key = -1;
+        builder.setNull(1);
+      } else {
+        builder.setInteger(1, static_cast<int32_t>(key));
+      }
+      double value = (i % 113) * 0.5;
+      builder.setDouble(2, value);
+      ASSERT_TRUE(heap->insertTuple(builder));
+
+      Expected &group = expected[key];
+      group.max_value = group.count == 0 ? value
+                                         : std::max(group.max_value, value);
+      group.count++;
+      group.sum_id += i;
+    }
+  }
+
+  void TearDown() override {
+    delete heap;
+    delete bpm;
+    std::remove(db_file.c_str());
+  }
+
+  void runAndCheck(std::size_t threads, std::size_t memory_budget,
+                   HashAggregateStats *stats) {
+    auto scan = std::make_unique<ParallelSeqScan>(
+        bpm, heap->getPageIds(), schema, std::vector<uint32_t>{},
+        std::vector<Predicate>{}, 2);
+    HashAggregateOperator aggregate(
+        std::move(scan), 1,
+        {{AggregateType::COUNT_STAR},
+         {AggregateType::SUM, 0},
+         {AggregateType::MAX, 2}},
+        threads, bpm, memory_budget);
+
+    std::map<int64_t, Expected> actual;
+    DataChunk chunk(aggregate.getOutputSchema());
+    while (aggregate.next(chunk)) {
+      for (std::size_t i = 0; i < chunk.getCount(); i++) {
+        int64_t key = chunk.getColumn(0).isNull(i)
+                          ? -1
+                          : chunk.getColumn(0).getData<int32_t>()[i];
+        EXPECT_EQ(actual.count(key), 0u) << "group emitted twice: " << key;
+        Expected &group = actual[key];
+        group.count = chunk.getColumn(1).getData<int64_t>()[i];
+        group.sum_id = chunk.getColumn(2).getData<int64_t>()[i];
+        group.max_value = chunk.getColumn(3).getData<double>()[i];
+      }
+    }
+    *stats = aggregate.getStats();
+    EXPECT_FALSE(aggregate.failed());
+
+    ASSERT_EQ(actual.size(), expected.size());
+    for (const auto &[key, group] : expected) {
+      EXPECT_EQ(actual[key].count, group.count) << key;
+      EXPECT_EQ(actual[key].sum_id, group.sum_id) << key;
+      EXPECT_EQ(actual[key].max_value, group.max_value) << key;
+    }
+  }
+};
+
+TEST_F(HashAggregateOperatorTest, GroupsMatchAcrossThreadCounts) {
+  for (std::size_t threads : {1, 2, 4}) {
+    HashAggregateStats stats;
+    runAndCheck(threads, 64 << 20, &stats);
+    EXPECT_EQ(stats.groups, expected.size());
+    EXPECT_EQ(stats.spilled_partitions, 0u);
+  }
+}
+
+TEST_F(HashAggregateOperatorTest, PreAggregationCombinesRows) {
+  HashAggregateStats stats;
+  runAndCheck(1, 64 << 20, &stats);
+  // 30000 rows collapse into partial groups before the merge phase
+  EXPECT_LT(stats.partial_groups, static_cast<std::size_t>(kRows));
+  EXPECT_GE(stats.partial_groups, expected.size());
+}
+
+TEST_F(HashAggregateOperatorTest, SpilledGroupsMatch) {
+  for (std::size_t threads : {1, 4}) {
+    HashAggregateStats stats;
+    runAndCheck(threads, 32 << 10, &stats);
+    EXPECT_GT(stats.spilled_partitions, 0u);
+    EXPECT_GT(stats.spilled_groups, 0u);
+    // merged a few partitions at a time, not all groups at once
+    EXPECT_LT(stats.peak_merged_groups, expected.size() / 2);
+  }
+
+  // every spill page dropped: all frames are free again
+  std::vector<page_id_t> ids(64);
+  for (page_id_t &page_id : ids) {
+    ASSERT_NE(bpm->newPage(&page_id), nullptr);
+  }
+}
+
+TEST_F(HashAggregateOperatorTest, SpillFailureIsReported) {
+  // the scanned pages stay resident, every other frame is pinned: no frame
+  // is left for a spill page
+  std::vector<page_id_t> input(heap->getPageIds().begin(),
+                               heap->getPageIds().begin() + 20);
+  std::vector<page_id_t> pinned = input;
+  for (page_id_t page_id : input) {
+    ASSERT_NE(bpm->fetchPage(page_id), nullptr);
+  }
+  page_id_t page_id;
+  while (bpm->newPage(&page_id) != nullptr) {
+    pinned.push_back(page_id);
+  }
+
+  auto scan = std::make_unique<ParallelSeqScan>(
+      bpm, input, schema, std::vector<uint32_t>{}, std::vector<Predicate>{},
+      2);
+  HashAggregateOperator aggregate(std::move(scan), 1,
+                                  {{AggregateType::COUNT_STAR}}, 1, bpm,
+                                  4 << 10);
+  DataChunk chunk(aggregate.getOutputSchema());
+  while (aggregate.next(chunk)) {
+  }
+  EXPECT_TRUE(aggregate.failed());
+
+  for (page_id_t id : pinned) {
+    bpm->unpinPage(id, false);
+  }
+}
+
+TEST_F(HashAggregateOperatorTest, ScanFailureIsReported) {
+  // every frame pinned by other pages: no table page can be fetched
+  std::vector<page_id_t> pinned;
+  page_id_t page_id;
+  while (bpm->newPage(&page_id) != nullptr) {
+    pinned.push_back(page_id);
+  }
+
+  auto scan = std::make_unique<ParallelSeqScan>(
+      bpm, heap->getPageIds(), schema, std::vector<uint32_t>{});
+  HashAggregateOperator aggregate(std::move(scan), 1,
+                                  {{AggregateType::COUNT_STAR}}, 4, bpm,
+                                  1 << 20);
+  DataChunk chunk(aggregate.getOutputSchema());
+  EXPECT_FALSE(aggregate.next(chunk));
+  EXPECT_TRUE(aggregate.failed());
+
+  for (page_id_t id : pinned) {
+    bpm->unpinPage(id, false);
+  }
+}
+
+TEST_F(HashAggregateOperatorTest, OversizedPartitionsAreSplit) {
+  // a budget below one partition's partial groups
+  std::size_t budget = 8 << 10;
+  for (std::size_t threads : {1, 4}) {
+    HashAggregateStats stats;
+    runAndCheck(threads, budget, &stats);
+    EXPECT_GT(stats.split_partitions, 0u);
+    std::size_t record_size = 2 * sizeof(int64_t) + 3 * sizeof(AggregateState);
+    EXPECT_LE(stats.peak_merged_groups * record_size, budget);
+  }
+
+  std::vector<page_id_t> ids(64);
+  for (page_id_t &page_id : ids) {
+    ASSERT_NE(bpm->newPage(&page_id), nullptr);
+  }
+}
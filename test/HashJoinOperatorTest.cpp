@@ -0,0 +1,210 @@
+#include "execution/HashJoinOperator.hpp"
+#include "execution/RowConversion.hpp"
+#include <algorithm>
+#include <gtest/gtest.h>
+
+class HashJoinOperatorTest : public ::testing::Test {
+protected:
+  BufferPoolManager *bpm;
+  TableHeap *orders;
+  TableHeap *customers;
+  std::string db_file = "test_hash_join.db";
+  Schema customer_schema{{Column("customer_id", TypeId::INTEGER),
+                          Column("name", TypeId::VARCHAR)}};
+  Schema order_schema{{Column("order_id", TypeId::BIGINT, false),
+                       Column("customer_id", TypeId::BIGINT)}};
+  static constexpr int kCustomers = 3000;
+  static constexpr int kOrders = 8000;
+
+  void SetUp() override {
+    std::remove(db_file.c_str());
+    bpm = new BufferPoolManager(64, db_file);
+    customers = new TableHeap(bpm);
+    orders = new TableHeap(bpm);
+
+    // customer ids 0..2999, every id below 100 appears twice, one NULL id
+    TupleBuilder customer(customer_schema);
+    for (int i = 0; i < kCustomers; i++) {
+      customer.setInteger(0, i);
+      customer.setVarchar(1, "customer" + std::to_string(i));
+      ASSERT_TRUE(customers->insertTuple(customer));
+      if (i < 100) {
+        ASSERT_TRUE(customers->insertTuple(customer));
+      }
+    }
+    customer.setNull(0);
+    ASSERT_TRUE(customers->insertTuple(customer));
+
+    // orders reference ids 0..3999, ids >= 3000 have no customer
+    TupleBuilder order(order_schema);
+    for (int i = 0; i < kOrders; i++) {
+      order.setBigInt(0, i);
+      if (i % 500 == 7) {
+        order.setNull(1);
+      } else {
+        order.setBigInt(1, (i * 7) % 4000);
+      }
+      ASSERT_TRUE(orders->insertTuple(order));
+    }
+  }
+
+  void TearDown() override {
+    delete orders;
+    delete customers;
+    delete bpm;
+    std::remove(db_file.c_str());
+  }
+
+  // (order_id, customer name) pairs produced by the join
+  std::vector<std::pair<int64_t, std::string>>
+  runJoin(std::size_t memory_budget, HashJoinStats *stats,
+          bool *failed = nullptr) {
+    HashJoinOperator join(
+        std::make_unique<SeqScanOperator>(bpm, *customers, customer_schema),
+        std::make_unique<SeqScanOperator>(bpm, *orders, order_schema), 0, 1,
+        bpm, memory_budget);
+
+    EXPECT_EQ(join.getOutputSchema().getColumnCount(), 4u);
+    std::vector<std::pair<int64_t, std::string>> result;
+    DataChunk chunk(join.getOutputSchema());
+    while (join.next(chunk)) {
+      for (std::size_t i = 0; i < chunk.getCount(); i++) {
+        std::size_t row = chunk.getRowIndex(i);
+        EXPECT_EQ(chunk.getColumn(0).getData<int32_t>()[row],
+                  chunk.getColumn(3).getData<int64_t>()[row]);
+        result.emplace_back(chunk.getColumn(2).getData<int64_t>()[row],
+                            std::string(chunk.getColumn(1).getString(row)));
+      }
+    }
+    *stats = join.getStats();
+    if (failed != nullptr) {
+      *failed = join.failed();
+    } else {
+      EXPECT_FALSE(join.failed());
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+  }
+
+  std::size_t expectedRows() {
+    std::size_t rows = 0;
+    for (int i = 0; i < kOrders; i++) {
+      int key = (i * 7) % 4000;
+      if (i % 500 != 7 && key < kCustomers) {
+        rows += key < 100 ? 2 : 1;
+      }
+    }
+    return rows;
+  }
+};
+
+TEST_F(HashJoinOperatorTest, InMemoryJoin) {
+  HashJoinStats stats;
+  auto result = runJoin(64 << 20, &stats);
+
+  EXPECT_EQ(result.size(), expectedRows());
+  EXPECT_EQ(stats.spilled_partitions, 0u);
+  for (const auto &match : result) {
+    EXPECT_EQ(match.second,
+              "customer" + std::to_string((match.first * 7) % 4000));
+  }
+}
+
+TEST_F(HashJoinOperatorTest, SpilledJoinMatchesInMemory) {
+  HashJoinStats in_memory_stats;
+  auto expected = runJoin(64 << 20, &in_memory_stats);
+
+  HashJoinStats stats;
+  auto result = runJoin(16 << 10, &stats); // ~1/10 of the build side
+
+  EXPECT_GT(stats.spilled_partitions, 0u);
+  EXPECT_GT(stats.spilled_build_rows, 0u);
+  EXPECT_GT(stats.spilled_probe_rows, 0u);
+  EXPECT_EQ(result, expected);
+}
+
+TEST_F(HashJoinOperatorTest, TempPagesAreReleased) {
+  HashJoinStats stats;
+  runJoin(16 << 10, &stats);
+  ASSERT_GT(stats.spilled_partitions, 0u);
+
+  // all spill pages unpinned and dropped: every frame can be reused
+  std::vector<page_id_t> ids(64);
+  for (page_id_t &page_id : ids) {
+    ASSERT_NE(bpm->newPage(&page_id), nullptr);
+  }
+}
+
+TEST_F(HashJoinOperatorTest, OversizedPartitionsAreRepartitioned) {
+  HashJoinStats in_memory_stats;
+  auto expected = runJoin(64 << 20, &in_memory_stats);
+
+  // every one of the 16 partitions is larger than the whole budget
+  HashJoinStats stats;
+  auto result = runJoin(2 << 10, &stats);
+
+  EXPECT_GT(stats.repartitioned, 0u);
+  EXPECT_EQ(result, expected);
+
+  // the nested joins' spill pages are dropped too
+  std::vector<page_id_t> ids(64);
+  for (page_id_t &page_id : ids) {
+    ASSERT_NE(bpm->newPage(&page_id), nullptr);
+  }
+}
+
+TEST_F(HashJoinOperatorTest, SpillFailureIsReported) {
+  // leave a handful of frames: not enough for one spill page per partition
+  std::vector<page_id_t> pinned;
+  page_id_t page_id;
+  while (pinned.size() < 60 && bpm->newPage(&page_id) != nullptr) {
+    pinned.push_back(page_id);
+  }
+
+  HashJoinStats stats;
+  bool failed = false;
+  runJoin(16 << 10, &stats, &failed);
+  EXPECT_TRUE(failed);
+
+  for (page_id_t id : pinned) {
+    bpm->unpinPage(id, false);
+  }
+}
+
+TEST(JoinHashTableTest, DuplicateKeysShareOneEntry) {
+  // one heavily skewed key next to distinct ones
+  const uint32_t kSkewed = 50000;
+  const uint32_t kDistinct = 1000;
+  JoinHashTable table;
+  table.reset(kSkewed + kDistinct);
+  for (uint32_t row = 0; row < kSkewed; row++) {
+    table.insert(42, hashKey(42), row);
+  }
+  for (uint32_t i = 0; i < kDistinct; i++) {
+    int64_t key = 1000 + i;
+    table.insert(key, hashKey(key), kSkewed + i);
+  }
+
+  std::vector<uint32_t> rows;
+  table.forEachMatch(42, hashKey(42), [&](uint32_t row) {
+    rows.push_back(row);
+  });
+  std::sort(rows.begin(), rows.end());
+  ASSERT_EQ(rows.size(), kSkewed);
+  for (uint32_t row = 0; row < kSkewed; row++) {
+    EXPECT_EQ(rows[row], row);
+  }
+
+  for (uint32_t i = 0; i < kDistinct; i++) {
+    int64_t key = 1000 + i;
+    std::size_t matches = 0;
+    table.forEachMatch(key, hashKey(key), [&](uint32_t row) {
+      EXPECT_EQ(row, kSkewed + i);
+      matches++;
+    });
+    EXPECT_EQ(matches, 1u);
+  }
+  std::size_t missing = 0;
+  table.forEachMatch(7, hashKey(7), [&](uint32_t) { missing++; });
+  EXPECT_EQ(missing, 0u);
+}
@@ -0,0 +1,173 @@
+#include "buffer/LogFollower.hpp"
+#include <cstring>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+class LogFollowerTest : public ::testing::Test {
+protected:
+  std::string primary_file = "test_log_primary.db";
+  std::string replica_file = "test_log_replica.db";
+  std::string log_file = "test_log_pages.log";
+
+  void SetUp() override { removeFiles(); }
+  void TearDown() override { removeFiles(); }
+
+  void removeFiles() {
+    for (const std::string &file : {primary_file, replica_file, log_file}) {
+      std::remove(file.c_str());
+    }
+  }
+
+  // stamp stored at the start of a page
+  static int stampOf(Page *page) {
+    int stamp;
+    std::memcpy(&stamp, page->getData(), sizeof(stamp));
+    return stamp;
+  }
+
+  static void setStamp(BufferPoolManager &bpm, page_id_t page_id,
+                       int stamp) {
+    Page *page = bpm.fetchPage(page_id);
+    std::memcpy(page->getData(), &stamp, sizeof(stamp));
+    bpm.unpinPage(page, true);
+  }
+};
+
+TEST_F(LogFollowerTest, ChangesBecomeVisibleAtSyncPoints) {
+  BufferPoolManager primary(8, primary_file);
+  page_id_t page_id;
+  primary.newPage(&page_id);
+  primary.unpinPage(page_id, true);
+  setStamp(primary, page_id, 1);
+  ASSERT_TRUE(primary.enableLogShipping(log_file));
+  EXPECT_FALSE(primary.enableLogShipping(log_file));
+
+  LogFollower follower(log_file, 8, replica_file);
+  ASSERT_TRUE(follower.isOpen());
+  EXPECT_EQ(follower.poll(), 1u); // the base image
+  EXPECT_EQ(follower.getStatus().applied_lsn, primary.getLastLsn());
+
+  // written to disk and shipped, but not yet at a sync point
+  setStamp(primary, page_id, 2);
+  primary.flushPage(page_id);
+  EXPECT_EQ(follower.poll(), 0u);
+  BufferPoolManager *replica = follower.getBufferPool();
+  {
+    auto lock = follower.readLock();
+    Page *page = replica->fetchPage(page_id);
+    EXPECT_EQ(stampOf(page), 1);
+    replica->unpinPage(page, false);
+  }
+
+  uint64_t lsn = primary.logSyncPoint();
+  EXPECT_EQ(follower.poll(), 1u);
+  ReplicationStatus status = follower.getStatus();
+  EXPECT_EQ(status.applied_lsn, lsn);
+  EXPECT_EQ(status.read_lsn, lsn);
+  EXPECT_EQ(status.sync_points, 2u);
+  EXPECT_GE(status.lag_seconds, 0);
+  auto lock = follower.readLock();
+  Page *page = replica->fetchPage(page_id);
+  EXPECT_EQ(stampOf(page), 2);
+  replica->unpinPage(page, false);
+}
+
+TEST_F(LogFollowerTest, BatchLargerThanPendingCapIsApplied) {
+  BufferPoolManager primary(8, primary_file);
+  std::vector<page_id_t> ids(20);
+  for (page_id_t &page_id : ids) {
+    primary.newPage(&page_id);
+    primary.unpinPage(page_id, true);
+  }
+  ASSERT_TRUE(primary.enableLogShipping(log_file));
+
+  // room for two buffered images, the rest is read back from the log
+  LogFollower follower(log_file, 32, replica_file, 2 * PAGE_SIZE);
+  ASSERT_TRUE(follower.isOpen());
+  EXPECT_EQ(follower.poll(), 1u);
+
+  for (int round = 0; round < 2; round++) {
+    for (std::size_t i = 0; i < ids.size(); i++) {
+      setStamp(primary, ids[i], static_cast<int>(100 * round + i));
+      primary.flushPage(ids[i]);
+    }
+  }
+  primary.logSyncPoint();
+  EXPECT_EQ(follower.poll(), 1u);
+
+  auto lock = follower.readLock();
+  BufferPoolManager *replica = follower.getBufferPool();
+  for (std::size_t i = 0; i < ids.size(); i++) {
+    Page *page = replica->fetchPage(ids[i]);
+    ASSERT_NE(page, nullptr);
+    EXPECT_EQ(stampOf(page), static_cast<int>(100 + i));
+    replica->unpinPage(page, false);
+  }
+}
+
+TEST_F(LogFollowerTest, FollowerProcessSeesConsistentSyncPoints) {
+  constexpr int kPages = 20;
+  constexpr int kRounds = 30;
+  std::ofstream(log_file).close(); // exists before the follower opens it
+
+  pid_t child = fork();
+  ASSERT_GE(child, 0);
+  if (child == 0) {
+    // primary: every round stamps all pages, and the small pool writes
+    // some of them out (and ships them) before the round's sync point
+    BufferPoolManager primary(4, primary_file);
+    for (int i = 0; i < kPages; i++) {
+      page_id_t page_id;
+      primary.newPage(&page_id);
+      primary.unpinPage(page_id, true);
+      // the base image is round 0, not whatever a fresh page starts with
+      setStamp(primary, page_id, 0);
+    }
+    primary.enableLogShipping(log_file);
+    for (int round = 1; round <= kRounds; round++) {
+      for (int i = 0; i < kPages; i++) {
+        setStamp(primary, static_cast<page_id_t>(i), round);
+      }
+      primary.logSyncPoint();
+      usleep(1000);
+    }
+    _exit(0);
+  }
+
+  LogFollower follower(log_file, 8, replica_file);
+  BufferPoolManager *replica = follower.getBufferPool();
+  bool primary_done = false;
+  int status = 0;
+  int last_round = 0;
+  while (true) {
+    if (!primary_done) {
+      primary_done = waitpid(child, &status, WNOHANG) == child;
+    }
+    // once the primary is done, a poll that applies nothing saw it all
+    bool caught_up = follower.poll() == 0 && primary_done;
+    if (follower.getStatus().sync_points > 0) {
+      // a query sees every page from the same round
+      auto lock = follower.readLock();
+      int round = -1;
+      for (int i = 0; i < kPages; i++) {
+        Page *page = replica->fetchPage(static_cast<page_id_t>(i));
+        ASSERT_NE(page, nullptr);
+        round = i == 0 ? stampOf(page) : round;
+        EXPECT_EQ(stampOf(page), round) << "page " << i;
+        replica->unpinPage(page, false);
+      }
+      EXPECT_GE(round, last_round);
+      last_round = round;
+    }
+    if (caught_up) {
+      break;
+    }
+    usleep(200);
+  }
+  EXPECT_EQ(WEXITSTATUS(status), 0);
+  EXPECT_EQ(last_round, kRounds);
+  EXPECT_EQ(follower.getStatus().sync_points,
+            static_cast<std::size_t>(kRounds + 1));
+}
@@ -0,0 +1,245 @@
+#include "catalog/Catalog.hpp"
+#include "lsm/LsmTree.hpp"
+#include <gtest/gtest.h>
+#include <map>
+#include <random>
+
+class LsmTreeTest : public ::testing::Test {
+protected:
+  BufferPoolManager *bpm;
+  std::string db_file = "test_lsm_tree.db";
+  page_id_t manifest_page_id;
+
+  void SetUp() override {
+    std::remove(db_file.c_str());
+    bpm = new BufferPoolManager(64, db_file);
+    bpm->newPage(&manifest_page_id);
+    bpm->unpinPage(manifest_page_id, true);
+  }
+
+  void TearDown() override {
+    delete bpm;
+    std::remove(db_file.c_str());
+  }
+
+  // tiny memtable and levels so a few thousand keys compact several times
+  static LsmOptions smallOptions(CompactionStyle style, bool background) {
+    LsmOptions options;
+    options.memtable_bytes = 16 << 10;
+    options.l0_compaction_trigger = 3;
+    options.level_base_bytes = 64 << 10;
+    options.level_ratio = 4;
+    options.style = style;
+    options.background = background;
+    return options;
+  }
+
+  static std::string valueFor(int64_t key, int round) {
+    return "v" + std::to_string(key) + "_" + std::to_string(round);
+  }
+
+  // random puts and removes, checked against a std::map
+  void runWorkload(LsmTree &tree, std::map<int64_t, std::string> &model) {
+    std::mt19937 rng(7);
+    for (int round = 0; round < 3; round++) {
+      for (int i = 0; i < 4000; i++) {
+        int64_t key = rng() % 5000;
+        if (rng() % 5 == 0) {
+          ASSERT_TRUE(tree.remove(key));
+          model.erase(key);
+        } else {
+          ASSERT_TRUE(tree.put(key, valueFor(key, round)));
+          model[key] = valueFor(key, round);
+        }
+      }
+    }
+  }
+
+  void expectContents(LsmTree &tree,
+                      const std::map<int64_t, std::string> &model) {
+    std::string value;
+    for (int64_t key = 0; key < 5000; key++) {
+      auto it = model.find(key);
+      if (it == model.end()) {
+        EXPECT_FALSE(tree.get(key, &value)) << key;
+      } else {
+        ASSERT_TRUE(tree.get(key, &value)) << key;
+        EXPECT_EQ(value, it->second);
+      }
+    }
+
+    auto expected = model.lower_bound(100);
+    tree.scan(100, 3000, [&](int64_t key, std::string_view v) {
+      ASSERT_NE(expected, model.end());
+      EXPECT_EQ(key, expected->first);
+      EXPECT_EQ(v, expected->second);
+      ++expected;
+    });
+    EXPECT_EQ(expected, model.upper_bound(3000));
+  }
+};
+
+TEST_F(LsmTreeTest, PutGetRemoveInMemTable) {
+  LsmTree tree(bpm, manifest_page_id);
+  std::string value;
+
+  EXPECT_FALSE(tree.get(1, &value));
+  ASSERT_TRUE(tree.put(1, "one"));
+  ASSERT_TRUE(tree.put(2, "two"));
+  ASSERT_TRUE(tree.put(1, "uno"));
+  ASSERT_TRUE(tree.get(1, &value));
+  EXPECT_EQ(value, "uno");
+
+  ASSERT_TRUE(tree.remove(2));
+  EXPECT_FALSE(tree.get(2, &value));
+  EXPECT_EQ(tree.getStats().flushes, 0u);
+}
+
+TEST_F(LsmTreeTest, LeveledCompactionKeepsNewestVersions) {
+  std::map<int64_t, std::string> model;
+  LsmTree tree(bpm, manifest_page_id,
+               smallOptions(CompactionStyle::LEVELED, false));
+  runWorkload(tree, model);
+  tree.flush();
+  tree.waitForCompactions();
+
+  LsmStats stats = tree.getStats();
+  EXPECT_GT(stats.flushes, 3u);
+  EXPECT_GT(stats.compactions, 0u);
+  std::vector<std::size_t> runs = tree.getRunsPerLevel();
+  ASSERT_GT(runs.size(), 1u);
+  EXPECT_LT(runs[0], 3u);
+  for (std::size_t level = 1; level < runs.size(); level++) {
+    EXPECT_LE(runs[level], 1u) << level;
+  }
+  expectContents(tree, model);
+}
+
+TEST_F(LsmTreeTest, TieredCompactionInBackground) {
+  std::map<int64_t, std::string> model;
+  LsmTree tree(bpm, manifest_page_id,
+               smallOptions(CompactionStyle::TIERED, true));
+  runWorkload(tree, model);
+  tree.flush();
+  tree.waitForCompactions();
+
+  EXPECT_GT(tree.getStats().compactions, 0u);
+  for (std::size_t runs : tree.getRunsPerLevel()) {
+    EXPECT_LT(runs, 3u);
+  }
+  expectContents(tree, model);
+}
+
+TEST_F(LsmTreeTest, BloomFiltersSkipRunsForAbsentKeys) {
+  LsmTree tree(bpm, manifest_page_id,
+               smallOptions(CompactionStyle::TIERED, false));
+  for (int64_t key = 0; key < 3000; key++) {
+    ASSERT_TRUE(tree.put(key * 2, valueFor(key, 0)));
+  }
+  tree.flush();
+
+  std::string value;
+  for (int64_t key = 0; key < 3000; key++) {
+    EXPECT_FALSE(tree.get(key * 2 + 1, &value));
+  }
+  LsmReadCost reads = tree.getStats().reads;
+  EXPECT_GT(reads.runs_probed, 0u);
+  // most probes of absent keys end at the filter
+  EXPECT_LT(reads.pages_read, reads.runs_probed / 10);
+}
+
+TEST_F(LsmTreeTest, UnreadableRunFailsGetAndScan) {
+  LsmTree tree(bpm, manifest_page_id,
+               smallOptions(CompactionStyle::LEVELED, false));
+  ASSERT_TRUE(tree.put(1, "old"));
+  tree.flush();
+  ASSERT_TRUE(tree.put(1, "new"));
+  tree.flush();
+
+  // the older run (first page after the manifest) stays readable, every
+  // other frame is pinned so the newer run cannot be fetched
+  page_id_t older = manifest_page_id + 1;
+  ASSERT_NE(bpm->fetchPage(older), nullptr);
+  std::vector<page_id_t> pinned;
+  page_id_t page_id;
+  while (bpm->newPage(&page_id) != nullptr) {
+    pinned.push_back(page_id);
+  }
+
+  std::string value;
+  EXPECT_FALSE(tree.get(1, &value));
+  EXPECT_TRUE(value.empty()) << "read the overwritten value";
+  std::vector<std::string> seen;
+  EXPECT_FALSE(tree.scan(0, 10, [&](int64_t, std::string_view v) {
+    seen.emplace_back(v);
+  }));
+  EXPECT_TRUE(seen.empty());
+  EXPECT_EQ(tree.getStats().read_errors, 2u);
+
+  for (page_id_t id : pinned) {
+    bpm->unpinPage(id, false);
+  }
+  bpm->unpinPage(older, false);
+  ASSERT_TRUE(tree.get(1, &value));
+  EXPECT_EQ(value, "new");
+  EXPECT_TRUE(tree.scan(0, 10, [&](int64_t, std::string_view v) {
+    seen.emplace_back(v);
+  }));
+  EXPECT_EQ(seen, std::vector<std::string>{"new"});
+}
+
+TEST_F(LsmTreeTest, EntryLargerThanPageRejected) {
+  SSTableBuilder builder(bpm, 1);
+  ASSERT_TRUE(builder.add(1, false, "small"));
+  // 64 KB + 10 bytes would wrap to a short uint16 record length
+  EXPECT_FALSE(builder.add(2, false, std::string(65536 + 10, 'x')));
+  EXPECT_EQ(builder.finish(10), nullptr);
+}
+
+TEST_F(LsmTreeTest, ReopensFromManifest) {
+  std::map<int64_t, std::string> model;
+  {
+    LsmTree tree(bpm, manifest_page_id,
+                 smallOptions(CompactionStyle::LEVELED, true));
+    runWorkload(tree, model);
+    // the destructor flushes the memtable and writes the manifest
+  }
+  delete bpm;
+  bpm = new BufferPoolManager(64, db_file);
+
+  LsmTree tree(bpm, manifest_page_id,
+               smallOptions(CompactionStyle::LEVELED, true));
+  EXPECT_GT(tree.getRunsPerLevel().size(), 0u);
+  expectContents(tree, model);
+}
+
+TEST_F(LsmTreeTest, CatalogRecordsStorageEngine) {
+  // the catalog needs a brand new file: drop the fixture's manifest page
+  delete bpm;
+  std::remove(db_file.c_str());
+  bpm = new BufferPoolManager(64, db_file);
+  Schema schema({Column("id", TypeId::BIGINT, false),
+                 Column("payload", TypeId::VARCHAR)});
+  {
+    Catalog catalog(bpm);
+    TableInfo *events =
+        catalog.createTable("events", schema, StorageEngine::LSM);
+    ASSERT_NE(events, nullptr);
+    ASSERT_NE(catalog.createTable("users", schema), nullptr);
+    // the root page of an LSM table is its manifest
+    LsmTree tree(bpm, events->root_page_id);
+    ASSERT_TRUE(tree.put(42, "answer"));
+  }
+  delete bpm;
+  bpm = new BufferPoolManager(64, db_file);
+
+  Catalog catalog(bpm);
+  EXPECT_EQ(catalog.getTable("users")->engine, StorageEngine::HEAP);
+  TableInfo *info = catalog.getTable("events");
+  ASSERT_NE(info, nullptr);
+  EXPECT_EQ(info->engine, StorageEngine::LSM);
+  LsmTree tree(bpm, info->root_page_id);
+  std::string value;
+  ASSERT_TRUE(tree.get(42, &value));
+  EXPECT_EQ(value, "answer");
+}
@@ -0,0 +1,109 @@
+#include "lsm/MemTable.hpp"
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <limits>
+#include <random>
+#include <thread>
+#include <vector>
+
+class MemTableTest : public ::testing::Test {
+protected:
+  MemTable table;
+};
+
+TEST_F(MemTableTest, PutGetAndOverwrite) {
+  std::string value;
+  EXPECT_EQ(table.get(5, &value), LsmLookup::ABSENT);
+
+  table.put(5, "five", false);
+  table.put(-3, "minus three", false);
+  ASSERT_EQ(table.get(5, &value), LsmLookup::FOUND);
+  EXPECT_EQ(value, "five");
+
+  table.put(5, "FIVE", false);
+  ASSERT_EQ(table.get(5, &value), LsmLookup::FOUND);
+  EXPECT_EQ(value, "FIVE");
+  EXPECT_EQ(table.size(), 2u);
+
+  table.put(-3, "", true);
+  EXPECT_EQ(table.get(-3, &value), LsmLookup::DELETED);
+  EXPECT_EQ(table.get(4, &value), LsmLookup::ABSENT);
+}
+
+TEST_F(MemTableTest, IteratesInKeyOrder) {
+  std::mt19937 rng(3);
+  std::vector<int64_t> keys;
+  for (int64_t i = 0; i < 10000; i++) {
+    keys.push_back(i * 2);
+  }
+  std::shuffle(keys.begin(), keys.end(), rng);
+  for (int64_t key : keys) {
+    table.put(key, std::to_string(key), false);
+  }
+
+  int64_t expected = 100;
+  table.forEach(99, 1000,
+                [&](int64_t key, bool tombstone, std::string_view value) {
+                  EXPECT_EQ(key, expected);
+                  EXPECT_FALSE(tombstone);
+                  EXPECT_EQ(value, std::to_string(key));
+                  expected += 2;
+                });
+  EXPECT_EQ(expected, 1002);
+}
+
+TEST_F(MemTableTest, ArenaAccountsForValues) {
+  std::size_t before = table.getMemoryUsage();
+  std::string big(100000, 'x'); // larger than an arena block
+  table.put(1, big, false);
+  EXPECT_GE(table.getMemoryUsage() - before, big.size());
+
+  std::string value;
+  ASSERT_EQ(table.get(1, &value), LsmLookup::FOUND);
+  EXPECT_EQ(value, big);
+}
+
+TEST_F(MemTableTest, ConcurrentInsertsAndReads) {
+  constexpr int kThreads = 8;
+  constexpr int64_t kPerThread = 20000;
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; t++) {
+    threads.emplace_back([&, t] {
+      // interleaved key ranges, plus one key every thread overwrites
+      for (int64_t i = 0; i < kPerThread; i++) {
+        int64_t key = i * kThreads + t;
+        table.put(key, std::to_string(key), false);
+        table.put(-1, std::to_string(t), false);
+      }
+    });
+  }
+  // a reader walking the list while it grows sees sorted keys
+  threads.emplace_back([&] {
+    for (int pass = 0; pass < 20; pass++) {
+      int64_t last = std::numeric_limits<int64_t>::min();
+      table.forEach(std::numeric_limits<int64_t>::min(),
+                    std::numeric_limits<int64_t>::max(),
+                    [&](int64_t key, bool, std::string_view) {
+                      EXPECT_GT(key, last);
+                      last = key;
+                    });
+    }
+  });
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(table.size(), static_cast<std::size_t>(kThreads * kPerThread + 1));
+  std::string value;
+  for (int64_t key = 0; key < kThreads * kPerThread; key++) {
+    ASSERT_EQ(table.get(key, &value), LsmLookup::FOUND) << key;
+    EXPECT_EQ(value, std::to_string(key));
+  }
+  int64_t expected = -1;
+  table.forEach(-1, kThreads * kPerThread,
+                [&](int64_t key, bool, std::string_view) {
+                  EXPECT_EQ(key, expected++);
+                });
+  EXPECT_EQ(expected, kThreads * kPerThread);
+}
@@ -0,0 +1,136 @@
+#include "execution/ParallelAggregateOperator.hpp"
+#include <gtest/gtest.h>
+#include <mutex>
+#include <set>
+
+class ParallelSeqScanTest : public ::testing::Test {
+protected:
+  BufferPoolManager *bpm;
+  TableHeap *heap;
+  std::string db_file = "test_parallel_scan.db";
+  Schema schema{{Column("id", TypeId::BIGINT, false),
+                 Column("bucket", TypeId::INTEGER, false)}};
+  static constexpr int kRows = 20000;
+
+  void SetUp() override {
+    std::remove(db_file.c_str());
+    // smaller than the table, so workers also evict and re-read pages
+    bpm = new BufferPoolManager(32, db_file);
+    heap = new TableHeap(bpm);
+
+    TupleBuilder builder(schema);
+    for (int i = 0; i < kRows; i++) {
+      builder.setBigInt(0, i);
+      builder.setInteger(1, i % 7);
+      ASSERT_TRUE(heap->insertTuple(builder));
+    }
+  }
+
+  void TearDown() override {
+    delete heap;
+    delete bpm;
+    std::remove(db_file.c_str());
+  }
+};
+
+TEST_F(ParallelSeqScanTest, MorselsCoverAllPagesOnce) {
+  std::vector<page_id_t> pages(103);
+  MorselQueue queue(pages, 10);
+  std::size_t begin;
+  std::size_t end;
+  std::size_t covered = 0;
+  int morsels = 0;
+  while (queue.next(&begin, &end)) {
+    EXPECT_EQ(begin, covered);
+    covered = end;
+    morsels++;
+  }
+  EXPECT_EQ(covered, 103u);
+  EXPECT_EQ(morsels, 11);
+}
+
+TEST_F(ParallelSeqScanTest, EveryRowSeenExactlyOnce) {
+  ParallelSeqScan scan(bpm, heap->getPageIds(), schema, {0}, {}, 4);
+  std::mutex mutex;
+  std::set<int64_t> seen;
+  std::size_t rows = 0;
+
+  ASSERT_TRUE(scan.execute(4, [&](std::size_t, DataChunk &chunk) {
+    std::lock_guard<std::mutex> guard(mutex);
+    for (std::size_t i = 0; i < chunk.getCount(); i++) {
+      seen.insert(chunk.getColumn(0).getData<int64_t>()[chunk.getRowIndex(i)]);
+      rows++;
+    }
+  }));
+
+  EXPECT_EQ(rows, static_cast<std::size_t>(kRows));
+  EXPECT_EQ(seen.size(), static_cast<std::size_t>(kRows));
+}
+
+TEST_F(ParallelSeqScanTest, AggregateMatchesAcrossThreadCounts) {
+  int64_t expected_sum = 0;
+  int64_t expected_count = 0;
+  for (int i = 0; i < kRows; i++) {
+    if (i % 7 == 3) {
+      expected_sum += i;
+      expected_count++;
+    }
+  }
+
+  for (std::size_t threads : {1, 2, 4, 8}) {
+    auto scan = std::make_unique<ParallelSeqScan>(
+        bpm, heap->getPageIds(), schema, std::vector<uint32_t>{},
+        std::vector<Predicate>{{1, CompareOp::EQ, Value::integer32(3)}}, 2);
+    ParallelAggregateOperator aggregate(
+        std::move(scan),
+        {{AggregateType::COUNT_STAR}, {AggregateType::SUM, 0}}, threads);
+
+    DataChunk chunk(aggregate.getOutputSchema());
+    ASSERT_TRUE(aggregate.next(chunk));
+    EXPECT_EQ(chunk.getColumn(0).getData<int64_t>()[0], expected_count);
+    EXPECT_EQ(chunk.getColumn(1).getData<int64_t>()[0], expected_sum);
+    EXPECT_FALSE(aggregate.next(chunk));
+  }
+}
+
+TEST_F(ParallelSeqScanTest, UnreadablePageFailsScan) {
+  // every frame pinned by other pages: no table page can be fetched
+  std::vector<page_id_t> pinned;
+  page_id_t page_id;
+  while (bpm->newPage(&page_id) != nullptr) {
+    pinned.push_back(page_id);
+  }
+
+  for (std::size_t threads : {1, 4}) {
+    ParallelSeqScan scan(bpm, heap->getPageIds(), schema, {0}, {}, 4);
+    std::atomic<std::size_t> rows{0};
+    EXPECT_FALSE(scan.execute(threads, [&](std::size_t, DataChunk &chunk) {
+      rows += chunk.getCount();
+    }));
+    EXPECT_LT(rows.load(), static_cast<std::size_t>(kRows));
+  }
+
+  for (page_id_t id : pinned) {
+    bpm->unpinPage(id, false);
+  }
+}
+
+TEST_F(ParallelSeqScanTest, AggregateReportsScanFailure) {
+  std::vector<page_id_t> pinned;
+  page_id_t page_id;
+  while (bpm->newPage(&page_id) != nullptr) {
+    pinned.push_back(page_id);
+  }
+
+  auto scan = std::make_unique<ParallelSeqScan>(
+      bpm, heap->getPageIds(), schema, std::vector<uint32_t>{});
+  ParallelAggregateOperator aggregate(std::move(scan),
+                                      {{AggregateType::COUNT_STAR}}, 4);
+  DataChunk chunk(aggregate.getOutputSchema());
+  EXPECT_FALSE(aggregate.next(chunk));
+  EXPECT_TRUE(aggregate.failed());
+
+  for (page_id_t id : pinned) {
+    bpm->unpinPage(id, false);
+  }
+}
@@ -0,0 +1,132 @@
+#include "buffer/SizeClassPool.hpp"
+#include <gtest/gtest.h>
+
+class SizeClassPoolTest : public ::testing::Test {
+protected:
+  BufferPoolManager *bpm;
+  std::string db_file = "test_size_class_pool.db";
+
+  void SetUp() override {
+    std::remove(db_file.c_str());
+    bpm = new BufferPoolManager(4, db_file);
+  }
+
+  void TearDown() override {
+    delete bpm;
+    std::remove(db_file.c_str());
+  }
+
+  static void fill(char *data, std::size_t bytes, int seed) {
+    for (std::size_t i = 0; i < bytes; i++) {
+      data[i] = static_cast<char>((i * 31 + seed) & 0x7f);
+    }
+  }
+
+  static bool matches(const char *data, std::size_t bytes, int seed) {
+    for (std::size_t i = 0; i < bytes; i++) {
+      if (data[i] != static_cast<char>((i * 31 + seed) & 0x7f)) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+TEST_F(SizeClassPoolTest, SizesRoundUpToClasses) {
+  EXPECT_EQ(SizeClassPool::pageSizeFor(1), 4096u);
+  EXPECT_EQ(SizeClassPool::pageSizeFor(4096), 4096u);
+  EXPECT_EQ(SizeClassPool::pageSizeFor(4097), 8192u);
+  EXPECT_EQ(SizeClassPool::pageSizeFor(100000), 131072u);
+  EXPECT_EQ(SizeClassPool::pageSizeFor(SizeClassPool::kMaxPageSize),
+            SizeClassPool::kMaxPageSize);
+
+  SizeClassPool pool(bpm, 1 << 20);
+  page_id_t page_id;
+  EXPECT_EQ(pool.newPage(SizeClassPool::kMaxPageSize + 1, &page_id),
+            nullptr);
+}
+
+TEST_F(SizeClassPoolTest, PagesReserveConsecutiveIds) {
+  SizeClassPool pool(bpm, 1 << 20);
+  page_id_t large_id, next_id;
+  ASSERT_NE(pool.newPage(5 * PAGE_SIZE, &large_id), nullptr); // 8 pages
+  bpm->newPage(&next_id);
+  EXPECT_EQ(next_id, large_id + 8);
+  bpm->unpinPage(next_id, false);
+  pool.unpinPage(large_id, false);
+}
+
+TEST_F(SizeClassPoolTest, LargePageIsOneRead) {
+  const std::size_t bytes = 100000;
+  page_id_t page_id;
+  {
+    SizeClassPool pool(bpm, 1 << 20);
+    char *data = pool.newPage(bytes, &page_id);
+    ASSERT_NE(data, nullptr);
+    fill(data, bytes, 1);
+    pool.unpinPage(page_id, true);
+  } // written back
+
+  SizeClassPool pool(bpm, 1 << 20);
+  bpm->resetStats();
+  char *data = pool.fetchPage(page_id, bytes);
+  ASSERT_NE(data, nullptr);
+  EXPECT_TRUE(matches(data, bytes, 1));
+  EXPECT_EQ(bpm->getStats().disk_reads, 1u);
+
+  // resident now: a second fetch is a hit
+  EXPECT_EQ(pool.fetchPage(page_id, bytes), data);
+  EXPECT_EQ(pool.fetchPage(page_id, 2 * bytes), nullptr); // wrong class
+  SizeClassStats stats = pool.getStats().classes[5];
+  EXPECT_EQ(stats.hits, 1u);
+  EXPECT_EQ(stats.misses, 1u);
+  pool.unpinPage(page_id, false);
+  pool.unpinPage(page_id, false);
+}
+
+TEST_F(SizeClassPoolTest, EvictsWithinClassBeforeOthers) {
+  const std::size_t small = 4 * PAGE_SIZE; // 16KB class
+  SizeClassPool pool(bpm, 4 * small);
+  std::vector<page_id_t> ids(5);
+  for (int i = 0; i < 5; i++) {
+    char *data = pool.newPage(small, &ids[i]);
+    ASSERT_NE(data, nullptr);
+    fill(data, small, i);
+    pool.unpinPage(ids[i], true);
+  }
+  // the fifth page reused the buffer of the first
+  SizeClassPoolStats stats = pool.getStats();
+  EXPECT_EQ(stats.allocated_bytes, 4 * small);
+  EXPECT_EQ(stats.classes[2].evictions, 1u);
+  EXPECT_EQ(stats.classes[2].resident_pages, 4u);
+
+  // a 32KB page takes the memory of the two coldest 16KB pages
+  page_id_t large_id;
+  ASSERT_NE(pool.newPage(2 * small, &large_id), nullptr);
+  stats = pool.getStats();
+  EXPECT_EQ(stats.allocated_bytes, 4 * small);
+  EXPECT_EQ(stats.classes[2].evictions, 3u);
+  EXPECT_EQ(stats.classes[2].resident_pages, 2u);
+  EXPECT_EQ(stats.classes[3].resident_pages, 1u);
+  pool.unpinPage(large_id, false);
+
+  // evicted pages come back intact from disk
+  for (int i = 0; i < 5; i++) {
+    char *data = pool.fetchPage(ids[i], small);
+    ASSERT_NE(data, nullptr);
+    EXPECT_TRUE(matches(data, small, i)) << i;
+    pool.unpinPage(ids[i], false);
+  }
+}
+
+TEST_F(SizeClassPoolTest, PinnedPagesAreNeverEvicted) {
+  SizeClassPool pool(bpm, 2 * PAGE_SIZE);
+  page_id_t pinned_id, other_id;
+  ASSERT_NE(pool.newPage(2 * PAGE_SIZE, &pinned_id), nullptr);
+  EXPECT_EQ(pool.newPage(PAGE_SIZE, &other_id), nullptr);
+
+  pool.unpinPage(pinned_id, true);
+  EXPECT_NE(pool.newPage(PAGE_SIZE, &other_id), nullptr);
+  EXPECT_EQ(pool.getStats().classes[1].evictions, 1u);
+  pool.unpinPage(other_id, false);
+}
@@ -0,0 +1,114 @@
+#include "table/TableHeap.hpp"
+#include <gtest/gtest.h>
+
+struct TestRecord {
+  int id;
+  char data[200];
+};
+
+class TableHeapTest : public ::testing::Test {
+protected:
+  BufferPoolManager *bpm;
+  std::string db_file = "test_table_heap.db";
+
+  void SetUp() override {
+    std::remove(db_file.c_str());
+    bpm = new BufferPoolManager(4, db_file);
+  }
+
+  void TearDown() override {
+    delete bpm;
+    std::remove(db_file.c_str());
+  }
+};
+
+TEST_F(TableHeapTest, InsertAndGet) {
+  TableHeap heap(bpm);
+  TestRecord rec = {7, "Hello"};
+  RID rid;
+
+  ASSERT_TRUE(heap.insertRecord((char *)&rec, sizeof(rec), &rid));
+  EXPECT_EQ(rid.page_id, heap.getFirstPageId());
+  EXPECT_EQ(rid.slot_num, 0);
+
+  std::vector<char> out;
+  ASSERT_TRUE(heap.getRecord(rid, out));
+  ASSERT_EQ(out.size(), sizeof(TestRecord));
+  EXPECT_EQ(((TestRecord *)out.data())->id, 7);
+}
+
+TEST_F(TableHeapTest, GrowsAcrossPagesAndReopens) {
+  page_id_t first_page_id;
+  {
+    TableHeap heap(bpm);
+    first_page_id = heap.getFirstPageId();
+    // ~19 records fit in one page, more than the 4 frames worth of pages
+    for (int i = 0; i < 150; i++) {
+      TestRecord rec = {i, "Data"};
+      ASSERT_TRUE(heap.insertRecord((char *)&rec, sizeof(rec)));
+    }
+    EXPECT_GT(heap.getPageIds().size(), 4u);
+  }
+
+  // reopening walks the page chain
+  TableHeap reopened(bpm, first_page_id);
+  int expected = 0;
+  reopened.forEachRecord([&](const RID &, const char *data, uint16_t) {
+    EXPECT_EQ(((const TestRecord *)data)->id, expected);
+    expected++;
+  });
+  EXPECT_EQ(expected, 150);
+}
+
+TEST_F(TableHeapTest, DeleteSkipsRecordInScan) {
+  TableHeap heap(bpm);
+  RID rids[3];
+  for (int i = 0; i < 3; i++) {
+    TestRecord rec = {i, "Data"};
+    heap.insertRecord((char *)&rec, sizeof(rec), &rids[i]);
+  }
+
+  ASSERT_TRUE(heap.deleteRecord(rids[1]));
+
+  std::vector<int> ids;
+  heap.forEachRecord([&](const RID &, const char *data, uint16_t) {
+    ids.push_back(((const TestRecord *)data)->id);
+  });
+  EXPECT_EQ(ids, (std::vector<int>{0, 2}));
+
+  std::vector<char> out;
+  EXPECT_FALSE(heap.getRecord(rids[1], out));
+}
+
+TEST_F(TableHeapTest, UpdateRecord) {
+  TableHeap heap(bpm);
+  TestRecord rec = {1, "Before"};
+  RID rid;
+  heap.insertRecord((char *)&rec, sizeof(rec), &rid);
+
+  strcpy(rec.data, "After");
+  ASSERT_TRUE(heap.updateRecord(rid, (char *)&rec, sizeof(rec)));
+
+  std::vector<char> out;
+  ASSERT_TRUE(heap.getRecord(rid, out));
+  EXPECT_STREQ(((TestRecord *)out.data())->data, "After");
+}
+
+TEST_F(TableHeapTest, HeapInOwnFileIsDroppedWithIt) {
+  std::string table_file = "test_table_heap_own.db";
+  file_id_t file_id = bpm->addFile(table_file);
+  ASSERT_NE(file_id, INVALID_FILE_ID);
+  {
+    TableHeap heap(bpm, file_id);
+    TestRecord rec = {1, "Own file"};
+    for (int i = 0; i < 100; i++) {
+      ASSERT_TRUE(heap.insertRecord((char *)&rec, sizeof(rec)));
+    }
+    ASSERT_GT(heap.getPageIds().size(), 1u);
+    for (page_id_t page_id : heap.getPageIds()) {
+      EXPECT_EQ(fileOf(page_id), file_id);
+    }
+  }
+  EXPECT_EQ(bpm->getNumPages(), 0u);
+  EXPECT_TRUE(bpm->dropFile(file_id));
+}
@@ -0,0 +1,155 @@
+#include "storage/Tuple.hpp"
+#include <gtest/gtest.h>
+
+class TupleTest : public ::testing::Test {
+protected:
+  Schema schema{{Column("id", TypeId::INTEGER, false),
+                 Column("name", TypeId::VARCHAR),
+                 Column("balance", TypeId::DOUBLE),
+                 Column("active", TypeId::BOOLEAN),
+                 Column("email", TypeId::VARCHAR),
+                 Column("created_at", TypeId::BIGINT)}};
+  Page page;
+};
+
+// ============ SCHEMA TESTS ============
+
+TEST_F(TupleTest, SchemaOffsets) {
+  // 6 columns -> 1 byte of null bitmap, then slots in column order
+  EXPECT_EQ(schema.getNullBitmapSize(), 1);
+  EXPECT_EQ(schema.getOffset(0), 1);  // INTEGER
+  EXPECT_EQ(schema.getOffset(1), 5);  // VARCHAR entry
+  EXPECT_EQ(schema.getOffset(2), 9);  // DOUBLE
+  EXPECT_EQ(schema.getOffset(3), 17); // BOOLEAN
+  EXPECT_EQ(schema.getOffset(4), 18); // VARCHAR entry
+  EXPECT_EQ(schema.getOffset(5), 22); // BIGINT
+  EXPECT_EQ(schema.getFixedLength(), 30);
+
+  EXPECT_EQ(schema.getVarlenColumns().size(), 2u);
+  EXPECT_EQ(schema.getColumnIndex("balance"), 2);
+  EXPECT_EQ(schema.getColumnIndex("missing"), -1);
+}
+
+// ============ SERIALIZATION TESTS ============
+
+TEST_F(TupleTest, RoundTripThroughPage) {
+  TupleBuilder builder(schema);
+  builder.setInteger(0, 42);
+  builder.setVarchar(1, "Alice");
+  builder.setDouble(2, 1234.5);
+  builder.setBoolean(3, true);
+  builder.setVarchar(4, "alice@example.com");
+  builder.setBigInt(5, 1700000000000LL);
+
+  ASSERT_TRUE(builder.insertInto(page));
+  EXPECT_EQ(page.getNumberOfRecords(), 1);
+  EXPECT_EQ(page.getRecordLength(0), builder.getSerializedLength());
+
+  Tuple tuple = Tuple::fromPage(&schema, page, 0);
+  ASSERT_TRUE(tuple.isValid());
+  EXPECT_EQ(tuple.getInteger(0), 42);
+  EXPECT_EQ(tuple.getVarchar(1), "Alice");
+  EXPECT_DOUBLE_EQ(tuple.getDouble(2), 1234.5);
+  EXPECT_TRUE(tuple.getBoolean(3));
+  EXPECT_EQ(tuple.getVarchar(4), "alice@example.com");
+  EXPECT_EQ(tuple.getBigInt(5), 1700000000000LL);
+  for (uint32_t i = 0; i < schema.getColumnCount(); i++) {
+    EXPECT_FALSE(tuple.isNull(i));
+  }
+}
+
+TEST_F(TupleTest, NullColumns) {
+  TupleBuilder builder(schema);
+  builder.setInteger(0, 7);
+  builder.setVarchar(4, "only-email");
+  // everything else is left NULL
+
+  ASSERT_TRUE(builder.insertInto(page));
+  Tuple tuple = Tuple::fromPage(&schema, page, 0);
+
+  EXPECT_FALSE(tuple.isNull(0));
+  EXPECT_TRUE(tuple.isNull(1));
+  EXPECT_TRUE(tuple.isNull(2));
+  EXPECT_TRUE(tuple.isNull(3));
+  EXPECT_FALSE(tuple.isNull(4));
+  EXPECT_TRUE(tuple.isNull(5));
+
+  // a NULL varchar takes no varlen space
+  EXPECT_EQ(tuple.getVarchar(1).size(), 0u);
+  EXPECT_EQ(tuple.getVarchar(4), "only-email");
+  EXPECT_EQ(tuple.getLength(), schema.getFixedLength() + 10);
+}
+
+TEST_F(TupleTest, BuilderReuseAfterReset) {
+  TupleBuilder builder(schema);
+  builder.setInteger(0, 1);
+  builder.setVarchar(1, "a rather long first name");
+  ASSERT_TRUE(builder.insertInto(page));
+
+  builder.reset();
+  builder.setInteger(0, 2);
+  builder.setVarchar(1, "Bo");
+  ASSERT_TRUE(builder.insertInto(page));
+
+  Tuple first = Tuple::fromPage(&schema, page, 0);
+  Tuple second = Tuple::fromPage(&schema, page, 1);
+  EXPECT_EQ(first.getVarchar(1), "a rather long first name");
+  EXPECT_EQ(second.getInteger(0), 2);
+  EXPECT_EQ(second.getVarchar(1), "Bo");
+  EXPECT_TRUE(second.isNull(2));
+}
+
+TEST_F(TupleTest, CopyColumnsBetweenSchemas) {
+  TupleBuilder builder(schema);
+  builder.setInteger(0, 9);
+  builder.setVarchar(1, "Carol");
+  builder.setBigInt(5, 99);
+  ASSERT_TRUE(builder.insertInto(page));
+  Tuple source = Tuple::fromPage(&schema, page, 0);
+
+  Schema projected = schema.project({5, 1, 2});
+  TupleBuilder projector(projected);
+  projector.setFrom(0, source, 5);
+  projector.setFrom(1, source, 1);
+  projector.setFrom(2, source, 2);
+
+  std::vector<char> buffer(projector.getSerializedLength());
+  projector.serializeTo(buffer.data());
+  Tuple copy(&projected, buffer.data(), buffer.size());
+
+  EXPECT_EQ(copy.getBigInt(0), 99);
+  EXPECT_EQ(copy.getVarchar(1), "Carol");
+  EXPECT_TRUE(copy.isNull(2));
+}
+
+TEST_F(TupleTest, PageFullRejectsTuple) {
+  TupleBuilder builder(schema);
+  builder.setInteger(0, 1);
+  builder.setVarchar(1, std::string(1000, 'x'));
+
+  int count = 0;
+  while (builder.insertInto(page)) {
+    count++;
+  }
+
+  EXPECT_EQ(count, 3); // 4 * ~1030 bytes does not fit in 4KB
+  EXPECT_EQ(page.getNumberOfRecords(), 3);
+  Tuple last = Tuple::fromPage(&schema, page, 2);
+  EXPECT_EQ(last.getVarchar(1).size(), 1000u);
+}
+
+TEST_F(TupleTest, RowLongerThanPageRejected) {
+  TupleBuilder builder(schema);
+  builder.setInteger(0, 1);
+  // 64 KB + 100 bytes would wrap to a small uint16 record length
+  builder.setVarchar(1, std::string(65536 + 100, 'x'));
+  EXPECT_FALSE(builder.fitsInPage());
+  EXPECT_FALSE(builder.insertInto(page));
+  EXPECT_EQ(page.getNumberOfRecords(), 0);
+
+  builder.setVarchar(1, std::string(Page::MAX_RECORD_LENGTH -
+                                        schema.getFixedLength(),
+                                    'x'));
+  EXPECT_TRUE(builder.fitsInPage());
+  EXPECT_TRUE(builder.insertInto(page));
+}